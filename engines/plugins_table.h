@@ -0,0 +1,153 @@
+/* This file is automatically generated by configure */
+/* DO NOT EDIT MANUALLY */
+// This file is being included by "base/plugins.cpp"
+#if PLUGIN_ENABLED_STATIC(SCUMM)
+LINK_PLUGIN(SCUMM)
+#endif
+#if PLUGIN_ENABLED_STATIC(ACCESS)
+LINK_PLUGIN(ACCESS)
+#endif
+#if PLUGIN_ENABLED_STATIC(AGI)
+LINK_PLUGIN(AGI)
+#endif
+#if PLUGIN_ENABLED_STATIC(AGOS)
+LINK_PLUGIN(AGOS)
+#endif
+#if PLUGIN_ENABLED_STATIC(AVALANCHE)
+LINK_PLUGIN(AVALANCHE)
+#endif
+#if PLUGIN_ENABLED_STATIC(BBVS)
+LINK_PLUGIN(BBVS)
+#endif
+#if PLUGIN_ENABLED_STATIC(CGE)
+LINK_PLUGIN(CGE)
+#endif
+#if PLUGIN_ENABLED_STATIC(CGE2)
+LINK_PLUGIN(CGE2)
+#endif
+#if PLUGIN_ENABLED_STATIC(CINE)
+LINK_PLUGIN(CINE)
+#endif
+#if PLUGIN_ENABLED_STATIC(COMPOSER)
+LINK_PLUGIN(COMPOSER)
+#endif
+#if PLUGIN_ENABLED_STATIC(CRUISE)
+LINK_PLUGIN(CRUISE)
+#endif
+#if PLUGIN_ENABLED_STATIC(DRACI)
+LINK_PLUGIN(DRACI)
+#endif
+#if PLUGIN_ENABLED_STATIC(DRASCULA)
+LINK_PLUGIN(DRASCULA)
+#endif
+#if PLUGIN_ENABLED_STATIC(DREAMWEB)
+LINK_PLUGIN(DREAMWEB)
+#endif
+#if PLUGIN_ENABLED_STATIC(FULLPIPE)
+LINK_PLUGIN(FULLPIPE)
+#endif
+#if PLUGIN_ENABLED_STATIC(GOB)
+LINK_PLUGIN(GOB)
+#endif
+#if PLUGIN_ENABLED_STATIC(GROOVIE)
+LINK_PLUGIN(GROOVIE)
+#endif
+#if PLUGIN_ENABLED_STATIC(HOPKINS)
+LINK_PLUGIN(HOPKINS)
+#endif
+#if PLUGIN_ENABLED_STATIC(HUGO)
+LINK_PLUGIN(HUGO)
+#endif
+#if PLUGIN_ENABLED_STATIC(KYRA)
+LINK_PLUGIN(KYRA)
+#endif
+#if PLUGIN_ENABLED_STATIC(LASTEXPRESS)
+LINK_PLUGIN(LASTEXPRESS)
+#endif
+#if PLUGIN_ENABLED_STATIC(LURE)
+LINK_PLUGIN(LURE)
+#endif
+#if PLUGIN_ENABLED_STATIC(MADE)
+LINK_PLUGIN(MADE)
+#endif
+#if PLUGIN_ENABLED_STATIC(MADS)
+LINK_PLUGIN(MADS)
+#endif
+#if PLUGIN_ENABLED_STATIC(MOHAWK)
+LINK_PLUGIN(MOHAWK)
+#endif
+#if PLUGIN_ENABLED_STATIC(MORTEVIELLE)
+LINK_PLUGIN(MORTEVIELLE)
+#endif
+#if PLUGIN_ENABLED_STATIC(NEVERHOOD)
+LINK_PLUGIN(NEVERHOOD)
+#endif
+#if PLUGIN_ENABLED_STATIC(PARALLACTION)
+LINK_PLUGIN(PARALLACTION)
+#endif
+#if PLUGIN_ENABLED_STATIC(PEGASUS)
+LINK_PLUGIN(PEGASUS)
+#endif
+#if PLUGIN_ENABLED_STATIC(PRINCE)
+LINK_PLUGIN(PRINCE)
+#endif
+#if PLUGIN_ENABLED_STATIC(QUEEN)
+LINK_PLUGIN(QUEEN)
+#endif
+#if PLUGIN_ENABLED_STATIC(SAGA)
+LINK_PLUGIN(SAGA)
+#endif
+#if PLUGIN_ENABLED_STATIC(SCI)
+LINK_PLUGIN(SCI)
+#endif
+#if PLUGIN_ENABLED_STATIC(SHERLOCK)
+LINK_PLUGIN(SHERLOCK)
+#endif
+#if PLUGIN_ENABLED_STATIC(SKY)
+LINK_PLUGIN(SKY)
+#endif
+#if PLUGIN_ENABLED_STATIC(SWORD1)
+LINK_PLUGIN(SWORD1)
+#endif
+#if PLUGIN_ENABLED_STATIC(SWORD2)
+LINK_PLUGIN(SWORD2)
+#endif
+#if PLUGIN_ENABLED_STATIC(SWORD25)
+LINK_PLUGIN(SWORD25)
+#endif
+#if PLUGIN_ENABLED_STATIC(TEENAGENT)
+LINK_PLUGIN(TEENAGENT)
+#endif
+#if PLUGIN_ENABLED_STATIC(TESTBED)
+LINK_PLUGIN(TESTBED)
+#endif
+#if PLUGIN_ENABLED_STATIC(TINSEL)
+LINK_PLUGIN(TINSEL)
+#endif
+#if PLUGIN_ENABLED_STATIC(TOLTECS)
+LINK_PLUGIN(TOLTECS)
+#endif
+#if PLUGIN_ENABLED_STATIC(TONY)
+LINK_PLUGIN(TONY)
+#endif
+#if PLUGIN_ENABLED_STATIC(TOON)
+LINK_PLUGIN(TOON)
+#endif
+#if PLUGIN_ENABLED_STATIC(TOUCHE)
+LINK_PLUGIN(TOUCHE)
+#endif
+#if PLUGIN_ENABLED_STATIC(TSAGE)
+LINK_PLUGIN(TSAGE)
+#endif
+#if PLUGIN_ENABLED_STATIC(TUCKER)
+LINK_PLUGIN(TUCKER)
+#endif
+#if PLUGIN_ENABLED_STATIC(VOYEUR)
+LINK_PLUGIN(VOYEUR)
+#endif
+#if PLUGIN_ENABLED_STATIC(WINTERMUTE)
+LINK_PLUGIN(WINTERMUTE)
+#endif
+#if PLUGIN_ENABLED_STATIC(ZVISION)
+LINK_PLUGIN(ZVISION)
+#endif
@@ -139,6 +139,7 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	registerCmd("pl",                 WRAP_METHOD(Console, cmdPlaneList));	// alias
 	registerCmd("plane_items",        WRAP_METHOD(Console, cmdPlaneItemList));
 	registerCmd("pi",                 WRAP_METHOD(Console, cmdPlaneItemList));	// alias
+	registerCmd("frame_stats",        WRAP_METHOD(Console, cmdFrameStats));
 	registerCmd("saved_bits",         WRAP_METHOD(Console, cmdSavedBits));
 	registerCmd("show_saved_bits",    WRAP_METHOD(Console, cmdShowSavedBits));
 	// Segments
@@ -154,6 +155,8 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	registerCmd("gc_reachable",		WRAP_METHOD(Console, cmdGCShowReachable));
 	registerCmd("gc_freeable",		WRAP_METHOD(Console, cmdGCShowFreeable));
 	registerCmd("gc_normalize",		WRAP_METHOD(Console, cmdGCNormalize));
+	registerCmd("gc_mode",				WRAP_METHOD(Console, cmdGCMode));
+	registerCmd("gc_stats",			WRAP_METHOD(Console, cmdGCStats));
 	// Music/SFX
 	registerCmd("songlib",			WRAP_METHOD(Console, cmdSongLib));
 	registerCmd("songinfo",			WRAP_METHOD(Console, cmdSongInfo));
@@ -381,6 +384,7 @@ bool Console::cmdHelp(int argc, const char **argv) {
 	debugPrintf(" window_list / wl - Shows a list of all the windows (ports) in the draw list (SCI0 - SCI1.1)\n");
 	debugPrintf(" plane_list / pl - Shows a list of all the planes in the draw list (SCI2+)\n");
 	debugPrintf(" plane_items / pi - Shows a list of all items for a plane (SCI2+)\n");
+	debugPrintf(" frame_stats - Shows how much of the screen gets redrawn per frame (SCI2+)\n");
 	debugPrintf(" saved_bits - List saved bits on the hunk\n");
 	debugPrintf(" show_saved_bits - Display saved bits\n");
 	debugPrintf("\n");
@@ -395,6 +399,8 @@ bool Console::cmdHelp(int argc, const char **argv) {
 	debugPrintf(" gc_reachable - Lists all addresses directly reachable from a given memory object\n");
 	debugPrintf(" gc_freeable - Lists all addresses freeable in a given segment\n");
 	debugPrintf(" gc_normalize - Prints the \"normal\" address of a given address\n");
+	debugPrintf(" gc_mode - Shows or sets the garbage collection mode\n");
+	debugPrintf(" gc_stats - Shows garbage collection pause times\n");
 	debugPrintf("\n");
 	debugPrintf("Music/SFX:\n");
 	debugPrintf(" songlib - Shows the song library\n");
@@ -1796,6 +1802,37 @@ bool Console::cmdPlaneItemList(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::cmdFrameStats(int argc, const char **argv) {
+#ifdef ENABLE_SCI32
+	if (!_engine->_gfxFrameout) {
+		debugPrintf("This SCI version does not use kFrameOut\n");
+		return true;
+	}
+
+	if (argc == 2) {
+		if (!scumm_stricmp(argv[1], "reset")) {
+			_engine->_gfxFrameout->resetFrameStats();
+			debugPrintf("Frame statistics reset\n");
+			return true;
+		} else if (!scumm_stricmp(argv[1], "on")) {
+			_engine->_gfxFrameout->setDirtyRectsEnabled(true);
+		} else if (!scumm_stricmp(argv[1], "off")) {
+			_engine->_gfxFrameout->setDirtyRectsEnabled(false);
+		} else {
+			debugPrintf("Shows how much of the screen gets recomposited per frame\n");
+			debugPrintf("Usage: %s [reset | on | off]\n", argv[0]);
+			debugPrintf("on/off enables or disables redrawing of damaged regions only\n");
+			return true;
+		}
+	}
+
+	_engine->_gfxFrameout->printFrameStats(this);
+#else
+	debugPrintf("SCI32 isn't included in this compiled executable\n");
+#endif
+	return true;
+}
+
 bool Console::cmdSavedBits(int argc, const char **argv) {
 	SegManager *segman = _engine->_gamestate->_segMan;
 	SegmentId id = segman->findSegmentByType(SEG_TYPE_HUNK);
@@ -2466,6 +2503,66 @@ bool Console::cmdGCNormalize(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::cmdGCMode(int argc, const char **argv) {
+	GarbageCollector *gc = _engine->_gamestate->_gc;
+
+	if (argc < 2 || argc > 3) {
+		debugPrintf("Shows or sets the garbage collection mode.\n");
+		debugPrintf("Usage: %s full|incremental|nursery|nonursery [step budget]\n", argv[0]);
+		debugPrintf(" full - Stop-the-world collection every gc_interval kernel calls\n");
+		debugPrintf(" incremental - Collection in bounded steps, one per kernel call\n");
+		debugPrintf(" nursery/nonursery - Toggle cheap collections of recent allocations\n");
+		debugPrintf("Current mode: %s, nursery %s, step budget %d\n",
+			gc->getMode() == kGCModeIncremental ? "incremental" : "full",
+			gc->isNurseryEnabled() ? "on" : "off", gc->_stepBudget);
+		return true;
+	}
+
+	if (!scumm_stricmp(argv[1], "full")) {
+		gc->setMode(kGCModeFull);
+	} else if (!scumm_stricmp(argv[1], "incremental")) {
+		gc->setMode(kGCModeIncremental);
+		if (argc == 3)
+			gc->_stepBudget = MAX(atoi(argv[2]), 1);
+	} else if (!scumm_stricmp(argv[1], "nursery")) {
+		gc->setNurseryEnabled(true);
+	} else if (!scumm_stricmp(argv[1], "nonursery")) {
+		gc->setNurseryEnabled(false);
+	} else {
+		debugPrintf("Unknown mode '%s'\n", argv[1]);
+	}
+
+	return true;
+}
+
+static void printGCPauseStats(Console *con, const char *name, const GCPauseStats &stats) {
+	con->debugPrintf("%-12s %6d pauses, %6d ms total, %4d ms max, %6d max work, %6d freed\n",
+		name, stats.count, stats.totalTime, stats.maxTime, stats.maxWork, stats.freed);
+}
+
+bool Console::cmdGCStats(int argc, const char **argv) {
+	GarbageCollector *gc = _engine->_gamestate->_gc;
+
+	if (argc == 2 && !scumm_stricmp(argv[1], "reset")) {
+		gc->resetStats();
+		debugPrintf("Garbage collection statistics reset\n");
+		return true;
+	}
+
+	debugPrintf("Mode: %s, nursery %s%s\n",
+		gc->getMode() == kGCModeIncremental ? "incremental" : "full",
+		gc->isNurseryEnabled() ? "on" : "off",
+		gc->isCycleActive() ? ", cycle in progress" : "");
+	printGCPauseStats(this, "Full:", gc->_fullStats);
+	printGCPauseStats(this, "Incremental:", gc->_stepStats);
+	printGCPauseStats(this, "Nursery:", gc->_nurseryStats);
+	debugPrintf("Completed incremental cycles: %d, last one freed %d entries\n", gc->_cycles, gc->_lastCycleFreed);
+	debugPrintf("Work is counted in references traced and entries swept\n");
+	debugPrintf("Use \"%s reset\" to reset the statistics\n", argv[0]);
+
+	return true;
+}
+
 bool Console::cmdVMVarlist(int argc, const char **argv) {
 	EngineState *s = _engine->_gamestate;
 	const char *varnames[] = {"global", "local", "temp", "param"};
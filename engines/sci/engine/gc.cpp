@@ -22,6 +22,7 @@
 
 #include "sci/engine/gc.h"
 #include "common/array.h"
+#include "common/system.h"
 #include "sci/graphics/ports.h"
 
 namespace Sci {
@@ -64,6 +65,11 @@ void WorklistManager::pushArray(const Common::Array<reg_t> &tmp) {
 		push(*it);
 }
 
+void WorklistManager::clear() {
+	_worklist.clear();
+	_map.clear();
+}
+
 static AddrSet *normalizeAddresses(SegManager *segMan, const AddrSet &nonnormal_map) {
 	AddrSet *normal_map = new AddrSet();
 
@@ -95,10 +101,22 @@ static void processWorkList(SegManager *segMan, WorklistManager &wm, const Commo
 	}
 }
 
-AddrSet *findAllActiveReferences(EngineState *s) {
-	assert(!s->_executionStack.empty());
+static void pushLockedScripts(const Common::Array<SegmentObj *> &heap, WorklistManager &wm) {
+	uint heapSize = heap.size();
 
-	WorklistManager wm;
+	for (uint i = 1; i < heapSize; i++) {
+		if (heap[i] && heap[i]->getType() == SEG_TYPE_SCRIPT) {
+			Script *script = (Script *)heap[i];
+
+			if (script->getLockers()) { // Explicitly loaded?
+				wm.pushArray(script->listObjectReferences());
+			}
+		}
+	}
+}
+
+static void pushVMRoots(EngineState *s, WorklistManager &wm) {
+	assert(!s->_executionStack.empty());
 
 	// Initialize registers
 	wm.push(s->r_acc);
@@ -135,20 +153,17 @@ AddrSet *findAllActiveReferences(EngineState *s) {
 	}
 
 	debugC(kDebugLevelGC, "[GC] -- Finished adding execution stack");
+}
+
+AddrSet *findAllActiveReferences(EngineState *s) {
+	WorklistManager wm;
+
+	pushVMRoots(s, wm);
 
 	const Common::Array<SegmentObj *> &heap = s->_segMan->getSegments();
-	uint heapSize = heap.size();
 
 	// Init: Explicitly loaded scripts
-	for (uint i = 1; i < heapSize; i++) {
-		if (heap[i] && heap[i]->getType() == SEG_TYPE_SCRIPT) {
-			Script *script = (Script *)heap[i];
-
-			if (script->getLockers()) { // Explicitly loaded?
-				wm.pushArray(script->listObjectReferences());
-			}
-		}
-	}
+	pushLockedScripts(heap, wm);
 
 	debugC(kDebugLevelGC, "[GC] -- Finished explicitly loaded scripts, done with root set");
 
@@ -160,8 +175,9 @@ AddrSet *findAllActiveReferences(EngineState *s) {
 	return normalizeAddresses(s->_segMan, wm._map);
 }
 
-void run_gc(EngineState *s) {
+static uint32 runFullCollection(EngineState *s, uint &liveCount) {
 	SegManager *segMan = s->_segMan;
+	uint32 freed = 0;
 
 	// Some debug stuff
 	debugC(kDebugLevelGC, "[GC] Running...");
@@ -174,6 +190,7 @@ void run_gc(EngineState *s) {
 
 	// Compute the set of all segments references currently in use.
 	AddrSet *activeRefs = findAllActiveReferences(s);
+	liveCount = activeRefs->size();
 
 	// Iterate over all segments, and check for each whether it
 	// contains stuff that can be collected.
@@ -196,6 +213,7 @@ void run_gc(EngineState *s) {
 					// Not found -> we can free it
 					mobj->freeAtAddress(segMan, addr);
 					debugC(kDebugLevelGC, "[GC] Deallocating %04x:%04x", PRINT_REG(addr));
+					freed++;
 #ifdef GC_DEBUG_CODE
 					segcount[type]++;
 #endif
@@ -214,6 +232,355 @@ void run_gc(EngineState *s) {
 		if (segcount[i])
 			debugC(kDebugLevelGC, "\t%d\t* %s", segcount[i], segnames[i]);
 #endif
+
+	return freed;
+}
+
+void run_gc(EngineState *s) {
+	s->_gc->collectFull();
+}
+
+// Segment types which hold individually allocated entries. These are
+// the only ones considered by nursery collections.
+static bool isEntryTableType(SegmentType type) {
+	switch (type) {
+	case SEG_TYPE_CLONES:
+	case SEG_TYPE_LISTS:
+	case SEG_TYPE_NODES:
+	case SEG_TYPE_HUNK:
+#ifdef ENABLE_SCI32
+	case SEG_TYPE_ARRAY:
+	case SEG_TYPE_STRING:
+#endif
+		return true;
+	default:
+		return false;
+	}
+}
+
+// Like processWorkList(), but stops after the given amount of references.
+// Used by incremental cycles, where queued entries may have been freed by
+// the scripts in the meantime.
+static uint processWorkListBounded(SegManager *segMan, WorklistManager &wm, uint budget) {
+	const Common::Array<SegmentObj *> &heap = segMan->getSegments();
+	SegmentId stackSegment = segMan->findSegmentByType(SEG_TYPE_STACK);
+	uint work = 0;
+
+	while (!wm._worklist.empty() && work < budget) {
+		reg_t reg = wm._worklist.back();
+		wm._worklist.pop_back();
+		work++;
+
+		if (reg.getSegment() == stackSegment || reg.getSegment() >= heap.size())
+			continue;
+
+		SegmentObj *mobj = heap[reg.getSegment()];
+		if (mobj && mobj->isValidOffset(reg.getOffset()))
+			wm.pushArray(mobj->listAllOutgoingReferences(reg));
+	}
+
+	return work;
+}
+
+void GCPauseStats::reset() {
+	count = 0;
+	totalTime = 0;
+	maxTime = 0;
+	maxWork = 0;
+	freed = 0;
+}
+
+void GCPauseStats::record(uint32 time, uint32 work, uint32 freedCount) {
+	count++;
+	totalTime += time;
+	if (time > maxTime)
+		maxTime = time;
+	if (work > maxWork)
+		maxWork = work;
+	freed += freedCount;
+}
+
+GarbageCollector::GarbageCollector(EngineState *s)
+	: _stepBudget(256), _nurseryThreshold(1024), _cycles(0), _lastCycleFreed(0), _s(s),
+	  _segMan(s->_segMan), _mode(kGCModeFull), _nurseryEnabled(false),
+	  _phase(kPhaseIdle), _live(0), _sweepSegment(0), _sweepPos(0), _cycleFreed(0) {
+}
+
+GarbageCollector::~GarbageCollector() {
+	delete _live;
+}
+
+void GarbageCollector::collect() {
+	if (_mode == kGCModeFull)
+		collectFull();
+	else if (_phase == kPhaseIdle)
+		startCycle();
+	else
+		step();
+}
+
+void GarbageCollector::step() {
+	if (_phase == kPhaseIdle) {
+		// The stored references are bounded as well, as they are logged on
+		// every pointer store
+		if (_nurseryEnabled &&
+		    (_segMan->getGCAllocations().size() >= _nurseryThreshold ||
+		     _segMan->getGCStoredRefs().size() >= _nurseryThreshold * 16))
+			collectNursery();
+		return;
+	}
+
+	uint32 startTime = g_system->getMillis();
+	uint32 freed = 0;
+	uint work;
+
+	if (_phase == kPhaseMark)
+		work = markStep(_stepBudget);
+	else
+		work = sweepStep(_stepBudget, freed);
+
+	_stepStats.record(g_system->getMillis() - startTime, work, freed);
+}
+
+void GarbageCollector::collectFull() {
+	uint32 startTime = g_system->getMillis();
+	uint liveCount = 0;
+
+	debugC(kDebugLevelGC, "[GC] Full collection");
+
+	// Any active cycle is superseded by the full collection
+	reset();
+
+	uint32 freed = runFullCollection(_s, liveCount);
+
+	// Everything which survived is old now
+	updateTracking();
+
+	_fullStats.record(g_system->getMillis() - startTime, liveCount, freed);
+}
+
+void GarbageCollector::collectNursery() {
+	uint32 startTime = g_system->getMillis();
+	const Common::Array<SegmentObj *> &heap = _segMan->getSegments();
+	Common::Array<reg_t> &allocated = _segMan->getGCAllocations();
+	Common::Array<reg_t> &stored = _segMan->getGCStoredRefs();
+	uint work = 0;
+	uint32 freed = 0;
+
+	debugC(kDebugLevelGC, "[GC] Nursery collection: %d allocations, %d stores", allocated.size(), stored.size());
+
+	// Entries allocated since the last collection, which are still in use.
+	// Entries may have been freed and reallocated in the meantime, so the
+	// same address may show up more than once.
+	AddrSet young;
+	for (Common::Array<reg_t>::const_iterator it = allocated.begin(); it != allocated.end(); ++it) {
+		SegmentObj *mobj = (it->getSegment() < heap.size()) ? heap[it->getSegment()] : NULL;
+		if (mobj && isEntryTableType(mobj->getType()) && mobj->isValidOffset(it->getOffset()))
+			young.setVal(*it, true);
+	}
+
+	if (!young.empty()) {
+		WorklistManager wm;
+
+		// Any reference to a young entry from older heap memory has been
+		// stored after the entry was allocated, so it has been logged by
+		// the write barrier. This means that only the VM roots and the
+		// logged stores need to be considered, and only young entries
+		// need to be traced.
+		pushVMRoots(_s, wm);
+		wm.pushArray(stored);
+		if (g_sci->_gfxPorts)
+			g_sci->_gfxPorts->processEngineHunkList(wm);
+
+		while (!wm._worklist.empty()) {
+			reg_t reg = wm._worklist.back();
+			wm._worklist.pop_back();
+			work++;
+
+			if (young.contains(reg))
+				wm.pushArray(heap[reg.getSegment()]->listAllOutgoingReferences(reg));
+		}
+
+		for (AddrSet::const_iterator it = young.begin(); it != young.end(); ++it) {
+			if (!wm._map.contains(it->_key)) {
+				heap[it->_key.getSegment()]->freeAtAddress(_segMan, it->_key);
+				debugC(kDebugLevelGC, "[GC] Deallocating %04x:%04x", PRINT_REG(it->_key));
+				freed++;
+			}
+		}
+	}
+
+	allocated.clear();
+	stored.clear();
+
+	_nurseryStats.record(g_system->getMillis() - startTime, work, freed);
+}
+
+void GarbageCollector::reset() {
+	delete _live;
+	_live = 0;
+	_wm.clear();
+	_sweepList.clear();
+	_phase = kPhaseIdle;
+	updateTracking();
+}
+
+void GarbageCollector::setMode(GCMode mode) {
+	if (mode != _mode)
+		reset();
+	_mode = mode;
+}
+
+void GarbageCollector::setNurseryEnabled(bool enable) {
+	_nurseryEnabled = enable;
+	if (_phase == kPhaseIdle)
+		updateTracking();
+}
+
+void GarbageCollector::resetStats() {
+	_fullStats.reset();
+	_nurseryStats.reset();
+	_stepStats.reset();
+	_cycles = 0;
+	_lastCycleFreed = 0;
+}
+
+void GarbageCollector::startCycle() {
+	uint32 startTime = g_system->getMillis();
+
+	debugC(kDebugLevelGC, "[GC] Starting incremental cycle");
+
+	_wm.clear();
+	_segMan->setGCTracking(true);
+	_phase = kPhaseMark;
+	_cycleFreed = 0;
+
+	pushVMRoots(_s, _wm);
+	pushLockedScripts(_segMan->getSegments(), _wm);
+
+	_stepStats.record(g_system->getMillis() - startTime, _wm._worklist.size(), 0);
+}
+
+uint GarbageCollector::markStep(uint budget) {
+	drainLogs();
+
+	uint work = processWorkListBounded(_segMan, _wm, budget);
+
+	if (_wm._worklist.empty())
+		finishMark();
+
+	return work;
+}
+
+void GarbageCollector::finishMark() {
+	// The VM registers and stack are not covered by the write barrier,
+	// so they need to be scanned again, and anything only reachable
+	// from them needs to be traced in one go.
+	pushVMRoots(_s, _wm);
+	pushLockedScripts(_segMan->getSegments(), _wm);
+	drainLogs();
+	processWorkListBounded(_segMan, _wm, (uint)-1);
+
+	if (g_sci->_gfxPorts)
+		g_sci->_gfxPorts->processEngineHunkList(_wm);
+
+	_live = normalizeAddresses(_segMan, _wm._map);
+	_wm.clear();
+
+	_phase = kPhaseSweep;
+	_sweepSegment = 1;
+	_sweepList.clear();
+	_sweepPos = 0;
+}
+
+uint GarbageCollector::sweepStep(uint budget, uint32 &freed) {
+	drainLogs();
+
+	const Common::Array<SegmentObj *> &heap = _segMan->getSegments();
+	uint work = 0;
+
+	while (work < budget) {
+		if (_sweepPos >= _sweepList.size()) {
+			if (_sweepSegment >= heap.size()) {
+				finishCycle();
+				break;
+			}
+
+			// Advance to the next segment
+			SegmentObj *mobj = heap[_sweepSegment];
+			if (mobj)
+				_sweepList = mobj->listAllDeallocatable(_sweepSegment);
+			else
+				_sweepList.clear();
+			_sweepPos = 0;
+			_sweepSegment++;
+			work++;
+			continue;
+		}
+
+		const reg_t addr = _sweepList[_sweepPos++];
+		work++;
+
+		// The scripts may have freed the entry since the list was built
+		SegmentObj *mobj = (addr.getSegment() < heap.size()) ? heap[addr.getSegment()] : NULL;
+		if (!mobj || (isEntryTableType(mobj->getType()) && !mobj->isValidOffset(addr.getOffset())))
+			continue;
+
+		if (!_live->contains(addr)) {
+			mobj->freeAtAddress(_segMan, addr);
+			debugC(kDebugLevelGC, "[GC] Deallocating %04x:%04x", PRINT_REG(addr));
+			// Counted right away, as finishCycle() may report the cycle
+			// within this step
+			freed++;
+			_cycleFreed++;
+		}
+	}
+
+	return work;
+}
+
+void GarbageCollector::finishCycle() {
+	debugC(kDebugLevelGC, "[GC] Finished incremental cycle, %d entries freed", _cycleFreed);
+
+	delete _live;
+	_live = 0;
+	_sweepList.clear();
+	_phase = kPhaseIdle;
+	_cycles++;
+	_lastCycleFreed = _cycleFreed;
+
+	// Everything which survived is old now
+	updateTracking();
+}
+
+void GarbageCollector::drainLogs() {
+	Common::Array<reg_t> &stored = _segMan->getGCStoredRefs();
+	Common::Array<reg_t> &allocated = _segMan->getGCAllocations();
+	const Common::Array<SegmentObj *> &heap = _segMan->getSegments();
+
+	if (_phase == kPhaseMark) {
+		// Stored references and new entries are shaded, and scripts
+		// loaded during the cycle are treated like roots
+		_wm.pushArray(stored);
+		for (Common::Array<reg_t>::const_iterator it = allocated.begin(); it != allocated.end(); ++it) {
+			_wm.push(*it);
+
+			SegmentObj *mobj = (it->getSegment() < heap.size()) ? heap[it->getSegment()] : NULL;
+			if (mobj && mobj->getType() == SEG_TYPE_SCRIPT)
+				_wm.pushArray(((Script *)mobj)->listObjectReferences());
+		}
+	} else if (_phase == kPhaseSweep) {
+		// Anything allocated after marking has finished is live
+		for (Common::Array<reg_t>::const_iterator it = allocated.begin(); it != allocated.end(); ++it)
+			_live->setVal(*it, true);
+	}
+
+	stored.clear();
+	allocated.clear();
+}
+
+void GarbageCollector::updateTracking() {
+	_segMan->setGCTracking(_nurseryEnabled || _phase != kPhaseIdle);
 }
 
 } // End of namespace Sci
@@ -61,6 +61,108 @@ struct WorklistManager {
 
 	void push(reg_t reg);
 	void pushArray(const Common::Array<reg_t> &tmp);
+	void clear();
+};
+
+enum GCMode {
+	kGCModeFull = 0,       ///< Stop-the-world mark and sweep every GC interval
+	kGCModeIncremental = 1 ///< Mark and sweep spread over kernel calls in bounded steps
+};
+
+/** Pause time statistics for one kind of collector work */
+struct GCPauseStats {
+	uint32 count;     ///< Number of pauses
+	uint32 totalTime; ///< Total time spent, in milliseconds
+	uint32 maxTime;   ///< Longest pause, in milliseconds
+	uint32 maxWork;   ///< Most references/entries processed in one pause
+	uint32 freed;     ///< Number of addresses deallocated
+
+	GCPauseStats() { reset(); }
+	void reset();
+	void record(uint32 time, uint32 work, uint32 freedCount);
+};
+
+/**
+ * Drives the garbage collector. Besides the classic full collection
+ * (run_gc), this supports an incremental mode, where the mark and sweep
+ * phases are performed in bounded steps on subsequent kernel calls, and
+ * a nursery, which allows cheap collections of the list, node, hunk,
+ * clone and array entries allocated since the last collection.
+ *
+ * Both rely on the write barrier of the SegManager, which logs all
+ * references stored into object variables, locals, lists and arrays, as
+ * well as all allocations.
+ */
+class GarbageCollector {
+public:
+	GarbageCollector(EngineState *s);
+	~GarbageCollector();
+
+	/**
+	 * Called when the GC interval has expired: runs a full collection or,
+	 * in incremental mode, starts a new collection cycle.
+	 */
+	void collect();
+
+	/**
+	 * Called on every kernel call in between: performs the next step of
+	 * an active incremental cycle, or collects the nursery when it is full.
+	 */
+	void step();
+
+	/** Runs a full collection, finishing or aborting any active cycle */
+	void collectFull();
+
+	/** Collects unreachable entries allocated since the last collection */
+	void collectNursery();
+
+	/** Drops all collector state, used when the heap is rebuilt */
+	void reset();
+
+	GCMode getMode() const { return _mode; }
+	void setMode(GCMode mode);
+	bool isNurseryEnabled() const { return _nurseryEnabled; }
+	void setNurseryEnabled(bool enable);
+	bool isCycleActive() const { return _phase != kPhaseIdle; }
+
+	uint _stepBudget;       ///< References/entries processed per incremental step
+	uint _nurseryThreshold; ///< Logged allocations/stores that trigger a nursery collection
+
+	GCPauseStats _fullStats;
+	GCPauseStats _nurseryStats;
+	GCPauseStats _stepStats;
+	uint32 _cycles;         ///< Completed incremental cycles
+	uint32 _lastCycleFreed; ///< Entries freed by the last completed incremental cycle
+
+	void resetStats();
+
+private:
+	enum Phase {
+		kPhaseIdle,
+		kPhaseMark,
+		kPhaseSweep
+	};
+
+	void startCycle();
+	uint markStep(uint budget);
+	void finishMark();
+	uint sweepStep(uint budget, uint32 &freed);
+	void finishCycle();
+	void drainLogs();
+	void updateTracking();
+
+	EngineState *_s;
+	SegManager *_segMan;
+	GCMode _mode;
+	bool _nurseryEnabled;
+
+	Phase _phase;
+	WorklistManager _wm;
+	AddrSet *_live;
+	uint _sweepSegment;
+	Common::Array<reg_t> _sweepList;
+	uint _sweepPos;
+	uint32 _cycleFreed;     ///< Entries freed so far by the active incremental cycle
 };
 
 
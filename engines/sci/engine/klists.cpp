@@ -219,6 +219,9 @@ static void addToFront(EngineState *s, reg_t listRef, reg_t nodeRef) {
 		oldNode->pred = nodeRef;
 	}
 	list->first = nodeRef;
+
+	s->_segMan->gcWriteBarrier(nodeRef);
+	s->_segMan->gcWriteBarrier(newNode->succ);
 }
 
 static void addToEnd(EngineState *s, reg_t listRef, reg_t nodeRef) {
@@ -245,6 +248,9 @@ static void addToEnd(EngineState *s, reg_t listRef, reg_t nodeRef) {
 		old_n->succ = nodeRef;
 	}
 	list->last = nodeRef;
+
+	s->_segMan->gcWriteBarrier(nodeRef);
+	s->_segMan->gcWriteBarrier(newNode->pred);
 }
 
 reg_t kNextNode(EngineState *s, int argc, reg_t *argv) {
@@ -285,8 +291,10 @@ reg_t kNodeValue(EngineState *s, int argc, reg_t *argv) {
 reg_t kAddToFront(EngineState *s, int argc, reg_t *argv) {
 	addToFront(s, argv[0], argv[1]);
 
-	if (argc == 3)
+	if (argc == 3) {
 		s->_segMan->lookupNode(argv[1])->key = argv[2];
+		s->_segMan->gcWriteBarrier(argv[2]);
+	}
 
 	return s->r_acc;
 }
@@ -294,8 +302,10 @@ reg_t kAddToFront(EngineState *s, int argc, reg_t *argv) {
 reg_t kAddToEnd(EngineState *s, int argc, reg_t *argv) {
 	addToEnd(s, argv[0], argv[1]);
 
-	if (argc == 3)
+	if (argc == 3) {
 		s->_segMan->lookupNode(argv[1])->key = argv[2];
+		s->_segMan->gcWriteBarrier(argv[2]);
+	}
 
 	return s->r_acc;
 }
@@ -319,8 +329,10 @@ reg_t kAddAfter(EngineState *s, int argc, reg_t *argv) {
 		return NULL_REG;
 	}
 
-	if (argc == 4)
+	if (argc == 4) {
 		newnode->key = argv[3];
+		s->_segMan->gcWriteBarrier(argv[3]);
+	}
 
 	if (firstnode) { // We're really appending after
 		reg_t oldnext = firstnode->succ;
@@ -335,6 +347,10 @@ reg_t kAddAfter(EngineState *s, int argc, reg_t *argv) {
 		else
 			s->_segMan->lookupNode(oldnext)->pred = argv[2];
 
+		s->_segMan->gcWriteBarrier(argv[1]);
+		s->_segMan->gcWriteBarrier(argv[2]);
+		s->_segMan->gcWriteBarrier(oldnext);
+
 	} else { // !firstnode
 		addToFront(s, argv[0], argv[2]); // Set as initial list node
 	}
@@ -391,6 +407,9 @@ reg_t kDeleteKey(EngineState *s, int argc, reg_t *argv) {
 	if (!n->succ.isNull())
 		s->_segMan->lookupNode(n->succ)->pred = n->pred;
 
+	s->_segMan->gcWriteBarrier(n->pred);
+	s->_segMan->gcWriteBarrier(n->succ);
+
 	// Erase references to the predecessor and successor nodes, as the game
 	// scripts could reference the node itself again.
 	// Happens in the intro of QFG1 and in Longbow, when exiting the cave.
@@ -727,8 +746,10 @@ reg_t kArray(EngineState *s, int argc, reg_t *argv) {
 		if (array->getSize() < index + count)
 			array->setSize(index + count);
 
-		for (uint16 i = 0; i < count; i++)
+		for (uint16 i = 0; i < count; i++) {
 			array->setValue(i + index, argv[i + 3]);
+			s->_segMan->gcWriteBarrier(argv[i + 3]);
+		}
 
 		return argv[1]; // We also have to return the handle
 	}
@@ -748,6 +769,7 @@ reg_t kArray(EngineState *s, int argc, reg_t *argv) {
 
 		for (uint16 i = 0; i < count; i++)
 			array->setValue(i + index, argv[4]);
+		s->_segMan->gcWriteBarrier(argv[4]);
 
 		return argv[1];
 	}
@@ -779,8 +801,10 @@ reg_t kArray(EngineState *s, int argc, reg_t *argv) {
 		if (array1->getSize() < index1 + count)
 			array1->setSize(index1 + count);
 
-		for (uint16 i = 0; i < count; i++)
+		for (uint16 i = 0; i < count; i++) {
 			array1->setValue(i + index1, array2->getValue(i + index2));
+			s->_segMan->gcWriteBarrier(array2->getValue(i + index2));
+		}
 
 		return arrayHandle;
 	}
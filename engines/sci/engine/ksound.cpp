@@ -304,6 +304,7 @@ reg_t kSetLanguage(EngineState *s, int argc, reg_t *argv) {
 	// subdirectory instead.
 	Common::String audioDirectory = s->_segMan->getString(argv[0]);
 	//warning("SetLanguage: set audio resource directory to '%s'", audioDirectory.c_str());
+	g_sci->_audio->purgeSyncCache();
 	g_sci->getResMan()->changeAudioDirectory(audioDirectory);
 
 	return s->r_acc;
@@ -41,6 +41,7 @@
 #include "sci/video/seq_decoder.h"
 #ifdef ENABLE_SCI32
 #include "video/coktel_decoder.h"
+#include "sci/graphics/frameout.h"
 #include "sci/video/robot_decoder.h"
 #endif
 
@@ -131,6 +132,13 @@ void playVideo(Video::VideoDecoder *videoDecoder, VideoState videoState) {
 
 	delete[] scaleBuffer;
 	delete videoDecoder;
+
+#ifdef ENABLE_SCI32
+	// The video got copied to the screen directly, so the next frame has to
+	// update the whole screen
+	if (g_sci->_gfxFrameout)
+		g_sci->_gfxFrameout->invalidate();
+#endif
 }
 
 reg_t kShowMovie(EngineState *s, int argc, reg_t *argv) {
@@ -31,6 +31,7 @@
 #include "sci/event.h"
 
 #include "sci/engine/features.h"
+#include "sci/engine/gc.h"
 #include "sci/engine/kernel.h"
 #include "sci/engine/state.h"
 #include "sci/engine/message.h"
@@ -940,6 +941,7 @@ void gamestate_restore(EngineState *s, Common::SeekableReadStream *fh) {
 	s->_segMan->reconstructClones();
 	s->initGlobals();
 	s->gcCountDown = GC_INTERVAL - 1;
+	s->_gc->reset();
 
 	// Time state:
 	s->lastWaitTime = g_system->getMillis();
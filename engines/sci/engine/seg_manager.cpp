@@ -29,7 +29,7 @@ namespace Sci {
 
 
 SegManager::SegManager(ResourceManager *resMan, ScriptPatcher *scriptPatcher)
-	: _resMan(resMan), _scriptPatcher(scriptPatcher) {
+	: _resMan(resMan), _scriptPatcher(scriptPatcher), _gcTracking(false) {
 	_heap.push_back(0);
 
 	_clonesSegId = 0;
@@ -60,6 +60,8 @@ void SegManager::resetSegMan() {
 	}
 
 	_heap.clear();
+	_gcStoredRefs.clear();
+	_gcAllocations.clear();
 
 	// And reinitialize
 	_heap.push_back(0);
@@ -141,6 +143,8 @@ Script *SegManager::allocateScript(int script_nr, SegmentId *segid) {
 	// Add the script to the "script id -> segment id" hashmap
 	_scriptSegMap[script_nr] = *segid;
 
+	gcNoteAllocation(make_reg(*segid, 0));
+
 	return (Script *)mem;
 }
 
@@ -389,6 +393,7 @@ reg_t SegManager::allocateHunkEntry(const char *hunk_type, int size) {
 	offset = table->allocEntry();
 
 	reg_t addr = make_reg(_hunksSegId, offset);
+	gcNoteAllocation(addr);
 	Hunk *h = &(table->_table[offset]);
 
 	if (!h)
@@ -424,6 +429,7 @@ Clone *SegManager::allocateClone(reg_t *addr) {
 	offset = table->allocEntry();
 
 	*addr = make_reg(_clonesSegId, offset);
+	gcNoteAllocation(*addr);
 	return &(table->_table[offset]);
 }
 
@@ -438,6 +444,7 @@ List *SegManager::allocateList(reg_t *addr) {
 	offset = table->allocEntry();
 
 	*addr = make_reg(_listsSegId, offset);
+	gcNoteAllocation(*addr);
 	return &(table->_table[offset]);
 }
 
@@ -452,6 +459,7 @@ Node *SegManager::allocateNode(reg_t *addr) {
 	offset = table->allocEntry();
 
 	*addr = make_reg(_nodesSegId, offset);
+	gcNoteAllocation(*addr);
 	return &(table->_table[offset]);
 }
 
@@ -817,6 +825,7 @@ byte *SegManager::allocDynmem(int size, const char *descr, reg_t *addr) {
 	SegmentId seg;
 	SegmentObj *mobj = allocSegment(new DynMem(), &seg);
 	*addr = make_reg(seg, 0);
+	gcNoteAllocation(*addr);
 
 	DynMem &d = *(DynMem *)mobj;
 
@@ -855,6 +864,7 @@ SciArray<reg_t> *SegManager::allocateArray(reg_t *addr) {
 	offset = table->allocEntry();
 
 	*addr = make_reg(_arraysSegId, offset);
+	gcNoteAllocation(*addr);
 	return &(table->_table[offset]);
 }
 
@@ -895,6 +905,7 @@ SciString *SegManager::allocateString(reg_t *addr) {
 	offset = table->allocEntry();
 
 	*addr = make_reg(_stringSegId, offset);
+	gcNoteAllocation(*addr);
 	return &(table->_table[offset]);
 }
 
@@ -1064,4 +1075,10 @@ void SegManager::uninstantiateScriptSci0(int script_nr) {
 	} while (objType != 0);
 }
 
+void SegManager::setGCTracking(bool enable) {
+	_gcTracking = enable;
+	_gcStoredRefs.clear();
+	_gcAllocations.clear();
+}
+
 } // End of namespace Sci
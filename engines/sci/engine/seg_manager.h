@@ -441,7 +441,40 @@ public:
 
 	const Common::Array<SegmentObj *> &getSegments() const { return _heap; }
 
+	// Garbage collector support
+
+	/**
+	 * Enables or disables logging of stored references and allocations,
+	 * which is needed by the incremental and nursery garbage collectors.
+	 * Changing the setting drops the current logs.
+	 */
+	void setGCTracking(bool enable);
+	bool isGCTracking() const { return _gcTracking; }
+
+	/**
+	 * Write barrier for the garbage collector. Must be called whenever a
+	 * reference is stored into an object variable, a local variable, a
+	 * list, a node or an array.
+	 * @param value		the value that has been stored
+	 */
+	void gcWriteBarrier(reg_t value) {
+		if (_gcTracking && value.getSegment())
+			_gcStoredRefs.push_back(value);
+	}
+
+	Common::Array<reg_t> &getGCStoredRefs() { return _gcStoredRefs; }
+	Common::Array<reg_t> &getGCAllocations() { return _gcAllocations; }
+
 private:
+	void gcNoteAllocation(reg_t addr) {
+		if (_gcTracking)
+			_gcAllocations.push_back(addr);
+	}
+
+	bool _gcTracking;
+	Common::Array<reg_t> _gcStoredRefs; ///< References stored into the heap since the logs were drained
+	Common::Array<reg_t> _gcAllocations; ///< Entries and scripts allocated since the logs were drained
+
 	Common::Array<SegmentObj *> _heap;
 	Common::Array<Class> _classTable; /**< Table of all classes */
 	/** Map script ids to segment ids. */
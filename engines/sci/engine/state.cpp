@@ -27,6 +27,7 @@
 #include "sci/event.h"
 
 #include "sci/engine/file.h"
+#include "sci/engine/gc.h"
 #include "sci/engine/kernel.h"
 #include "sci/engine/state.h"
 #include "sci/engine/selector.h"
@@ -75,10 +76,12 @@ EngineState::EngineState(SegManager *segMan)
 #endif
 	_dirseeker() {
 
+	_gc = new GarbageCollector(this);
 	reset(false);
 }
 
 EngineState::~EngineState() {
+	delete _gc;
 	delete _msgState;
 #ifdef ENABLE_SCI32
 	delete _virtualIndexFile;
@@ -108,6 +111,7 @@ void EngineState::reset(bool isRestoring) {
 	lastWaitTime = 0;
 
 	gcCountDown = 0;
+	_gc->reset();
 
 	_throttleCounter = 0;
 	_throttleLastTime = 0;
@@ -46,6 +46,7 @@ namespace Sci {
 class FileHandle;
 class DirSeeker;
 class EventManager;
+class GarbageCollector;
 class MessageState;
 class SoundCommandParser;
 class VirtualIndexFile;
@@ -188,6 +189,7 @@ public:
 	void shrinkStackToBase();
 
 	int gcCountDown; /**< Number of kernel calls until next gc */
+	GarbageCollector *_gc; /**< The garbage collector */
 
 	MessageState *_msgState;
 
@@ -187,6 +187,7 @@ static void write_var(EngineState *s, int type, int index, reg_t value) {
 				if (lookupSelector(s->_segMan, stopGroopPos, SELECTOR(client), &varp, NULL) == kSelectorVariable) {
 					reg_t *clientVar = varp.getPointer(s->_segMan);
 					*clientVar = value;
+					s->_segMan->gcWriteBarrier(value);
 				}
 			}
 		}
@@ -200,6 +201,10 @@ static void write_var(EngineState *s, int type, int index, reg_t value) {
 
 		s->variables[type][index] = value;
 
+		// Temporaries and parameters live on the stack, which is a GC root
+		if (type == VAR_GLOBAL || type == VAR_LOCAL)
+			s->_segMan->gcWriteBarrier(value);
+
 		if (type == VAR_GLOBAL && index == 90) {
 			// The game is trying to change its speech/subtitle settings
 			if (!g_sci->getEngineState()->_syncedAudioOptions || s->variables[VAR_GLOBAL][4] == TRUE_REG) {
@@ -257,6 +262,7 @@ static void _exec_varselectors(EngineState *s) {
 			// varselector access?
 			if (xs.argc) { // write?
 				*var = xs.variables_argp[1];
+				s->_segMan->gcWriteBarrier(*var);
 
 			} else // No, read
 				s->r_acc = *var;
@@ -854,7 +860,9 @@ void run_vm(EngineState *s) {
 			// Run the garbage collector, if needed
 			if (s->gcCountDown-- <= 0) {
 				s->gcCountDown = s->scriptGCInterval;
-				run_gc(s);
+				s->_gc->collect();
+			} else {
+				s->_gc->step();
 			}
 
 			// Call kernel function
@@ -934,9 +942,10 @@ void run_vm(EngineState *s) {
 				if (old_xs->type == EXEC_STACK_TYPE_VARSELECTOR) {
 					// varselector access?
 					reg_t *var = old_xs->getVarPointer(s->_segMan);
-					if (old_xs->argc) // write?
+					if (old_xs->argc) { // write?
 						*var = old_xs->variables_argp[1];
-					else // No, read
+						s->_segMan->gcWriteBarrier(*var);
+					} else // No, read
 						s->r_acc = *var;
 				}
 
@@ -1092,6 +1101,7 @@ void run_vm(EngineState *s) {
 		case op_aTop: // 0x32 (50)
 			// Accumulator To Property
 			validate_property(s, obj, opparams[0]) = s->r_acc;
+			s->_segMan->gcWriteBarrier(s->r_acc);
 			break;
 
 		case op_pTos: // 0x33 (51)
@@ -1099,10 +1109,13 @@ void run_vm(EngineState *s) {
 			PUSH32(validate_property(s, obj, opparams[0]));
 			break;
 
-		case op_sTop: // 0x34 (52)
+		case op_sTop: { // 0x34 (52)
 			// Stack To Property
-			validate_property(s, obj, opparams[0]) = POP32();
+			reg_t &opProperty = validate_property(s, obj, opparams[0]);
+			opProperty = POP32();
+			s->_segMan->gcWriteBarrier(opProperty);
 			break;
+		}
 
 		case op_ipToa: // 0x35 (53)
 		case op_dpToa: // 0x36 (54)
@@ -1116,6 +1129,7 @@ void run_vm(EngineState *s) {
 				opProperty += 1;
 			else
 				opProperty -= 1;
+			s->_segMan->gcWriteBarrier(opProperty);
 
 			if (opcode == op_ipToa || opcode == op_dpToa)
 				s->r_acc = opProperty;
@@ -30,17 +30,31 @@
 #include "sci/graphics/cache.h"
 #include "sci/graphics/font.h"
 #include "sci/graphics/fontsjis.h"
+#include "sci/graphics/screen.h"
 #include "sci/graphics/view.h"
 
 namespace Sci {
 
+struct CachedPicture {
+	GuiResourceId pictureId;
+	bool mirroredFlag;
+	int16 EGApaletteNo;
+	bool undithering;
+	Common::Rect rect;
+	byte *bits;
+	int16 ditheredPicColors[DITHERED_BG_COLORS_SIZE];
+	PictureStateLog stateLog;
+	uint32 lastUsed;
+};
+
 GfxCache::GfxCache(ResourceManager *resMan, GfxScreen *screen, GfxPalette *palette)
-	: _resMan(resMan), _screen(screen), _palette(palette) {
+	: _resMan(resMan), _screen(screen), _palette(palette), _pictureUseCounter(0) {
 }
 
 GfxCache::~GfxCache() {
 	purgeFontCache();
 	purgeViewCache();
+	purgePictureCache();
 }
 
 void GfxCache::purgeFontCache() {
@@ -61,6 +75,15 @@ void GfxCache::purgeViewCache() {
 	_cachedViews.clear();
 }
 
+void GfxCache::purgePictureCache() {
+	for (PictureCache::iterator iter = _cachedPictures.begin(); iter != _cachedPictures.end(); ++iter) {
+		delete[] (*iter)->bits;
+		delete *iter;
+	}
+
+	_cachedPictures.clear();
+}
+
 GfxFont *GfxCache::getFont(GuiResourceId fontId) {
 	if (_cachedFonts.size() >= MAX_CACHED_FONTS)
 		purgeFontCache();
@@ -86,6 +109,51 @@ GfxView *GfxCache::getView(GuiResourceId viewId) {
 	return _cachedViews[viewId];
 }
 
+const PictureStateLog *GfxCache::restorePicture(GuiResourceId pictureId, bool mirroredFlag, int16 EGApaletteNo, const Common::Rect &rect) {
+	bool undithering = _screen->isUnditheringEnabled();
+
+	for (PictureCache::iterator iter = _cachedPictures.begin(); iter != _cachedPictures.end(); ++iter) {
+		CachedPicture *cached = *iter;
+		if (cached->pictureId == pictureId && cached->mirroredFlag == mirroredFlag &&
+			cached->EGApaletteNo == EGApaletteNo && cached->undithering == undithering &&
+			cached->rect == rect) {
+			_screen->bitsRestore(cached->bits);
+			memcpy(_screen->unditherGetDitheredBgColors(), cached->ditheredPicColors, sizeof(cached->ditheredPicColors));
+			cached->lastUsed = ++_pictureUseCounter;
+			return &cached->stateLog;
+		}
+	}
+
+	return NULL;
+}
+
+void GfxCache::addPicture(GuiResourceId pictureId, bool mirroredFlag, int16 EGApaletteNo, const Common::Rect &rect, const PictureStateLog &stateLog) {
+	if (_cachedPictures.size() >= MAX_CACHED_PICTURES) {
+		// Throw out the least recently used picture
+		uint oldest = 0;
+		for (uint i = 1; i < _cachedPictures.size(); i++) {
+			if (_cachedPictures[i]->lastUsed < _cachedPictures[oldest]->lastUsed)
+				oldest = i;
+		}
+		delete[] _cachedPictures[oldest]->bits;
+		delete _cachedPictures[oldest];
+		_cachedPictures.remove_at(oldest);
+	}
+
+	CachedPicture *cached = new CachedPicture();
+	cached->pictureId = pictureId;
+	cached->mirroredFlag = mirroredFlag;
+	cached->EGApaletteNo = EGApaletteNo;
+	cached->undithering = _screen->isUnditheringEnabled();
+	cached->rect = rect;
+	cached->bits = new byte[_screen->bitsGetDataSize(rect, GFX_SCREEN_MASK_ALL)];
+	_screen->bitsSave(rect, GFX_SCREEN_MASK_ALL, cached->bits);
+	memcpy(cached->ditheredPicColors, _screen->unditherGetDitheredBgColors(), sizeof(cached->ditheredPicColors));
+	cached->stateLog = stateLog;
+	cached->lastUsed = ++_pictureUseCounter;
+	_cachedPictures.push_back(cached);
+}
+
 int16 GfxCache::kernelViewGetCelWidth(GuiResourceId viewId, int16 loopNo, int16 celNo) {
 	return getView(viewId)->getCelInfo(loopNo, celNo)->scriptWidth;
 }
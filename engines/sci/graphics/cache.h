@@ -29,12 +29,14 @@ namespace Sci {
 
 class GfxFont;
 class GfxView;
+struct CachedPicture;
 
 typedef Common::HashMap<int, GfxFont *> FontCache;
 typedef Common::HashMap<int, GfxView *> ViewCache;
+typedef Common::Array<CachedPicture *> PictureCache;
 
 /**
- * Cache class, handles caching of views/fonts
+ * Cache class, handles caching of views/fonts and of rendered pictures
  */
 class GfxCache {
 public:
@@ -51,9 +53,23 @@ public:
 
 	byte kernelViewGetColorAtCoordinate(GuiResourceId viewId, int16 loopNo, int16 celNo, int16 x, int16 y);
 
+	/**
+	 * Copies a cached rendering of a picture into the given screen rect and
+	 * returns the state changes, which the picture did while drawing. Returns
+	 * NULL, if the picture isn't cached.
+	 */
+	const PictureStateLog *restorePicture(GuiResourceId pictureId, bool mirroredFlag, int16 EGApaletteNo, const Common::Rect &rect);
+
+	/**
+	 * Caches the rendering of a picture, which has just been drawn into the
+	 * given screen rect.
+	 */
+	void addPicture(GuiResourceId pictureId, bool mirroredFlag, int16 EGApaletteNo, const Common::Rect &rect, const PictureStateLog &stateLog);
+
 private:
 	void purgeFontCache();
 	void purgeViewCache();
+	void purgePictureCache();
 
 	ResourceManager *_resMan;
 	GfxScreen *_screen;
@@ -61,6 +77,8 @@ private:
 
 	FontCache _cachedFonts;
 	ViewCache _cachedViews;
+	PictureCache _cachedPictures;
+	uint32 _pictureUseCounter;
 };
 
 } // End of namespace Sci
@@ -66,6 +66,10 @@ GfxFrameout::GfxFrameout(SegManager *segMan, ResourceManager *resMan, GfxCoordAd
 	_curScrollText = -1;
 	_showScrollText = false;
 	_maxScrollTexts = 0;
+	_fullRedraw = true;
+	_dirtyRectsEnabled = true;
+	_lastShowScrollText = false;
+	resetFrameStats();
 }
 
 GfxFrameout::~GfxFrameout() {
@@ -77,6 +81,8 @@ void GfxFrameout::clear() {
 	_planes.clear();
 	deletePlanePictures(NULL_REG);
 	clearScrollTexts();
+	_damageRects.clear();
+	_fullRedraw = true;
 }
 
 void GfxFrameout::clearScrollTexts() {
@@ -160,6 +166,9 @@ void GfxFrameout::kernelAddPlane(reg_t object) {
 	newPlane.pictureId = kPlanePlainColored;
 	newPlane.planePictureMirrored = false;
 	newPlane.planeBack = 0;
+	newPlane.drawn = false;
+	newPlane.updated = false;
+	newPlane.drawnHash = 0;
 	_planes.push_back(newPlane);
 
 	kernelUpdatePlane(object);
@@ -246,6 +255,8 @@ void GfxFrameout::kernelDeletePlane(reg_t object) {
 
 	for (PlaneList::iterator it = _planes.begin(); it != _planes.end(); ++it) {
 		if (it->object == object) {
+			if (it->drawn)
+				addDamage(it->drawnRect);
 			_planes.erase(it);
 			Common::Rect planeRect;
 			planeRect.top = readSelectorValue(_segMan, object, SELECTOR(top));
@@ -258,6 +269,7 @@ void GfxFrameout::kernelDeletePlane(reg_t object) {
 
 			// Blackout removed plane rect
 			_paint32->fillRect(planeRect, 0);
+			addDamage(planeRect);
 			return;
 		}
 	}
@@ -274,6 +286,9 @@ void GfxFrameout::addPlanePicture(reg_t object, GuiResourceId pictureId, uint16
 	newPicture.startX = startX;
 	newPicture.startY = startY;
 	newPicture.pictureCels = 0;
+	newPicture.drawn = false;
+	newPicture.updated = false;
+	newPicture.drawnHash = 0;
 	_planePictures.push_back(newPicture);
 }
 
@@ -282,6 +297,8 @@ void GfxFrameout::deletePlanePictures(reg_t object) {
 
 	while (it != _planePictures.end()) {
 		if (it->object == object || object.isNull()) {
+			if (it->drawn)
+				addDamage(it->drawnRect);
 			delete it->pictureCels;
 			delete it->picture;
 			it = _planePictures.erase(it);
@@ -442,6 +459,8 @@ void GfxFrameout::kernelDeleteScreenItem(reg_t object) {
 	if (!itemEntry)
 		return;
 
+	if (itemEntry->drawn)
+		addDamage(itemEntry->drawnRect);
 	_screenItems.remove(itemEntry);
 	delete itemEntry;
 }
@@ -460,6 +479,8 @@ void GfxFrameout::deletePlaneItems(reg_t planeObject) {
 
 		if (objectMatches) {
 			FrameoutEntry *itemEntry = *listIterator;
+			if (itemEntry->drawn)
+				addDamage(itemEntry->drawnRect);
 			listIterator = _screenItems.erase(listIterator);
 			delete itemEntry;
 		} else {
@@ -509,10 +530,13 @@ bool planeSortHelper(const PlaneEntry &entry1, const PlaneEntry &entry2) {
 void GfxFrameout::sortPlanes() {
 	// First, remove any invalid planes
 	for (PlaneList::iterator it = _planes.begin(); it != _planes.end();) {
-		if (!_segMan->isObject(it->object))
+		if (!_segMan->isObject(it->object)) {
+			if (it->drawn)
+				addDamage(it->drawnRect);
 			it = _planes.erase(it);
-		else
+		} else {
 			it++;
+		}
 	}
 
 	// Sort the rest of them
@@ -651,205 +675,466 @@ void GfxFrameout::drawPicture(FrameoutEntry *itemEntry, int16 planeOffsetX, int1
 	//	warning("picture cel %d %d", itemEntry->celNo, itemEntry->priority);
 }
 
-void GfxFrameout::kernelFrameout() {
-	if (g_sci->_robotDecoder->isVideoLoaded()) {
-		showVideo();
+// FNV-1a style hashing of the state that defines what a plane or screen item
+// looks like on screen
+static inline void hashValue(uint32 &hash, uint32 value) {
+	hash = (hash ^ value) * 16777619;
+}
+
+static void hashRect(uint32 &hash, const Common::Rect &rect) {
+	hashValue(hash, (uint16)rect.left | ((uint32)(uint16)rect.top << 16));
+	hashValue(hash, (uint16)rect.right | ((uint32)(uint16)rect.bottom << 16));
+}
+
+void GfxFrameout::addDamage(const Common::Rect &rect) {
+	if (!rect.isValidRect() || rect.isEmpty())
+		return;
+
+	Common::Rect damageRect = rect;
+	damageRect.clip(_screen->getWidth(), _screen->getHeight());
+	if (damageRect.isEmpty())
 		return;
+
+	// Merge with overlapping regions, so that no pixel gets recomposited twice
+	uint i = 0;
+	while (i < _damageRects.size()) {
+		if (_damageRects[i].contains(damageRect))
+			return;
+
+		if (_damageRects[i].intersects(damageRect)) {
+			damageRect.extend(_damageRects[i]);
+			_damageRects.remove_at(i);
+			i = 0;
+		} else {
+			i++;
+		}
 	}
 
-	_palette->palVaryUpdate();
+	_damageRects.push_back(damageRect);
+
+	// Too many regions, recomposite their bounding box instead
+	if (_damageRects.size() > 16) {
+		for (i = 1; i < _damageRects.size(); i++)
+			_damageRects[0].extend(_damageRects[i]);
+		_damageRects.resize(1);
+	}
+}
+
+void GfxFrameout::updateDrawnState(bool &drawn, bool &updated, uint32 &drawnHash, Common::Rect &drawnRect, uint32 hash, const Common::Rect &rect) {
+	hashRect(hash, rect);
+
+	if (!drawn || drawnHash != hash) {
+		if (drawn)
+			addDamage(drawnRect);
+		addDamage(rect);
+	}
+
+	drawn = true;
+	updated = true;
+	drawnHash = hash;
+	drawnRect = rect;
+}
 
-	for (PlaneList::iterator it = _planes.begin(); it != _planes.end(); it++) {
-		reg_t planeObject = it->object;
+void GfxFrameout::damageUndrawn(bool &drawn, bool &updated, const Common::Rect &drawnRect) {
+	if (drawn && !updated) {
+		addDamage(drawnRect);
+		drawn = false;
+	}
+	updated = false;
+}
+
+void GfxFrameout::preparePlane(PlaneEntry &plane, FrameoutDrawPlane &drawPlane) {
+	reg_t planeObject = plane.object;
+
+	drawPlane.plane = &plane;
+	drawPlane.visible = false;
+	drawPlane.clearRect = false;
+	drawPlane.fillRect = false;
+
+	uint32 planeHash = 2166136261u;
+	Common::Rect planeDrawnRect;
+
+	// Plane lines are drawn on invisible planes as well
+	for (PlaneLineList::iterator it = plane.lines.begin(); it != plane.lines.end(); ++it) {
+		Common::Point startPoint = it->startPoint;
+		Common::Point endPoint = it->endPoint;
+		_coordAdjuster->kernelLocalToGlobal(startPoint.x, startPoint.y, planeObject);
+		_coordAdjuster->kernelLocalToGlobal(endPoint.x, endPoint.y, planeObject);
+
+		Common::Rect lineRect(MIN(startPoint.x, endPoint.x), MIN(startPoint.y, endPoint.y),
+							  MAX(startPoint.x, endPoint.x) + 1, MAX(startPoint.y, endPoint.y) + 1);
+		if (planeDrawnRect.isEmpty())
+			planeDrawnRect = lineRect;
+		else
+			planeDrawnRect.extend(lineRect);
+
+		hashRect(planeHash, lineRect);
+		hashValue(planeHash, it->color | (it->priority << 8) | (it->control << 16));
+	}
+
+	int16 planeLastPriority = plane.lastPriority;
+
+	// Update priority here, sq6 sets it w/o UpdatePlane
+	int16 planePriority = plane.priority = readSelectorValue(_segMan, planeObject, SELECTOR(priority));
+
+	plane.lastPriority = planePriority;
+	if (planePriority < 0) { // Plane currently not meant to be shown
+		// If plane was shown before, delete plane rect
+		if (planePriority != planeLastPriority) {
+			drawPlane.clearRect = true;
+			planeDrawnRect = plane.planeRect;
+		}
+		updateDrawnState(plane.drawn, plane.updated, plane.drawnHash, plane.drawnRect, planeHash, planeDrawnRect);
+		return;
+	}
+
+	drawPlane.visible = true;
+
+	// There is a race condition lurking in SQ6, which causes the game to hang in the intro, when teleporting to Polysorbate LX.
+	// Since I first wrote the patch, the race has stopped occurring for me though.
+	// I'll leave this for investigation later, when someone can reproduce.
+	//if (plane.pictureId == kPlanePlainColored)	// FIXME: This is what SSCI does, and fixes the intro of LSL7, but breaks the dialogs in GK1 (adds black boxes)
+	if (plane.pictureId == kPlanePlainColored && (plane.planeBack || g_sci->getGameId() != GID_GK1))
+		drawPlane.fillRect = true;
+
+	// Invoking drewPicture() with an invalid picture ID in SCI32 results in
+	// invalidating the palVary palette when a palVary effect is active. This
+	// is quite obvious in QFG4, where the day time palette is incorrectly
+	// shown when exiting the caves, and the correct night time palette
+	// flashes briefly each time that kPalVaryInit is called.
+	if (plane.pictureId != 0xFFFF)
+		_palette->drewPicture(plane.pictureId);
+
+	if (planeDrawnRect.isEmpty())
+		planeDrawnRect = plane.planeRect;
+	else
+		planeDrawnRect.extend(plane.planeRect);
+
+	hashValue(planeHash, planePriority);
+	hashValue(planeHash, plane.pictureId | (plane.planeBack << 16) | (drawPlane.fillRect << 24) | (plane.planePictureMirrored << 25));
+	hashValue(planeHash, (uint16)plane.planeOffsetX | ((uint32)(uint16)plane.planeOffsetY << 16));
+	updateDrawnState(plane.drawn, plane.updated, plane.drawnHash, plane.drawnRect, planeHash, planeDrawnRect);
+
+	FrameoutList itemList;
+
+	createPlaneItemList(planeObject, itemList);
+
+	// Picture cels get drawn inside the plane rect. They are tracked per
+	// picture, as their cel entries are recreated on every frame.
+	for (PlanePictureList::iterator pictureIt = _planePictures.begin(); pictureIt != _planePictures.end(); pictureIt++) {
+		if (pictureIt->object == planeObject) {
+			uint32 pictureHash = 2166136261u;
+			hashValue(pictureHash, pictureIt->pictureId);
+			hashValue(pictureHash, pictureIt->startX | (pictureIt->startY << 16));
+			updateDrawnState(pictureIt->drawn, pictureIt->updated, pictureIt->drawnHash, pictureIt->drawnRect, pictureHash, plane.planeRect);
+		}
+	}
+
+	for (FrameoutList::iterator listIterator = itemList.begin(); listIterator != itemList.end(); listIterator++) {
+		FrameoutEntry *itemEntry = *listIterator;
+
+		if (!itemEntry->visible)
+			continue;
+
+		FrameoutDrawItem drawItem;
+		drawItem.entry = itemEntry;
+		drawItem.view = NULL;
+		drawItem.drawView = false;
+		drawItem.drawText = false;
+
+		if (itemEntry->object.isNull()) {
+			// Picture cel data
+			_coordAdjuster->fromScriptToDisplay(itemEntry->y, itemEntry->x);
+			_coordAdjuster->fromScriptToDisplay(itemEntry->picStartY, itemEntry->picStartX);
+
+			if (!isPictureOutOfView(itemEntry, plane.planeRect, plane.planeOffsetX, plane.planeOffsetY)) {
+				drawItem.rect = plane.planeRect;
+				drawPlane.items.push_back(drawItem);
+			}
+			continue;
+		}
+
+		GfxView *view = (itemEntry->viewId != 0xFFFF) ? _cache->getView(itemEntry->viewId) : NULL;
+		int16 dummyX = 0;
+
+		if (view && view->isSci2Hires()) {
+			view->adjustToUpscaledCoordinates(itemEntry->y, itemEntry->x);
+			view->adjustToUpscaledCoordinates(itemEntry->z, dummyX);
+		} else if (getSciVersion() >= SCI_VERSION_2_1) {
+			_coordAdjuster->fromScriptToDisplay(itemEntry->y, itemEntry->x);
+			_coordAdjuster->fromScriptToDisplay(itemEntry->z, dummyX);
+		}
+
+		// Adjust according to current scroll position
+		itemEntry->x -= plane.planeOffsetX;
+		itemEntry->y -= plane.planeOffsetY;
+
+		uint16 useInsetRect = readSelectorValue(_segMan, itemEntry->object, SELECTOR(useInsetRect));
+		if (useInsetRect) {
+			itemEntry->celRect.top = readSelectorValue(_segMan, itemEntry->object, SELECTOR(inTop));
+			itemEntry->celRect.left = readSelectorValue(_segMan, itemEntry->object, SELECTOR(inLeft));
+			itemEntry->celRect.bottom = readSelectorValue(_segMan, itemEntry->object, SELECTOR(inBottom));
+			itemEntry->celRect.right = readSelectorValue(_segMan, itemEntry->object, SELECTOR(inRight));
+			if (view && view->isSci2Hires()) {
+				view->adjustToUpscaledCoordinates(itemEntry->celRect.top, itemEntry->celRect.left);
+				view->adjustToUpscaledCoordinates(itemEntry->celRect.bottom, itemEntry->celRect.right);
+			}
+			itemEntry->celRect.translate(itemEntry->x, itemEntry->y);
+			// TODO: maybe we should clip the cels rect with this, i'm not sure
+			//  the only currently known usage is game menu of gk1
+		} else if (view) {
+			// Process global scaling, if needed.
+			// TODO: Seems like SCI32 always processes global scaling for scaled objects
+			// TODO: We can only process symmetrical scaling for now (i.e. same value for scaleX/scaleY)
+			if ((itemEntry->scaleSignal & kScaleSignalDoScaling32) &&
+			   !(itemEntry->scaleSignal & kScaleSignalDisableGlobalScaling32) &&
+			    (itemEntry->scaleX == itemEntry->scaleY) &&
+				itemEntry->scaleX != 128)
+				applyGlobalScaling(itemEntry, plane.planeRect, view->getHeight(itemEntry->loopNo, itemEntry->celNo));
+
+			if ((itemEntry->scaleX == 128) && (itemEntry->scaleY == 128))
+				view->getCelRect(itemEntry->loopNo, itemEntry->celNo,
+					itemEntry->x, itemEntry->y, itemEntry->z, itemEntry->celRect);
+			else
+				view->getCelScaledRect(itemEntry->loopNo, itemEntry->celNo,
+					itemEntry->x, itemEntry->y, itemEntry->z, itemEntry->scaleX,
+					itemEntry->scaleY, itemEntry->celRect);
+
+			Common::Rect nsRect = itemEntry->celRect;
+			// Translate back to actual coordinate within scrollable plane
+			nsRect.translate(plane.planeOffsetX, plane.planeOffsetY);
+
+			if (g_sci->getGameId() == GID_PHANTASMAGORIA2) {
+				// HACK: Some (?) objects in Phantasmagoria 2 have no NS rect. Skip them for now.
+				// TODO: Remove once we figure out how Phantasmagoria 2 draws objects on screen.
+				if (lookupSelector(_segMan, itemEntry->object, SELECTOR(nsLeft), NULL, NULL) != kSelectorVariable)
+					continue;
+			}
+
+			if (view && view->isSci2Hires()) {
+				view->adjustBackUpscaledCoordinates(nsRect.top, nsRect.left);
+				view->adjustBackUpscaledCoordinates(nsRect.bottom, nsRect.right);
+				g_sci->_gfxCompare->setNSRect(itemEntry->object, nsRect);
+			} else if (getSciVersion() >= SCI_VERSION_2_1 && _resMan->detectHires()) {
+				_coordAdjuster->fromDisplayToScript(nsRect.top, nsRect.left);
+				_coordAdjuster->fromDisplayToScript(nsRect.bottom, nsRect.right);
+				g_sci->_gfxCompare->setNSRect(itemEntry->object, nsRect);
+			}
+
+			// TODO: For some reason, the top left nsRect coordinates get
+			// swapped in the GK1 inventory screen, investigate why.
+			// This is also needed for GK1 rooms 710 and 720 (catacombs, inner and
+			// outer circle), for handling the tiles and talking to Wolfgang.
+			// HACK: Fix the coordinates by explicitly setting them here for GK1.
+			// Also check bug #6729, for another case where this is needed.
+			if (g_sci->getGameId() == GID_GK1)
+				g_sci->_gfxCompare->setNSRect(itemEntry->object, nsRect);
+		}
+
+		// Don't attempt to draw sprites that are outside the visible
+		// screen area. An example is the random people walking in
+		// Jackson Square in GK1.
+		if (itemEntry->celRect.bottom < 0 || itemEntry->celRect.top  >= _screen->getDisplayHeight() ||
+		    itemEntry->celRect.right  < 0 || itemEntry->celRect.left >= _screen->getDisplayWidth())
+			continue;
+
+		Common::Rect clipRect, translatedClipRect;
+		clipRect = itemEntry->celRect;
+
+		if (view && view->isSci2Hires()) {
+			clipRect.clip(plane.upscaledPlaneClipRect);
+			translatedClipRect = clipRect;
+			translatedClipRect.translate(plane.upscaledPlaneRect.left, plane.upscaledPlaneRect.top);
+		} else {
+			// QFG4 passes invalid rectangles when a battle is starting
+			if (!clipRect.isValidRect())
+				continue;
+			clipRect.clip(plane.planeClipRect);
+			translatedClipRect = clipRect;
+			translatedClipRect.translate(plane.planeRect.left, plane.planeRect.top);
+		}
+
+		uint32 itemHash = 2166136261u;
+
+		if (view && !clipRect.isEmpty()) {
+			drawItem.view = view;
+			drawItem.drawView = true;
+			drawItem.clipRect = clipRect;
+			drawItem.translatedClipRect = translatedClipRect;
+			drawItem.rect = translatedClipRect;
+
+			hashValue(itemHash, itemEntry->viewId);
+			hashValue(itemHash, (uint16)itemEntry->loopNo | ((uint32)(uint16)itemEntry->celNo << 16));
+			hashValue(itemHash, (uint16)itemEntry->scaleX | ((uint32)(uint16)itemEntry->scaleY << 16));
+			hashRect(itemHash, itemEntry->celRect);
+		}
+
+		// Draw text, if it exists
+		if (lookupSelector(_segMan, itemEntry->object, SELECTOR(text), NULL, NULL) == kSelectorVariable) {
+			Common::Rect textRect;
+			uint32 textChecksum;
+
+			drawItem.drawText = true;
+			if (g_sci->_gfxText32->getTextBitmapInfo(itemEntry->x, itemEntry->y, plane.planeRect, itemEntry->object, textRect, textChecksum)) {
+				if (drawItem.rect.isEmpty())
+					drawItem.rect = textRect;
+				else
+					drawItem.rect.extend(textRect);
+				hashValue(itemHash, textChecksum);
+			}
+		}
+
+		if (!drawItem.drawView && !drawItem.drawText)
+			continue;
+
+		// The drawing order and the priority screen depend on these as well
+		hashValue(itemHash, (uint16)itemEntry->priority | ((uint32)(uint16)itemEntry->y << 16));
+		hashValue(itemHash, itemEntry->givenOrderNr);
+		updateDrawnState(itemEntry->drawn, itemEntry->updated, itemEntry->drawnHash, itemEntry->drawnRect, itemHash, drawItem.rect);
+
+		drawPlane.items.push_back(drawItem);
+	}
+}
+
+void GfxFrameout::drawPlanes(FrameoutDrawPlaneList &drawPlanes, const Common::Rect *damageRect) {
+	for (FrameoutDrawPlaneList::iterator it = drawPlanes.begin(); it != drawPlanes.end(); ++it) {
+		PlaneEntry *plane = it->plane;
+		Common::Rect planeRect = damageRect ? plane->planeRect.findIntersectingRect(*damageRect) : plane->planeRect;
 
 		// Draw any plane lines, if they exist
 		// These are drawn on invisible planes as well. (e.g. "invisiblePlane" in LSL6 hires)
 		// FIXME: Lines aren't always drawn (e.g. when the narrator speaks in LSL6 hires).
 		// Perhaps something is painted over them?
-		for (PlaneLineList::iterator it2 = it->lines.begin(); it2 != it->lines.end(); ++it2) {
+		for (PlaneLineList::iterator it2 = plane->lines.begin(); it2 != plane->lines.end(); ++it2) {
 			Common::Point startPoint = it2->startPoint;
 			Common::Point endPoint = it2->endPoint;
-			_coordAdjuster->kernelLocalToGlobal(startPoint.x, startPoint.y, it->object);
-			_coordAdjuster->kernelLocalToGlobal(endPoint.x, endPoint.y, it->object);
+			_coordAdjuster->kernelLocalToGlobal(startPoint.x, startPoint.y, plane->object);
+			_coordAdjuster->kernelLocalToGlobal(endPoint.x, endPoint.y, plane->object);
 			_screen->drawLine(startPoint, endPoint, it2->color, it2->priority, it2->control);
 		}
 
-		int16 planeLastPriority = it->lastPriority;
-
-		// Update priority here, sq6 sets it w/o UpdatePlane
-		int16 planePriority = it->priority = readSelectorValue(_segMan, planeObject, SELECTOR(priority));
-
-		it->lastPriority = planePriority;
-		if (planePriority < 0) { // Plane currently not meant to be shown
-			// If plane was shown before, delete plane rect
-			if (planePriority != planeLastPriority)
-				_paint32->fillRect(it->planeRect, 0);
+		if (!it->visible) {
+			if (it->clearRect)
+				_paint32->fillRect(planeRect, 0);
 			continue;
 		}
 
-		// There is a race condition lurking in SQ6, which causes the game to hang in the intro, when teleporting to Polysorbate LX.
-		// Since I first wrote the patch, the race has stopped occurring for me though.
-		// I'll leave this for investigation later, when someone can reproduce.
-		//if (it->pictureId == kPlanePlainColored)	// FIXME: This is what SSCI does, and fixes the intro of LSL7, but breaks the dialogs in GK1 (adds black boxes)
-		if (it->pictureId == kPlanePlainColored && (it->planeBack || g_sci->getGameId() != GID_GK1))
-			_paint32->fillRect(it->planeRect, it->planeBack);
-
-		_coordAdjuster->pictureSetDisplayArea(it->planeRect);
-		// Invoking drewPicture() with an invalid picture ID in SCI32 results in
-		// invalidating the palVary palette when a palVary effect is active. This
-		// is quite obvious in QFG4, where the day time palette is incorrectly
-		// shown when exiting the caves, and the correct night time palette
-		// flashes briefly each time that kPalVaryInit is called.
-		if (it->pictureId != 0xFFFF)
-			_palette->drewPicture(it->pictureId);
-
-		FrameoutList itemList;
+		if (it->fillRect)
+			_paint32->fillRect(planeRect, plane->planeBack);
 
-		createPlaneItemList(planeObject, itemList);
+		_coordAdjuster->pictureSetDisplayArea(plane->planeRect);
 
-		for (FrameoutList::iterator listIterator = itemList.begin(); listIterator != itemList.end(); listIterator++) {
-			FrameoutEntry *itemEntry = *listIterator;
+		for (FrameoutDrawItemList::iterator itemIt = it->items.begin(); itemIt != it->items.end(); ++itemIt) {
+			FrameoutEntry *itemEntry = itemIt->entry;
 
-			if (!itemEntry->visible)
+			if (damageRect && !itemIt->rect.intersects(*damageRect))
 				continue;
 
 			if (itemEntry->object.isNull()) {
-				// Picture cel data
-				_coordAdjuster->fromScriptToDisplay(itemEntry->y, itemEntry->x);
-				_coordAdjuster->fromScriptToDisplay(itemEntry->picStartY, itemEntry->picStartX);
-
-				if (!isPictureOutOfView(itemEntry, it->planeRect, it->planeOffsetX, it->planeOffsetY))
-					drawPicture(itemEntry, it->planeOffsetX, it->planeOffsetY, it->planePictureMirrored);
-			} else {
-				GfxView *view = (itemEntry->viewId != 0xFFFF) ? _cache->getView(itemEntry->viewId) : NULL;
-				int16 dummyX = 0;
-
-				if (view && view->isSci2Hires()) {
-					view->adjustToUpscaledCoordinates(itemEntry->y, itemEntry->x);
-					view->adjustToUpscaledCoordinates(itemEntry->z, dummyX);
-				} else if (getSciVersion() >= SCI_VERSION_2_1) {
-					_coordAdjuster->fromScriptToDisplay(itemEntry->y, itemEntry->x);
-					_coordAdjuster->fromScriptToDisplay(itemEntry->z, dummyX);
-				}
+				drawPicture(itemEntry, plane->planeOffsetX, plane->planeOffsetY, plane->planePictureMirrored);
+				continue;
+			}
 
-				// Adjust according to current scroll position
-				itemEntry->x -= it->planeOffsetX;
-				itemEntry->y -= it->planeOffsetY;
-
-				uint16 useInsetRect = readSelectorValue(_segMan, itemEntry->object, SELECTOR(useInsetRect));
-				if (useInsetRect) {
-					itemEntry->celRect.top = readSelectorValue(_segMan, itemEntry->object, SELECTOR(inTop));
-					itemEntry->celRect.left = readSelectorValue(_segMan, itemEntry->object, SELECTOR(inLeft));
-					itemEntry->celRect.bottom = readSelectorValue(_segMan, itemEntry->object, SELECTOR(inBottom));
-					itemEntry->celRect.right = readSelectorValue(_segMan, itemEntry->object, SELECTOR(inRight));
-					if (view && view->isSci2Hires()) {
-						view->adjustToUpscaledCoordinates(itemEntry->celRect.top, itemEntry->celRect.left);
-						view->adjustToUpscaledCoordinates(itemEntry->celRect.bottom, itemEntry->celRect.right);
-					}
-					itemEntry->celRect.translate(itemEntry->x, itemEntry->y);
-					// TODO: maybe we should clip the cels rect with this, i'm not sure
-					//  the only currently known usage is game menu of gk1
-				} else if (view) {
-					// Process global scaling, if needed.
-					// TODO: Seems like SCI32 always processes global scaling for scaled objects
-					// TODO: We can only process symmetrical scaling for now (i.e. same value for scaleX/scaleY)
-					if ((itemEntry->scaleSignal & kScaleSignalDoScaling32) &&
-					   !(itemEntry->scaleSignal & kScaleSignalDisableGlobalScaling32) &&
-					    (itemEntry->scaleX == itemEntry->scaleY) &&
-						itemEntry->scaleX != 128)
-						applyGlobalScaling(itemEntry, it->planeRect, view->getHeight(itemEntry->loopNo, itemEntry->celNo));
-
-					if ((itemEntry->scaleX == 128) && (itemEntry->scaleY == 128))
-						view->getCelRect(itemEntry->loopNo, itemEntry->celNo,
-							itemEntry->x, itemEntry->y, itemEntry->z, itemEntry->celRect);
-					else
-						view->getCelScaledRect(itemEntry->loopNo, itemEntry->celNo,
-							itemEntry->x, itemEntry->y, itemEntry->z, itemEntry->scaleX,
-							itemEntry->scaleY, itemEntry->celRect);
-
-					Common::Rect nsRect = itemEntry->celRect;
-					// Translate back to actual coordinate within scrollable plane
-					nsRect.translate(it->planeOffsetX, it->planeOffsetY);
-
-					if (g_sci->getGameId() == GID_PHANTASMAGORIA2) {
-						// HACK: Some (?) objects in Phantasmagoria 2 have no NS rect. Skip them for now.
-						// TODO: Remove once we figure out how Phantasmagoria 2 draws objects on screen.
-						if (lookupSelector(_segMan, itemEntry->object, SELECTOR(nsLeft), NULL, NULL) != kSelectorVariable)
-							continue;
-					}
-
-					if (view && view->isSci2Hires()) {
-						view->adjustBackUpscaledCoordinates(nsRect.top, nsRect.left);
-						view->adjustBackUpscaledCoordinates(nsRect.bottom, nsRect.right);
-						g_sci->_gfxCompare->setNSRect(itemEntry->object, nsRect);
-					} else if (getSciVersion() >= SCI_VERSION_2_1 && _resMan->detectHires()) {
-						_coordAdjuster->fromDisplayToScript(nsRect.top, nsRect.left);
-						_coordAdjuster->fromDisplayToScript(nsRect.bottom, nsRect.right);
-						g_sci->_gfxCompare->setNSRect(itemEntry->object, nsRect);
-					}
-
-					// TODO: For some reason, the top left nsRect coordinates get
-					// swapped in the GK1 inventory screen, investigate why.
-					// This is also needed for GK1 rooms 710 and 720 (catacombs, inner and
-					// outer circle), for handling the tiles and talking to Wolfgang.
-					// HACK: Fix the coordinates by explicitly setting them here for GK1.
-					// Also check bug #6729, for another case where this is needed.
-					if (g_sci->getGameId() == GID_GK1)
-						g_sci->_gfxCompare->setNSRect(itemEntry->object, nsRect);
-				}
+			if (itemIt->drawView) {
+				GfxView *view = itemIt->view;
+				if ((itemEntry->scaleX == 128) && (itemEntry->scaleY == 128))
+					view->draw(itemEntry->celRect, itemIt->clipRect, itemIt->translatedClipRect,
+						itemEntry->loopNo, itemEntry->celNo, 255, 0, view->isSci2Hires());
+				else
+					view->drawScaled(itemEntry->celRect, itemIt->clipRect, itemIt->translatedClipRect,
+						itemEntry->loopNo, itemEntry->celNo, 255, itemEntry->scaleX, itemEntry->scaleY);
+			}
 
-				// Don't attempt to draw sprites that are outside the visible
-				// screen area. An example is the random people walking in
-				// Jackson Square in GK1.
-				if (itemEntry->celRect.bottom < 0 || itemEntry->celRect.top  >= _screen->getDisplayHeight() ||
-				    itemEntry->celRect.right  < 0 || itemEntry->celRect.left >= _screen->getDisplayWidth())
-					continue;
+			if (itemIt->drawText)
+				g_sci->_gfxText32->drawTextBitmap(itemEntry->x, itemEntry->y, plane->planeRect, itemEntry->object);
+		}
+	}
+}
 
-				Common::Rect clipRect, translatedClipRect;
-				clipRect = itemEntry->celRect;
-
-				if (view && view->isSci2Hires()) {
-					clipRect.clip(it->upscaledPlaneClipRect);
-					translatedClipRect = clipRect;
-					translatedClipRect.translate(it->upscaledPlaneRect.left, it->upscaledPlaneRect.top);
-				} else {
-					// QFG4 passes invalid rectangles when a battle is starting
-					if (!clipRect.isValidRect())
-						continue;
-					clipRect.clip(it->planeClipRect);
-					translatedClipRect = clipRect;
-					translatedClipRect.translate(it->planeRect.left, it->planeRect.top);
-				}
+void GfxFrameout::kernelFrameout() {
+	if (g_sci->_robotDecoder->isVideoLoaded()) {
+		showVideo();
+		// The video got copied to the screen directly
+		_fullRedraw = true;
+		return;
+	}
 
-				if (view) {
-					if (!clipRect.isEmpty()) {
-						if ((itemEntry->scaleX == 128) && (itemEntry->scaleY == 128))
-							view->draw(itemEntry->celRect, clipRect, translatedClipRect,
-								itemEntry->loopNo, itemEntry->celNo, 255, 0, view->isSci2Hires());
-						else
-							view->drawScaled(itemEntry->celRect, clipRect, translatedClipRect,
-								itemEntry->loopNo, itemEntry->celNo, 255, itemEntry->scaleX, itemEntry->scaleY);
-					}
-				}
+	_palette->palVaryUpdate();
 
-				// Draw text, if it exists
-				if (lookupSelector(_segMan, itemEntry->object, SELECTOR(text), NULL, NULL) == kSelectorVariable) {
-					g_sci->_gfxText32->drawTextBitmap(itemEntry->x, itemEntry->y, it->planeRect, itemEntry->object);
-				}
-			}
+	// Find out what is going to be drawn, and which parts of the screen
+	// changed since the last frame
+	FrameoutDrawPlaneList drawPlaneList;
+	drawPlaneList.resize(_planes.size());
+
+	uint planeNr = 0;
+	for (PlaneList::iterator it = _planes.begin(); it != _planes.end(); ++it, ++planeNr)
+		preparePlane(*it, drawPlaneList[planeNr]);
+
+	// Anything that was drawn in the last frame, but not in this one, leaves
+	// a damaged region behind
+	for (FrameoutList::iterator it = _screenItems.begin(); it != _screenItems.end(); ++it)
+		damageUndrawn((*it)->drawn, (*it)->updated, (*it)->drawnRect);
+	for (PlaneList::iterator it = _planes.begin(); it != _planes.end(); ++it)
+		damageUndrawn(it->drawn, it->updated, it->drawnRect);
+	for (PlanePictureList::iterator it = _planePictures.begin(); it != _planePictures.end(); ++it)
+		damageUndrawn(it->drawn, it->updated, it->drawnRect);
+
+	// Scroll text is drawn on top of everything, and isn't tracked
+	bool showScrollText = _showScrollText && _curScrollText >= 0;
+	if (showScrollText || showScrollText != _lastShowScrollText)
+		_fullRedraw = true;
+	_lastShowScrollText = showScrollText;
+
+	// Clipping isn't possible on upscaled screens, see GfxScreen::setClipRect()
+	if (!_dirtyRectsEnabled || _screen->getUpscaledHires() != GFX_SCREEN_UPSCALED_DISABLED)
+		_fullRedraw = true;
+
+	const uint32 screenPixels = _screen->getWidth() * _screen->getHeight();
+	uint32 damagedPixels = 0;
+	for (uint i = 0; i < _damageRects.size(); i++)
+		damagedPixels += _damageRects[i].width() * _damageRects[i].height();
+
+	// Recompositing each region separately isn't worth it, if most of the
+	// screen got damaged anyway
+	if (damagedPixels > screenPixels / 4 * 3)
+		_fullRedraw = true;
+
+	if (_fullRedraw) {
+		drawPlanes(drawPlaneList, NULL);
+		showCurrentScrollText();
+		_screen->copyToScreen();
+
+		_statFullFrames++;
+		_statLastRects = 1;
+		damagedPixels = screenPixels;
+	} else if (_damageRects.empty()) {
+		_statSkippedFrames++;
+		_statLastRects = 0;
+	} else {
+		for (uint i = 0; i < _damageRects.size(); i++) {
+			_screen->setClipRect(_damageRects[i]);
+			drawPlanes(drawPlaneList, &_damageRects[i]);
 		}
+		_screen->resetClipRect();
 
-		for (PlanePictureList::iterator pictureIt = _planePictures.begin(); pictureIt != _planePictures.end(); pictureIt++) {
-			if (pictureIt->object == planeObject) {
-				delete[] pictureIt->pictureCels;
-				pictureIt->pictureCels = 0;
-			}
-		}
+		for (uint i = 0; i < _damageRects.size(); i++)
+			_screen->copyRectToScreen(_damageRects[i]);
+
+		_statLastRects = _damageRects.size();
 	}
 
-	showCurrentScrollText();
+	_statFrames++;
+	_statPixelsTotal += screenPixels;
+	_statPixelsRedrawn += damagedPixels;
+	_statLastPixels = damagedPixels;
+
+	_damageRects.clear();
+	_fullRedraw = false;
 
-	_screen->copyToScreen();
+	for (PlanePictureList::iterator pictureIt = _planePictures.begin(); pictureIt != _planePictures.end(); pictureIt++) {
+		delete[] pictureIt->pictureCels;
+		pictureIt->pictureCels = 0;
+	}
 
 	g_sci->getEngineState()->_throttleTrigger = true;
 }
@@ -882,6 +1167,24 @@ void GfxFrameout::printPlaneList(Console *con) {
 	}
 }
 
+void GfxFrameout::printFrameStats(Console *con) {
+	con->debugPrintf("Dirty rects: %s\n", _dirtyRectsEnabled ? "enabled" : "disabled");
+	con->debugPrintf("Frames: %d (%d full redraws, %d unchanged)\n", _statFrames, _statFullFrames, _statSkippedFrames);
+	if (_statPixelsTotal)
+		con->debugPrintf("Pixels redrawn: %.1f%%\n", (double)_statPixelsRedrawn * 100.0 / (double)_statPixelsTotal);
+	con->debugPrintf("Last frame: %d pixels in %d rects\n", _statLastPixels, _statLastRects);
+}
+
+void GfxFrameout::resetFrameStats() {
+	_statFrames = 0;
+	_statFullFrames = 0;
+	_statSkippedFrames = 0;
+	_statPixelsTotal = 0;
+	_statPixelsRedrawn = 0;
+	_statLastRects = 0;
+	_statLastPixels = 0;
+}
+
 void GfxFrameout::printPlaneItemList(Console *con, reg_t planeObject) {
 	for (FrameoutList::iterator listIterator = _screenItems.begin(); listIterator != _screenItems.end(); listIterator++) {
 		FrameoutEntry *e = *listIterator;
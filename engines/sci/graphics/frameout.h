@@ -52,6 +52,12 @@ struct PlaneEntry {
 	bool planePictureMirrored;
 	byte planeBack;
 	PlaneLineList lines;
+
+	// State of the last frame, used to find damaged screen regions
+	bool drawn;
+	bool updated;
+	uint32 drawnHash;
+	Common::Rect drawnRect;
 };
 
 typedef Common::List<PlaneEntry> PlaneList;
@@ -73,6 +79,12 @@ struct FrameoutEntry {
 	int16 picStartX;
 	int16 picStartY;
 	bool visible;
+
+	// State of the last frame, used to find damaged screen regions
+	bool drawn;
+	bool updated;
+	uint32 drawnHash;
+	Common::Rect drawnRect;
 };
 
 typedef Common::List<FrameoutEntry *> FrameoutList;
@@ -84,10 +96,43 @@ struct PlanePictureEntry {
 	GuiResourceId pictureId;
 	GfxPicture *picture;
 	FrameoutEntry *pictureCels; // temporary
+
+	// State of the last frame, used to find damaged screen regions
+	bool drawn;
+	bool updated;
+	uint32 drawnHash;
+	Common::Rect drawnRect;
 };
 
 typedef Common::List<PlanePictureEntry> PlanePictureList;
 
+/**
+ * An item of a plane that is going to be drawn in the current frame.
+ * Filled in before anything gets drawn, so that only the damaged regions
+ * of the screen need to be recomposited.
+ */
+struct FrameoutDrawItem {
+	FrameoutEntry *entry;
+	GfxView *view;
+	Common::Rect clipRect;
+	Common::Rect translatedClipRect;
+	Common::Rect rect; // screen area touched by this item
+	bool drawView;
+	bool drawText;
+};
+
+typedef Common::Array<FrameoutDrawItem> FrameoutDrawItemList;
+
+struct FrameoutDrawPlane {
+	PlaneEntry *plane;
+	bool visible;
+	bool clearRect; // plane got hidden, blackout its rect
+	bool fillRect;  // plain colored plane, fill its rect
+	FrameoutDrawItemList items;
+};
+
+typedef Common::Array<FrameoutDrawPlane> FrameoutDrawPlaneList;
+
 struct ScrollTextEntry {
 	reg_t bitmapHandle;
 	reg_t kWindow;
@@ -108,6 +153,7 @@ class GfxCoordAdjuster32;
 class GfxPaint32;
 class GfxPalette;
 class GfxScreen;
+class GfxView;
 
 /**
  * Frameout class, kFrameout and relevant functions for SCI32 games
@@ -150,10 +196,30 @@ public:
 
 	void printPlaneList(Console *con);
 	void printPlaneItemList(Console *con, reg_t planeObject);
+	void printFrameStats(Console *con);
+	void resetFrameStats();
+
+	/**
+	 * Makes the next kernelFrameout() recomposite and update the whole
+	 * screen. Needed after anything else has drawn to the screen.
+	 */
+	void invalidate() { _fullRedraw = true; }
+
+	/**
+	 * Enables or disables recompositing of damaged screen regions only.
+	 * When disabled, the whole screen is recomposited on every frame.
+	 */
+	void setDirtyRectsEnabled(bool enabled) { _dirtyRectsEnabled = enabled; _fullRedraw = true; }
+	bool isDirtyRectsEnabled() const { return _dirtyRectsEnabled; }
 
 private:
 	void showVideo();
 	void createPlaneItemList(reg_t planeObject, FrameoutList &itemList);
+	void preparePlane(PlaneEntry &plane, FrameoutDrawPlane &drawPlane);
+	void drawPlanes(FrameoutDrawPlaneList &drawPlanes, const Common::Rect *damageRect);
+	void updateDrawnState(bool &drawn, bool &updated, uint32 &drawnHash, Common::Rect &drawnRect, uint32 hash, const Common::Rect &rect);
+	void damageUndrawn(bool &drawn, bool &updated, const Common::Rect &drawnRect);
+	void addDamage(const Common::Rect &rect);
 	bool isPictureOutOfView(FrameoutEntry *itemEntry, Common::Rect planeRect, int16 planeOffsetX, int16 planeOffsetY);
 	void drawPicture(FrameoutEntry *itemEntry, int16 planeOffsetX, int16 planeOffsetY, bool planePictureMirrored);
 
@@ -173,6 +239,21 @@ private:
 	bool _showScrollText;
 	uint16 _maxScrollTexts;
 
+	// Damaged screen regions of the current frame
+	Common::Array<Common::Rect> _damageRects;
+	bool _fullRedraw;
+	bool _dirtyRectsEnabled;
+	bool _lastShowScrollText;
+
+	// Frame statistics, see printFrameStats()
+	uint32 _statFrames;
+	uint32 _statFullFrames;
+	uint32 _statSkippedFrames;
+	uint64 _statPixelsTotal;
+	uint64 _statPixelsRedrawn;
+	uint32 _statLastRects;
+	uint32 _statLastPixels;
+
 	void sortPlanes();
 };
 
@@ -23,6 +23,7 @@
 #ifndef SCI_GRAPHICS_HELPERS_H
 #define SCI_GRAPHICS_HELPERS_H
 
+#include "common/array.h"
 #include "common/endian.h"	// for READ_LE_UINT16
 #include "common/rect.h"
 #include "common/serializer.h"
@@ -34,6 +35,7 @@ namespace Sci {
 #define MAX_CACHED_CURSORS 10
 #define MAX_CACHED_FONTS 20
 #define MAX_CACHED_VIEWS 50
+#define MAX_CACHED_PICTURES 8
 
 #define SCI_SHAKE_DIRECTION_VERTICAL 1
 #define SCI_SHAKE_DIRECTION_HORIZONTAL 2
@@ -130,6 +132,27 @@ struct Palette {
 	byte intensity[256];
 };
 
+/**
+ * A state change done by a vector picture besides drawing. These get
+ * recorded along with cached picture renderings, so that they can be
+ * redone when the cached rendering is used.
+ */
+struct PictureStateChange {
+	enum Type {
+		kSetPalette,
+		kModifyAmigaPalette,
+		kPriorityBands,
+		kPriorityBandsEqualDistance
+	};
+
+	Type type;
+	Palette palette;
+	byte data[32];
+	int16 top, bottom;
+};
+
+typedef Common::Array<PictureStateChange> PictureStateLog;
+
 struct PalSchedule {
 	byte from;
 	uint32 schedule;
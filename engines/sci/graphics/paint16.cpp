@@ -70,7 +70,33 @@ void GfxPaint16::drawPicture(GuiResourceId pictureId, int16 animationNr, bool mi
 	if (!addToFlag)
 		clearScreen(_screen->getColorWhite());
 
-	picture->draw(animationNr, mirroredFlag, addToFlag, paletteId);
+	// Interpreting vector pictures is slow (especially EGA flood fills), so
+	// we keep the rendering of pictures around and just copy it, when the
+	// picture gets drawn again. Pictures that are added to the current one
+	// depend on what was on screen before, so those can't be cached. The
+	// picture rect also needs to cover the whole screen below the port top,
+	// otherwise we couldn't be sure that it got cleared completely.
+	Common::Rect picRect = _ports->_curPort->rect;
+	_ports->offsetRect(picRect);
+	bool cacheable = !addToFlag && !_EGAdrawingVisualize && picture->isVectorPicture() &&
+					 _screen->getUpscaledHires() == GFX_SCREEN_UPSCALED_DISABLED &&
+					 picRect.left == 0 && picRect.top >= 0 &&
+					 picRect.right == _screen->getWidth() && picRect.bottom == _screen->getHeight();
+
+	if (cacheable) {
+		const PictureStateLog *stateLog = _cache->restorePicture(pictureId, mirroredFlag, paletteId, picRect);
+		if (stateLog) {
+			picture->replayStateLog(*stateLog);
+		} else {
+			PictureStateLog newStateLog;
+			picture->setStateLog(&newStateLog);
+			picture->draw(animationNr, mirroredFlag, addToFlag, paletteId);
+			picture->setStateLog(NULL);
+			_cache->addPicture(pictureId, mirroredFlag, paletteId, picRect, newStateLog);
+		}
+	} else {
+		picture->draw(animationNr, mirroredFlag, addToFlag, paletteId);
+	}
 	delete picture;
 
 	// We make a call to SciPalette here, for increasing sys timestamp and also loading targetpalette, if palvary active
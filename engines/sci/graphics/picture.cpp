@@ -36,7 +36,7 @@ namespace Sci {
 //#define DEBUG_PICTURE_DRAW
 
 GfxPicture::GfxPicture(ResourceManager *resMan, GfxCoordAdjuster *coordAdjuster, GfxPorts *ports, GfxScreen *screen, GfxPalette *palette, GuiResourceId resourceId, bool EGAdrawingVisualize)
-	: _resMan(resMan), _coordAdjuster(coordAdjuster), _ports(ports), _screen(screen), _palette(palette), _resourceId(resourceId), _EGAdrawingVisualize(EGAdrawingVisualize) {
+	: _resMan(resMan), _coordAdjuster(coordAdjuster), _ports(ports), _screen(screen), _palette(palette), _resourceId(resourceId), _EGAdrawingVisualize(EGAdrawingVisualize), _stateLog(0) {
 	assert(resourceId != -1);
 	initData(resourceId);
 }
@@ -56,6 +56,39 @@ GuiResourceId GfxPicture::getResourceId() {
 	return _resourceId;
 }
 
+bool GfxPicture::isVectorPicture() {
+	// Same check as in draw()
+	uint16 headerSize = READ_LE_UINT16(_resource->data);
+	return headerSize != 0x26 && headerSize != 0x0e;
+}
+
+void GfxPicture::replayStateLog(const PictureStateLog &stateLog) {
+	for (PictureStateLog::const_iterator it = stateLog.begin(); it != stateLog.end(); ++it) {
+		switch (it->type) {
+		case PictureStateChange::kSetPalette: {
+			Palette palette = it->palette;
+			_palette->set(&palette, true);
+			break;
+		}
+		case PictureStateChange::kModifyAmigaPalette: {
+			byte data[32];
+			memcpy(data, it->data, sizeof(data));
+			_palette->modifyAmigaPalette(data);
+			break;
+		}
+		case PictureStateChange::kPriorityBands: {
+			byte data[14];
+			memcpy(data, it->data, sizeof(data));
+			_ports->priorityBandsInit(data);
+			break;
+		}
+		case PictureStateChange::kPriorityBandsEqualDistance:
+			_ports->priorityBandsInit(-1, it->top, it->bottom);
+			break;
+		}
+	}
+}
+
 // differentiation between various picture formats can NOT get done using sci-version checks.
 //  Games like PQ1 use the "old" vector data picture format, but are actually SCI1.1
 //  We should leave this that way to decide the format on-the-fly instead of hardcoding it in any way
@@ -788,6 +821,12 @@ void GfxPicture::drawVectorData(byte *data, int dataSize) {
 					break;
 				case PIC_OPX_EGA_SET_PRIORITY_TABLE:
 					_ports->priorityBandsInit(data + curPos);
+					if (_stateLog) {
+						PictureStateChange change;
+						change.type = PictureStateChange::kPriorityBands;
+						memcpy(change.data, data + curPos, 14);
+						_stateLog->push_back(change);
+					}
 					curPos += 14;
 					break;
 				default:
@@ -811,6 +850,12 @@ void GfxPicture::drawVectorData(byte *data, int dataSize) {
 						} else {
 							// Setting half of the Amiga palette
 							_palette->modifyAmigaPalette(&data[curPos]);
+							if (_stateLog) {
+								PictureStateChange change;
+								change.type = PictureStateChange::kModifyAmigaPalette;
+								memcpy(change.data, &data[curPos], 32);
+								_stateLog->push_back(change);
+							}
 							curPos += 32;
 						}
 					} else {
@@ -820,6 +865,12 @@ void GfxPicture::drawVectorData(byte *data, int dataSize) {
 							palette.colors[i].r = data[curPos++]; palette.colors[i].g = data[curPos++]; palette.colors[i].b = data[curPos++];
 						}
 						_palette->set(&palette, true);
+						if (_stateLog) {
+							PictureStateChange change;
+							change.type = PictureStateChange::kSetPalette;
+							change.palette = palette;
+							_stateLog->push_back(change);
+						}
 					}
 					break;
 				case PIC_OPX_VGA_EMBEDDED_VIEW: // draw cel
@@ -837,10 +888,23 @@ void GfxPicture::drawVectorData(byte *data, int dataSize) {
 					break;
 				case PIC_OPX_VGA_PRIORITY_TABLE_EQDIST:
 					_ports->priorityBandsInit(-1, READ_LE_UINT16(data + curPos), READ_LE_UINT16(data + curPos + 2));
+					if (_stateLog) {
+						PictureStateChange change;
+						change.type = PictureStateChange::kPriorityBandsEqualDistance;
+						change.top = READ_LE_UINT16(data + curPos);
+						change.bottom = READ_LE_UINT16(data + curPos + 2);
+						_stateLog->push_back(change);
+					}
 					curPos += 4;
 					break;
 				case PIC_OPX_VGA_PRIORITY_TABLE_EXPLICIT:
 					_ports->priorityBandsInit(data + curPos);
+					if (_stateLog) {
+						PictureStateChange change;
+						change.type = PictureStateChange::kPriorityBands;
+						memcpy(change.data, data + curPos, 14);
+						_stateLog->push_back(change);
+					}
 					curPos += 14;
 					break;
 				default:
@@ -51,6 +51,23 @@ public:
 	GuiResourceId getResourceId();
 	void draw(int16 animationNr, bool mirroredFlag, bool addToFlag, int16 EGApaletteNo);
 
+	/**
+	 * Returns true for pictures made of vector data (SCI0 - SCI1), which are
+	 * slow to draw and worth caching.
+	 */
+	bool isVectorPicture();
+
+	/**
+	 * Records all non-drawing state changes of the following draw() calls
+	 * into the given log, or stops recording when NULL is given.
+	 */
+	void setStateLog(PictureStateLog *stateLog) { _stateLog = stateLog; }
+
+	/**
+	 * Redoes the state changes of a recorded draw() call.
+	 */
+	void replayStateLog(const PictureStateLog &stateLog);
+
 #ifdef ENABLE_SCI32
 	int16 getSci32celCount();
 	int16 getSci32celY(int16 celNo);
@@ -98,6 +115,8 @@ private:
 
 	// If true, we will show the whole EGA drawing process...
 	bool _EGAdrawingVisualize;
+
+	PictureStateLog *_stateLog;
 };
 
 } // End of namespace Sci
@@ -222,6 +222,8 @@ GfxScreen::GfxScreen(ResourceManager *resMan) : _resMan(resMan) {
 	_vectorGetPixelPtr = &GfxScreen::getPixelNormal;
 	_putPixelPtr = &GfxScreen::putPixelNormal;
 	_getPixelPtr = &GfxScreen::getPixelNormal;
+	_putPixelUnclippedPtr = 0;
+	_clipActive = false;
 	
 	switch (_upscaledHires) {
 	case GFX_SCREEN_UPSCALED_480x300:
@@ -447,6 +449,31 @@ void GfxScreen::putPixelAllUpscaled(int16 x, int16 y, byte drawMask, byte color,
 		putScaledPixelOnScreen(_controlScreen, x, y, control);
 }
 
+// Sets a pixel through the regular code pointer, if it's inside the clip rect
+void GfxScreen::putPixelClipped(int16 x, int16 y, byte drawMask, byte color, byte priority, byte control) {
+	if (_clipRect.contains(x, y))
+		(this->*_putPixelUnclippedPtr)(x, y, drawMask, color, priority, control);
+}
+
+void GfxScreen::setClipRect(const Common::Rect &rect) {
+	if (_upscaledHires != GFX_SCREEN_UPSCALED_DISABLED)
+		error("setClipRect: not supported in upscaled hires mode");
+
+	_clipRect = rect;
+	if (!_clipActive) {
+		_putPixelUnclippedPtr = _putPixelPtr;
+		_putPixelPtr = &GfxScreen::putPixelClipped;
+		_clipActive = true;
+	}
+}
+
+void GfxScreen::resetClipRect() {
+	if (_clipActive) {
+		_putPixelPtr = _putPixelUnclippedPtr;
+		_clipActive = false;
+	}
+}
+
 /**
  * This is used to put font pixels onto the screen - we adjust differently, so that we won't
  *  do triple pixel lines in any case on upscaled hires. That way the font will not get distorted
@@ -454,6 +481,8 @@ void GfxScreen::putPixelAllUpscaled(int16 x, int16 y, byte drawMask, byte color,
  */
 void GfxScreen::putFontPixel(int16 startingY, int16 x, int16 y, byte color) {
 	int16 actualY = startingY + y;
+	if (_clipActive && !_clipRect.contains(x, actualY))
+		return;
 	if (_fontIsUpscaled) {
 		// Do not scale ourselves, but put it on the display directly
 		putPixelOnDisplay(x, actualY, color);
@@ -490,6 +519,8 @@ void GfxScreen::putFontPixel(int16 startingY, int16 x, int16 y, byte color) {
  * the upscaled display screen (like japanese fonts, hires portraits, etc.).
  */
 void GfxScreen::putPixelOnDisplay(int16 x, int16 y, byte color) {
+	if (_clipActive && !_clipRect.contains(x, y))
+		return;
 	int offset = y * _displayWidth + x;
 	_displayScreen[offset] = color;
 }
@@ -172,6 +172,15 @@ public:
 	void setFontIsUpscaled(bool isUpscaled) { _fontIsUpscaled = isUpscaled; }
 	bool fontIsUpscaled() const { return _fontIsUpscaled; }
 
+	/**
+	 * Restricts putPixel(), putFontPixel() and putPixelOnDisplay() to the
+	 * given rect. Only meant for non-upscaled screens, where screen and
+	 * display coordinates are the same (used by the SCI32 frameout code to
+	 * recomposite damaged regions only).
+	 */
+	void setClipRect(const Common::Rect &rect);
+	void resetClipRect();
+
 private:
 	uint16 _width;
 	uint16 _height;
@@ -264,6 +273,12 @@ private:
 	void putPixelNormal (int16 x, int16 y, byte drawMask, byte color, byte priority, byte control);
 	void putPixelDisplayUpscaled (int16 x, int16 y, byte drawMask, byte color, byte priority, byte control);
 	void putPixelAllUpscaled (int16 x, int16 y, byte drawMask, byte color, byte priority, byte control);
+	void putPixelClipped (int16 x, int16 y, byte drawMask, byte color, byte priority, byte control);
+
+	// putPixel code pointer that is active while a clip rect is set
+	void (GfxScreen::*_putPixelUnclippedPtr) (int16 x, int16 y, byte drawMask, byte color, byte priority, byte control);
+	bool _clipActive;
+	Common::Rect _clipRect;
 
 	byte (GfxScreen::*_getPixelPtr) (byte *screen, int16 x, int16 y);
 	byte getPixelNormal (byte *screen, int16 x, int16 y);
@@ -204,6 +204,38 @@ void GfxText32::drawTextBitmap(int16 x, int16 y, Common::Rect planeRect, reg_t t
 	drawTextBitmapInternal(x, y, planeRect, textObject, hunkId);
 }
 
+bool GfxText32::getTextBitmapInfo(int16 x, int16 y, Common::Rect planeRect, reg_t textObject, Common::Rect &rect, uint32 &checksum) {
+	reg_t hunkId = readSelector(_segMan, textObject, SELECTOR(bitmap));
+	// Same checks as in drawTextBitmapInternal()
+	if (hunkId.isNull() || x < 0 || y < 0)
+		return false;
+
+	byte *memoryPtr = _segMan->getHunkPointer(hunkId);
+	if (!memoryPtr)
+		return false;
+
+	const byte *surface = memoryPtr + BITMAP_HEADER_SIZE;
+	uint16 textX = planeRect.left + x;
+	uint16 textY = planeRect.top + y;
+	uint16 width = READ_LE_UINT16(memoryPtr);
+	uint16 height = READ_LE_UINT16(memoryPtr + 2);
+
+	if (_screen->fontIsUpscaled()) {
+		textX = textX * _screen->getDisplayWidth() / _screen->getWidth();
+		textY = textY * _screen->getDisplayHeight() / _screen->getHeight();
+	}
+
+	rect = Common::Rect(textX, textY, textX + width, textY + height);
+
+	checksum = (width << 16) | height;
+	checksum = checksum * 31 + (uint16)readSelectorValue(_segMan, textObject, SELECTOR(skip));
+	checksum = checksum * 31 + (uint16)readSelectorValue(_segMan, textObject, SELECTOR(back));
+	for (uint32 i = 0; i < (uint32)width * height; i++)
+		checksum = checksum * 31 + surface[i];
+
+	return true;
+}
+
 void GfxText32::drawScrollTextBitmap(reg_t textObject, reg_t hunkId, uint16 x, uint16 y) {
 	/*reg_t plane = readSelector(_segMan, textObject, SELECTOR(plane));
 	Common::Rect planeRect;
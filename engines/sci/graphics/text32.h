@@ -36,6 +36,12 @@ public:
 	reg_t createScrollTextBitmap(Common::String text, reg_t textObject, uint16 maxWidth = 0, uint16 maxHeight = 0, reg_t prevHunk = NULL_REG);
 	void drawTextBitmap(int16 x, int16 y, Common::Rect planeRect, reg_t textObject);
 	void drawScrollTextBitmap(reg_t textObject, reg_t hunkId, uint16 x, uint16 y);
+	/**
+	 * Gets the screen area drawTextBitmap() would paint for the given text
+	 * object, together with a checksum of the bitmap contents. Returns false
+	 * if nothing would be drawn.
+	 */
+	bool getTextBitmapInfo(int16 x, int16 y, Common::Rect planeRect, reg_t textObject, Common::Rect &rect, uint32 &checksum);
 	void disposeTextBitmap(reg_t hunkId);
 	int16 GetLongest(const char *text, int16 maxWidth, GfxFont *font);
 
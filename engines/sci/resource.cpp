@@ -739,7 +739,12 @@ void ResourceManager::scanNewSources() {
 
 		if (!source->_scanned) {
 			source->_scanned = true;
-			source->scanSource(this);
+
+			ResSourceType sourceType = source->getSourceType();
+			if (_newResIndex && (sourceType == kSourceExtMap || sourceType == kSourceIntMap || sourceType == kSourceExtAudioMap))
+				scanMapSource(source);
+			else
+				source->scanSource(this);
 		}
 	}
 }
@@ -858,6 +863,11 @@ void ResourceManager::freeResourceSources() {
 }
 
 ResourceManager::ResourceManager() {
+	_resIndex = NULL;
+	_newResIndex = NULL;
+	_resIndexBlock = NULL;
+	_resIndexDirty = false;
+	_resMapIdSum = 0;
 }
 
 void ResourceManager::init() {
@@ -865,12 +875,20 @@ void ResourceManager::init() {
 	_memoryLRU = 0;
 	_LRU.clear();
 	_resMap.clear();
+	_resMapIdSum = 0;
 	_audioMapSCI1 = NULL;
 
 	// FIXME: put this in an Init() function, so that we can error out if detection fails completely
 
-	_mapVersion = detectMapVersion();
-	_volVersion = detectVolVersion();
+	loadResourceIndex();
+
+	if (_resIndex) {
+		_mapVersion = _resIndex->mapVersion;
+		_volVersion = _resIndex->volVersion;
+	} else {
+		_mapVersion = detectMapVersion();
+		_volVersion = detectVolVersion();
+	}
 
 	// TODO/FIXME: Remove once SCI3 resource detection is finished
 	if ((_mapVersion == kResVersionSci3 || _volVersion == kResVersionSci3) && (_mapVersion != _volVersion)) {
@@ -894,9 +912,18 @@ void ResourceManager::init() {
 	if ((_mapVersion == kResVersionUnknown) && (_volVersion == kResVersionUnknown)) {
 		warning("Volume and map version not detected, assuming that this is not a SCI game");
 		_viewType = kViewUnknown;
+		delete _newResIndex;
+		_newResIndex = NULL;
+		delete _resIndex;
+		_resIndex = NULL;
 		return;
 	}
 
+	if (_newResIndex) {
+		_newResIndex->mapVersion = _mapVersion;
+		_newResIndex->volVersion = _volVersion;
+	}
+
 	scanNewSources();
 
 	if (!addAudioSources()) {
@@ -910,7 +937,14 @@ void ResourceManager::init() {
 	addScriptChunkSources();
 	scanNewSources();
 
-	detectSciVersion();
+	if (isResourceIndexCurrent()) {
+		s_sciVersion = _resIndex->sciVersion;
+		_viewType = _resIndex->viewType;
+	} else {
+		detectSciVersion();
+	}
+
+	saveResourceIndex(s_sciVersion);
 
 	debugC(1, kDebugLevelResMan, "resMan: Detected %s", getSciVersionDesc(getSciVersion()));
 
@@ -951,6 +985,7 @@ void ResourceManager::initForDetection() {
 	_memoryLRU = 0;
 	_LRU.clear();
 	_resMap.clear();
+	_resMapIdSum = 0;
 	_audioMapSCI1 = NULL;
 
 	_mapVersion = detectMapVersion();
@@ -969,6 +1004,9 @@ ResourceManager::~ResourceManager() {
 	}
 	freeResourceSources();
 
+	delete _resIndex;
+	delete _newResIndex;
+
 	Common::List<Common::File *>::iterator it = _volumeFiles.begin();
 	while (it != _volumeFiles.end()) {
 		delete *it;
@@ -1721,6 +1759,9 @@ int ResourceManager::readResourceMapSCI1(ResourceSource *map) {
 				// resource data files like fonts, views, scripts, etc. Thus,
 				// if we use the first entries in the resource file, half of the
 				// game will be English and umlauts will also be missing :P
+				if (_resIndexBlock)
+					recordResourceIndexOp(kResourceIndexRelocate, resId, source, fileOffset, 0);
+
 				if (resource->_source->getSourceType() == kSourceVolume) {
 					resource->_source = source;
 					resource->_fileOffset = fileOffset;
@@ -1830,10 +1871,14 @@ void ResourceManager::addResource(ResourceId resId, ResourceSource *src, uint32
 	if (_resMap.contains(resId) == false) {
 		Resource *res = new Resource(this, resId);
 		_resMap.setVal(resId, res);
+		_resMapIdSum += getResourceIdHash(resId);
 		res->_source = src;
 		res->_fileOffset = offset;
 		res->size = size;
 	}
+
+	if (_resIndexBlock)
+		recordResourceIndexOp(kResourceIndexAdd, resId, src, offset, size);
 }
 
 Resource *ResourceManager::updateResource(ResourceId resId, ResourceSource *src, uint32 size) {
@@ -1845,6 +1890,7 @@ Resource *ResourceManager::updateResource(ResourceId resId, ResourceSource *src,
 	} else {
 		res = new Resource(this, resId);
 		_resMap.setVal(resId, res);
+		_resMapIdSum += getResourceIdHash(resId);
 	}
 
 	res->_status = kResStatusNoMalloc;
@@ -133,6 +133,8 @@ enum ResVersion {
 
 class ResourceManager;
 class ResourceSource;
+struct ResourceIndex;
+struct ResourceIndexBlock;
 
 class ResourceId {
 	static inline ResourceType fixupType(ResourceType type) {
@@ -367,6 +369,16 @@ public:
 	 */
 	Common::List<ResourceId> listResources(ResourceType type, int mapNumber = -1);
 
+	/**
+	 * Opens a stream over an audio resource stored in an audio volume, without
+	 * loading the resource. For original volumes the stream starts at the
+	 * resource header, for volumes compressed by our tools at the compressed
+	 * data. The stream has its own file handle, so the mixer may read it.
+	 * @param res	The audio resource
+	 * @return The stream, or NULL if the resource has to be loaded instead
+	 */
+	Common::SeekableReadStream *createAudioResourceStream(Resource *res);
+
 	void setAudioLanguage(int language);
 	int getAudioLanguage() const;
 	void changeAudioDirectory(Common::String path);
@@ -436,10 +448,15 @@ protected:
 	int _memoryLRU;		///< Amount of resource bytes under LRU control
 	Common::List<Resource *> _LRU; ///< Last Resource Used list
 	ResourceMap _resMap;
+	uint32 _resMapIdSum; ///< Sum of getResourceIdHash() over _resMap, kept up to date for getMapSourceStamp()
 	Common::List<Common::File *> _volumeFiles; ///< list of opened volume files
 	ResourceSource *_audioMapSCI1; ///< Currently loaded audio map for SCI1
 	ResVersion _volVersion; ///< resource.0xx version
 	ResVersion _mapVersion; ///< resource.map version
+	ResourceIndex *_resIndex; ///< Resource index loaded from disk, only valid during init()
+	ResourceIndex *_newResIndex; ///< Resource index being built during init()
+	ResourceIndexBlock *_resIndexBlock; ///< Block receiving the changes of the map currently being parsed
+	bool _resIndexDirty; ///< Set when any part of the loaded resource index was unusable
 
 	/**
 	 * Add a path to the resource manager's list of sources.
@@ -479,6 +496,40 @@ protected:
 	void addScriptChunkSources();
 	void freeResourceSources();
 
+	/**--- Resource index functions (resource_index.cpp) ---*/
+
+	/**
+	 * Loads the resource index of the current target and starts building a
+	 * new one. The loaded index is dropped if the initial sources or their
+	 * file sizes have changed since it was written.
+	 */
+	void loadResourceIndex();
+
+	/**
+	 * Writes the resource index built during init(), if it differs from the
+	 * loaded one, and releases both.
+	 * @param sciVersion	The detected SCI version
+	 */
+	void saveResourceIndex(SciVersion sciVersion);
+
+	/**
+	 * Returns true if the loaded resource index describes the current
+	 * resource map, so its SCI version and view type can be used instead of
+	 * running detectSciVersion().
+	 */
+	bool isResourceIndexCurrent();
+
+	/**
+	 * Scans a resource or audio map source, replaying its changes from the
+	 * loaded resource index if possible, and records them in the new one.
+	 */
+	void scanMapSource(ResourceSource *source);
+	bool replayResourceIndex(ResourceSource *map, uint32 mapIndex, uint32 stamp);
+	void recordResourceIndexOp(int type, ResourceId resId, ResourceSource *src, uint32 offset, uint32 size);
+	uint32 getMapSourceStamp(ResourceSource *source);
+	uint32 getResourceMapHash(bool withLocations) const;
+	static uint32 getResourceIdHash(const ResourceId &id);
+
 	/**
 	 * Returns a string describing a ResVersion.
 	 * @param version	The resource version
@@ -24,6 +24,7 @@
 
 #include "common/archive.h"
 #include "common/file.h"
+#include "common/substream.h"
 #include "common/textconsole.h"
 
 #include "sci/resource.h"
@@ -79,6 +80,74 @@ AudioVolumeResourceSource::~AudioVolumeResourceSource() {
 	delete[] _audioCompressionOffsetMapping;
 }
 
+bool AudioVolumeResourceSource::translateCompressedOffset(int32 offset, int32 &compressedOffset, int32 &compressedEnd) const {
+	const int32 *mappingTable = _audioCompressionOffsetMapping;
+
+	// Each entry holds the original and the compressed offset, the
+	// compressed data ends where the next entry begins
+	do {
+		if (mappingTable[0] == offset) {
+			compressedOffset = mappingTable[1];
+			compressedEnd = mappingTable[3];
+			return compressedOffset != 0;
+		}
+		mappingTable += 2;
+	} while (*mappingTable);
+
+	return false;
+}
+
+Common::SeekableReadStream *AudioVolumeResourceSource::createReadStream(Resource *res) {
+	int32 begin = res->_fileOffset;
+	int32 end = 0;
+
+	if (_audioCompressionType) {
+		if (!translateCompressedOffset(res->_fileOffset, begin, end))
+			return NULL;
+	}
+
+	// The stream gets its own file handle instead of one of the shared volume
+	// files, as it is read from the mixer thread
+	Common::SeekableReadStream *fileStream = 0;
+
+	if (_resourceFile) {
+		fileStream = _resourceFile->createReadStream();
+	} else {
+		Common::File *file = new Common::File();
+		if (file->open(getLocationName()))
+			fileStream = file;
+		else
+			delete file;
+	}
+
+	if (!fileStream)
+		return NULL;
+
+	if (!_audioCompressionType) {
+		// SCI1.1+ resources start with a header holding their size, older
+		// ones get their size from the audio map
+		if (getSciVersion() >= SCI_VERSION_1_1)
+			end = fileStream->size();
+		else
+			end = begin + res->size;
+	}
+
+	if (begin >= end || end > fileStream->size()) {
+		delete fileStream;
+		return NULL;
+	}
+
+	return new Common::SeekableSubReadStream(fileStream, begin, end, DisposeAfterUse::YES);
+}
+
+Common::SeekableReadStream *ResourceManager::createAudioResourceStream(Resource *res) {
+	// Already loaded resources are played from memory
+	if (res->_status != kResStatusNoMalloc || res->_source->getSourceType() != kSourceAudioVolume)
+		return NULL;
+
+	return static_cast<AudioVolumeResourceSource *>(res->_source)->createReadStream(res);
+}
+
 bool Resource::loadFromWaveFile(Common::SeekableReadStream *file) {
 	data = new byte[size];
 
@@ -222,6 +291,7 @@ void ResourceManager::removeAudioResource(ResourceId resId) {
 					removeFromLRU(res);
 
 				_resMap.erase(resId);
+				_resMapIdSum -= getResourceIdHash(resId);
 				delete res;
 			}
 		}
@@ -877,31 +947,22 @@ void AudioVolumeResourceSource::loadResource(ResourceManager *resMan, Resource *
 	if (_audioCompressionType) {
 		// this file is compressed, so lookup our offset in the offset-translation table and get the new offset
 		//  also calculate the compressed size by using the next offset
-		int32 *mappingTable = _audioCompressionOffsetMapping;
 		int32 compressedOffset = 0;
+		int32 compressedEnd = 0;
 
-		do {
-			if (*mappingTable == res->_fileOffset) {
-				mappingTable++;
-				compressedOffset = *mappingTable;
-				// Go to next compressed offset and use that to calculate size of compressed sample
-				switch (res->getType()) {
-				case kResourceTypeSync:
-				case kResourceTypeSync36:
-				case kResourceTypeRave:
-					// we should already have a (valid) size
-					break;
-				default:
-					mappingTable += 2;
-					res->size = *mappingTable - compressedOffset;
-				}
-				break;
-			}
-			mappingTable += 2;
-		} while (*mappingTable);
-
-		if (!compressedOffset)
+		if (!translateCompressedOffset(res->_fileOffset, compressedOffset, compressedEnd))
 			error("could not translate offset to compressed offset in audio volume");
+
+		switch (res->getType()) {
+		case kResourceTypeSync:
+		case kResourceTypeSync36:
+		case kResourceTypeRave:
+			// we should already have a (valid) size
+			break;
+		default:
+			res->size = compressedEnd - compressedOffset;
+		}
+
 		fileStream->seek(compressedOffset, SEEK_SET);
 
 		switch (res->getType()) {
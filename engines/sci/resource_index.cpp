@@ -0,0 +1,461 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+// Resource index: a cache of the resource map built by ResourceManager::init()
+//
+// Parsing the resource maps, and especially the SCI1.1+ audio maps (which are
+// resources themselves and may hold tens of thousands of entries), along with
+// detecting the SCI version, makes up most of the engine startup time. The
+// changes each map makes to the resource map are recorded and written to
+// "<target>.resindex" in the save path, and replayed on the next start.
+//
+// The backends offer no file modification times, so the index is keyed by the
+// names and sizes of the resource files instead. Every recorded map also
+// carries a stamp of its own input and of the resource map state it was
+// applied to, so a changed patch set only invalidates the affected maps.
+
+#include "common/config-manager.h"
+#include "common/debug.h"
+#include "common/file.h"
+#include "common/fs.h"
+#include "common/memstream.h"
+#include "common/savefile.h"
+#include "common/system.h"
+
+#include "sci/resource.h"
+#include "sci/resource_intern.h"
+
+namespace Sci {
+
+enum {
+	kResourceIndexVersion = 1
+};
+
+static const uint32 kResourceIndexHashSeed = 2166136261U;
+
+static uint32 mixHash(uint32 hash, uint32 value) {
+	// FNV-1a over the bytes of value
+	for (int i = 0; i < 4; i++) {
+		hash ^= (value >> (i * 8)) & 0xFF;
+		hash *= 16777619;
+	}
+	return hash;
+}
+
+static uint32 getSourceHash(const ResourceSource *source) {
+	uint32 hash = mixHash(kResourceIndexHashSeed, source->getSourceType());
+	hash = mixHash(hash, source->_volumeNumber);
+	return mixHash(hash, Common::hashit_lower(source->getLocationName()));
+}
+
+static uint32 getSourceFileSize(const ResourceSource *source) {
+	switch (source->getSourceType()) {
+	case kSourceVolume:
+	case kSourceExtMap:
+	case kSourceAudioVolume:
+	case kSourceExtAudioMap:
+		break;
+	default:
+		// Directories and internal maps have no file of their own
+		return 0;
+	}
+
+	Common::SeekableReadStream *stream = 0;
+
+	if (source->_resourceFile) {
+		stream = source->_resourceFile->createReadStream();
+	} else {
+		Common::File *file = new Common::File();
+		if (file->open(source->getLocationName()))
+			stream = file;
+		else
+			delete file;
+	}
+
+	uint32 size = stream ? stream->size() : 0;
+	delete stream;
+	return size;
+}
+
+static Common::String getResourceIndexName() {
+	return ConfMan.getActiveDomainName() + ".resindex";
+}
+
+static bool isVolumeSource(const ResourceSource *source) {
+	// Resources in these sources only get their size when they are loaded
+	return source->getSourceType() == kSourceVolume || source->getSourceType() == kSourceMacResourceFork;
+}
+
+uint32 ResourceManager::getResourceIdHash(const ResourceId &id) {
+	uint32 hash = mixHash(kResourceIndexHashSeed, id.getType());
+	hash = mixHash(hash, id.getNumber());
+	return mixHash(hash, id.getTuple());
+}
+
+uint32 ResourceManager::getResourceMapHash(bool withLocations) const {
+	uint32 sum = 0;
+	const ResourceSource *lastSource = 0;
+	uint32 lastSourceHash = 0;
+
+	// The resource map has no defined order, so the entries are combined
+	// with an order independent sum
+	for (ResourceMap::const_iterator it = _resMap.begin(); it != _resMap.end(); ++it) {
+		uint32 hash = getResourceIdHash(it->_key);
+
+		if (withLocations) {
+			const Resource *res = it->_value;
+
+			if (res->_source != lastSource) {
+				lastSource = res->_source;
+				lastSourceHash = getSourceHash(lastSource);
+			}
+
+			hash = mixHash(hash, lastSourceHash);
+			hash = mixHash(hash, res->_fileOffset);
+			if (!isVolumeSource(res->_source))
+				hash = mixHash(hash, res->size);
+		}
+
+		sum += hash;
+	}
+
+	return mixHash(sum, _resMap.size());
+}
+
+uint32 ResourceManager::getMapSourceStamp(ResourceSource *source) {
+	// Maps only add resources which aren't present yet, so the set of
+	// resources before the scan is part of the stamp. This is the same as
+	// getResourceMapHash(false), without walking the whole resource map.
+	uint32 stamp = mixHash(kResourceIndexHashSeed, mixHash(_resMapIdSum, _resMap.size()));
+
+	if (source->getSourceType() == kSourceIntMap) {
+		// SCI1.1+ audio maps are map resources, possibly patched
+		Resource *mapRes = _resMap.getVal(ResourceId(kResourceTypeMap, source->_volumeNumber), NULL);
+
+		if (mapRes) {
+			stamp = mixHash(stamp, getSourceHash(mapRes->_source));
+			stamp = mixHash(stamp, mapRes->_fileOffset);
+			if (!isVolumeSource(mapRes->_source))
+				stamp = mixHash(stamp, mapRes->size);
+		}
+
+		// Some audio maps lack sizes, which are then read from the volume
+		ResourceSource *volume = findVolume(source, 0);
+		if (volume)
+			stamp = mixHash(stamp, getSourceFileSize(volume));
+	} else {
+		stamp = mixHash(stamp, getSourceFileSize(source));
+	}
+
+	return stamp;
+}
+
+void ResourceManager::loadResourceIndex() {
+	_resIndex = NULL;
+	_resIndexBlock = NULL;
+	_resIndexDirty = false;
+	_newResIndex = NULL;
+
+	if (ConfMan.getActiveDomainName().empty())
+		return;
+
+	uint32 baseKey = kResourceIndexHashSeed;
+	for (Common::List<ResourceSource *>::iterator it = _sources.begin(); it != _sources.end(); ++it) {
+		baseKey = mixHash(baseKey, getSourceHash(*it));
+		baseKey = mixHash(baseKey, getSourceFileSize(*it));
+	}
+
+	_newResIndex = new ResourceIndex();
+	_newResIndex->baseKey = baseKey;
+
+	Common::InSaveFile *in = g_system->getSavefileManager()->openForLoading(getResourceIndexName());
+	if (!in) {
+		_resIndexDirty = true;
+		return;
+	}
+
+	// Read the whole index at once, and parse it from memory
+	uint32 size = in->size();
+	byte *buf = (byte *)malloc(size);
+	if (!buf || in->read(buf, size) != size) {
+		free(buf);
+		delete in;
+		_resIndexDirty = true;
+		return;
+	}
+	delete in;
+
+	Common::MemoryReadStream stream(buf, size, DisposeAfterUse::YES);
+	ResourceIndex *index = new ResourceIndex();
+
+	bool valid = stream.readUint32BE() == MKTAG('S', 'R', 'I', 'X')
+		&& stream.readUint32LE() == kResourceIndexVersion;
+
+	if (valid) {
+		index->baseKey = stream.readUint32LE();
+		index->mapVersion = (ResVersion)stream.readByte();
+		index->volVersion = (ResVersion)stream.readByte();
+		index->fingerprint = stream.readUint32LE();
+		index->sciVersion = (SciVersion)stream.readByte();
+		index->viewType = (ViewType)stream.readByte();
+		valid = (index->baseKey == baseKey);
+	}
+
+	if (valid) {
+		uint32 sourceCount = stream.readUint32LE();
+		for (uint32 i = 0; i < sourceCount && !stream.eos(); i++)
+			index->sourceHashes.push_back(stream.readUint32LE());
+
+		uint32 blockCount = stream.readUint32LE();
+		index->blocks.resize(MIN<uint32>(blockCount, sourceCount));
+		for (uint32 i = 0; i < index->blocks.size() && !stream.eos(); i++) {
+			ResourceIndexBlock &block = index->blocks[i];
+			block.mapSource = stream.readUint32LE();
+			block.stamp = stream.readUint32LE();
+			block.mapVersion = (ResVersion)stream.readByte();
+
+			uint32 opCount = stream.readUint32LE();
+			if (opCount > (uint32)(stream.size() - stream.pos()))
+				break;
+
+			block.ops.resize(opCount);
+			for (uint32 j = 0; j < opCount; j++) {
+				ResourceIndexOp &op = block.ops[j];
+				op.type = (ResourceIndexOpType)stream.readByte();
+				ResourceType type = (ResourceType)stream.readByte();
+				uint16 number = stream.readUint16LE();
+				uint32 tuple = stream.readUint32LE();
+				op.id = ResourceId(type, number, tuple);
+				op.source = stream.readUint32LE();
+				op.offset = stream.readUint32LE();
+				op.size = stream.readUint32LE();
+			}
+		}
+
+		valid = !stream.eos() && !stream.err() && stream.pos() == stream.size();
+	}
+
+	if (!valid) {
+		debugC(1, kDebugLevelResMan, "resMan: Resource index %s is outdated", getResourceIndexName().c_str());
+		delete index;
+		_resIndexDirty = true;
+		return;
+	}
+
+	debugC(1, kDebugLevelResMan, "resMan: Loaded resource index %s with %d maps", getResourceIndexName().c_str(), index->blocks.size());
+	_resIndex = index;
+}
+
+void ResourceManager::saveResourceIndex(SciVersion sciVersion) {
+	if (!_newResIndex)
+		return;
+
+	ResourceIndex *index = _newResIndex;
+	_newResIndex = NULL;
+
+	if (_resIndexDirty || !_resIndex || _resIndex->fingerprint != index->fingerprint) {
+		index->sciVersion = sciVersion;
+		index->viewType = _viewType;
+
+		Common::OutSaveFile *out = g_system->getSavefileManager()->openForSaving(getResourceIndexName(), false);
+
+		if (out) {
+			out->writeUint32BE(MKTAG('S', 'R', 'I', 'X'));
+			out->writeUint32LE(kResourceIndexVersion);
+			out->writeUint32LE(index->baseKey);
+			out->writeByte(index->mapVersion);
+			out->writeByte(index->volVersion);
+			out->writeUint32LE(index->fingerprint);
+			out->writeByte(index->sciVersion);
+			out->writeByte(index->viewType);
+
+			out->writeUint32LE(_sources.size());
+			for (Common::List<ResourceSource *>::iterator it = _sources.begin(); it != _sources.end(); ++it)
+				out->writeUint32LE(getSourceHash(*it));
+
+			out->writeUint32LE(index->blocks.size());
+			for (uint32 i = 0; i < index->blocks.size(); i++) {
+				const ResourceIndexBlock &block = index->blocks[i];
+				out->writeUint32LE(block.mapSource);
+				out->writeUint32LE(block.stamp);
+				out->writeByte(block.mapVersion);
+				out->writeUint32LE(block.ops.size());
+
+				for (uint32 j = 0; j < block.ops.size(); j++) {
+					const ResourceIndexOp &op = block.ops[j];
+					out->writeByte(op.type);
+					out->writeByte(op.id.getType());
+					out->writeUint16LE(op.id.getNumber());
+					out->writeUint32LE(op.id.getTuple());
+					out->writeUint32LE(op.source);
+					out->writeUint32LE(op.offset);
+					out->writeUint32LE(op.size);
+				}
+			}
+
+			out->finalize();
+			if (out->err())
+				warning("Failed to write resource index %s", getResourceIndexName().c_str());
+			else
+				debugC(1, kDebugLevelResMan, "resMan: Wrote resource index %s", getResourceIndexName().c_str());
+			delete out;
+		}
+	}
+
+	delete index;
+	delete _resIndex;
+	_resIndex = NULL;
+}
+
+bool ResourceManager::isResourceIndexCurrent() {
+	if (!_newResIndex)
+		return false;
+
+	uint32 fingerprint = getResourceMapHash(true);
+	for (Common::List<ResourceSource *>::iterator it = _sources.begin(); it != _sources.end(); ++it)
+		fingerprint = mixHash(fingerprint, getSourceHash(*it));
+
+	_newResIndex->fingerprint = fingerprint;
+
+	return _resIndex && _resIndex->fingerprint == fingerprint
+		&& _resIndex->sciVersion != SCI_VERSION_NONE && _resIndex->viewType != kViewUnknown;
+}
+
+void ResourceManager::scanMapSource(ResourceSource *source) {
+	uint32 mapIndex = 0;
+	for (Common::List<ResourceSource *>::iterator it = _sources.begin(); *it != source; ++it)
+		mapIndex++;
+
+	ResourceIndexBlock block;
+	block.mapSource = mapIndex;
+	block.stamp = getMapSourceStamp(source);
+
+	_newResIndex->blocks.push_back(block);
+	ResourceIndexBlock &newBlock = _newResIndex->blocks.back();
+
+	if (!replayResourceIndex(source, mapIndex, block.stamp)) {
+		debugC(1, kDebugLevelResMan, "resMan: Scanning %s", source->getLocationName().c_str());
+		_resIndexDirty = true;
+		_resIndexBlock = &newBlock;
+		source->scanSource(this);
+		_resIndexBlock = NULL;
+	}
+
+	newBlock.mapVersion = _mapVersion;
+}
+
+bool ResourceManager::replayResourceIndex(ResourceSource *map, uint32 mapIndex, uint32 stamp) {
+	if (!_resIndex)
+		return false;
+
+	const Common::Array<uint32> &sourceHashes = _resIndex->sourceHashes;
+	if (mapIndex >= sourceHashes.size() || sourceHashes[mapIndex] != getSourceHash(map))
+		return false;
+
+	const ResourceIndexBlock *block = NULL;
+	for (uint32 i = 0; i < _resIndex->blocks.size(); i++) {
+		if (_resIndex->blocks[i].mapSource == mapIndex && _resIndex->blocks[i].stamp == stamp) {
+			block = &_resIndex->blocks[i];
+			break;
+		}
+	}
+
+	if (!block)
+		return false;
+
+	// Resolve all target sources first, so that a stale block leaves the
+	// resource map untouched
+	Common::Array<ResourceSource *> sources;
+	for (Common::List<ResourceSource *>::iterator it = _sources.begin(); it != _sources.end(); ++it)
+		sources.push_back(*it);
+
+	Common::Array<ResourceSource *> targets;
+	targets.resize(block->ops.size());
+	ResourceSource *lastSource = NULL;
+	uint32 lastSourceIndex = 0;
+
+	for (uint32 i = 0; i < block->ops.size(); i++) {
+		uint32 sourceIndex = block->ops[i].source;
+
+		if (!lastSource || sourceIndex != lastSourceIndex) {
+			if (sourceIndex >= sources.size() || sourceIndex >= sourceHashes.size()
+				|| sourceHashes[sourceIndex] != getSourceHash(sources[sourceIndex]))
+				return false;
+
+			lastSource = sources[sourceIndex];
+			lastSourceIndex = sourceIndex;
+		}
+
+		targets[i] = lastSource;
+	}
+
+	for (uint32 i = 0; i < block->ops.size(); i++) {
+		const ResourceIndexOp &op = block->ops[i];
+
+		if (op.type == kResourceIndexAdd) {
+			addResource(op.id, targets[i], op.offset, op.size);
+		} else {
+			Resource *res = _resMap.getVal(op.id, NULL);
+			if (res && res->_source->getSourceType() == kSourceVolume) {
+				res->_source = targets[i];
+				res->_fileOffset = op.offset;
+				res->size = 0;
+			}
+		}
+	}
+
+	_newResIndex->blocks.back().ops = block->ops;
+	_mapVersion = block->mapVersion;
+	return true;
+}
+
+void ResourceManager::recordResourceIndexOp(int type, ResourceId resId, ResourceSource *src, uint32 offset, uint32 size) {
+	if (!_resIndexBlock)
+		return;
+
+	// Most entries of a map point to the same volume
+	if (src != _newResIndex->lastSource) {
+		uint32 sourceIndex = 0;
+		Common::List<ResourceSource *>::iterator it;
+		for (it = _sources.begin(); it != _sources.end() && *it != src; ++it)
+			sourceIndex++;
+
+		if (it == _sources.end()) {
+			// Not a source we can refer to, so this map can't be replayed
+			_resIndexBlock->stamp = 0;
+			return;
+		}
+
+		_newResIndex->lastSource = src;
+		_newResIndex->lastSourceIndex = sourceIndex;
+	}
+
+	ResourceIndexOp op;
+	op.type = (ResourceIndexOpType)type;
+	op.id = resId;
+	op.source = _newResIndex->lastSourceIndex;
+	op.offset = offset;
+	op.size = size;
+	_resIndexBlock->ops.push_back(op);
+}
+
+} // End of namespace Sci
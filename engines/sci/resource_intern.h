@@ -154,6 +154,15 @@ public:
 	virtual void loadResource(ResourceManager *resMan, Resource *res);
 
 	virtual uint32 getAudioCompressionType() const;
+
+	/**
+	 * Creates a stream over the data of a resource in this volume, which
+	 * doesn't require the resource to be loaded.
+	 */
+	Common::SeekableReadStream *createReadStream(Resource *res);
+
+protected:
+	bool translateCompressedOffset(int32 offset, int32 &compressedOffset, int32 &compressedEnd) const;
 };
 
 class ExtAudioMapResourceSource : public ResourceSource {
@@ -216,6 +225,56 @@ protected:
 
 #endif
 
+enum ResourceIndexOpType {
+	kResourceIndexAdd = 0,	///< Resource added by a map (addResource())
+	kResourceIndexRelocate	///< Existing volume resource moved to a later map entry
+};
+
+/**
+ * A single change to the resource map made while scanning a map source.
+ */
+struct ResourceIndexOp {
+	ResourceIndexOpType type;
+	ResourceId id;
+	uint32 source;	///< Position of the target source in the source list
+	uint32 offset;
+	uint32 size;
+};
+
+/**
+ * The changes made to the resource map by scanning one map source.
+ */
+struct ResourceIndexBlock {
+	uint32 mapSource;	///< Position of the map source in the source list
+	uint32 stamp;	///< Stamp of the map data and the resource map state before the scan
+	ResVersion mapVersion;	///< Map version after the scan (SCI0 maps may correct it)
+	Common::Array<ResourceIndexOp> ops;
+};
+
+/**
+ * Resource index, as stored in the "<target>.resindex" file. It allows
+ * ResourceManager::init() to skip parsing the resource and audio maps and
+ * detecting the SCI version, when the game files haven't changed since the
+ * previous run.
+ */
+struct ResourceIndex {
+	uint32 baseKey;	///< Hash of the initial sources and their file sizes
+	ResVersion mapVersion;
+	ResVersion volVersion;
+	uint32 fingerprint;	///< Hash of the final resource map, before version detection
+	SciVersion sciVersion;
+	ViewType viewType;
+	Common::Array<uint32> sourceHashes;
+	Common::Array<ResourceIndexBlock> blocks;
+
+	// Only used while recording
+	ResourceSource *lastSource;
+	uint32 lastSourceIndex;
+
+	ResourceIndex() : baseKey(0), mapVersion(kResVersionUnknown), volVersion(kResVersionUnknown),
+		fingerprint(0), sciVersion(SCI_VERSION_NONE), viewType(kViewUnknown), lastSource(0), lastSourceIndex(0) {}
+};
+
 } // End of namespace Sci
 
 #endif // SCI_RESOURCE_INTERN_H
@@ -33,6 +33,7 @@
 #include "sci/event.h"
 
 #include "sci/engine/features.h"
+#include "sci/engine/gc.h"
 #include "sci/engine/message.h"
 #include "sci/engine/object.h"
 #include "sci/engine/state.h"
@@ -568,6 +569,7 @@ bool SciEngine::initGame() {
 
 	_gamestate->_msgState = new MessageState(_gamestate->_segMan);
 	_gamestate->gcCountDown = GC_INTERVAL - 1;
+	_gamestate->_gc->reset();
 
 	// Script 0 should always be at segment 1
 	if (script0Segment != 1) {
@@ -30,6 +30,7 @@
 
 #include "common/file.h"
 #include "common/memstream.h"
+#include "common/substream.h"
 #include "common/system.h"
 
 #include "audio/audiostream.h"
@@ -52,6 +53,7 @@ AudioPlayer::AudioPlayer(ResourceManager *resMan) : _resMan(resMan), _audioRate(
 
 AudioPlayer::~AudioPlayer() {
 	stopAllAudio();
+	purgeSyncCache();
 }
 
 void AudioPlayer::stopAllAudio() {
@@ -297,11 +299,208 @@ static byte *readSOLAudio(Common::SeekableReadStream *audioStream, uint32 &size,
 	return buffer;
 }
 
+/**
+ * Decodes compressed SOL audio while it is being played.
+ */
+class SOLStream : public Audio::SeekableAudioStream {
+public:
+	SOLStream(Common::SeekableReadStream *stream, uint16 rate, byte audioFlags);
+	~SOLStream() { delete _stream; }
+
+	int readBuffer(int16 *buffer, const int numSamples);
+	bool isStereo() const { return false; }
+	int getRate() const { return _rate; }
+	bool endOfData() const { return _pendingNibble < 0 && _stream->pos() >= _stream->size(); }
+	bool seek(const Audio::Timestamp &where);
+	Audio::Timestamp getLength() const { return _length; }
+
+private:
+	Common::SeekableReadStream *_stream;
+	uint16 _rate;
+	bool _is16Bit;
+	bool _isUnsigned;
+	int32 _sample;	///< Current DPCM sample value
+	int _pendingNibble;	///< Second nibble of the last 8-bit byte, or -1
+	Audio::Timestamp _length;
+
+	void reset();
+	int16 convertSample8(byte sample) const;
+};
+
+SOLStream::SOLStream(Common::SeekableReadStream *stream, uint16 rate, byte audioFlags)
+	: _stream(stream), _rate(rate), _length(0, rate) {
+
+	_is16Bit = (audioFlags & kSolFlag16Bit) != 0;
+	_isUnsigned = !(audioFlags & kSolFlagIsSigned);
+
+	// 16-bit DPCM stores one sample per byte, 8-bit DPCM two
+	uint32 sampleCount = _is16Bit ? _stream->size() : _stream->size() * 2;
+	_length = Audio::Timestamp(0, sampleCount, rate);
+
+	reset();
+}
+
+void SOLStream::reset() {
+	_stream->seek(0);
+	_sample = _is16Bit ? 0 : 0x80;
+	_pendingNibble = -1;
+}
+
+int16 SOLStream::convertSample8(byte sample) const {
+	if (_isUnsigned)
+		return (int16)((sample - 128) << 8);
+	return (int16)((int8)sample << 8);
+}
+
+int SOLStream::readBuffer(int16 *buffer, const int numSamples) {
+	byte data[512];
+	int samples = 0;
+
+	while (samples < numSamples) {
+		byte out;
+
+		if (_pendingNibble >= 0) {
+			deDPCM8Nibble(&out, _sample, _pendingNibble);
+			buffer[samples++] = convertSample8(out);
+			_pendingNibble = -1;
+			continue;
+		}
+
+		uint32 wanted = _is16Bit ? numSamples - samples : (numSamples - samples + 1) / 2;
+		uint32 bytesRead = _stream->read(data, MIN<uint32>(wanted, sizeof(data)));
+		if (!bytesRead)
+			break;
+
+		for (uint32 i = 0; i < bytesRead; i++) {
+			byte b = data[i];
+
+			if (_is16Bit) {
+				if (b & 0x80)
+					_sample -= tableDPCM16[b & 0x7f];
+				else
+					_sample += tableDPCM16[b];
+
+				_sample = CLIP<int32>(_sample, -32768, 32767);
+				uint16 value = (uint16)_sample;
+				if (_isUnsigned)
+					value ^= 0x8000;
+				buffer[samples++] = (int16)value;
+			} else {
+				deDPCM8Nibble(&out, _sample, b >> 4);
+				buffer[samples++] = convertSample8(out);
+
+				// An odd request leaves the second nibble for the next call
+				if (samples < numSamples) {
+					deDPCM8Nibble(&out, _sample, b & 0xf);
+					buffer[samples++] = convertSample8(out);
+				} else {
+					_pendingNibble = b & 0xf;
+				}
+			}
+		}
+	}
+
+	return samples;
+}
+
+bool SOLStream::seek(const Audio::Timestamp &where) {
+	uint32 target = where.convertToFramerate(_rate).totalNumberOfFrames();
+	if (target > (uint32)_length.totalNumberOfFrames())
+		return false;
+
+	// DPCM samples depend on all previous ones, so decode up to the target
+	reset();
+
+	int16 scratch[512];
+	while (target > 0) {
+		int samples = readBuffer(scratch, MIN<uint32>(target, ARRAYSIZE(scratch)));
+		if (samples <= 0)
+			return false;
+		target -= samples;
+	}
+
+	return true;
+}
+
 byte *AudioPlayer::getDecodedRobotAudioFrame(Common::SeekableReadStream *str, uint32 encodedSize) {
 	byte flags = 0;
 	return readSOLAudio(str, encodedSize, kSolFlagCompressed | kSolFlag16Bit, flags);
 }
 
+Audio::SeekableAudioStream *AudioPlayer::createAudioVolumeStream(ResourceId id) {
+	Resource *audioRes = _resMan->testResource(id);
+	if (!audioRes)
+		return NULL;
+
+	Common::SeekableReadStream *stream = _resMan->createAudioResourceStream(audioRes);
+	if (!stream)
+		return NULL;
+
+	switch (audioRes->getAudioCompressionType()) {
+	case 0:
+		break;
+#ifdef USE_MAD
+	case MKTAG('M','P','3',' '):
+		return Audio::makeMP3Stream(stream, DisposeAfterUse::YES);
+#endif
+#ifdef USE_VORBIS
+	case MKTAG('O','G','G',' '):
+		return Audio::makeVorbisStream(stream, DisposeAfterUse::YES);
+#endif
+#ifdef USE_FLAC
+	case MKTAG('F','L','A','C'):
+		return Audio::makeFLACStream(stream, DisposeAfterUse::YES);
+#endif
+	default:
+		// No decoder, let the regular code path report it
+		delete stream;
+		return NULL;
+	}
+
+	// WAVE and AIFF data is left to the regular code path
+	uint32 tag = stream->readUint32BE();
+	stream->seek(0);
+	if (tag == MKTAG('R','I','F','F') || tag == MKTAG('F','O','R','M')) {
+		delete stream;
+		return NULL;
+	}
+
+	if (getSciVersion() < SCI_VERSION_1_1) {
+		// SCI1 raw audio
+		_audioRate = 11025;
+		return Audio::makeRawStream(stream, _audioRate, Audio::FLAG_UNSIGNED, DisposeAfterUse::YES);
+	}
+
+	ResourceType type = _resMan->convertResType(stream->readByte());
+	byte headerSize = stream->readByte();
+	uint32 size = 0;
+	byte audioFlags = 0;
+
+	if (type != kResourceTypeAudio || !readSOLHeader(stream, headerSize, size, _audioRate, audioFlags, audioRes->size)) {
+		delete stream;
+		return NULL;
+	}
+
+	uint32 dataOffset = 2 + headerSize;
+	if (!size || dataOffset + size > (uint32)stream->size()) {
+		delete stream;
+		return NULL;
+	}
+
+	Common::SeekableReadStream *dataStream = new Common::SeekableSubReadStream(stream, dataOffset, dataOffset + size, DisposeAfterUse::YES);
+
+	if (audioFlags & kSolFlagCompressed)
+		return new SOLStream(dataStream, _audioRate, audioFlags);
+
+	byte flags = 0;
+	if (audioFlags & kSolFlag16Bit)
+		flags |= Audio::FLAG_16BITS | Audio::FLAG_LITTLE_ENDIAN;
+	if (!(audioFlags & kSolFlagIsSigned))
+		flags |= Audio::FLAG_UNSIGNED;
+
+	return Audio::makeRawStream(dataStream, _audioRate, flags, DisposeAfterUse::YES);
+}
+
 Audio::RewindableAudioStream *AudioPlayer::getAudioStream(uint32 number, uint32 volume, int *sampleLen) {
 	Audio::SeekableAudioStream *audioSeekStream = 0;
 	Audio::RewindableAudioStream *audioStream = 0;
@@ -312,6 +511,18 @@ Audio::RewindableAudioStream *AudioPlayer::getAudioStream(uint32 number, uint32
 
 	*sampleLen = 0;
 
+	// Play directly from the audio volume if possible, so that playback
+	// doesn't have to wait for the whole resource to be loaded and decoded
+	if (volume == 65535)
+		audioSeekStream = createAudioVolumeStream(ResourceId(kResourceTypeAudio, number));
+	else
+		audioSeekStream = createAudioVolumeStream(ResourceId(kResourceTypeAudio36, volume, number));
+
+	if (audioSeekStream) {
+		*sampleLen = (audioSeekStream->getLength().msecs() * 60) / 1000; // we translate msecs to ticks
+		return audioSeekStream;
+	}
+
 	if (volume == 65535) {
 		audioRes = _resMan->findResource(ResourceId(kResourceTypeAudio, number), false);
 		if (!audioRes) {
@@ -440,10 +651,33 @@ Audio::RewindableAudioStream *AudioPlayer::getAudioStream(uint32 number, uint32
 }
 
 void AudioPlayer::setSoundSync(ResourceId id, reg_t syncObjAddr, SegManager *segMan) {
-	_syncResource = _resMan->findResource(id, 1);
+	_syncResource = NULL;
 	_syncOffset = 0;
 
+	// The last few sync resources are kept locked, as lines are often
+	// repeated (e.g. when the player clicks an object again)
+	Resource *cachedResource = _resMan->testResource(id);
+	if (cachedResource) {
+		for (Common::List<Resource *>::iterator it = _syncCache.begin(); it != _syncCache.end(); ++it) {
+			if (*it == cachedResource) {
+				_syncCache.erase(it);
+				_syncResource = cachedResource;
+				break;
+			}
+		}
+	}
+
+	if (!_syncResource) {
+		_syncResource = _resMan->findResource(id, true);
+
+		if (_syncResource && _syncCache.size() >= kSyncCacheSize) {
+			_resMan->unlockResource(_syncCache.back());
+			_syncCache.pop_back();
+		}
+	}
+
 	if (_syncResource) {
+		_syncCache.push_front(_syncResource);
 		writeSelectorValue(segMan, syncObjAddr, SELECTOR(syncCue), 0);
 	} else {
 		warning("setSoundSync: failed to find resource %s", id.toString().c_str());
@@ -470,10 +704,17 @@ void AudioPlayer::doSoundSync(reg_t syncObjAddr, SegManager *segMan) {
 }
 
 void AudioPlayer::stopSoundSync() {
-	if (_syncResource) {
-		_resMan->unlockResource(_syncResource);
-		_syncResource = NULL;
-	}
+	// The resource stays locked in the sync cache
+	_syncResource = NULL;
+}
+
+void AudioPlayer::purgeSyncCache() {
+	stopSoundSync();
+
+	for (Common::List<Resource *>::iterator it = _syncCache.begin(); it != _syncCache.end(); ++it)
+		_resMan->unlockResource(*it);
+
+	_syncCache.clear();
 }
 
 int AudioPlayer::audioCdPlay(int track, int start, int duration) {
@@ -24,11 +24,14 @@
 #ifndef SCI_AUDIO_H
 #define SCI_AUDIO_H
 
+#include "common/list.h"
+
 #include "sci/engine/vm_types.h"
 #include "audio/mixer.h"
 
 namespace Audio {
 class RewindableAudioStream;
+class SeekableAudioStream;
 } // End of namespace Audio
 
 namespace Sci {
@@ -80,6 +83,7 @@ public:
 	void setSoundSync(ResourceId id, reg_t syncObjAddr, SegManager *segMan);
 	void doSoundSync(reg_t syncObjAddr, SegManager *segMan);
 	void stopSoundSync();
+	void purgeSyncCache();
 
 	int audioCdPlay(int track, int start, int duration);
 	void audioCdStop();
@@ -89,12 +93,19 @@ public:
 	void stopAllAudio();
 
 private:
+	enum {
+		kSyncCacheSize = 4 ///< Number of recently used sync resources kept locked
+	};
+
+	Audio::SeekableAudioStream *createAudioVolumeStream(ResourceId id);
+
 	ResourceManager *_resMan;
 	uint16 _audioRate;
 	Audio::SoundHandle _audioHandle;
 	Audio::Mixer *_mixer;
 	Resource *_syncResource; /**< Used by kDoSync for speech syncing in CD talkie games */
 	uint _syncOffset;
+	Common::List<Resource *> _syncCache; /**< Locked sync resources, most recently used first */
 	uint32 _audioCdStart;
 	bool _wPlayFlag;
 };
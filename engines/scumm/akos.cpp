@@ -339,6 +339,8 @@ void AkosRenderer::setCostume(int costume, int shadow) {
 	const byte *akos = _vm->getResourceAddress(rtCostume, costume);
 	assert(akos);
 
+	_costume = costume;
+
 	akhd = (const AkosHeader *) _vm->findResourceData(MKTAG('A','K','H','D'), akos);
 	akof = (const AkosOffset *) _vm->findResourceData(MKTAG('A','K','O','F'), akos);
 	akci = _vm->findResourceData(MKTAG('A','K','C','I'), akos);
@@ -782,6 +784,7 @@ byte AkosRenderer::codec1(int xmoveCur, int ymoveCur) {
 	Common::Rect rect;
 	int step;
 	byte drawFlag = 1;
+	int firstColumn = 0;
 	Codec1 v1;
 
 	const int scaletableSize = (_vm->_game.heversion >= 61) ? 128 : 384;
@@ -947,7 +950,7 @@ byte AkosRenderer::codec1(int xmoveCur, int ymoveCur) {
 
 		if (skip > 0) {
 			v1.skip_width -= skip;
-			codec1_ignorePakCols(v1, skip);
+			firstColumn = skip;
 			v1.x = v1.boundsRect.left;
 		} else {
 			skip = rect.right - v1.boundsRect.right;
@@ -962,7 +965,7 @@ byte AkosRenderer::codec1(int xmoveCur, int ymoveCur) {
 			skip = rect.right - v1.boundsRect.right + 1;
 		if (skip > 0) {
 			v1.skip_width -= skip;
-			codec1_ignorePakCols(v1, skip)	;
+			firstColumn = skip;
 			v1.x = v1.boundsRect.right - 1;
 		} else {
 			skip = (v1.boundsRect.left -1) - rect.left;
@@ -977,6 +980,18 @@ byte AkosRenderer::codec1(int xmoveCur, int ymoveCur) {
 	if (v1.skip_width <= 0 || _height <= 0)
 		return 0;
 
+	// Unscaled cels without shadows are drawn from the cel cache
+	const AkosCachedCel *cel = NULL;
+	if (!use_scaling && !_shadow_mode && !_actorHitMode)
+		cel = getCachedCel(v1);
+
+	// If codec1_ignorePakCols() stops at the start of a run of 256 pixels,
+	// codec1_genericDecode() drops the rest of the run. Keep that behavior.
+	if (cel && cel->longRuns && firstColumn)
+		cel = NULL;
+	if (!cel && firstColumn)
+		codec1_ignorePakCols(v1, firstColumn);
+
 	if (rect.left < v1.boundsRect.left)
 		rect.left = v1.boundsRect.left;
 
@@ -996,11 +1011,175 @@ byte AkosRenderer::codec1(int xmoveCur, int ymoveCur) {
 
 	v1.destptr = (byte *)_out.getBasePtr(v1.x, v1.y);
 
-	codec1_genericDecode(v1);
+	if (cel)
+		drawCachedCel(cel, v1, firstColumn);
+	else
+		codec1_genericDecode(v1);
 
 	return drawFlag;
 }
 
+AkosRenderer::~AkosRenderer() {
+	while (!_celCache.empty())
+		removeCachedCel(_celCache.begin());
+}
+
+const AkosCachedCel *AkosRenderer::getCachedCel(const Codec1 &v1) {
+	AkosCelCacheKey key;
+	key.costume = _costume;
+	key.offset = _srcptr - akcd;
+
+	CelCacheMap::iterator it = _celCache.find(key);
+	if (it != _celCache.end()) {
+		AkosCachedCel *cel = it->_value;
+
+		// The costume may have been reloaded since the cel was decoded
+		if (cel->data == _srcptr && cel->width == _width && cel->height == _height) {
+			_celCacheLRU.erase(cel->lruPos);
+			_celCacheLRU.push_back(key);
+			cel->lruPos = --_celCacheLRU.end();
+			return cel;
+		}
+
+		removeCachedCel(it);
+	}
+
+	// The cache may use up to an eighth of the resource heap
+	const uint32 maxSize = _vm->_res->getMaxHeapThreshold() / 8;
+	if ((uint32)(_width * _height) > maxSize / 4)
+		return NULL;
+
+	AkosCachedCel *cel = decodeCachedCel(v1);
+
+	while (!_celCacheLRU.empty() && _celCacheSize + cel->size > maxSize)
+		removeCachedCel(_celCache.find(_celCacheLRU.front()));
+
+	_celCacheLRU.push_back(key);
+	cel->lruPos = --_celCacheLRU.end();
+	_celCache[key] = cel;
+	_celCacheSize += cel->size;
+	return cel;
+}
+
+AkosCachedCel *AkosRenderer::decodeCachedCel(const Codec1 &v1) {
+	AkosCachedCel *cel = new AkosCachedCel;
+	cel->data = _srcptr;
+	cel->width = _width;
+	cel->height = _height;
+	cel->longRuns = false;
+	cel->pixels = (byte *)calloc(_width * _height, 1);
+	assert(cel->pixels);
+
+	// The cel is run length encoded column by column
+	const byte *src = _srcptr;
+	const int numPixels = _width * _height;
+	int pos = 0;
+	while (pos < numPixels) {
+		byte len = *src++;
+		const byte color = len >> v1.shr;
+		len &= v1.mask;
+		if (!len)
+			len = *src++;
+
+		// A length of 0 stands for 256, like in codec1_genericDecode()
+		int count = len;
+		if (!len) {
+			count = 256;
+			cel->longRuns = true;
+		}
+		if (count > numPixels - pos)
+			count = numPixels - pos;
+
+		if (color) {
+			for (int i = pos; i < pos + count; i++)
+				cel->pixels[(i % _height) * _width + i / _height] = color;
+		}
+		pos += count;
+	}
+
+	// Collect the non-transparent spans of each line
+	for (int y = 0; y < _height; y++) {
+		const byte *line = cel->pixels + y * _width;
+		cel->lines.push_back(cel->spans.size());
+
+		int x = 0;
+		while (x < _width) {
+			if (!line[x]) {
+				x++;
+				continue;
+			}
+
+			AkosCachedCel::Span span;
+			span.x = x;
+			while (x < _width && line[x])
+				x++;
+			span.width = x - span.x;
+			cel->spans.push_back(span);
+		}
+	}
+	cel->lines.push_back(cel->spans.size());
+
+	cel->size = sizeof(AkosCachedCel) + _width * _height +
+		cel->spans.size() * sizeof(AkosCachedCel::Span) + cel->lines.size() * sizeof(uint32);
+	return cel;
+}
+
+void AkosRenderer::drawCachedCel(const AkosCachedCel *cel, const Codec1 &v1, int firstColumn) {
+	const Common::Rect &bounds = v1.boundsRect;
+
+	// Like codec1_genericDecode(), stop at the first column which leaves
+	// the screen
+	int numColumns = v1.skip_width;
+	for (int i = 1; i < numColumns; i++) {
+		const int x = v1.x + i * v1.scaleXstep;
+		if (x < 0 || x >= bounds.right) {
+			numColumns = i;
+			break;
+		}
+	}
+
+	const int xstart = _vm->_virtscr[kMainVirtScreen].xstart;
+	const int bpp = _vm->_bytesPerPixel;
+
+	for (int row = 0; row < cel->height; row++) {
+		const int y = v1.y + row;
+		if (y < bounds.top || y >= bounds.bottom)
+			continue;
+
+		byte *dst = (byte *)_out.getBasePtr(0, y);
+		const byte *mask = _vm->getMaskBuffer(-(xstart & 7), y, _zbuf);
+		const byte *src = cel->pixels + row * cel->width;
+
+		for (uint i = cel->lines[row]; i < cel->lines[row + 1]; i++) {
+			const AkosCachedCel::Span &span = cel->spans[i];
+			const int c1 = MAX<int>(span.x, firstColumn);
+			const int c2 = MIN<int>(span.x + span.width, firstColumn + numColumns);
+
+			for (int c = c1; c < c2; c++) {
+				const int x = v1.x + (c - firstColumn) * v1.scaleXstep;
+				if (x < 0 || x >= bounds.right || (mask[x >> 3] & revBitMask(x & 7)))
+					continue;
+
+				const uint16 pcolor = _palette[src[c]];
+				if (bpp == 2)
+					WRITE_UINT16(dst + x * 2, pcolor);
+				else
+					dst[x] = pcolor;
+			}
+		}
+	}
+}
+
+void AkosRenderer::removeCachedCel(CelCacheMap::iterator it) {
+	AkosCachedCel *cel = it->_value;
+	_celCacheSize -= cel->size;
+	_celCacheLRU.erase(cel->lruPos);
+	_celCache.erase(it);
+
+	free(cel->pixels);
+	delete cel;
+}
+
 void AkosRenderer::markRectAsDirty(Common::Rect rect) {
 	rect.left -= _vm->_virtscr[kMainVirtScreen].xstart & 7;
 	rect.right -= _vm->_virtscr[kMainVirtScreen].xstart & 7;
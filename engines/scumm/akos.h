@@ -23,6 +23,10 @@
 #ifndef SCUMM_AKOS_H
 #define SCUMM_AKOS_H
 
+#include "common/array.h"
+#include "common/hashmap.h"
+#include "common/list.h"
+
 #include "scumm/base-costume.h"
 
 namespace Scumm {
@@ -31,6 +35,44 @@ struct CostumeData;
 struct AkosHeader;
 struct AkosOffset;
 
+struct AkosCelCacheKey {
+	int costume;
+	uint32 offset;	// Offset of the cel data in the AKCD block
+
+	bool operator==(const AkosCelCacheKey &key) const {
+		return costume == key.costume && offset == key.offset;
+	}
+};
+
+struct AkosCelCacheKeyHash {
+	uint operator()(const AkosCelCacheKey &key) const {
+		return (key.costume << 20) ^ key.offset;
+	}
+};
+
+/**
+ * A decoded codec 1 cel. The pixels are stored as color indices, before
+ * the actor palette is applied, so the same entry can be drawn with any
+ * palette and facing. The non-transparent pixels of each line are stored
+ * as spans.
+ */
+struct AkosCachedCel {
+	struct Span {
+		uint16 x;
+		uint16 width;
+	};
+
+	const byte *data;	// Cel data the entry was decoded from
+	int width;
+	int height;
+	bool longRuns;	// Has runs of 256 pixels, see AkosRenderer::codec1()
+	byte *pixels;
+	Common::Array<Span> spans;
+	Common::Array<uint32> lines;	// Index of the first span of each line, plus the end
+	uint32 size;
+	Common::List<AkosCelCacheKey>::iterator lruPos;
+};
+
 class AkosCostumeLoader : public BaseCostumeLoader {
 protected:
 	const byte *_akos;
@@ -73,6 +115,8 @@ protected:
 	const byte *rgbs;		// HE specific: RGB table
 	const uint8 *xmap;		// HE specific: shadow color table
 
+	int _costume;
+
 	struct {
 		bool repeatMode;
 		int repeatCount;
@@ -97,8 +141,11 @@ public:
 		akct = 0;
 		rgbs = 0;
 		xmap = 0;
+		_costume = 0;
 		_actorHitMode = false;
+		_celCacheSize = 0;
 	}
+	~AkosRenderer();
 
 	bool _actorHitMode;
 	int16 _actorHitX, _actorHitY;
@@ -122,6 +169,18 @@ protected:
 	void akos16Decompress(byte *dest, int32 pitch, const byte *src, int32 t_width, int32 t_height, int32 dir, int32 numskip_before, int32 numskip_after, byte transparency, int maskLeft, int maskTop, int zBuf);
 
 	void markRectAsDirty(Common::Rect rect);
+
+	typedef Common::List<AkosCelCacheKey> CelCacheLRU;
+	typedef Common::HashMap<AkosCelCacheKey, AkosCachedCel *, AkosCelCacheKeyHash> CelCacheMap;
+
+	CelCacheMap _celCache;
+	CelCacheLRU _celCacheLRU;	// Least recently used cel first
+	uint32 _celCacheSize;
+
+	const AkosCachedCel *getCachedCel(const Codec1 &v1);
+	AkosCachedCel *decodeCachedCel(const Codec1 &v1);
+	void removeCachedCel(CelCacheMap::iterator it);
+	void drawCachedCel(const AkosCachedCel *cel, const Codec1 &v1, int firstColumn);
 };
 
 } // End of namespace Scumm
@@ -20,6 +20,7 @@
  *
  */
 
+#include "common/algorithm.h"
 #include "common/debug-channels.h"
 #include "common/file.h"
 #include "common/str.h"
@@ -29,14 +30,27 @@
 #include "scumm/actor.h"
 #include "scumm/boxes.h"
 #include "scumm/debugger.h"
+#include "scumm/file.h"
 #include "scumm/imuse/imuse.h"
 #include "scumm/object.h"
 #include "scumm/resource.h"
+#include "scumm/script_profiler.h"
 #include "scumm/scumm.h"
 #include "scumm/sound.h"
 
+#ifdef ENABLE_HE
+#include "scumm/he/intern_he.h"
+#include "scumm/he/wiz_he.h"
+#endif
+#ifdef ENABLE_SCUMM_7_8
+#include "scumm/smush/codec37.h"
+#include "scumm/smush/codec47.h"
+#endif
+
 namespace Scumm {
 
+extern const char *nameOfResType(ResType type);
+
 void debugC(int channel, const char *s, ...) {
 	char buf[STRINGBUFLEN];
 	va_list va;
@@ -97,6 +111,15 @@ ScummDebugger::ScummDebugger(ScummEngine *s)
 	registerCmd("imuse",     WRAP_METHOD(ScummDebugger, Cmd_IMuse));
 
 	registerCmd("resetcursors",    WRAP_METHOD(ScummDebugger, Cmd_ResetCursors));
+
+	registerCmd("resources", WRAP_METHOD(ScummDebugger, Cmd_Resources));
+	registerCmd("profile",   WRAP_METHOD(ScummDebugger, Cmd_Profile));
+#ifdef ENABLE_HE
+	registerCmd("wizcache", WRAP_METHOD(ScummDebugger, Cmd_WizCache));
+#endif
+#ifdef ENABLE_SCUMM_7_8
+	registerCmd("smush_bench", WRAP_METHOD(ScummDebugger, Cmd_SmushBench));
+#endif
 }
 
 ScummDebugger::~ScummDebugger() {
@@ -840,4 +863,303 @@ bool ScummDebugger::Cmd_ResetCursors(int argc, const char **argv) {
 	return false;
 }
 
+bool ScummDebugger::Cmd_Resources(int argc, const char **argv) {
+	ResourceManager *res = _vm->_res;
+
+	if (argc > 1) {
+		if (!strcmp(argv[1], "reset")) {
+			res->resetExpireStats();
+			debugPrintf("Resource statistics reset\n");
+		} else {
+			debugPrintf("Usage: %s [reset]\n", argv[0]);
+		}
+		return true;
+	}
+
+	debugPrintf("Heap: %d bytes allocated, expiring from %d down to %d bytes\n",
+		res->getAllocatedSize(), res->getMaxHeapThreshold(), res->getMinHeapThreshold());
+	debugPrintf("Type          Loaded      Bytes   Locked  Expired Reloaded\n");
+
+	for (ResType type = rtFirst; type <= rtLast; type = ResType(type + 1)) {
+		uint32 loaded = 0, bytes = 0, locked = 0;
+
+		for (ResId idx = 0; idx < res->_types[type].size(); idx++) {
+			const ResourceManager::Resource &tmp = res->_types[type][idx];
+			if (!tmp._address)
+				continue;
+
+			loaded++;
+			bytes += tmp._size;
+			if (tmp.isLocked())
+				locked++;
+		}
+
+		if (!loaded && !res->getExpiredCount(type))
+			continue;
+
+		debugPrintf("%-12s %7d %10d %8d %8d %8d\n", nameOfResType(type), loaded, bytes, locked,
+			res->getExpiredCount(type), res->getReloadCount(type));
+	}
+
+	return true;
+}
+
+static const char *scriptTypeName(byte where) {
+	switch (where) {
+	case WIO_INVENTORY:
+		return "inventory";
+	case WIO_ROOM:
+		return "room";
+	case WIO_GLOBAL:
+		return "global";
+	case WIO_LOCAL:
+		return "local";
+	case WIO_FLOBJECT:
+		return "object";
+	default:
+		return "unknown";
+	}
+}
+
+struct OpcodeTicksGreater {
+	const ScriptProfiler *profiler;
+
+	bool operator()(int a, int b) const {
+		return profiler->getOpcodeStats(a).ticks > profiler->getOpcodeStats(b).ticks;
+	}
+};
+
+bool ScummDebugger::Cmd_Profile(int argc, const char **argv) {
+	if (argc > 1) {
+		if (!strcmp(argv[1], "on")) {
+			if (!_vm->_scriptProfiler)
+				_vm->_scriptProfiler = new ScriptProfiler();
+			_vm->_scriptProfiler->setEnabled(true);
+			debugPrintf("Script profiling enabled\n");
+		} else if (!strcmp(argv[1], "off")) {
+			if (_vm->_scriptProfiler)
+				_vm->_scriptProfiler->setEnabled(false);
+			debugPrintf("Script profiling disabled\n");
+		} else if (!strcmp(argv[1], "reset")) {
+			if (_vm->_scriptProfiler)
+				_vm->_scriptProfiler->reset();
+			debugPrintf("Script profile reset\n");
+		} else if (!strcmp(argv[1], "dump") && argc > 2) {
+			if (!_vm->_scriptProfiler) {
+				debugPrintf("No script profile recorded\n");
+				return true;
+			}
+
+			Common::DumpFile out;
+			if (!out.open(argv[2])) {
+				debugPrintf("Could not open '%s' for writing\n", argv[2]);
+				return true;
+			}
+
+			const ScriptProfiler *profiler = _vm->_scriptProfiler;
+			out.writeString(Common::String::format("kind,type,room,number,name,count,switches,%s\n", ScriptProfiler::getTickUnit()));
+
+			Common::Array<ScriptProfiler::ScriptStats> scripts;
+			profiler->getScriptStats(scripts);
+			for (uint i = 0; i < scripts.size(); i++) {
+				const ScriptProfiler::ScriptStats &stats = scripts[i];
+				out.writeString(Common::String::format("script,%s,%d,%d,,%u,%u,%llu\n", scriptTypeName(stats.where),
+					stats.room, stats.number, stats.opcodes, stats.switches, (unsigned long long)stats.ticks));
+			}
+
+			for (int i = 0; i < 256; i++) {
+				const ScriptProfiler::OpcodeStats &stats = profiler->getOpcodeStats(i);
+				if (!stats.count)
+					continue;
+				out.writeString(Common::String::format("opcode,,,%d,%s,%u,,%llu\n", i, _vm->getOpcodeDesc(i),
+					stats.count, (unsigned long long)stats.ticks));
+			}
+
+			out.finalize();
+			out.close();
+			debugPrintf("Script profile written to '%s'\n", argv[2]);
+		} else {
+			debugPrintf("Usage: %s [on|off|reset|dump <file>]\n", argv[0]);
+		}
+		return true;
+	}
+
+	const ScriptProfiler *profiler = _vm->_scriptProfiler;
+	if (!profiler) {
+		debugPrintf("Script profiling is disabled, use '%s on' to enable it\n", argv[0]);
+		return true;
+	}
+
+	debugPrintf("Script profiling is %s, %u script switches, times in %s\n",
+		profiler->isEnabled() ? "enabled" : "disabled", profiler->getSwitchCount(), ScriptProfiler::getTickUnit());
+
+	const uint kMaxLines = 15;
+
+	Common::Array<ScriptProfiler::ScriptStats> scripts;
+	profiler->getScriptStats(scripts);
+	debugPrintf("Type       Room Script    Opcodes Switches             Time\n");
+	for (uint i = 0; i < scripts.size() && i < kMaxLines; i++) {
+		const ScriptProfiler::ScriptStats &stats = scripts[i];
+		debugPrintf("%-9s %5d %6d %10u %8u %16llu\n", scriptTypeName(stats.where), stats.room, stats.number,
+			stats.opcodes, stats.switches, (unsigned long long)stats.ticks);
+	}
+
+	Common::Array<int> opcodes;
+	for (int i = 0; i < 256; i++) {
+		if (profiler->getOpcodeStats(i).count)
+			opcodes.push_back(i);
+	}
+	OpcodeTicksGreater greater;
+	greater.profiler = profiler;
+	Common::sort(opcodes.begin(), opcodes.end(), greater);
+
+	debugPrintf("Opcode                              Count             Time\n");
+	for (uint i = 0; i < opcodes.size() && i < kMaxLines; i++) {
+		const ScriptProfiler::OpcodeStats &stats = profiler->getOpcodeStats(opcodes[i]);
+		debugPrintf("0x%02x %-25s %10u %16llu\n", opcodes[i], _vm->getOpcodeDesc(opcodes[i]),
+			stats.count, (unsigned long long)stats.ticks);
+	}
+
+	return true;
+}
+
+#ifdef ENABLE_HE
+
+bool ScummDebugger::Cmd_WizCache(int argc, const char **argv) {
+	if (_vm->_game.heversion < 71) {
+		debugPrintf("Command only works with HE71+ games\n");
+		return true;
+	}
+
+	Wiz *wiz = ((ScummEngine_v71he *)_vm)->_wiz;
+
+	if (argc > 1) {
+		if (!strcmp(argv[1], "reset")) {
+			wiz->resetImageCacheStats();
+			debugPrintf("Wiz image cache statistics reset\n");
+		} else {
+			debugPrintf("Usage: %s [reset]\n", argv[0]);
+		}
+		return true;
+	}
+
+	uint entries;
+	uint32 size, hits, misses;
+	wiz->getImageCacheStats(entries, size, hits, misses);
+
+	debugPrintf("Wiz image cache: %d images, %d of %d KB used\n", entries, size / 1024, wiz->getImageCacheMaxSize() / 1024);
+	debugPrintf("Hits: %d, misses: %d\n", hits, misses);
+
+	return true;
+}
+
+#endif
+
+#ifdef ENABLE_SCUMM_7_8
+
+struct SmushBenchFrame {
+	int codec;
+	int width, height;
+	byte *data;
+};
+
+bool ScummDebugger::Cmd_SmushBench(int argc, const char **argv) {
+	if (argc < 2) {
+		debugPrintf("Usage: %s <san file> [<passes>]\n", argv[0]);
+		debugPrintf("Decodes the codec 37 and 47 frames of a SMUSH animation and reports the frame rate\n");
+		return true;
+	}
+
+	int passes = (argc > 2) ? atoi(argv[2]) : 1;
+	if (passes < 1)
+		passes = 1;
+
+	ScummFile file;
+	if (!_vm->openFile(file, argv[1])) {
+		debugPrintf("Can't open %s\n", argv[1]);
+		return true;
+	}
+
+	if (file.readUint32BE() != MKTAG('A','N','I','M')) {
+		debugPrintf("%s is not a SMUSH animation\n", argv[1]);
+		return true;
+	}
+	const int32 animEnd = file.readUint32BE() + file.pos();
+
+	// Load all frame objects first, so the file access isn't measured
+	Common::Array<SmushBenchFrame> frames;
+	while (file.pos() + 8 <= animEnd && !file.eos()) {
+		const uint32 type = file.readUint32BE();
+		const int32 size = file.readUint32BE();
+		const int32 offset = file.pos();
+
+		if (type == MKTAG('F','R','M','E')) {
+			while (file.pos() + 8 <= offset + size) {
+				const uint32 subType = file.readUint32BE();
+				const int32 subSize = file.readUint32BE();
+				const int32 subOffset = file.pos();
+
+				if (subType == MKTAG('F','O','B','J') && subSize > 14) {
+					SmushBenchFrame frame;
+					frame.codec = file.readUint16LE();
+					file.skip(4);
+					frame.width = file.readUint16LE();
+					frame.height = file.readUint16LE();
+					file.skip(4);
+
+					if (frame.codec == 37 || frame.codec == 47) {
+						frame.data = (byte *)malloc(subSize - 14);
+						assert(frame.data);
+						file.read(frame.data, subSize - 14);
+						frames.push_back(frame);
+					}
+				}
+
+				file.seek(subOffset + subSize + (subSize & 1), SEEK_SET);
+			}
+		}
+
+		file.seek(offset + size, SEEK_SET);
+	}
+
+	if (frames.empty()) {
+		debugPrintf("%s has no codec 37 or 47 frames\n", argv[1]);
+		return true;
+	}
+
+	byte *dst = (byte *)malloc(frames[0].width * frames[0].height);
+	assert(dst);
+
+	uint32 decoded = 0;
+	const uint32 startTime = _vm->_system->getMillis();
+	for (int pass = 0; pass < passes; pass++) {
+		// SmushPlayer creates the decoders for the size of the first frame
+		Codec37Decoder codec37(frames[0].width, frames[0].height);
+		Codec47Decoder codec47(frames[0].width, frames[0].height);
+
+		for (uint i = 0; i < frames.size(); i++) {
+			if (frames[i].width != frames[0].width || frames[i].height != frames[0].height)
+				continue;
+
+			if (frames[i].codec == 37)
+				codec37.decode(dst, frames[i].data);
+			else
+				codec47.decode(dst, frames[i].data);
+			decoded++;
+		}
+	}
+	const uint32 time = MAX<uint32>(_vm->_system->getMillis() - startTime, 1);
+
+	debugPrintf("Decoded %d frames of %dx%d in %d ms: %.2f frames/sec\n", decoded, frames[0].width, frames[0].height,
+		time, decoded * 1000.0 / time);
+
+	free(dst);
+	for (uint i = 0; i < frames.size(); i++)
+		free(frames[i].data);
+
+	return true;
+}
+
+#endif
+
 } // End of namespace Scumm
@@ -69,6 +69,17 @@ private:
 
 	bool Cmd_ResetCursors(int argc, const char **argv);
 
+	bool Cmd_Resources(int argc, const char **argv);
+	bool Cmd_Profile(int argc, const char **argv);
+
+#ifdef ENABLE_HE
+	bool Cmd_WizCache(int argc, const char **argv);
+#endif
+
+#ifdef ENABLE_SCUMM_7_8
+	bool Cmd_SmushBench(int argc, const char **argv);
+#endif
+
 	void printBox(int box);
 	void drawBox(int box);
 };
@@ -46,6 +46,10 @@ extern "C" void asmDrawStripToScreen(int height, int width, void const* text, vo
 extern "C" void asmCopy8Col(byte* dst, int dstPitch, const byte* src, int height, uint8 bitDepth);
 #endif /* USE_ARM_GFX_ASM */
 
+#ifdef USE_SSE2_GFX
+#include <emmintrin.h>
+#endif
+
 namespace Scumm {
 
 static void blit(byte *dst, int dstPitch, const byte *src, int srcPitch, int w, int h, uint8 bitDepth);
@@ -684,6 +688,30 @@ void ScummEngine::drawStripToScreen(VirtScreen *vs, int x, int width, int top, i
 		} else {
 #ifdef USE_ARM_GFX_ASM
 			asmDrawStripToScreen(height, width, text, src, _compositeBuf, vs->pitch, width, _textSurface.pitch);
+#elif defined(USE_SSE2_GFX)
+			// We blit sixteen pixels at a time, picking the game graphics
+			// wherever the text pixel is CHARSET_MASK_TRANSPARENCY, just
+			// like the generic code below.
+			const byte *src8 = (const byte *)src;
+			const byte *text8 = (const byte *)text;
+			byte *dst8 = _compositeBuf;
+
+			const int rowWidth = width * m;
+			const __m128i transparency = _mm_set1_epi8((char)CHARSET_MASK_TRANSPARENCY);
+			for (int h = height * m; h > 0; --h) {
+				int w = 0;
+				for (; w + 16 <= rowWidth; w += 16) {
+					__m128i temp = _mm_loadu_si128((const __m128i *)(text8 + w));
+					__m128i mask = _mm_cmpeq_epi8(temp, transparency);
+					__m128i pixels = _mm_loadu_si128((const __m128i *)(src8 + w));
+					_mm_storeu_si128((__m128i *)(dst8 + w), _mm_or_si128(_mm_and_si128(mask, pixels), _mm_andnot_si128(mask, temp)));
+				}
+				for (; w < rowWidth; ++w)
+					dst8[w] = (text8[w] == CHARSET_MASK_TRANSPARENCY) ? src8[w] : text8[w];
+				src8 += rowWidth + vsPitch;
+				text8 += _textSurface.pitch;
+				dst8 += rowWidth;
+			}
 #else
 			// We blit four pixels at a time, for improved performance.
 			const uint32 *src32 = (const uint32 *)src;
@@ -78,7 +78,6 @@ private:
 	int addFromCollisionTreeNode(int index, int parent, uint32 *indices, int objIndexBase);
 	void addCollisionObj(byte objId);
 	int findCollisionWith(int objId, float inX, float inY, float inZ, float inXVec, float inYVec, float inZVec, float &collideX, float &collideY, float &collideZ, int indexArrayId, int dataArrayId, float *nextVelX, float *nextVelY, float *nextVelZ, float *a15);
-	void getPointsForFace(int faceId, float &x1, float &y1, float &z1, float &x2, float &y2, float &z2, float &x3, float &y3, float &z3, float &x4, float &y4, float &z4, const int *objPoints);
 	void crossProduct(float x1, float y1, float z1, float x2, float y2, float z2, float x3, float y3, float z3, float x4, float y4, float z4, float &outX, float &outY, float &outZ);
 	double dotProduct(float a1, float a2, float a3, float a4, float a5, float a6);
 	void sortCollisionList(float *data, int numEntries, int entrySize, int compareOn);
@@ -91,6 +90,27 @@ private:
 
 	// op_1021 can (optionally) set two variables for use in op_1008
 	uint32 _var1021[2];
+
+	// findCollisionWith tests the trajectory against the 6 faces of
+	// each collision object. Everything that only depends on the face
+	// itself is kept here, so it is only recomputed when the points of
+	// the object change.
+	struct CollisionFace {
+		float x1, y1, z1, x2, y2, z2, x3, y3, z3, x4, y4, z4;
+		float xMult, yMult, zMult; // unit normal of the face
+		double angle1, angle4; // angle of the face at points 1 and 4
+		double len21, len31, len24, len34; // lengths of the face edges
+	};
+
+	struct CollisionObject {
+		bool valid;
+		int objPoints[24];
+		CollisionFace faces[6];
+	};
+
+	// indexed by collision object id
+	CollisionObject *_collisionObjCache;
+	const CollisionObject &getCollisionObject(int objId, int indexArrayId, int dataArrayId);
 };
 
 int LogicHEsoccer::versionID() {
@@ -101,11 +121,15 @@ LogicHEsoccer::LogicHEsoccer(ScummEngine_v90he *vm) : LogicHE(vm) {
 	_userDataD = (double *)calloc(1732, sizeof(double));
 	_collisionTree = 0;
 	_collisionTreeAllocated = false;
+	_collisionObjCache = new CollisionObject[256];
+	for (int i = 0; i < 256; i++)
+		_collisionObjCache[i].valid = false;
 }
 
 LogicHEsoccer::~LogicHEsoccer() {
 	free(_userDataD);
 	delete[] _collisionTree;
+	delete[] _collisionObjCache;
 }
 
 int32 LogicHEsoccer::dispatch(int op, int numArgs, int32 *args) {
@@ -181,6 +205,9 @@ void LogicHEsoccer::initOnce() {
 	// The original sets some paths here that we don't need to worry about
 	_collisionTreeAllocated = false;
 	_userDataD[530] = 0;
+
+	for (int i = 0; i < 256; i++)
+		_collisionObjCache[i].valid = false;
 }
 
 int LogicHEsoccer::startOfFrame() {
@@ -837,44 +864,23 @@ int LogicHEsoccer::findCollisionWith(int objId, float inX, float inY, float inZ,
 		inYVec = ABS((int)inYVec);
 	}
 
-	// get the 8 points which define the 6 faces of this object
-	int objIndex = getFromArray(indexArrayId, 0, 4 * objId - 1);
-	int objPoints[24];
-	for (int i = 0; i < 24; i++)
-		objPoints[i] = getFromArray(dataArrayId, 0, objIndex + i);
+	const CollisionObject &obj = getCollisionObject(objId, indexArrayId, dataArrayId);
 
 	for (int faceId = 0; faceId < 6; faceId++) {
-		// This assigns variables from objPoints based on faceId
-		float x1, y1, z1, x2, y2, z2, x3, y3, z3, x4, y4, z4;
-		float faceCrossX, faceCrossY, faceCrossZ;
-		getPointsForFace(faceId, x1, y1, z1, x2, y2, z2, x3, y3, z3, x4, y4, z4, objPoints);
-		crossProduct(x1, y1, z1, x2, y2, z2, x1, y1, z1, x3, y3, z3, faceCrossX, faceCrossY, faceCrossZ);
-
-		float faceArea = sqrt(faceCrossX * faceCrossX + faceCrossY * faceCrossY + faceCrossZ * faceCrossZ);
-
-		// The original did not initialize these variables and would
-		// use them uninitialized if faceArea == 0.0
-		float xMult = 0.0, yMult = 0.0, zMult = 0.0;
-
-		if (faceArea != 0.0) {
-			// UnitCross = Cross/||Cross||
-			xMult = faceCrossX / faceArea;
-			yMult = faceCrossY / faceArea;
-			zMult = faceCrossZ / faceArea;
-		}
+		const CollisionFace &face = obj.faces[faceId];
 		double scalingMult = 5.0;
 
-		float ZToFacePoint1 = z1 - inZ;
-		float YToFacePoint1 = y1 - inY_plus1;
-		float XToFacePoint1 = x1 - inX;
+		float ZToFacePoint1 = face.z1 - inZ;
+		float YToFacePoint1 = face.y1 - inY_plus1;
+		float XToFacePoint1 = face.x1 - inX;
 		// scalar component of UnitCross in direction of (start -> P1)
-		double ToFacePoint1 = dotProduct(xMult, yMult, zMult, XToFacePoint1, YToFacePoint1, ZToFacePoint1);
+		double ToFacePoint1 = dotProduct(face.xMult, face.yMult, face.zMult, XToFacePoint1, YToFacePoint1, ZToFacePoint1);
 
 		float ZToDest = destZ - inZ;
 		float YToDest = destY - inY_plus1;
 		float XToDest = destX - inX;
 		// scalar component of UnitCross in direction of (start -> dest)
-		double ToDest = dotProduct(xMult, yMult, zMult, XToDest, YToDest, ZToDest);
+		double ToDest = dotProduct(face.xMult, face.yMult, face.zMult, XToDest, YToDest, ZToDest);
 
 		if (fabs(ToDest) > 0.00000001)
 			scalingMult = ToFacePoint1 / ToDest;
@@ -886,60 +892,44 @@ int LogicHEsoccer::findCollisionWith(int objId, float inX, float inY, float inZ,
 			double collisionZ = inZ + (destZ - inZ) * scalingMult;
 
 			// now we need to work out whether this point is actually inside the face
-			double dot1 = dotProduct(x2 - x1, y2 - y1, z2 - z1, x3 - x1, y3 - y1, z3 - z1);
-			double sqrt1 = vectorLength(x2 - x1, y2 - y1, z2 - z1);
-			double num1 = dot1 / (vectorLength(x3 - x1, y3 - y1, z3 - z1) * sqrt1);
-			num1 = CLIP<double>(num1, -1.0, 1.0);
-			double faceAngle = acos(num1);
-
-			double dot2 = dotProduct(x2 - x1, y2 - y1, z2 - z1, collisionX - x1, collisionY - y1, collisionZ - z1);
-			double sqrt2 = vectorLength(x2 - x1, y2 - y1, z2 - z1);
-			double num2 = dot2 / (vectorLength(collisionX - x1, collisionY - y1, collisionZ - z1) * sqrt2);
+			double dot2 = dotProduct(face.x2 - face.x1, face.y2 - face.y1, face.z2 - face.z1, collisionX - face.x1, collisionY - face.y1, collisionZ - face.z1);
+			double num2 = dot2 / (vectorLength(collisionX - face.x1, collisionY - face.y1, collisionZ - face.z1) * face.len21);
 			num2 = CLIP<double>(num2, -1.0, 1.0);
 			double angle1 = acos(num2);
 
-			double dot3 = dotProduct(x3 - x1, y3 - y1, z3 - z1, collisionX - x1, collisionY - y1, collisionZ - z1);
-			double sqrt3 = vectorLength(x3 - x1, y3 - y1, z3 - z1);
-			double num3 = dot3 / (vectorLength(collisionX - x1, collisionY - y1, collisionZ - z1) * sqrt3);
+			double dot3 = dotProduct(face.x3 - face.x1, face.y3 - face.y1, face.z3 - face.z1, collisionX - face.x1, collisionY - face.y1, collisionZ - face.z1);
+			double num3 = dot3 / (vectorLength(collisionX - face.x1, collisionY - face.y1, collisionZ - face.z1) * face.len31);
 			num3 = CLIP<double>(num3, -1.0, 1.0);
 			double angle2 = acos(num3);
 
-			if (angle1 + angle2 - 0.001 <= faceAngle) {
-				double dot4 = dotProduct(x2 - x4, y2 - y4, z2 - z4, x3 - x4, y3 - y4, z3 - z4);
-				double sqrt4 = vectorLength(x2 - x4, y2 - y4, z2 - z4);
-				double num4 = dot4 / (vectorLength(x3 - x4, y3 - y4, z3 - z4) * sqrt4);
-				num4 = CLIP<double>(num4, -1.0, 1.0);
-				faceAngle = acos(num4);
-
-				double dot5 = dotProduct(x2 - x4, y2 - y4, z2 - z4, collisionX - x4, collisionY - y4, collisionZ - z4);
-				double sqrt5 = vectorLength(x2 - x4, y2 - y4, z2 - z4);
-				double num5 = dot5 / (vectorLength(collisionX - x4, collisionY - y4, collisionZ - z4) * sqrt5);
+			if (angle1 + angle2 - 0.001 <= face.angle1) {
+				double dot5 = dotProduct(face.x2 - face.x4, face.y2 - face.y4, face.z2 - face.z4, collisionX - face.x4, collisionY - face.y4, collisionZ - face.z4);
+				double num5 = dot5 / (vectorLength(collisionX - face.x4, collisionY - face.y4, collisionZ - face.z4) * face.len24);
 				num5 = CLIP<double>(num5, -1.0, 1.0);
 				double angle3 = acos(num5);
 
-				double dot6 = dotProduct(x3 - x4, y3 - y4, z3 - z4, collisionX - x4, collisionY - y4, collisionZ - z4);
-				double sqrt6 = vectorLength(x3 - x4, y3 - y4, z3 - z4);
-				double num6 = dot6 / (vectorLength(collisionX - x4, collisionY - y4, collisionZ - z4) * sqrt6);
+				double dot6 = dotProduct(face.x3 - face.x4, face.y3 - face.y4, face.z3 - face.z4, collisionX - face.x4, collisionY - face.y4, collisionZ - face.z4);
+				double num6 = dot6 / (vectorLength(collisionX - face.x4, collisionY - face.y4, collisionZ - face.z4) * face.len34);
 				num6 = CLIP<double>(num6, -1.0, 1.0);
 				double angle4 = acos(num6);
 
-				if (angle3 + angle4 - 0.001 <= faceAngle) {
+				if (angle3 + angle4 - 0.001 <= face.angle4) {
 					// found a collision with this face
 					if (foundCollision) {
 						// if we already found one, is the new one closer?
 						// (except this don't adjust for the modification of collideX/Y/Z..)
 						double ToCollide = vectorLength(inX - collisionX, inY_plus1 - collisionY, inZ - collisionZ);
 						if (vectorLength(inX - collideX, inY_plus1 - collideY, inZ - collideZ) > ToCollide) {
-							collideX = collisionX - xMult * 3.0;
-							collideY = collisionY - yMult * 3.0;
-							collideZ = collisionZ - zMult * 3.0;
-							op_1005(xMult, yMult, zMult, inXVec, inYVec, inZVec, nextVelX, nextVelY, nextVelZ, a15);
+							collideX = collisionX - face.xMult * 3.0;
+							collideY = collisionY - face.yMult * 3.0;
+							collideZ = collisionZ - face.zMult * 3.0;
+							op_1005(face.xMult, face.yMult, face.zMult, inXVec, inYVec, inZVec, nextVelX, nextVelY, nextVelZ, a15);
 						}
 					} else {
-						collideX = collisionX - xMult * 3.0;
-						collideY = collisionY - yMult * 3.0;
-						collideZ = collisionZ - zMult * 3.0;
-						op_1005(xMult, yMult, zMult, inXVec, inYVec, inZVec, nextVelX, nextVelY, nextVelZ, a15);
+						collideX = collisionX - face.xMult * 3.0;
+						collideY = collisionY - face.yMult * 3.0;
+						collideZ = collisionZ - face.zMult * 3.0;
+						op_1005(face.xMult, face.yMult, face.zMult, inXVec, inYVec, inZVec, nextVelX, nextVelY, nextVelZ, a15);
 					}
 
 					foundCollision = 1;
@@ -951,96 +941,79 @@ int LogicHEsoccer::findCollisionWith(int objId, float inX, float inY, float inZ,
 	return foundCollision;
 }
 
-void LogicHEsoccer::getPointsForFace(int faceId, float &x1, float &y1, float &z1, float &x2, float &y2, float &z2, float &x3, float &y3, float &z3, float &x4, float &y4, float &z4, const int *objPoints) {
-	// Note that this originally returned a value, but said value was never used
-	// TODO: This can probably be shortened using a few tables...
-
-	switch (faceId) {
-	case 0:
-		x1 = objPoints[0];
-		y1 = objPoints[1];
-		z1 = objPoints[2];
-		x2 = objPoints[3];
-		y2 = objPoints[4];
-		z2 = objPoints[5];
-		x3 = objPoints[6];
-		y3 = objPoints[7];
-		z3 = objPoints[8];
-		x4 = objPoints[9];
-		y4 = objPoints[10];
-		z4 = objPoints[11];
-		break;
-	case 1:
-		x1 = objPoints[0];
-		y1 = objPoints[1];
-		z1 = objPoints[2];
-		x2 = objPoints[6];
-		y2 = objPoints[7];
-		z2 = objPoints[8];
-		x3 = objPoints[12];
-		y3 = objPoints[13];
-		z3 = objPoints[14];
-		x4 = objPoints[18];
-		y4 = objPoints[19];
-		z4 = objPoints[20];
-		break;
-	case 2:
-		x1 = objPoints[3];
-		y1 = objPoints[4];
-		z1 = objPoints[5];
-		x2 = objPoints[15];
-		y2 = objPoints[16];
-		z2 = objPoints[17];
-		x3 = objPoints[9];
-		y3 = objPoints[10];
-		z3 = objPoints[11];
-		x4 = objPoints[21];
-		y4 = objPoints[22];
-		z4 = objPoints[23];
-		break;
-	case 3:
-		x1 = objPoints[0];
-		y1 = objPoints[1];
-		z1 = objPoints[2];
-		x2 = objPoints[12];
-		y2 = objPoints[13];
-		z2 = objPoints[14];
-		x3 = objPoints[3];
-		y3 = objPoints[4];
-		z3 = objPoints[5];
-		x4 = objPoints[15];
-		y4 = objPoints[16];
-		z4 = objPoints[17];
-		break;
-	case 4:
-		x1 = objPoints[6];
-		y1 = objPoints[7];
-		z1 = objPoints[8];
-		x2 = objPoints[9];
-		y2 = objPoints[10];
-		z2 = objPoints[11];
-		x3 = objPoints[18];
-		y3 = objPoints[19];
-		z3 = objPoints[20];
-		x4 = objPoints[21];
-		y4 = objPoints[22];
-		z4 = objPoints[23];
-		break;
-	case 5:
-		x1 = objPoints[15];
-		y1 = objPoints[16];
-		z1 = objPoints[17];
-		x2 = objPoints[12];
-		y2 = objPoints[13];
-		z2 = objPoints[14];
-		x3 = objPoints[21];
-		y3 = objPoints[22];
-		z3 = objPoints[23];
-		x4 = objPoints[18];
-		y4 = objPoints[19];
-		z4 = objPoints[20];
-		break;
+const LogicHEsoccer::CollisionObject &LogicHEsoccer::getCollisionObject(int objId, int indexArrayId, int dataArrayId) {
+	// The 4 points (indexes into the 8 object points) that define each face
+	static const int facePoints[6][4] = {
+		{ 0, 1, 2, 3 },
+		{ 0, 2, 4, 6 },
+		{ 1, 5, 3, 7 },
+		{ 0, 4, 1, 5 },
+		{ 2, 3, 6, 7 },
+		{ 5, 4, 7, 6 }
+	};
+
+	// get the 8 points which define the 6 faces of this object
+	int objIndex = getFromArray(indexArrayId, 0, 4 * objId - 1);
+	int objPoints[24];
+	for (int i = 0; i < 24; i++)
+		objPoints[i] = getFromArray(dataArrayId, 0, objIndex + i);
+
+	// The scripts are free to move the objects around, so the points are
+	// always fetched and only the derived face data is reused
+	CollisionObject &obj = _collisionObjCache[objId & 0xff];
+	if (obj.valid && !memcmp(obj.objPoints, objPoints, sizeof(objPoints)))
+		return obj;
+
+	memcpy(obj.objPoints, objPoints, sizeof(objPoints));
+	obj.valid = true;
+
+	for (int faceId = 0; faceId < 6; faceId++) {
+		CollisionFace &face = obj.faces[faceId];
+		const int *p1 = &objPoints[facePoints[faceId][0] * 3];
+		const int *p2 = &objPoints[facePoints[faceId][1] * 3];
+		const int *p3 = &objPoints[facePoints[faceId][2] * 3];
+		const int *p4 = &objPoints[facePoints[faceId][3] * 3];
+
+		face.x1 = p1[0]; face.y1 = p1[1]; face.z1 = p1[2];
+		face.x2 = p2[0]; face.y2 = p2[1]; face.z2 = p2[2];
+		face.x3 = p3[0]; face.y3 = p3[1]; face.z3 = p3[2];
+		face.x4 = p4[0]; face.y4 = p4[1]; face.z4 = p4[2];
+
+		float faceCrossX, faceCrossY, faceCrossZ;
+		crossProduct(face.x1, face.y1, face.z1, face.x2, face.y2, face.z2, face.x1, face.y1, face.z1, face.x3, face.y3, face.z3, faceCrossX, faceCrossY, faceCrossZ);
+
+		float faceArea = sqrt(faceCrossX * faceCrossX + faceCrossY * faceCrossY + faceCrossZ * faceCrossZ);
+
+		// The original did not initialize these variables and would
+		// use them uninitialized if faceArea == 0.0
+		face.xMult = 0.0;
+		face.yMult = 0.0;
+		face.zMult = 0.0;
+
+		if (faceArea != 0.0) {
+			// UnitCross = Cross/||Cross||
+			face.xMult = faceCrossX / faceArea;
+			face.yMult = faceCrossY / faceArea;
+			face.zMult = faceCrossZ / faceArea;
+		}
+
+		face.len21 = vectorLength(face.x2 - face.x1, face.y2 - face.y1, face.z2 - face.z1);
+		face.len31 = vectorLength(face.x3 - face.x1, face.y3 - face.y1, face.z3 - face.z1);
+		face.len24 = vectorLength(face.x2 - face.x4, face.y2 - face.y4, face.z2 - face.z4);
+		face.len34 = vectorLength(face.x3 - face.x4, face.y3 - face.y4, face.z3 - face.z4);
+
+		double dot1 = dotProduct(face.x2 - face.x1, face.y2 - face.y1, face.z2 - face.z1, face.x3 - face.x1, face.y3 - face.y1, face.z3 - face.z1);
+		double num1 = dot1 / (face.len31 * face.len21);
+		num1 = CLIP<double>(num1, -1.0, 1.0);
+		face.angle1 = acos(num1);
+
+		double dot4 = dotProduct(face.x2 - face.x4, face.y2 - face.y4, face.z2 - face.z4, face.x3 - face.x4, face.y3 - face.y4, face.z3 - face.z4);
+		double num4 = dot4 / (face.len34 * face.len24);
+		num4 = CLIP<double>(num4, -1.0, 1.0);
+		face.angle4 = acos(num4);
 	}
+
+	return obj;
 }
 
 void LogicHEsoccer::crossProduct(float x1, float y1, float z1, float x2, float y2, float z2, float x3, float y3, float z3, float x4, float y4, float z4, float &outX, float &outY, float &outZ) {
@@ -1057,6 +1030,10 @@ void LogicHEsoccer::sortCollisionList(float *data, int numEntries, int entrySize
 	// This takes an input array of collisions, and tries to sort it based on the distance
 	// (index of compareOn, always 1), copying in groups of entrySize, which is always 8
 
+	// Note that entry is never reset, so this is a single bubble pass which
+	// only moves the furthest collision to the end of the list. op_1014 picks
+	// entries by position afterwards, so this must not become a real sort.
+
 	bool found = true;
 	int entry = 0;
 
@@ -22,6 +22,9 @@
 
 #ifdef ENABLE_HE
 
+#include "common/algorithm.h"
+#include "common/func.h"
+
 #include "scumm/he/intern_he.h"
 #include "scumm/resource.h"
 #include "scumm/saveload.h"
@@ -38,13 +41,19 @@ Sprite::Sprite(ScummEngine_v90he *vm)
 	_vm(vm),
 	_spriteGroups(0),
 	_spriteTable(0),
-	_activeSpritesTable(0) {
+	_activeSpritesTable(0),
+	_indexWidth(0),
+	_indexHeight(0),
+	_indexedCells(0),
+	_activeSpritePos(0) {
 }
 
 Sprite::~Sprite() {
 	free(_spriteGroups);
 	free(_spriteTable);
 	free(_activeSpritesTable);
+	delete[] _indexedCells;
+	free(_activeSpritePos);
 }
 
 void ScummEngine_v90he::allocateArrays() {
@@ -103,109 +112,141 @@ void Sprite::getSpriteBounds(int spriteId, bool checkGroup, Common::Rect &bound)
 //
 int Sprite::findSpriteWithClassOf(int x_pos, int y_pos, int spriteGroupId, int type, int num, int *args) {
 	debug(2, "findSprite: x %d, y %d, spriteGroup %d, type %d, num %d", x_pos, y_pos, spriteGroupId, type, num);
+
+	// Only sprites whose bounding box contains the position can be hit,
+	// unless they are tested against a mask image
+	Common::Array<int> candidates;
+	Common::Rect cells;
+	getIndexCells(x_pos, y_pos, x_pos, y_pos, cells);
+
+	const Common::Array<uint16> &cell = _indexCells[cells.top * _indexWidth + cells.left];
+	for (uint i = 0; i < cell.size(); i++) {
+		if (_activeSpritePos[cell[i]] >= 0)
+			candidates.push_back(_activeSpritePos[cell[i]]);
+	}
+	if (!type) {
+		for (uint i = 0; i < _maskedSprites.size(); i++) {
+			if (_activeSpritePos[_maskedSprites[i]] >= 0)
+				candidates.push_back(_activeSpritePos[_maskedSprites[i]]);
+		}
+	}
+
+	// Test the candidates from the top to the bottom, like the sprites are drawn
+	Common::sort(candidates.begin(), candidates.end(), Common::Greater<int>());
+
+	for (uint i = 0; i < candidates.size(); i++) {
+		if (i > 0 && candidates[i] == candidates[i - 1])
+			continue;
+
+		SpriteInfo *spi = _activeSpritesTable[candidates[i]];
+		if (hitTestSprite(spi, x_pos, y_pos, spriteGroupId, type, num, args))
+			return spi->id;
+	}
+
+	return 0;
+}
+
+bool Sprite::hitTestSprite(SpriteInfo *spi, int x_pos, int y_pos, int spriteGroupId, int type, int num, int *args) {
 	Common::Point pos[1];
 	bool cond;
 	int code, classId;
 
-	for (int i = (_numSpritesToProcess - 1); i >= 0; i--) {
-		SpriteInfo *spi = _activeSpritesTable[i];
-		if (!spi->curImage)
-			continue;
+	if (!spi->curImage)
+		return false;
 
-		if (spriteGroupId && spi->group != spriteGroupId)
-			continue;
+	if (spriteGroupId && spi->group != spriteGroupId)
+		return false;
 
-		cond = true;
-		for (int j = 0; j < num; j++) {
-			code = classId = args[j];
-			classId &= 0x7F;
-			assertRange(1, classId, 32, "class");
-			if (code & 0x80) {
-				if (!(spi->classFlags & (1 << (classId - 1))))
-					cond = 0;
-			} else {
-				if ((spi->classFlags & (1 << (classId - 1))))
-					cond = 0;
-			}
+	cond = true;
+	for (int j = 0; j < num; j++) {
+		code = classId = args[j];
+		classId &= 0x7F;
+		assertRange(1, classId, 32, "class");
+		if (code & 0x80) {
+			if (!(spi->classFlags & (1 << (classId - 1))))
+				cond = 0;
+		} else {
+			if ((spi->classFlags & (1 << (classId - 1))))
+				cond = 0;
 		}
-		if (!cond)
-			continue;
+	}
+	if (!cond)
+		return false;
+
+	if (type) {
+		if (spi->bbox.left > spi->bbox.right)
+			return false;
+		if (spi->bbox.top > spi->bbox.bottom)
+			return false;
+		if (spi->bbox.left > x_pos)
+			return false;
+		if (spi->bbox.top > y_pos)
+			return false;
+		if (spi->bbox.right < x_pos)
+			return false;
+		if (spi->bbox.bottom < y_pos)
+			return false;
+		return true;
+	} else {
+		int image, imageState, angle, scale;
+		int32 w, h;
 
-		if (type) {
+		image = spi->curImage;
+		if (spi->maskImage) {
+			int32 x1, x2, y1, y2;
+
+			image = spi->maskImage;
+			imageState = spi->curImageState % _vm->_wiz->getWizImageStates(spi->maskImage);
+
+			pos[0].x = x_pos - spi->pos.x;
+			pos[0].y = y_pos - spi->pos.y;
+
+			_vm->_wiz->getWizImageSpot(spi->curImage, imageState, x1, y1);
+			_vm->_wiz->getWizImageSpot(spi->maskImage, imageState, x2, y2);
+
+			pos[0].x += (x2 - x1);
+			pos[0].y += (y2 - y1);
+		} else {
 			if (spi->bbox.left > spi->bbox.right)
-				continue;
+				return false;
 			if (spi->bbox.top > spi->bbox.bottom)
-				continue;
+				return false;
 			if (spi->bbox.left > x_pos)
-				continue;
+				return false;
 			if (spi->bbox.top > y_pos)
-				continue;
+				return false;
 			if (spi->bbox.right < x_pos)
-				continue;
+				return false;
 			if (spi->bbox.bottom < y_pos)
-				continue;
-			return spi->id;
-		} else {
-			int image, imageState, angle, scale;
-			int32 w, h;
-
-			image = spi->curImage;
-			if (spi->maskImage) {
-				int32 x1, x2, y1, y2;
+				return false;
 
-				image = spi->maskImage;
-				imageState = spi->curImageState % _vm->_wiz->getWizImageStates(spi->maskImage);
-
-				pos[0].x = x_pos - spi->pos.x;
-				pos[0].y = y_pos - spi->pos.y;
-
-				_vm->_wiz->getWizImageSpot(spi->curImage, imageState, x1, y1);
-				_vm->_wiz->getWizImageSpot(spi->maskImage, imageState, x2, y2);
-
-				pos[0].x += (x2 - x1);
-				pos[0].y += (y2 - y1);
-			} else {
-				if (spi->bbox.left > spi->bbox.right)
-					continue;
-				if (spi->bbox.top > spi->bbox.bottom)
-					continue;
-				if (spi->bbox.left > x_pos)
-					continue;
-				if (spi->bbox.top > y_pos)
-					continue;
-				if (spi->bbox.right < x_pos)
-					continue;
-				if (spi->bbox.bottom < y_pos)
-					continue;
+			pos[0].x = x_pos - spi->pos.x;
+			pos[0].y = y_pos - spi->pos.y;
+			imageState = spi->curImageState;
+		}
 
-				pos[0].x = x_pos - spi->pos.x;
-				pos[0].y = y_pos - spi->pos.y;
-				imageState = spi->curImageState;
+		angle = spi->curAngle;
+		scale = spi->curScale;
+		if ((spi->flags & kSFScaled) || (spi->flags & kSFRotated)) {
+			if (spi->flags & kSFScaled && scale) {
+				pos[0].x = pos[0].x * 256 / scale;
+				pos[0].y = pos[0].y * 256 / scale;
 			}
-
-			angle = spi->curAngle;
-			scale = spi->curScale;
-			if ((spi->flags & kSFScaled) || (spi->flags & kSFRotated)) {
-				if (spi->flags & kSFScaled && scale) {
-					pos[0].x = pos[0].x * 256 / scale;
-					pos[0].y = pos[0].y * 256 / scale;
-				}
-				if (spi->flags & kSFRotated && angle) {
-					angle = (360 - angle) % 360;
-					_vm->_wiz->polygonRotatePoints(pos, 1, angle);
-				}
-
-				_vm->_wiz->getWizImageDim(image, imageState, w, h);
-				pos[0].x += w / 2;
-				pos[0].y += h / 2;
+			if (spi->flags & kSFRotated && angle) {
+				angle = (360 - angle) % 360;
+				_vm->_wiz->polygonRotatePoints(pos, 1, angle);
 			}
 
-			if (_vm->_wiz->isWizPixelNonTransparent(image, imageState, pos[0].x, pos[0].y, spi->curImgFlags))
-				return spi->id;
+			_vm->_wiz->getWizImageDim(image, imageState, w, h);
+			pos[0].x += w / 2;
+			pos[0].y += h / 2;
 		}
+
+		if (_vm->_wiz->isWizPixelNonTransparent(image, imageState, pos[0].x, pos[0].y, spi->curImgFlags))
+			return true;
 	}
 
-	return 0;
+	return false;
 }
 
 int Sprite::getSpriteClass(int spriteId, int num, int *args) {
@@ -517,6 +558,17 @@ void Sprite::setSpriteSourceImage(int spriteId, int value) {
 void Sprite::setSpriteMaskImage(int spriteId, int value) {
 	assertRange(1, spriteId, _varNumSprites, "sprite");
 
+	if (value && !_spriteTable[spriteId].maskImage) {
+		_maskedSprites.push_back(spriteId);
+	} else if (!value && _spriteTable[spriteId].maskImage) {
+		for (uint i = 0; i < _maskedSprites.size(); i++) {
+			if (_maskedSprites[i] == spriteId) {
+				_maskedSprites.remove_at(i);
+				break;
+			}
+		}
+	}
+
 	_spriteTable[spriteId].maskImage = value;
 }
 
@@ -795,7 +847,7 @@ void Sprite::resetSprite(int spriteId) {
 	_spriteTable[spriteId].classFlags = 0;
 	_spriteTable[spriteId].palette = 0;
 	_spriteTable[spriteId].sourceImage = 0;
-	_spriteTable[spriteId].maskImage = 0;
+	setSpriteMaskImage(spriteId, 0);
 	_spriteTable[spriteId].priority = 0;
 	_spriteTable[spriteId].field_84 = 0;
 	_spriteTable[spriteId].imgFlags = 0;
@@ -1064,6 +1116,13 @@ void Sprite::allocTables(int numSprites, int numGroups, int numMaxSprites) {
 	_spriteGroups = (SpriteGroup *)malloc((_varNumSpriteGroups + 1) * sizeof(SpriteGroup));
 	_spriteTable = (SpriteInfo *)malloc((_varNumSprites + 1) * sizeof(SpriteInfo));
 	_activeSpritesTable = (SpriteInfo **)malloc((_varNumSprites + 1) * sizeof(SpriteInfo *));
+
+	_indexWidth = (_vm->_screenWidth + kIndexCellSize - 1) / kIndexCellSize;
+	_indexHeight = (_vm->_screenHeight + kIndexCellSize - 1) / kIndexCellSize;
+	_indexCells.resize(_indexWidth * _indexHeight);
+	_indexedCells = new Common::Rect[_varNumSprites + 1];
+	_activeSpritePos = (int32 *)malloc((_varNumSprites + 1) * sizeof(int32));
+	resetActiveSpritePos();
 }
 
 void Sprite::resetGroup(int spriteGroupId) {
@@ -1094,6 +1153,73 @@ void Sprite::resetTables(bool refreshScreen) {
 		_vm->restoreBackgroundHE(Common::Rect(_vm->_screenWidth, _vm->_screenHeight));
 	}
 	_numSpritesToProcess = 0;
+
+	resetActiveSpritePos();
+	rebuildSpriteIndex();
+}
+
+void Sprite::getIndexCells(int x1, int y1, int x2, int y2, Common::Rect &cells) const {
+	const int maxX = _indexWidth * kIndexCellSize - 1;
+	const int maxY = _indexHeight * kIndexCellSize - 1;
+
+	cells.left = CLIP(x1, 0, maxX) / kIndexCellSize;
+	cells.top = CLIP(y1, 0, maxY) / kIndexCellSize;
+	cells.right = CLIP(x2, 0, maxX) / kIndexCellSize + 1;
+	cells.bottom = CLIP(y2, 0, maxY) / kIndexCellSize + 1;
+}
+
+void Sprite::updateSpriteIndex(int spriteId) {
+	const SpriteInfo *spi = &_spriteTable[spriteId];
+
+	// Sprites with an invalid bounding box can't be hit and aren't indexed
+	Common::Rect cells;
+	if (spi->bbox.left <= spi->bbox.right && spi->bbox.top <= spi->bbox.bottom)
+		getIndexCells(spi->bbox.left, spi->bbox.top, spi->bbox.right, spi->bbox.bottom, cells);
+
+	Common::Rect &oldCells = _indexedCells[spriteId];
+	if (cells == oldCells)
+		return;
+
+	for (int y = oldCells.top; y < oldCells.bottom; y++) {
+		for (int x = oldCells.left; x < oldCells.right; x++) {
+			Common::Array<uint16> &cell = _indexCells[y * _indexWidth + x];
+			for (uint i = 0; i < cell.size(); i++) {
+				if (cell[i] == spriteId) {
+					cell[i] = cell.back();
+					cell.pop_back();
+					break;
+				}
+			}
+		}
+	}
+
+	for (int y = cells.top; y < cells.bottom; y++) {
+		for (int x = cells.left; x < cells.right; x++)
+			_indexCells[y * _indexWidth + x].push_back(spriteId);
+	}
+
+	oldCells = cells;
+}
+
+void Sprite::rebuildSpriteIndex() {
+	for (uint i = 0; i < _indexCells.size(); i++)
+		_indexCells[i].clear();
+
+	_maskedSprites.clear();
+	for (int i = 0; i <= _varNumSprites; i++) {
+		_indexedCells[i] = Common::Rect();
+		if (i == 0)
+			continue;
+
+		updateSpriteIndex(i);
+		if (_spriteTable[i].maskImage)
+			_maskedSprites.push_back(i);
+	}
+}
+
+void Sprite::resetActiveSpritePos() {
+	for (int i = 0; i <= _varNumSprites; i++)
+		_activeSpritePos[i] = -1;
 }
 
 void Sprite::resetBackground() {
@@ -1144,21 +1270,43 @@ void Sprite::resetBackground() {
 
 void Sprite::setRedrawFlags(bool checkZOrder) {
 	VirtScreen *vs = &_vm->_virtscr[kMainVirtScreen];
-	for (int i = 0; i < _numSpritesToProcess; ++i) {
-		SpriteInfo *spi = _activeSpritesTable[i];
-		if (!(spi->flags & kSFNeedRedraw)) {
-			if ((!checkZOrder || spi->priority >= 0) && (spi->flags & kSFMarkDirty)) {
-				int32 lp = spi->bbox.left / 8;
-				lp = MAX((int32)0, lp);
-				lp = MIN(lp, _vm->_gdi->_numStrips);
-				int32 rp = (spi->bbox.right + 7) / 8;
-				rp = MAX((int32)0, rp);
-				rp = MIN(rp, _vm->_gdi->_numStrips);
-				for (; lp < rp; lp++) {
-					if (vs->tdirty[lp] < vs->h && spi->bbox.bottom >= vs->tdirty[lp] && spi->bbox.top <= vs->bdirty[lp]) {
-						spi->flags |= kSFNeedRedraw;
-						break;
-					}
+
+	// Only the sprites in the index cells of the dirty strips can need to be
+	// redrawn
+	for (int strip = 0; strip < _vm->_gdi->_numStrips; strip++) {
+		if (vs->tdirty[strip] >= vs->h)
+			continue;
+
+		Common::Rect cells;
+		getIndexCells(strip * 8, MIN(vs->tdirty[strip], vs->bdirty[strip]),
+			strip * 8 + 7, MAX(vs->tdirty[strip], vs->bdirty[strip]), cells);
+
+		for (int y = cells.top; y < cells.bottom; y++) {
+			for (int x = cells.left; x < cells.right; x++) {
+				const Common::Array<uint16> &cell = _indexCells[y * _indexWidth + x];
+				for (uint i = 0; i < cell.size(); i++) {
+					if (_activeSpritePos[cell[i]] >= 0)
+						checkSpriteRedraw(&_spriteTable[cell[i]], checkZOrder);
+				}
+			}
+		}
+	}
+}
+
+void Sprite::checkSpriteRedraw(SpriteInfo *spi, bool checkZOrder) {
+	VirtScreen *vs = &_vm->_virtscr[kMainVirtScreen];
+	if (!(spi->flags & kSFNeedRedraw)) {
+		if ((!checkZOrder || spi->priority >= 0) && (spi->flags & kSFMarkDirty)) {
+			int32 lp = spi->bbox.left / 8;
+			lp = MAX((int32)0, lp);
+			lp = MIN(lp, _vm->_gdi->_numStrips);
+			int32 rp = (spi->bbox.right + 7) / 8;
+			rp = MAX((int32)0, rp);
+			rp = MIN(rp, _vm->_gdi->_numStrips);
+			for (; lp < rp; lp++) {
+				if (vs->tdirty[lp] < vs->h && spi->bbox.bottom >= vs->tdirty[lp] && spi->bbox.top <= vs->bdirty[lp]) {
+					spi->flags |= kSFNeedRedraw;
+					break;
 				}
 			}
 		}
@@ -1213,6 +1361,9 @@ static int compareSprTable(const void *a, const void *b) {
 void Sprite::sortActiveSprites() {
 	int groupZorder;
 
+	for (int i = 0; i < _numSpritesToProcess; i++)
+		_activeSpritePos[_activeSpritesTable[i] - _spriteTable] = -1;
+
 	_numSpritesToProcess = 0;
 
 	if (_varNumSprites <= 1)
@@ -1239,10 +1390,11 @@ void Sprite::sortActiveSprites() {
 		}
 	}
 
-	if (_numSpritesToProcess < 2)
-		return;
+	if (_numSpritesToProcess >= 2)
+		qsort(_activeSpritesTable, _numSpritesToProcess, sizeof(SpriteInfo *), compareSprTable);
 
-	qsort(_activeSpritesTable, _numSpritesToProcess, sizeof(SpriteInfo *), compareSprTable);
+	for (int i = 0; i < _numSpritesToProcess; i++)
+		_activeSpritePos[_activeSpritesTable[i]->id] = i;
 }
 
 void Sprite::processImages(bool arg) {
@@ -1372,9 +1524,12 @@ void Sprite::processImages(bool arg) {
 				bboxPtr->top = 1234;
 				bboxPtr->right = -1234;
 				bboxPtr->bottom = -1234;
+				updateSpriteIndex(spi->id);
 				continue;
 			}
 		}
+		updateSpriteIndex(spi->id);
+
 		if (spi->palette) {
 			wiz.processFlags |= kWPFPaletteNum;
 			wiz.img.palette = spi->palette;
@@ -1458,8 +1613,11 @@ void Sprite::saveOrLoadSpriteData(Serializer *s) {
 	}
 
 	// Reset active sprite table
-	if (s->isLoading())
+	if (s->isLoading()) {
 		_numSpritesToProcess = 0;
+		resetActiveSpritePos();
+		rebuildSpriteIndex();
+	}
 
 }
 
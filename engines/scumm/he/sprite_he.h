@@ -23,6 +23,8 @@
 #if !defined(SCUMM_HE_SPRITE_HE_H) && defined(ENABLE_HE)
 #define SCUMM_HE_SPRITE_HE_H
 
+#include "common/array.h"
+
 namespace Scumm {
 
 enum SpriteFlags {
@@ -213,6 +215,30 @@ public:
 	void setSpriteImage(int spriteId, int imageNum);
 private:
 	ScummEngine_v90he *_vm;
+
+	/**
+	 * Uniform grid over the screen, holding the sprites whose bounding box
+	 * overlaps each cell. Boxes outside the screen are clamped to the
+	 * border cells. Used to find the sprites at a position or in a dirty
+	 * area without going through all active sprites.
+	 */
+	enum {
+		kIndexCellSize = 32
+	};
+
+	int _indexWidth;
+	int _indexHeight;
+	Common::Array<Common::Array<uint16> > _indexCells;
+	Common::Rect *_indexedCells;	// Cells covered by each sprite, empty if not indexed
+	int32 *_activeSpritePos;	// Position in _activeSpritesTable, or -1
+	Common::Array<uint16> _maskedSprites;	// Sprites with a mask image
+
+	bool hitTestSprite(SpriteInfo *spi, int x, int y, int spriteGroupId, int type, int num, int *args);
+	void checkSpriteRedraw(SpriteInfo *spi, bool checkZOrder);
+	void getIndexCells(int x1, int y1, int x2, int y2, Common::Rect &cells) const;
+	void updateSpriteIndex(int spriteId);
+	void rebuildSpriteIndex();
+	void resetActiveSpritePos();
 };
 
 } // End of namespace Scumm
@@ -40,6 +40,13 @@ Wiz::Wiz(ScummEngine_v71he *vm) : _vm(vm) {
 	memset(&_polygons, 0, sizeof(_polygons));
 	_cursorImage = false;
 	_rectOverrideEnabled = false;
+	_imageCacheSize = 0;
+	_imageCacheHits = 0;
+	_imageCacheMisses = 0;
+}
+
+Wiz::~Wiz() {
+	clearImageCache();
 }
 
 void Wiz::clearWizBuffer() {
@@ -1411,6 +1418,200 @@ void Wiz::captureImage(uint8 *src, int srcPitch, int srcw, int srch, int resNum,
 	_vm->_res->setModified(rtImage, resNum);
 }
 
+WizCachedImage *Wiz::getCachedImage(int resNum, int state, int comp, const uint8 *wizd, int width, int height, const uint8 *palPtr, int dstType) {
+	// Only the byte order of 16 bit destinations depends on the destination type
+	if (_vm->_bytesPerPixel == 2 && (dstType == kDstMemory || dstType == kDstResource))
+		dstType = kDstMemory;
+	else
+		dstType = kDstScreen;
+
+	WizImageCacheKey key;
+	key.resNum = resNum;
+	key.state = state;
+	key.palPtr = palPtr;
+	key.dstType = dstType;
+
+	ImageCacheMap::iterator it = _imageCache.find(key);
+	if (it != _imageCache.end()) {
+		WizCachedImage *image = it->_value;
+
+		// The palettes may have been changed since the image was decoded
+		if (image->wizd == wizd && image->bitDepth == _vm->_bytesPerPixel &&
+			(!image->palSize || !memcmp(image->pal, palPtr, image->palSize))) {
+			_imageCacheLRU.erase(image->lruPos);
+			_imageCacheLRU.push_back(key);
+			image->lruPos = --_imageCacheLRU.end();
+			_imageCacheHits++;
+			return image;
+		}
+
+		removeCachedImage(it);
+	}
+
+	_imageCacheMisses++;
+
+	if ((uint32)(width * height * _vm->_bytesPerPixel) > kImageCacheMaxSize / 4)
+		return NULL;
+
+	WizCachedImage *image = decodeCachedImage(comp, wizd, width, height, palPtr, dstType);
+
+	while (!_imageCacheLRU.empty() && _imageCacheSize + image->size > kImageCacheMaxSize)
+		removeCachedImage(_imageCache.find(_imageCacheLRU.front()));
+
+	_imageCacheLRU.push_back(key);
+	image->lruPos = --_imageCacheLRU.end();
+	_imageCache[key] = image;
+	_imageCacheSize += image->size;
+	return image;
+}
+
+WizCachedImage *Wiz::decodeCachedImage(int comp, const uint8 *wizd, int width, int height, const uint8 *palPtr, int dstType) {
+	WizCachedImage *image = new WizCachedImage;
+	const uint8 bitDepth = _vm->_bytesPerPixel;
+
+	image->wizd = wizd;
+	image->palSize = palPtr ? 256 * bitDepth : 0;
+	if (palPtr)
+		memcpy(image->pal, palPtr, image->palSize);
+	image->width = width;
+	image->height = height;
+	image->bitDepth = bitDepth;
+	image->pixels = (uint8 *)calloc(width * height, bitDepth);
+	assert(image->pixels);
+
+	// Decode the image with the regular code, so the result is identical
+	const Common::Rect srcRect(width, height);
+#ifdef USE_RGB_COLOR
+	if (comp == 5) {
+		decompress16BitWizImage<kWizCopy>(image->pixels, width * 2, dstType, wizd, srcRect, 0);
+	} else
+#endif
+	if (palPtr) {
+		decompressWizImage<kWizRMap>(image->pixels, width * bitDepth, dstType, wizd, srcRect, 0, palPtr, NULL, bitDepth);
+	} else {
+		decompressWizImage<kWizCopy>(image->pixels, width * bitDepth, dstType, wizd, srcRect, 0, NULL, NULL, bitDepth);
+	}
+
+	// Collect the opaque spans of each line
+	const int pixelSize = (comp == 5) ? 2 : 1;
+	const uint8 *dataPtr = wizd;
+	for (int y = 0; y < height; y++) {
+		image->lines.push_back(image->spans.size());
+
+		uint16 lineSize = READ_LE_UINT16(dataPtr); dataPtr += 2;
+		const uint8 *dataPtrNext = dataPtr + lineSize;
+		int x = 0;
+		while (lineSize != 0 && x < width) {
+			uint8 code = *dataPtr++;
+			if (code & 1) {
+				x += code >> 1;
+				continue;
+			}
+
+			const int count = MIN((code >> 2) + 1, width - x);
+			dataPtr += (code & 2) ? pixelSize : count * pixelSize;
+
+			if (image->spans.size() > image->lines.back() && image->spans.back().x + image->spans.back().width == x) {
+				image->spans.back().width += count;
+			} else {
+				WizCachedImage::Span span;
+				span.x = x;
+				span.width = count;
+				image->spans.push_back(span);
+			}
+			x += count;
+		}
+		dataPtr = dataPtrNext;
+	}
+	image->lines.push_back(image->spans.size());
+
+	image->size = sizeof(WizCachedImage) + width * height * bitDepth +
+		image->spans.size() * sizeof(WizCachedImage::Span) + image->lines.size() * sizeof(uint32);
+	return image;
+}
+
+void Wiz::drawCachedImage(const WizCachedImage *image, uint8 *dst, int dstPitch, int dstw, int dsth, int srcx, int srcy, const Common::Rect *rect, int flags) {
+	// Clip and flip exactly like copyWizImage()
+	Common::Rect r1, r2;
+	if (!calcClipRects(dstw, dsth, srcx, srcy, image->width, image->height, rect, r1, r2))
+		return;
+
+	const int bitDepth = image->bitDepth;
+	dst += r2.top * dstPitch + r2.left * bitDepth;
+	if (flags & kWIFFlipY) {
+		const int dy = (srcy < 0) ? srcy : (image->height - r1.height());
+		r1.translate(0, dy);
+	}
+	if (flags & kWIFFlipX) {
+		const int dx = (srcx < 0) ? srcx : (image->width - r1.width());
+		r1.translate(dx, 0);
+	}
+
+	const int w = r1.width();
+	const int h = r1.height();
+	for (int y = 0; y < h; y++) {
+		const int line = r1.top + y;
+		uint8 *dstLine = dst + ((flags & kWIFFlipY) ? (h - 1 - y) : y) * dstPitch;
+		const uint8 *srcLine = image->pixels + line * image->width * bitDepth;
+
+		for (uint i = image->lines[line]; i < image->lines[line + 1]; i++) {
+			const WizCachedImage::Span &span = image->spans[i];
+			const int x1 = MAX<int>(span.x, r1.left);
+			const int x2 = MIN<int>(span.x + span.width, r1.right);
+			if (x1 >= x2)
+				continue;
+
+			const uint8 *src = srcLine + x1 * bitDepth;
+			if (flags & kWIFFlipX) {
+				uint8 *dstPtr = dstLine + (w - 1 - (x1 - r1.left)) * bitDepth;
+				for (int x = x1; x < x2; x++) {
+					memcpy(dstPtr, src, bitDepth);
+					dstPtr -= bitDepth;
+					src += bitDepth;
+				}
+			} else {
+				memcpy(dstLine + (x1 - r1.left) * bitDepth, src, (x2 - x1) * bitDepth);
+			}
+		}
+	}
+}
+
+void Wiz::removeCachedImage(ImageCacheMap::iterator it) {
+	WizCachedImage *image = it->_value;
+	_imageCacheSize -= image->size;
+	_imageCacheLRU.erase(image->lruPos);
+	_imageCache.erase(it);
+
+	free(image->pixels);
+	delete image;
+}
+
+void Wiz::flushImageCache(int resNum) {
+	ImageCacheMap::iterator it = _imageCache.begin();
+	while (it != _imageCache.end()) {
+		ImageCacheMap::iterator cur = it++;
+		if (cur->_key.resNum == resNum)
+			removeCachedImage(cur);
+	}
+}
+
+void Wiz::clearImageCache() {
+	while (!_imageCache.empty())
+		removeCachedImage(_imageCache.begin());
+}
+
+void Wiz::getImageCacheStats(uint &entries, uint32 &size, uint32 &hits, uint32 &misses) const {
+	entries = _imageCache.size();
+	size = _imageCacheSize;
+	hits = _imageCacheHits;
+	misses = _imageCacheMisses;
+}
+
+void Wiz::resetImageCacheStats() {
+	_imageCacheHits = 0;
+	_imageCacheMisses = 0;
+}
+
 void Wiz::displayWizImage(WizImage *pwi) {
 	if (_vm->_fullRedraw) {
 		assert(_imagesNum < ARRAYSIZE(_images));
@@ -1574,6 +1775,7 @@ uint8 *Wiz::drawWizImage(int resNum, int state, int maskNum, int maskState, int
 		transColor = (trns == NULL) ? _vm->VAR(_vm->VAR_WIZ_TCOLOR) : -1;
 	}
 
+	const WizCachedImage *image;
 	switch (comp) {
 	case 0:
 		copyRawWizImage(dst, wizd, dstPitch, dstType, cw, ch, x1, y1, width, height, &rScreen, flags, palPtr, transColor, _vm->_bytesPerPixel);
@@ -1587,6 +1789,8 @@ uint8 *Wiz::drawWizImage(int resNum, int state, int maskNum, int maskState, int
 			dst = _vm->getMaskBuffer(0, 0, 1);
 			dstPitch /= _vm->_bytesPerPixel;
 			copyWizImageWithMask(dst, wizd, dstPitch, cw, ch, x1, y1, width, height, &rScreen, 0, 1);
+		} else if (!xmapPtr && (image = getCachedImage(resNum, state, comp, wizd, width, height, palPtr, dstType))) {
+			drawCachedImage(image, dst, dstPitch, cw, ch, x1, y1, &rScreen, flags);
 		} else {
 			copyWizImage(dst, wizd, dstPitch, dstType, cw, ch, x1, y1, width, height, &rScreen, flags, palPtr, xmapPtr, _vm->_bytesPerPixel);
 		}
@@ -1603,7 +1807,11 @@ uint8 *Wiz::drawWizImage(int resNum, int state, int maskNum, int maskState, int
 		// TODO: Unknown image type
 		break;
 	case 5:
-		copy16BitWizImage(dst, wizd, dstPitch, dstType, cw, ch, x1, y1, width, height, &rScreen, flags, xmapPtr);
+		if (!xmapPtr && (image = getCachedImage(resNum, state, comp, wizd, width, height, NULL, dstType))) {
+			drawCachedImage(image, dst, dstPitch, cw, ch, x1, y1, &rScreen, flags);
+		} else {
+			copy16BitWizImage(dst, wizd, dstPitch, dstType, cw, ch, x1, y1, width, height, &rScreen, flags, xmapPtr);
+		}
 		break;
 #endif
 	default:
@@ -23,6 +23,9 @@
 #if !defined(SCUMM_HE_WIZ_HE_H) && defined(ENABLE_HE)
 #define SCUMM_HE_WIZ_HE_H
 
+#include "common/array.h"
+#include "common/hashmap.h"
+#include "common/list.h"
 #include "common/rect.h"
 
 namespace Scumm {
@@ -146,6 +149,47 @@ enum DstSurface {
  	kDstCursor   = 3
 };
 
+struct WizImageCacheKey {
+	int resNum;
+	int state;
+	const uint8 *palPtr;
+	int dstType;
+
+	bool operator==(const WizImageCacheKey &key) const {
+		return resNum == key.resNum && state == key.state && palPtr == key.palPtr && dstType == key.dstType;
+	}
+};
+
+struct WizImageCacheKeyHash {
+	uint operator()(const WizImageCacheKey &key) const {
+		return (key.resNum << 8) ^ key.state ^ (uint)(size_t)key.palPtr ^ (key.dstType << 24);
+	}
+};
+
+/**
+ * A decoded Wiz image, in the pixel format of the surface it gets drawn to.
+ * The opaque pixels of each line are stored as spans, so drawing the image
+ * only has to copy them.
+ */
+struct WizCachedImage {
+	struct Span {
+		uint16 x;
+		uint16 width;
+	};
+
+	const uint8 *wizd;	// Image data the entry was decoded from
+	uint8 pal[512];		// Remap palette used for decoding
+	int palSize;
+	int width;
+	int height;
+	uint8 bitDepth;
+	uint8 *pixels;
+	Common::Array<Span> spans;
+	Common::Array<uint32> lines;	// Index of the first span of each line, plus the end
+	uint32 size;
+	Common::List<WizImageCacheKey>::iterator lruPos;
+};
+
 class ScummEngine_v71he;
 
 class Wiz {
@@ -160,6 +204,7 @@ public:
 	WizPolygon _polygons[NUM_POLYGONS];
 
 	Wiz(ScummEngine_v71he *vm);
+	~Wiz();
 
 	void clearWizBuffer();
 	Common::Rect _rectOverride;
@@ -236,8 +281,32 @@ public:
 	void computeWizHistogram(uint32 *histogram, const uint8 *data, const Common::Rect& rCapt);
 	void computeRawWizHistogram(uint32 *histogram, const uint8 *data, int srcPitch, const Common::Rect& rCapt);
 
+	void flushImageCache(int resNum);
+	void clearImageCache();
+	void getImageCacheStats(uint &entries, uint32 &size, uint32 &hits, uint32 &misses) const;
+	uint32 getImageCacheMaxSize() const { return kImageCacheMaxSize; }
+	void resetImageCacheStats();
+
 private:
 	ScummEngine_v71he *_vm;
+
+	enum {
+		kImageCacheMaxSize = 4 * 1024 * 1024
+	};
+
+	typedef Common::List<WizImageCacheKey> ImageCacheLRU;
+	typedef Common::HashMap<WizImageCacheKey, WizCachedImage *, WizImageCacheKeyHash> ImageCacheMap;
+
+	ImageCacheMap _imageCache;
+	ImageCacheLRU _imageCacheLRU;	// Least recently used image first
+	uint32 _imageCacheSize;
+	uint32 _imageCacheHits;
+	uint32 _imageCacheMisses;
+
+	WizCachedImage *getCachedImage(int resNum, int state, int comp, const uint8 *wizd, int width, int height, const uint8 *palPtr, int dstType);
+	WizCachedImage *decodeCachedImage(int comp, const uint8 *wizd, int width, int height, const uint8 *palPtr, int dstType);
+	void removeCachedImage(ImageCacheMap::iterator it);
+	static void drawCachedImage(const WizCachedImage *image, uint8 *dst, int dstPitch, int dstw, int dsth, int srcx, int srcy, const Common::Rect *rect, int flags);
 };
 
 } // End of namespace Scumm
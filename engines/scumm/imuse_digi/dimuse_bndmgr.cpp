@@ -63,6 +63,10 @@ bool BundleDirCache::isSndDataExtComp(int slot) {
 	return _budleDirCache[slot].isCompressed;
 }
 
+const char *BundleDirCache::getFileName(int slot) {
+	return _budleDirCache[slot].fileName;
+}
+
 int BundleDirCache::matchFile(const char *filename) {
 	int32 tag, offset;
 	bool found = false;
@@ -139,8 +143,140 @@ int BundleDirCache::matchFile(const char *filename) {
 	}
 }
 
-BundleMgr::BundleMgr(BundleDirCache *cache) {
+BundleBlockCache::BundleBlockCache(BundleDirCache *dirCache) : _dirCache(dirCache), _cacheSize(0) {
+	for (int i = 0; i < ARRAYSIZE(_readAheadFile); i++)
+		_readAheadFile[i] = NULL;
+}
+
+BundleBlockCache::~BundleBlockCache() {
+	for (BlockMap::iterator it = _blocks.begin(); it != _blocks.end(); ++it)
+		free(it->_value.data);
+	for (int i = 0; i < ARRAYSIZE(_readAheadFile); i++)
+		delete _readAheadFile[i];
+}
+
+bool BundleBlockCache::getBlock(int slot, int32 index, int32 block, byte *dst, int32 &size) {
+	Common::StackLock lock(_mutex);
+
+	BlockMap::iterator it = _blocks.find(BlockKey(slot, index, block));
+	if (it == _blocks.end())
+		return false;
+
+	Block &entry = it->_value;
+	memcpy(dst, entry.data, entry.size);
+	size = entry.size;
+
+	// Move the block to the end of the LRU list
+	_lru.erase(entry.lruPos);
+	_lru.push_back(it->_key);
+	entry.lruPos = --_lru.end();
+	return true;
+}
+
+void BundleBlockCache::addBlock(int slot, int32 index, int32 block, const byte *src, int32 size) {
+	Common::StackLock lock(_mutex);
+
+	BlockKey key(slot, index, block);
+	if (_blocks.contains(key))
+		return;
+
+	while (!_lru.empty() && _cacheSize + size > kMaxCacheSize)
+		removeBlock(_blocks.find(_lru.front()));
+
+	Block entry;
+	entry.data = (byte *)malloc(size);
+	assert(entry.data);
+	memcpy(entry.data, src, size);
+	entry.size = size;
+	_lru.push_back(key);
+	entry.lruPos = --_lru.end();
+
+	_blocks[key] = entry;
+	_cacheSize += size;
+}
+
+void BundleBlockCache::removeBlock(BlockMap::iterator it) {
+	assert(it != _blocks.end());
+
+	_cacheSize -= it->_value.size;
+	free(it->_value.data);
+	_lru.erase(it->_value.lruPos);
+	_blocks.erase(it);
+}
+
+void BundleBlockCache::queueReadAhead(int slot, int32 index, int32 block, int32 offset, int32 size, int32 codec) {
+	Common::StackLock lock(_mutex);
+
+	BlockKey key(slot, index, block);
+	if (_blocks.contains(key) || _readAhead.size() >= kMaxReadAheadRequests)
+		return;
+
+	for (Common::List<ReadAheadRequest>::const_iterator it = _readAhead.begin(); it != _readAhead.end(); ++it) {
+		if (it->key == key)
+			return;
+	}
+
+	_readAhead.push_back(ReadAheadRequest(key, offset, size, codec));
+}
+
+void BundleBlockCache::processReadAhead() {
+	byte *compInput = NULL;
+	int32 compInputSize = 0;
+	byte output[0x2000];
+
+	for (;;) {
+		// Only hold the lock while picking the next request, so the iMUSE
+		// callback can keep using the cache while the block is decoded
+		_mutex.lock();
+		if (_readAhead.empty()) {
+			_mutex.unlock();
+			break;
+		}
+		ReadAheadRequest request = _readAhead.front();
+		_readAhead.pop_front();
+		bool cached = _blocks.contains(request.key);
+		_mutex.unlock();
+
+		if (cached)
+			continue;
+
+		BaseScummFile *&file = _readAheadFile[request.key.slot];
+		if (!file) {
+			file = new ScummFile();
+			if (!g_scumm->openFile(*file, _dirCache->getFileName(request.key.slot))) {
+				warning("BundleBlockCache::processReadAhead() Can't open bundle file: %s", _dirCache->getFileName(request.key.slot));
+				delete file;
+				file = NULL;
+				continue;
+			}
+		}
+
+		if (request.size > compInputSize) {
+			free(compInput);
+			// CMI hack: one more byte at the end of input buffer
+			compInput = (byte *)malloc(request.size + 1);
+			assert(compInput);
+			compInputSize = request.size;
+		}
+
+		compInput[request.size] = 0;
+		file->seek(request.offset, SEEK_SET);
+		file->read(compInput, request.size);
+		int32 outputSize = BundleCodecs::decompressCodec(request.codec, compInput, output, request.size);
+		if (outputSize > 0x2000) {
+			error("_outputSize: %d", outputSize);
+		}
+
+		addBlock(request.key.slot, request.key.index, request.key.block, output, outputSize);
+	}
+
+	free(compInput);
+}
+
+BundleMgr::BundleMgr(BundleDirCache *cache, BundleBlockCache *blockCache) {
 	_cache = cache;
+	_blockCache = blockCache;
+	_bundleSlot = -1;
 	_bundleTable = NULL;
 	_compTable = NULL;
 	_numFiles = 0;
@@ -186,6 +322,7 @@ bool BundleMgr::open(const char *filename, bool &compressed, bool errorFlag) {
 
 	int slot = _cache->matchFile(filename);
 	assert(slot != -1);
+	_bundleSlot = slot;
 	compressed = _cache->isSndDataExtComp(slot);
 	_numFiles = _cache->getNumFiles(slot);
 	assert(_numFiles);
@@ -288,13 +425,16 @@ int32 BundleMgr::decompressSampleByIndex(int32 index, int32 offset, int32 size,
 
 	for (i = firstBlock; i <= lastBlock; i++) {
 		if (_lastBlock != i) {
-			// CMI hack: one more zero byte at the end of input buffer
-			_compInputBuff[_compTable[i].size] = 0;
-			_file->seek(_bundleTable[index].offset + _compTable[i].offset, SEEK_SET);
-			_file->read(_compInputBuff, _compTable[i].size);
-			_outputSize = BundleCodecs::decompressCodec(_compTable[i].codec, _compInputBuff, _compOutputBuff, _compTable[i].size);
-			if (_outputSize > 0x2000) {
-				error("_outputSize: %d", _outputSize);
+			if (!_blockCache->getBlock(_bundleSlot, index, i, _compOutputBuff, _outputSize)) {
+				// CMI hack: one more zero byte at the end of input buffer
+				_compInputBuff[_compTable[i].size] = 0;
+				_file->seek(_bundleTable[index].offset + _compTable[i].offset, SEEK_SET);
+				_file->read(_compInputBuff, _compTable[i].size);
+				_outputSize = BundleCodecs::decompressCodec(_compTable[i].codec, _compInputBuff, _compOutputBuff, _compTable[i].size);
+				if (_outputSize > 0x2000) {
+					error("_outputSize: %d", _outputSize);
+				}
+				_blockCache->addBlock(_bundleSlot, index, i, _compOutputBuff, _outputSize);
 			}
 			_lastBlock = i;
 		}
@@ -327,6 +467,10 @@ int32 BundleMgr::decompressSampleByIndex(int32 index, int32 offset, int32 size,
 		skip = 0;
 	}
 
+	// Let the block cache decode the following blocks in advance
+	for (i = _lastBlock + 1; i <= _lastBlock + kReadAheadBlocks && i < _numCompItems; i++)
+		_blockCache->queueReadAhead(_bundleSlot, index, i, _bundleTable[index].offset + _compTable[i].offset, _compTable[i].size, _compTable[i].codec);
+
 	return finalSize;
 }
 
@@ -25,6 +25,9 @@
 
 #include "common/scummsys.h"
 #include "common/file.h"
+#include "common/hashmap.h"
+#include "common/list.h"
+#include "common/mutex.h"
 
 namespace Scumm {
 
@@ -58,16 +61,92 @@ public:
 	~BundleDirCache();
 
 	int matchFile(const char *filename);
+	const char *getFileName(int slot);
 	AudioTable *getTable(int slot);
 	IndexNode *getIndexTable(int slot);
 	int32 getNumFiles(int slot);
 	bool isSndDataExtComp(int slot);
 };
 
+/**
+ * Cache of decompressed bundle blocks, shared by all BundleMgr instances.
+ *
+ * Blocks are identified by the bundle dir cache slot of their bundle, the
+ * index of the file in the bundle and the block number. Bundle managers
+ * also queue the blocks following the ones they decompress, which
+ * processReadAhead() decodes from the main thread. This way, the iMUSE
+ * callback usually finds the data it needs in the cache and doesn't have
+ * to access the disk while holding the iMUSE mutex.
+ */
+class BundleBlockCache {
+public:
+	BundleBlockCache(BundleDirCache *dirCache);
+	~BundleBlockCache();
+
+	bool getBlock(int slot, int32 index, int32 block, byte *dst, int32 &size);
+	void addBlock(int slot, int32 index, int32 block, const byte *src, int32 size);
+	void queueReadAhead(int slot, int32 index, int32 block, int32 offset, int32 size, int32 codec);
+	void processReadAhead();
+
+private:
+	enum {
+		kMaxCacheSize = 2 * 1024 * 1024,
+		kMaxReadAheadRequests = 64
+	};
+
+	struct BlockKey {
+		int slot;
+		int32 index;
+		int32 block;
+
+		BlockKey(int s, int32 i, int32 b) : slot(s), index(i), block(b) {}
+		bool operator==(const BlockKey &key) const {
+			return slot == key.slot && index == key.index && block == key.block;
+		}
+	};
+
+	struct BlockKeyHash {
+		uint operator()(const BlockKey &key) const {
+			return (key.block << 16) ^ (key.index << 2) ^ key.slot;
+		}
+	};
+
+	struct Block {
+		byte *data;
+		int32 size;
+		Common::List<BlockKey>::iterator lruPos;
+	};
+
+	struct ReadAheadRequest {
+		BlockKey key;
+		int32 offset;	// offset of the compressed block in the bundle file
+		int32 size;		// size of the compressed block
+		int32 codec;
+
+		ReadAheadRequest(const BlockKey &k, int32 o, int32 s, int32 c) : key(k), offset(o), size(s), codec(c) {}
+	};
+
+	typedef Common::HashMap<BlockKey, Block, BlockKeyHash> BlockMap;
+
+	BundleDirCache *_dirCache;
+	BlockMap _blocks;
+	Common::List<BlockKey> _lru;	// least recently used block first
+	uint32 _cacheSize;
+	Common::List<ReadAheadRequest> _readAhead;
+	BaseScummFile *_readAheadFile[4];	// one per bundle dir cache slot
+	Common::Mutex _mutex;
+
+	void removeBlock(BlockMap::iterator it);
+};
+
 class BundleMgr {
 
 private:
 
+	enum {
+		kReadAheadBlocks = 4
+	};
+
 	struct CompTable {
 		int32 offset;
 		int32 size;
@@ -75,6 +154,8 @@ private:
 	};
 
 	BundleDirCache *_cache;
+	BundleBlockCache *_blockCache;
+	int _bundleSlot;
 	BundleDirCache::AudioTable *_bundleTable;
 	BundleDirCache::IndexNode *_indexTable;
 	CompTable *_compTable;
@@ -94,7 +175,7 @@ private:
 
 public:
 
-	BundleMgr(BundleDirCache *_cache);
+	BundleMgr(BundleDirCache *cache, BundleBlockCache *blockCache);
 	~BundleMgr();
 
 	bool open(const char *filename, bool &compressed, bool errorFlag = false);
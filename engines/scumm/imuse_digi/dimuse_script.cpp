@@ -185,15 +185,21 @@ void IMuseDigital::flushTrack(Track *track) {
 }
 
 void IMuseDigital::flushTracks() {
-	Common::StackLock lock(_mutex, "IMuseDigital::flushTracks()");
-	debug(6, "flushTracks()");
-	for (int l = 0; l < MAX_DIGITAL_TRACKS + MAX_DIGITAL_FADETRACKS; l++) {
-		Track *track = _track[l];
-		if (track->used && track->toBeRemoved && !_mixer->isSoundHandleActive(track->mixChanHandle)) {
-			debug(5, "flushTracks() - soundId:%d", track->soundId);
-			memset(track, 0, sizeof(Track));
+	{
+		Common::StackLock lock(_mutex, "IMuseDigital::flushTracks()");
+		debug(6, "flushTracks()");
+		for (int l = 0; l < MAX_DIGITAL_TRACKS + MAX_DIGITAL_FADETRACKS; l++) {
+			Track *track = _track[l];
+			if (track->used && track->toBeRemoved && !_mixer->isSoundHandleActive(track->mixChanHandle)) {
+				debug(5, "flushTracks() - soundId:%d", track->soundId);
+				memset(track, 0, sizeof(Track));
+			}
 		}
 	}
+
+	// Decode the bundle data the tracks are going to need next without
+	// holding the mutex, so callback() doesn't have to wait for the disk
+	_sound->readAheadBundles();
 }
 
 void IMuseDigital::refreshScripts() {
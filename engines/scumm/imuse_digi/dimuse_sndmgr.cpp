@@ -47,6 +47,8 @@ ImuseDigiSndMgr::ImuseDigiSndMgr(ScummEngine *scumm) {
 	_disk = 0;
 	_cacheBundleDir = new BundleDirCache();
 	assert(_cacheBundleDir);
+	_cacheBundleBlocks = new BundleBlockCache(_cacheBundleDir);
+	assert(_cacheBundleBlocks);
 	BundleCodecs::initializeImcTables();
 }
 
@@ -55,6 +57,7 @@ ImuseDigiSndMgr::~ImuseDigiSndMgr() {
 		closeSound(&_sounds[l]);
 	}
 
+	delete _cacheBundleBlocks;
 	delete _cacheBundleDir;
 	BundleCodecs::releaseImcTables();
 }
@@ -321,7 +324,7 @@ ImuseDigiSndMgr::SoundDesc *ImuseDigiSndMgr::allocSlot() {
 bool ImuseDigiSndMgr::openMusicBundle(SoundDesc *sound, int &disk) {
 	bool result = false;
 
-	sound->bundle = new BundleMgr(_cacheBundleDir);
+	sound->bundle = new BundleMgr(_cacheBundleDir, _cacheBundleBlocks);
 	assert(sound->bundle);
 	if (_vm->_game.id == GID_CMI) {
 		if (_vm->_game.features & GF_DEMO) {
@@ -356,7 +359,7 @@ bool ImuseDigiSndMgr::openMusicBundle(SoundDesc *sound, int &disk) {
 bool ImuseDigiSndMgr::openVoiceBundle(SoundDesc *sound, int &disk) {
 	bool result = false;
 
-	sound->bundle = new BundleMgr(_cacheBundleDir);
+	sound->bundle = new BundleMgr(_cacheBundleDir, _cacheBundleBlocks);
 	assert(sound->bundle);
 	if (_vm->_game.id == GID_CMI) {
 		if (_vm->_game.features & GF_DEMO) {
@@ -635,6 +638,10 @@ int ImuseDigiSndMgr::getJumpFade(SoundDesc *soundDesc, int number) {
 	return soundDesc->jump[number].fadeDelay;
 }
 
+void ImuseDigiSndMgr::readAheadBundles() {
+	_cacheBundleBlocks->processReadAhead();
+}
+
 int32 ImuseDigiSndMgr::getDataFromRegion(SoundDesc *soundDesc, int region, byte **buf, int32 offset, int32 size) {
 	debug(6, "getDataFromRegion() region:%d, offset:%d, size:%d, numRegions:%d", region, offset, size, soundDesc->numRegions);
 	assert(checkForProperHandle(soundDesc));
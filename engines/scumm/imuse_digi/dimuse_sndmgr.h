@@ -116,6 +116,7 @@ private:
 	ScummEngine *_vm;
 	byte _disk;
 	BundleDirCache *_cacheBundleDir;
+	BundleBlockCache *_cacheBundleBlocks;
 
 	bool openMusicBundle(SoundDesc *sound, int &disk);
 	bool openVoiceBundle(SoundDesc *sound, int &disk);
@@ -147,6 +148,12 @@ public:
 	void getSyncSizeAndPtrById(SoundDesc *soundDesc, int number, int32 &sync_size, byte **sync_ptr);
 
 	int32 getDataFromRegion(SoundDesc *soundDesc, int region, byte **buf, int32 offset, int32 size);
+
+	/**
+	 * Decodes the bundle blocks queued for read-ahead. Must not be called
+	 * with the iMUSE mutex held.
+	 */
+	void readAheadBundles();
 };
 
 } // End of namespace Scumm
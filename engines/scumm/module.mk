@@ -59,6 +59,7 @@ MODULE_OBJS := \
 	resource.o \
 	room.o \
 	saveload.o \
+	script_profiler.o \
 	script_v0.o \
 	script_v2.o \
 	script_v3.o \
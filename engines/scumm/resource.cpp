@@ -48,6 +48,7 @@ enum {
 	RF_USAGE_MAX = RF_USAGE,
 
 	RS_MODIFIED = 0x10,
+	RS_EXPIRED = 0x20,
 	RF_OFFHEAP = 0x40
 };
 
@@ -540,6 +541,8 @@ void ResourceManager::allocResTypeData(ResType type, uint32 tag, int num, ResTyp
 
 	// If there was data in there, let's clear it out completely. This is important
 	// in case we are restarting the game.
+	for (ResId idx = 0; idx < _types[type].size(); idx++)
+		unlinkExpireEntry(type, idx);
 	_types[type].clear();
 	_types[type].resize(num);
 
@@ -777,28 +780,78 @@ void ResourceManager::increaseExpireCounter() {
 }
 
 void ResourceManager::increaseResourceCounters() {
-	for (ResType type = rtFirst; type <= rtLast; type = ResType(type + 1)) {
-		ResId idx = _types[type].size();
-		while (idx-- > 0) {
-			byte counter = _types[type][idx].getResourceCounter();
-			if (counter && counter < RF_USAGE_MAX) {
-				setResourceCounter(type, idx, counter + 1);
-			}
-		}
-	}
+	// The counters are derived from the generation, see getResourceCounter()
+	++_counterGeneration;
 }
 
 void ResourceManager::setResourceCounter(ResType type, ResId idx, byte counter) {
-	_types[type][idx].setResourceCounter(counter);
+	Resource &res = _types[type][idx];
+	counter = MIN<byte>(counter, RF_USAGE_MAX);
+
+	uint32 generation = counter ? _counterGeneration - (counter - 1) : 0;
+	if (res._counterGeneration == generation)
+		return;
+
+	unlinkExpireEntry(type, idx);
+	res._counterGeneration = generation;
+
+	// Only resources which can be reloaded from the data files may expire
+	if (generation && res._address && _types[type]._mode != kDynamicResTypeMode)
+		linkExpireEntry(type, idx);
 }
 
-void ResourceManager::Resource::setResourceCounter(byte counter) {
-	_flags &= RF_LOCK;	// Clear lower 7 bits, preserve the lock bit.
-	_flags |= counter;	// Update the usage counter
+byte ResourceManager::getResourceCounter(ResType type, ResId idx) const {
+	const Resource &res = _types[type][idx];
+	if (!res._counterGeneration)
+		return 0;
+	return MIN<uint32>(_counterGeneration - res._counterGeneration + 1, RF_USAGE_MAX);
 }
 
-byte ResourceManager::Resource::getResourceCounter() const {
-	return _flags & RF_USAGE;
+void ResourceManager::linkExpireEntry(ResType type, ResId idx) {
+	Resource &res = _types[type][idx];
+	uint32 entry = makeExpireEntry(type, idx);
+
+	// Resources almost always get a counter of 1, i.e. go to the end of the
+	// list. Otherwise, search the first resource with a lower counter.
+	uint32 next = kNoExpireEntry;
+	uint32 prev = _expireTail;
+	while (prev != kNoExpireEntry && getExpireEntry(prev)._counterGeneration > res._counterGeneration) {
+		next = prev;
+		prev = getExpireEntry(prev)._expirePrev;
+	}
+
+	res._expirePrev = prev;
+	res._expireNext = next;
+
+	if (prev != kNoExpireEntry)
+		getExpireEntry(prev)._expireNext = entry;
+	else
+		_expireHead = entry;
+
+	if (next != kNoExpireEntry)
+		getExpireEntry(next)._expirePrev = entry;
+	else
+		_expireTail = entry;
+}
+
+void ResourceManager::unlinkExpireEntry(ResType type, ResId idx) {
+	Resource &res = _types[type][idx];
+	uint32 entry = makeExpireEntry(type, idx);
+
+	if (res._expirePrev == kNoExpireEntry && _expireHead != entry)
+		return;	// Not in the list
+
+	if (res._expirePrev != kNoExpireEntry)
+		getExpireEntry(res._expirePrev)._expireNext = res._expireNext;
+	else
+		_expireHead = res._expireNext;
+
+	if (res._expireNext != kNoExpireEntry)
+		getExpireEntry(res._expireNext)._expirePrev = res._expirePrev;
+	else
+		_expireTail = res._expirePrev;
+
+	res._expirePrev = res._expireNext = kNoExpireEntry;
 }
 
 /* 2 bytes safety area to make "precaching" of bytes in the gdi drawer easier */
@@ -831,8 +884,16 @@ byte *ResourceManager::createResource(ResType type, ResId idx, uint32 size) {
 	memset(ptr, 0, size + SAFETY_AREA);
 	_allocatedSize += size;
 
-	_types[type][idx]._address = ptr;
-	_types[type][idx]._size = size;
+	Resource &res = _types[type][idx];
+	if (res.wasExpired()) {
+		_reloadCount[type]++;
+		res.clearExpired();
+	}
+
+	res._address = ptr;
+	res._size = size;
+	// Scripts may have set a counter while the resource wasn't loaded
+	res._counterGeneration = 0;
 	setResourceCounter(type, idx, 1);
 	return ptr;
 }
@@ -842,6 +903,8 @@ ResourceManager::Resource::Resource() {
 	_size = 0;
 	_flags = 0;
 	_status = 0;
+	_counterGeneration = 0;
+	_expirePrev = _expireNext = kNoExpireEntry;
 	_roomno = 0;
 	_roomoffs = 0;
 }
@@ -856,6 +919,7 @@ void ResourceManager::Resource::nuke() {
 	_address = 0;
 	_size = 0;
 	_flags = 0;
+	_counterGeneration = 0;
 	_status &= ~RS_MODIFIED;
 }
 
@@ -872,6 +936,15 @@ ResourceManager::ResourceManager(ScummEngine *vm) : _vm(vm) {
 	_maxHeapThreshold = 0;
 	_minHeapThreshold = 0;
 	_expireCounter = 0;
+	// Start high enough for every counter to map to a non-zero generation
+	_counterGeneration = RF_USAGE_MAX + 1;
+	_expireHead = _expireTail = kNoExpireEntry;
+	resetExpireStats();
+}
+
+void ResourceManager::resetExpireStats() {
+	memset(_expiredCount, 0, sizeof(_expiredCount));
+	memset(_reloadCount, 0, sizeof(_reloadCount));
 }
 
 ResourceManager::~ResourceManager() {
@@ -897,6 +970,8 @@ void ResourceManager::nukeResource(ResType type, ResId idx) {
 	byte *ptr = _types[type][idx]._address;
 	if (ptr != NULL) {
 		debugC(DEBUG_RESOURCE, "nukeResource(%s,%d)", nameOfResType(type), idx);
+		_vm->resourceChanged(type, idx);
+		unlinkExpireEntry(type, idx);
 		_allocatedSize -= _types[type][idx]._size;
 		_types[type][idx].nuke();
 	}
@@ -992,6 +1067,7 @@ void ResourceManager::setModified(ResType type, ResId idx) {
 	if (!validateResource("Modified", type, idx))
 		return;
 	_types[type][idx].setModified();
+	_vm->resourceChanged(type, idx);
 }
 
 void ResourceManager::setOffHeap(ResType type, ResId idx) {
@@ -1032,10 +1108,19 @@ void ResourceManager::Resource::setOnHeap() {
 	_status &= ~RF_OFFHEAP;
 }
 
+void ResourceManager::Resource::setExpired() {
+	_status |= RS_EXPIRED;
+}
+
+bool ResourceManager::Resource::wasExpired() const {
+	return (_status & RS_EXPIRED) != 0;
+}
+
+void ResourceManager::Resource::clearExpired() {
+	_status &= ~RS_EXPIRED;
+}
+
 void ResourceManager::expireResources(uint32 size) {
-	byte best_counter;
-	ResType best_type;
-	int best_res = 0;
 	uint32 oldAllocatedSize;
 
 	if (_expireCounter != 0xFF) {
@@ -1048,31 +1133,27 @@ void ResourceManager::expireResources(uint32 size) {
 
 	oldAllocatedSize = _allocatedSize;
 
-	do {
-		best_type = rtInvalid;
-		best_counter = 2;
-
-		for (ResType type = rtFirst; type <= rtLast; type = ResType(type + 1)) {
-			if (_types[type]._mode != kDynamicResTypeMode) {
-				// Resources of this type can be reloaded from the data files,
-				// so we can potentially unload them to free memory.
-				ResId idx = _types[type].size();
-				while (idx-- > 0) {
-					Resource &tmp = _types[type][idx];
-					byte counter = tmp.getResourceCounter();
-					if (!tmp.isLocked() && counter >= best_counter && tmp._address && !_vm->isResourceInUse(type, idx) && !tmp.isOffHeap()) {
-						best_counter = counter;
-						best_type = type;
-						best_res = idx;
-					}
-				}
-			}
+	// The expire list starts with the highest counters, so walk it until
+	// enough memory is free or only recently used resources (with a counter
+	// below 2) are left
+	uint32 entry = _expireHead;
+	while (entry != kNoExpireEntry && size + _allocatedSize > _minHeapThreshold) {
+		ResType type = ResType(entry >> 16);
+		ResId idx = entry & 0xFFFF;
+		Resource &tmp = _types[type][idx];
+		uint32 next = tmp._expireNext;
+
+		if (getResourceCounter(type, idx) < 2)
+			break;
+
+		if (!tmp.isLocked() && !_vm->isResourceInUse(type, idx) && !tmp.isOffHeap()) {
+			nukeResource(type, idx);
+			tmp.setExpired();
+			_expiredCount[type]++;
 		}
 
-		if (!best_type)
-			break;
-		nukeResource(best_type, best_res);
-	} while (size + _allocatedSize > _minHeapThreshold);
+		entry = next;
+	}
 
 	increaseResourceCounters();
 
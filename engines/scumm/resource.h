@@ -93,23 +93,36 @@ public:
 		uint32 _size;
 
 	protected:
+		friend class ResourceManager;
+
 		/**
 		 * The uppermost bit indicates whether the resources is locked.
-		 * The lower 7 bits contain a counter. This counter measures roughly
-		 * how old the resource is; it starts out with a count of 1 and can go
-		 * as high as 127. When memory falls low resp. when the engine decides
-		 * that it should throw out some unused stuff, then it begins by
-		 * removing the resources with the highest counter (excluding locked
-		 * resources and resources that are known to be in use).
 		 */
 		byte _flags;
 
 		/**
-		 * The status of the resource. Currently only one bit is used, which
-		 * indicates whether the resource is modified.
+		 * The status of the resource: whether it is modified, stored off
+		 * heap, or was expired since it was last loaded.
 		 */
 		byte _status;
 
+		/**
+		 * The resource counter generation in which the counter of this
+		 * resource was 1, or 0 if the resource has no counter. The counter
+		 * measures roughly how old the resource is; it starts out with a
+		 * count of 1 and can go as high as 127. When memory falls low resp.
+		 * when the engine decides that it should throw out some unused stuff,
+		 * then it begins by removing the resources with the highest counter
+		 * (excluding locked resources and resources that are known to be in
+		 * use).
+		 */
+		uint32 _counterGeneration;
+
+		/**
+		 * Neighbours in the expire list, or kNoExpireEntry.
+		 */
+		uint32 _expirePrev, _expireNext;
+
 	public:
 		/**
 		 * The id of the room (resp. the disk) the resource is contained in.
@@ -132,9 +145,6 @@ public:
 
 		void nuke();
 
-		inline void setResourceCounter(byte counter);
-		inline byte getResourceCounter() const;
-
 		void lock();
 		void unlock();
 		bool isLocked() const;
@@ -145,6 +155,10 @@ public:
 		void setOffHeap();
 		void setOnHeap();
 		bool isOffHeap() const;
+
+		void setExpired();
+		bool wasExpired() const;
+		void clearExpired();
 	};
 
 	/**
@@ -172,10 +186,30 @@ public:
 	ResTypeData _types[rtLast + 1];
 
 protected:
+	enum {
+		kNoExpireEntry = 0xFFFFFFFF
+	};
+
 	uint32 _allocatedSize;
 	uint32 _maxHeapThreshold, _minHeapThreshold;
 	byte _expireCounter;
 
+	/**
+	 * Incremented each time the resource counters are increased, so that
+	 * increasing them doesn't need to touch every resource.
+	 */
+	uint32 _counterGeneration;
+
+	/**
+	 * Loaded resources which can be reloaded from the game data files,
+	 * ordered by their counter, highest first. Entries are encoded by
+	 * makeExpireEntry().
+	 */
+	uint32 _expireHead, _expireTail;
+
+	uint32 _expiredCount[rtLast + 1];	///< Number of expired resources per type
+	uint32 _reloadCount[rtLast + 1];	///< Number of expired resources loaded again per type
+
 public:
 	ResourceManager(ScummEngine *vm);
 	~ResourceManager();
@@ -215,6 +249,11 @@ public:
 	 */
 	void setResourceCounter(ResType type, ResId idx, byte counter);
 
+	/**
+	 * Returns the specified resource's counter, 0 if it has none.
+	 */
+	byte getResourceCounter(ResType type, ResId idx) const;
+
 	/**
 	 * Increment the counter of all unlocked loaded resources.
 	 * The maximal count is 255.
@@ -225,10 +264,22 @@ public:
 
 	void resourceStats();
 
+	uint32 getAllocatedSize() const { return _allocatedSize; }
+	uint32 getMinHeapThreshold() const { return _minHeapThreshold; }
+	uint32 getMaxHeapThreshold() const { return _maxHeapThreshold; }
+	uint32 getExpiredCount(ResType type) const { return _expiredCount[type]; }
+	uint32 getReloadCount(ResType type) const { return _reloadCount[type]; }
+	void resetExpireStats();
+
 //protected:
 	bool validateResource(const char *str, ResType type, ResId idx) const;
 protected:
 	void expireResources(uint32 size);
+
+	static uint32 makeExpireEntry(ResType type, ResId idx) { return (type << 16) | idx; }
+	Resource &getExpireEntry(uint32 entry) { return _types[entry >> 16][entry & 0xFFFF]; }
+	void linkExpireEntry(ResType type, ResId idx);
+	void unlinkExpireEntry(ResType type, ResId idx);
 };
 
 } // End of namespace Scumm
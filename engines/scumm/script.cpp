@@ -27,6 +27,7 @@
 #include "scumm/actor.h"
 #include "scumm/object.h"
 #include "scumm/resource.h"
+#include "scumm/script_profiler.h"
 #include "scumm/util.h"
 #include "scumm/scumm_v0.h"
 #include "scumm/scumm_v2.h"
@@ -459,6 +460,11 @@ void ScummEngine::refreshScriptPointer() {
 /** Execute a script - Read opcode, and execute it from the table */
 void ScummEngine::executeScript() {
 	int c;
+
+	ScriptProfiler *profiler = (_scriptProfiler && _scriptProfiler->isEnabled()) ? _scriptProfiler : NULL;
+	if (profiler)
+		profiler->enterScript();
+
 	while (_currentScript != 0xFF) {
 
 		if (_showStack == 1) {
@@ -483,9 +489,18 @@ void ScummEngine::executeScript() {
 			debugN("\n");
 		}
 
+		if (profiler) {
+			const ScriptSlot &slot = vm.slot[_currentScript];
+			const bool inRoom = (slot.where == WIO_ROOM || slot.where == WIO_LOCAL);
+			profiler->beginOpcode(_currentScript, slot.where, slot.number, inRoom ? _roomResource : 0, _opcode);
+		}
+
 		executeOpcode(_opcode);
 
 	}
+
+	if (profiler)
+		profiler->leaveScript();
 }
 
 void ScummEngine::executeOpcode(byte i) {
@@ -0,0 +1,158 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "common/algorithm.h"
+#include "common/system.h"
+
+#include "scumm/script_profiler.h"
+
+namespace Scumm {
+
+ScriptProfiler::ScriptProfiler() : _enabled(false) {
+	reset();
+}
+
+void ScriptProfiler::setEnabled(bool enabled) {
+	// The debugger only changes this between frames, when no script runs
+	assert(_stack.empty());
+	_enabled = enabled;
+}
+
+void ScriptProfiler::reset() {
+	_scripts.clear();
+	memset(_opcodes, 0, sizeof(_opcodes));
+	_switches = 0;
+
+	_curScript = 0;
+	_curOpcode = -1;
+	_curSlot = -1;
+	_lastTicks = 0;
+}
+
+uint64 ScriptProfiler::getTicks() {
+#if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+	return __builtin_ia32_rdtsc();
+#else
+	return g_system->getMillis();
+#endif
+}
+
+const char *ScriptProfiler::getTickUnit() {
+#if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+	return "cycles";
+#else
+	return "ms";
+#endif
+}
+
+void ScriptProfiler::charge(uint64 now) {
+	if (_curOpcode < 0)
+		return;
+
+	const uint64 ticks = now - _lastTicks;
+	_opcodes[_curOpcode].ticks += ticks;
+	if (_curScript)
+		_curScript->ticks += ticks;
+}
+
+void ScriptProfiler::enterScript() {
+	const uint64 now = getTicks();
+	charge(now);
+
+	Frame frame;
+	frame.script = _curScript;
+	frame.opcode = _curOpcode;
+	frame.slot = _curSlot;
+	_stack.push_back(frame);
+
+	_curScript = 0;
+	_curOpcode = -1;
+	_curSlot = -1;
+	_lastTicks = now;
+}
+
+void ScriptProfiler::leaveScript() {
+	if (_stack.empty())
+		return;
+
+	const uint64 now = getTicks();
+	charge(now);
+
+	_curScript = _stack.back().script;
+	_curOpcode = _stack.back().opcode;
+	// Returning to the caller is no switch to another script
+	_curSlot = _stack.back().slot;
+	_stack.pop_back();
+	_lastTicks = now;
+}
+
+void ScriptProfiler::beginOpcode(byte slot, byte where, uint16 number, uint16 room, byte opcode) {
+	const uint64 now = getTicks();
+	charge(now);
+
+	// Only look the script up when execution switched to another slot
+	if (!_curScript || slot != _curSlot) {
+		ScriptKey key;
+		key.where = where;
+		key.number = number;
+		key.room = room;
+
+		ScriptMap::iterator it = _scripts.find(key);
+		if (it == _scripts.end()) {
+			ScriptStats &stats = _scripts[key];
+			stats.where = where;
+			stats.number = number;
+			stats.room = room;
+			stats.opcodes = 0;
+			stats.switches = 0;
+			stats.ticks = 0;
+			_curScript = &stats;
+		} else {
+			_curScript = &it->_value;
+		}
+
+		_curScript->switches++;
+		_switches++;
+		_curSlot = slot;
+	}
+
+	_curScript->opcodes++;
+	_opcodes[opcode].count++;
+	_curOpcode = opcode;
+	_lastTicks = now;
+}
+
+struct ScriptStatsTicksGreater {
+	bool operator()(const ScriptProfiler::ScriptStats &a, const ScriptProfiler::ScriptStats &b) const {
+		return a.ticks > b.ticks;
+	}
+};
+
+void ScriptProfiler::getScriptStats(Common::Array<ScriptStats> &stats) const {
+	stats.clear();
+	for (ScriptMap::const_iterator it = _scripts.begin(); it != _scripts.end(); ++it)
+		stats.push_back(it->_value);
+
+	Common::sort(stats.begin(), stats.end(), ScriptStatsTicksGreater());
+}
+
+} // End of namespace Scumm
@@ -0,0 +1,121 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef SCUMM_SCRIPT_PROFILER_H
+#define SCUMM_SCRIPT_PROFILER_H
+
+#include "common/array.h"
+#include "common/hashmap.h"
+#include "common/scummsys.h"
+
+namespace Scumm {
+
+/**
+ * Collects opcode counts and execution times of SCUMM scripts, per script
+ * and per opcode. Times are measured in ticks of getTicks(), and are
+ * exclusive: the time spent in a nested script is only counted for the
+ * nested script.
+ */
+class ScriptProfiler {
+public:
+	struct ScriptStats {
+		byte where;		///< WIO_* type of the script
+		uint16 number;
+		uint16 room;	///< Room of room and local scripts, 0 otherwise
+		uint32 opcodes;	///< Number of opcodes executed
+		uint32 switches;	///< Number of times execution switched to the script
+		uint64 ticks;
+	};
+
+	struct OpcodeStats {
+		uint32 count;
+		uint64 ticks;
+	};
+
+	ScriptProfiler();
+
+	bool isEnabled() const { return _enabled; }
+	void setEnabled(bool enabled);
+	void reset();
+
+	/**
+	 * Called when ScummEngine::executeScript() starts and stops executing
+	 * scripts. Calls may be nested, if a script runs another one.
+	 */
+	void enterScript();
+	void leaveScript();
+
+	/** Called right before an opcode gets executed. */
+	void beginOpcode(byte slot, byte where, uint16 number, uint16 room, byte opcode);
+
+	/** Get the statistics of all scripts, most expensive first. */
+	void getScriptStats(Common::Array<ScriptStats> &stats) const;
+	const OpcodeStats &getOpcodeStats(byte opcode) const { return _opcodes[opcode]; }
+	uint32 getSwitchCount() const { return _switches; }
+
+	/** Name of the unit of the tick counts. */
+	static const char *getTickUnit();
+
+private:
+	struct ScriptKey {
+		byte where;
+		uint16 number;
+		uint16 room;
+
+		bool operator==(const ScriptKey &key) const {
+			return where == key.where && number == key.number && room == key.room;
+		}
+	};
+
+	struct ScriptKeyHash {
+		uint operator()(const ScriptKey &key) const {
+			return (key.where << 28) ^ (key.room << 16) ^ key.number;
+		}
+	};
+
+	struct Frame {
+		ScriptStats *script;
+		int opcode;
+		int slot;
+	};
+
+	typedef Common::HashMap<ScriptKey, ScriptStats, ScriptKeyHash> ScriptMap;
+
+	static uint64 getTicks();
+	void charge(uint64 now);
+
+	bool _enabled;
+	ScriptMap _scripts;
+	OpcodeStats _opcodes[256];
+	uint32 _switches;
+
+	// Currently executing script and opcode
+	ScriptStats *_curScript;
+	int _curOpcode;
+	int _curSlot;
+	uint64 _lastTicks;
+	Common::Array<Frame> _stack;
+};
+
+} // End of namespace Scumm
+
+#endif
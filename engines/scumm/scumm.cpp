@@ -67,6 +67,7 @@
 #include "scumm/players/player_v5m.h"
 #include "scumm/resource.h"
 #include "scumm/he/resource_he.h"
+#include "scumm/script_profiler.h"
 #include "scumm/scumm_v0.h"
 #include "scumm/scumm_v8.h"
 #include "scumm/sound.h"
@@ -318,6 +319,7 @@ ScummEngine::ScummEngine(OSystem *syst, const DetectorResult &dr)
 	_keepText = false;
 	_costumeLoader = NULL;
 	_costumeRenderer = NULL;
+	_scriptProfiler = NULL;
 	_2byteFontPtr = 0;
 	_V1TalkingActor = 0;
 	_NESStartStrip = 0;
@@ -645,6 +647,7 @@ ScummEngine::~ScummEngine() {
 #endif
 
 	delete _debugger;
+	delete _scriptProfiler;
 
 	delete _res;
 	delete _gdi;
@@ -838,6 +841,11 @@ ScummEngine_v71he::~ScummEngine_v71he() {
 	delete _wiz;
 }
 
+void ScummEngine_v71he::resourceChanged(ResType type, ResId idx) {
+	if (type == rtImage)
+		_wiz->flushImageCache(idx);
+}
+
 ScummEngine_v72he::ScummEngine_v72he(OSystem *syst, const DetectorResult &dr)
 	: ScummEngine_v71he(syst, dr) {
 	VAR_NUM_ROOMS = 0xFF;
@@ -88,6 +88,7 @@ class MusicEngine;
 class Player_Towns;
 class ScummEngine;
 class ScummDebugger;
+class ScriptProfiler;
 class Serializer;
 class Sound;
 
@@ -646,6 +647,8 @@ protected:
 
 	OpcodeEntry _opcodes[256];
 
+	ScriptProfiler *_scriptProfiler;
+
 	virtual void setupOpcodes() = 0;
 	void executeOpcode(byte i);
 	const char *getOpcodeDesc(byte i);
@@ -761,6 +764,12 @@ protected:
 	int readSoundResourceSmallHeader(ResId idx);
 	bool isResourceInUse(ResType type, ResId idx) const;
 
+	/**
+	 * Called when a resource is nuked or marked as modified, so that data
+	 * derived from it can be dropped.
+	 */
+	virtual void resourceChanged(ResType type, ResId idx) {}
+
 	virtual void setupRoomSubBlocks();
 	virtual void resetRoomSubBlocks();
 
@@ -27,6 +27,10 @@
 #include "scumm/bomp.h"
 #include "scumm/smush/codec37.h"
 
+#ifdef USE_SSE2_SMUSH
+#include <emmintrin.h>
+#endif
+
 namespace Scumm {
 
 Codec37Decoder::Codec37Decoder(int width, int height) {
@@ -325,6 +329,23 @@ void Codec37Decoder::maketable(int pitch, int index) {
 		dst += 4;						  \
 	} while (0)
 
+/* Copy a run of horizontally adjacent 4x4 pixel blocks from the other delta buffer */
+
+static void copyBlockRun(byte *dst, const byte *src, int32 blocks, int pitch) {
+	const int32 width = blocks * 4;
+	for (int y = 0; y < 4; y++) {
+		int32 x = 0;
+#ifdef USE_SSE2_SMUSH
+		for (; x + 16 <= width; x += 16)
+			_mm_storeu_si128((__m128i *)(dst + x), _mm_loadu_si128((const __m128i *)(src + x)));
+#endif
+		for (; x < width; x += 4)
+			COPY_4X1_LINE(dst + x, src + x);
+		dst += pitch;
+		src += pitch;
+	}
+}
+
 void Codec37Decoder::proc1(byte *dst, const byte *src, int32 next_offs, int bw, int bh, int pitch, int16 *offset_table) {
 	uint8 code;
 	bool filling, skipCode;
@@ -439,10 +460,13 @@ void Codec37Decoder::proc4WithFDFE(byte *dst, const byte *src, int32 next_offs,
 				LITERAL_1X1(src, dst, pitch);
 			} else if (code == 0x00) {
 				int32 length = *src++ + 1;
-				for (int32 l = 0; l < length; l++) {
-					byte *dst2 = dst + next_offs;
-					COPY_4X4(dst2, dst, pitch);
-					i--;
+				while (length > 0) {
+					// Copy the blocks up to the end of the row at once
+					int32 count = MIN(length, i);
+					copyBlockRun(dst, dst + next_offs, count, pitch);
+					dst += count * 4;
+					length -= count;
+					i -= count;
 					if (i == 0) {
 						dst += pitch * 3;
 						bh--;
@@ -471,10 +495,13 @@ void Codec37Decoder::proc4WithoutFDFE(byte *dst, const byte *src, int32 next_off
 				LITERAL_1X1(src, dst, pitch);
 			} else if (code == 0x00) {
 				int32 length = *src++ + 1;
-				for (int32 l = 0; l < length; l++) {
-					byte *dst2 = dst + next_offs;
-					COPY_4X4(dst2, dst, pitch);
-					i--;
+				while (length > 0) {
+					// Copy the blocks up to the end of the row at once
+					int32 count = MIN(length, i);
+					copyBlockRun(dst, dst + next_offs, count, pitch);
+					dst += count * 4;
+					length -= count;
+					i -= count;
 					if (i == 0) {
 						dst += pitch * 3;
 						bh--;
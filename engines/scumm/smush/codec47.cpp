@@ -27,6 +27,10 @@
 #include "scumm/bomp.h"
 #include "scumm/smush/codec47.h"
 
+#ifdef USE_SSE2_SMUSH
+#include <emmintrin.h>
+#endif
+
 namespace Scumm {
 
 #if defined(SCUMM_NEED_ALIGNMENT)
@@ -70,6 +74,33 @@ namespace Scumm {
 		(dst)[1] = val;	\
 	} while (0)
 
+#ifdef USE_SSE2_SMUSH
+
+// The rows of 8x8 blocks are copied and filled with single 64-bit moves.
+// These are bit-exact with the generic versions below.
+
+#define COPY_8X1_LINE(dst, src)			\
+	_mm_storel_epi64((__m128i *)(dst), _mm_loadl_epi64((const __m128i *)(src)))
+
+#define FILL_8X1_LINE(dst, val)			\
+	_mm_storel_epi64((__m128i *)(dst), _mm_set1_epi8((char)(val)))
+
+#else /* USE_SSE2_SMUSH */
+
+#define COPY_8X1_LINE(dst, src)			\
+	do {					\
+		COPY_4X1_LINE(dst, src);	\
+		COPY_4X1_LINE((dst) + 4, (src) + 4);	\
+	} while (0)
+
+#define FILL_8X1_LINE(dst, val)			\
+	do {					\
+		FILL_4X1_LINE(dst, val);	\
+		FILL_4X1_LINE((dst) + 4, val);	\
+	} while (0)
+
+#endif /* USE_SSE2_SMUSH */
+
 static const  int8 codec47_table_small1[] = {
   0, 1, 2, 3, 3, 3, 3, 2, 1, 0, 0, 0, 1, 2, 2, 1,
 };
@@ -451,8 +482,7 @@ void Codec47Decoder::level1(byte *d_dst) {
 	if (code < 0xF8) {
 		tmp2 = _table[code] + _offset1;
 		for (i = 0; i < 8; i++) {
-			COPY_4X1_LINE(d_dst + 0, d_dst + tmp2);
-			COPY_4X1_LINE(d_dst + 4, d_dst + tmp2 + 4);
+			COPY_8X1_LINE(d_dst, d_dst + tmp2);
 			d_dst += _d_pitch;
 		}
 	} else if (code == 0xFF) {
@@ -466,8 +496,7 @@ void Codec47Decoder::level1(byte *d_dst) {
 	} else if (code == 0xFE) {
 		byte t = *_d_src++;
 		for (i = 0; i < 8; i++) {
-			FILL_4X1_LINE(d_dst, t);
-			FILL_4X1_LINE(d_dst + 4, t);
+			FILL_8X1_LINE(d_dst, t);
 			d_dst += _d_pitch;
 		}
 	} else if (code == 0xFD) {
@@ -490,15 +519,13 @@ void Codec47Decoder::level1(byte *d_dst) {
 	} else if (code == 0xFC) {
 		tmp2 = _offset2;
 		for (i = 0; i < 8; i++) {
-			COPY_4X1_LINE(d_dst + 0, d_dst + tmp2);
-			COPY_4X1_LINE(d_dst + 4, d_dst + tmp2 + 4);
+			COPY_8X1_LINE(d_dst, d_dst + tmp2);
 			d_dst += _d_pitch;
 		}
 	} else {
 		byte t = _paramPtr[code];
 		for (i = 0; i < 8; i++) {
-			FILL_4X1_LINE(d_dst, t);
-			FILL_4X1_LINE(d_dst + 4, t);
+			FILL_8X1_LINE(d_dst, t);
 			d_dst += _d_pitch;
 		}
 	}
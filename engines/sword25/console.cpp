@@ -22,14 +22,42 @@
 
 #include "sword25/console.h"
 #include "sword25/sword25.h"
+#include "sword25/kernel/kernel.h"
+#include "sword25/kernel/persistenceservice.h"
+#include "sword25/gfx/graphicengine.h"
+#include "sword25/gfx/renderobjectmanager.h"
 
 namespace Sword25 {
 
 Sword25Console::Sword25Console(Sword25Engine *vm) : GUI::Debugger(), _vm(vm) {
 	assert(_vm);
+
+	registerCmd("render_stats", WRAP_METHOD(Sword25Console, Cmd_RenderStats));
+	registerCmd("save_stats", WRAP_METHOD(Sword25Console, Cmd_SaveStats));
 }
 
 Sword25Console::~Sword25Console() {
 }
 
+bool Sword25Console::Cmd_RenderStats(int argc, const char **argv) {
+	GraphicEngine *gfx = Kernel::getInstance()->getGfx();
+	if (!gfx || !gfx->getRenderObjectManager()) {
+		debugPrintf("The graphics engine is not running\n");
+		return true;
+	}
+
+	const RenderObjectManager::FrameStats &stats = gfx->getRenderObjectManager()->getLastFrameStats();
+	debugPrintf("Render objects: %d\n", stats.objects);
+	debugPrintf("Update rects: %d\n", stats.updateRects);
+	debugPrintf("Pixels redrawn: %d\n", stats.pixels);
+	return true;
+}
+
+bool Sword25Console::Cmd_SaveStats(int argc, const char **argv) {
+	const PersistenceService::Stats &stats = PersistenceService::getInstance().getStats();
+	debugPrintf("Last save: %d ms, %d bytes of game data\n", stats.saveTime, stats.saveSize);
+	debugPrintf("Last load: %d ms, %d bytes of game data\n", stats.loadTime, stats.loadSize);
+	return true;
+}
+
 } // End of namespace Sword25
@@ -32,7 +32,7 @@
 #include "sword25/gfx/animationresource.h"
 
 #include "sword25/kernel/kernel.h"
-#include "sword25/kernel/resmanager.h" // for PRECACHE_RESOURCES
+#include "sword25/kernel/resmanager.h"
 #include "sword25/package/packagemanager.h"
 #include "sword25/gfx/bitmapresource.h"
 
@@ -206,14 +206,9 @@ AnimationResource::~AnimationResource() {
 bool AnimationResource::precacheAllFrames() const {
 	Common::Array<Frame>::const_iterator iter = _frames.begin();
 	for (; iter != _frames.end(); ++iter) {
-#ifdef PRECACHE_RESOURCES
-		if (!Kernel::getInstance()->getResourceManager()->precacheResource((*iter).fileName)) {
-			error("Could not precache \"%s\".", (*iter).fileName.c_str());
-			return false;
-		}
-#else
-		Kernel::getInstance()->getResourceManager()->requestResource((*iter).fileName);
-#endif
+		// A frame that can't be precached is loaded again when it is drawn
+		if (!Kernel::getInstance()->getResourceManager()->precacheResource((*iter).fileName))
+			warning("Could not precache \"%s\".", (*iter).fileName.c_str());
 	}
 
 	return true;
@@ -54,6 +54,9 @@ public:
 	virtual uint getFrameCount() const {
 		return _frames.size();
 	}
+	virtual uint getMemorySize() const {
+		return _frames.size() * sizeof(Frame);
+	}
 	virtual void unlock() {
 		release();
 	}
@@ -30,7 +30,7 @@
  */
 
 #include "sword25/kernel/kernel.h"
-#include "sword25/kernel/resmanager.h" // for PRECACHE_RESOURCES
+#include "sword25/kernel/resmanager.h"
 #include "sword25/package/packagemanager.h"
 
 #include "sword25/gfx/fontresource.h"
@@ -98,14 +98,10 @@ bool FontResource::parserCallback_font(ParserNode *node) {
 		               _bitmapFileName.c_str(), getFileName().c_str());
 	}
 
-#ifdef PRECACHE_RESOURCES
-	// Pre-cache the resource
+	// Pre-cache the resource. If that fails, it is loaded again when the font is drawn
 	if (!_pKernel->getResourceManager()->precacheResource(_bitmapFileName)) {
-		error("Could not precache \"%s\".", _bitmapFileName.c_str());
+		warning("Could not precache \"%s\".", _bitmapFileName.c_str());
 	}
-#else
-	_pKernel->getResourceManager()->requestResource(_bitmapFileName);
-#endif
 
 	return true;
 }
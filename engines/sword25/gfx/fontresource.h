@@ -61,6 +61,10 @@ public:
 		return _valid;
 	}
 
+	virtual uint getMemorySize() const {
+		return sizeof(_characterRects);
+	}
+
 	/**
 	    @brief Gibt die Zeilenhhe des Fonts in Pixeln zurck.
 
@@ -148,6 +148,9 @@ bool GraphicEngine::endFrame() {
 
 	g_system->updateScreen();
 
+	// Use the rest of the frame to load resources requested by the scripts in advance
+	Kernel::getInstance()->getResourceManager()->processPrecacheQueue();
+
 	return true;
 }
 
@@ -145,6 +145,13 @@ public:
 
 	RenderObjectPtr<Panel> getMainPanel();
 
+	/**
+	 * Returns the manager of the render object tree.
+	 */
+	RenderObjectManager *getRenderObjectManager() {
+		return _renderObjectManagerPtr.get();
+	}
+
 	/**
 	 * Specifies the time (in microseconds) since the last frame has passed
 	 */
@@ -43,6 +43,15 @@ namespace Sword25 {
 
 #define BEZSMOOTHNESS 0.5
 
+// The maximum amount of memory in bytes used by the rasters cached for all vector images
+#define VECTORIMAGE_CACHE_SIZE (16 * 1024 * 1024)
+// A size the image was not recently drawn at reuses a raster which differs by no more
+// than 1/VECTORIMAGE_SIZE_TOLERANCE from it
+#define VECTORIMAGE_SIZE_TOLERANCE 16
+
+Common::List<VectorImage::RasterCacheEntry> VectorImage::_rasterCache;
+uint VectorImage::_rasterCacheSize = 0;
+
 // -----------------------------------------------------------------------------
 // SWF datatype
 // -----------------------------------------------------------------------------
@@ -215,7 +224,11 @@ Common::Rect CalculateBoundingBox(const VectorImageElement &vectorImageElement)
 // Construction
 // -----------------------------------------------------------------------------
 
-VectorImage::VectorImage(const byte *pFileData, uint fileSize, bool &success, const Common::String &fname) : _pixelData(0), _fname(fname) {
+VectorImage::VectorImage(const byte *pFileData, uint fileSize, bool &success, const Common::String &fname) :
+	_requestedSizePos(0), _fname(fname) {
+	for (uint i = 0; i < REQUESTED_SIZE_COUNT; i++)
+		_requestedSizes[i] = Common::Point(-1, -1);
+
 	success = false;
 
 	// Create bitstream object
@@ -300,8 +313,16 @@ VectorImage::~VectorImage() {
 			if (_elements[j].getPathInfo(i).getVec())
 				free(_elements[j].getPathInfo(i).getVec());
 
-	if (_pixelData)
-		free(_pixelData);
+	Common::List<RasterCacheEntry>::iterator it = _rasterCache.begin();
+	while (it != _rasterCache.end()) {
+		if (it->image == this) {
+			_rasterCacheSize -= it->width * it->height * 4;
+			free(it->pixelData);
+			it = _rasterCache.erase(it);
+		} else {
+			++it;
+		}
+	}
 }
 
 
@@ -605,26 +626,20 @@ bool VectorImage::blit(int posX, int posY,
                        uint color,
                        int width, int height,
 					   RectangleList *updateRects) {
-	static VectorImage *oldThis = 0;
-	static int              oldWidth = -2;
-	static int              oldHeight = -2;
-
 	// If width or height to 0, nothing needs to be shown.
 	if (width == 0 || height == 0)
 		return true;
 
-	// Determine if the old image in the cache can not be reused and must be recalculated
-	if (!(oldThis == this && oldWidth == width && oldHeight == height)) {
-		render(width, height);
+	if (width == -1)
+		width = getWidth();
+	if (height == -1)
+		height = getHeight();
 
-		oldThis = this;
-		oldHeight = height;
-		oldWidth = width;
-	}
+	const RasterCacheEntry &raster = getRaster(width, height);
 
 	RenderedImage *rend = new RenderedImage();
 
-	rend->replaceContent(_pixelData, width, height);
+	rend->replaceContent(raster.pixelData, raster.width, raster.height);
 	rend->blit(posX, posY, flipping, pPartRect, color, width, height, updateRects);
 
 	delete rend;
@@ -632,4 +647,68 @@ bool VectorImage::blit(int posX, int posY,
 	return true;
 }
 
+bool VectorImage::wasRequested(int width, int height) const {
+	for (uint i = 0; i < REQUESTED_SIZE_COUNT; i++) {
+		if (_requestedSizes[i].x == width && _requestedSizes[i].y == height)
+			return true;
+	}
+
+	return false;
+}
+
+const VectorImage::RasterCacheEntry &VectorImage::getRaster(int width, int height) {
+	// A size that was not requested recently, e.g. during a zoom animation, may use
+	// a raster close to it, which is scaled by the blitter instead of rasterizing the
+	// image on every frame. Sizes which are requested again, even alternating with
+	// other sizes when several objects show the same image, are rasterized exactly.
+	bool exactOnly = wasRequested(width, height);
+	if (!exactOnly) {
+		_requestedSizes[_requestedSizePos] = Common::Point(width, height);
+		_requestedSizePos = (_requestedSizePos + 1) % REQUESTED_SIZE_COUNT;
+	}
+
+	Common::List<RasterCacheEntry>::iterator found = _rasterCache.end();
+	for (Common::List<RasterCacheEntry>::iterator it = _rasterCache.begin(); it != _rasterCache.end(); ++it) {
+		if (it->image != this)
+			continue;
+
+		if (it->width == width && it->height == height) {
+			found = it;
+			break;
+		}
+
+		if (!exactOnly && found == _rasterCache.end() &&
+			ABS(it->width - width) <= width / VECTORIMAGE_SIZE_TOLERANCE &&
+			ABS(it->height - height) <= height / VECTORIMAGE_SIZE_TOLERANCE)
+			found = it;
+	}
+
+	if (found != _rasterCache.end()) {
+		if (found != _rasterCache.begin()) {
+			RasterCacheEntry entry = *found;
+			_rasterCache.erase(found);
+			_rasterCache.push_front(entry);
+		}
+		return _rasterCache.front();
+	}
+
+	RasterCacheEntry entry;
+	entry.image = this;
+	entry.width = width;
+	entry.height = height;
+	entry.pixelData = render(width, height);
+	_rasterCache.push_front(entry);
+	_rasterCacheSize += width * height * 4;
+
+	// Drop the least recently used rasters, but always keep the one just created
+	while (_rasterCacheSize > VECTORIMAGE_CACHE_SIZE && _rasterCache.size() > 1) {
+		RasterCacheEntry &last = _rasterCache.back();
+		_rasterCacheSize -= last.width * last.height * 4;
+		free(last.pixelData);
+		_rasterCache.pop_back();
+	}
+
+	return _rasterCache.front();
+}
+
 } // End of namespace Sword25
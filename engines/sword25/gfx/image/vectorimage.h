@@ -39,6 +39,7 @@
 #include "sword25/kernel/common.h"
 #include "sword25/gfx/image/image.h"
 #include "common/rect.h"
+#include "common/list.h"
 
 #include "art.h"
 
@@ -183,7 +184,11 @@ public:
 	}
 	virtual bool fill(const Common::Rect *pFillRect = 0, uint color = BS_RGB(0, 0, 0));
 
-	void render(int width, int height);
+	/**
+	 * Rasterizes the image at the given size into a newly allocated ARGB buffer,
+	 * which has to be freed by the caller
+	 */
+	byte *render(int width, int height);
 
 	virtual uint getPixel(int x, int y);
 	virtual bool isBlitSource() const {
@@ -225,7 +230,27 @@ private:
 	Common::Array<VectorImageElement>    _elements;
 	Common::Rect                         _boundingBox;
 
-	byte *_pixelData;
+	struct RasterCacheEntry {
+		const VectorImage *image;
+		int width;
+		int height;
+		byte *pixelData;
+	};
+
+	const RasterCacheEntry &getRaster(int width, int height);
+	bool wasRequested(int width, int height) const;
+
+	// The vector images rasterized at the sizes they were last drawn, most recently used first.
+	// The cache is shared by all vector images, so that its memory use has a single limit.
+	static Common::List<RasterCacheEntry> _rasterCache;
+	static uint _rasterCacheSize;
+
+	// The sizes this image was last requested at, oldest overwritten first
+	enum {
+		REQUESTED_SIZE_COUNT = 8
+	};
+	Common::Point _requestedSizes[REQUESTED_SIZE_COUNT];
+	uint _requestedSizePos;
 
 	Common::String _fname;
 };
@@ -60,29 +60,21 @@ void art_rgb_fill_run1(byte *buf, byte r, byte g, byte b, int n) {
 }
 
 void art_rgb_run_alpha1(byte *buf, byte r, byte g, byte b, int alpha, int n) {
-	int i;
-	int v;
-
-	for (i = 0; i < n; i++) {
-#if defined(SCUMM_LITTLE_ENDIAN)
-		v = *buf;
-		*buf++ = MIN(v + alpha, 0xff);
-		v = *buf;
-		*buf++ = v + (((b - v) * alpha + 0x80) >> 8);
-		v = *buf;
-		*buf++ = v + (((g - v) * alpha + 0x80) >> 8);
-		v = *buf;
-		*buf++ = v + (((r - v) * alpha + 0x80) >> 8);
-#else
-		v = *buf;
-		*buf++ = v + (((r - v) * alpha + 0x80) >> 8);
-		v = *buf;
-		*buf++ = v + (((g - v) * alpha + 0x80) >> 8);
-		v = *buf;
-		*buf++ = v + (((b - v) * alpha + 0x80) >> 8);
-		v = *buf;
-		*buf++ = MIN(v + alpha, 0xff);
-#endif
+	// Each color channel becomes v + ((c - v) * alpha + 0x80) >> 8, which equals
+	// (v * (256 - alpha) + c * alpha + 0x80) >> 8 and never exceeds 16 bits. This
+	// allows blending the blue and red channels with a single multiplication.
+	// On both byte orders the pixel read as uint32 holds A, B, G, R from the low byte up.
+	uint32 *pixel = (uint32 *)buf;
+	uint32 invAlpha = 256 - alpha;
+	uint32 addBR = (b * alpha + 0x80) | ((r * alpha + 0x80) << 16);
+	uint32 addG = g * alpha + 0x80;
+
+	for (int i = 0; i < n; i++) {
+		uint32 v = *pixel;
+		uint32 br = ((((v >> 8) & 0x00FF00FF) * invAlpha + addBR) >> 8) & 0x00FF00FF;
+		uint32 gv = (((v >> 16) & 0xFF) * invAlpha + addG) >> 8;
+		uint32 av = MIN<uint32>((v & 0xFF) + alpha, 0xFF);
+		*pixel++ = (br << 8) | (gv << 16) | av;
 	}
 }
 
@@ -401,17 +393,14 @@ void drawBez(ArtBpath *bez1, ArtBpath *bez2, byte *buffer, int width, int height
 	free(vec);
 }
 
-void VectorImage::render(int width, int height) {
+byte *VectorImage::render(int width, int height) {
 	double scaleX = (width == - 1) ? 1 : static_cast<double>(width) / static_cast<double>(getWidth());
 	double scaleY = (height == - 1) ? 1 : static_cast<double>(height) / static_cast<double>(getHeight());
 
 	debug(3, "VectorImage::render(%d, %d) %s", width, height, _fname.c_str());
 
-	if (_pixelData)
-		free(_pixelData);
-
-	_pixelData = (byte *)malloc(width * height * 4);
-	memset(_pixelData, 0, width * height * 4);
+	byte *pixelData = (byte *)malloc(width * height * 4);
+	memset(pixelData, 0, width * height * 4);
 
 	for (uint e = 0; e < _elements.size(); e++) {
 
@@ -452,7 +441,7 @@ void VectorImage::render(int width, int height) {
 			(*fill0pos).code = ART_END;
 			(*fill1pos).code = ART_END;
 
-			drawBez(fill1, fill0, _pixelData, width, height, _boundingBox.left, _boundingBox.top, scaleX, scaleY, -1, _elements[e].getFillStyleColor(s));
+			drawBez(fill1, fill0, pixelData, width, height, _boundingBox.left, _boundingBox.top, scaleX, scaleY, -1, _elements[e].getFillStyleColor(s));
 
 			free(fill0);
 			free(fill1);
@@ -465,11 +454,13 @@ void VectorImage::render(int width, int height) {
 
 			for (uint p = 0; p < _elements[e].getPathCount(); p++) {
 				if (_elements[e].getPathInfo(p).getLineStyle() == s + 1) {
-					drawBez(_elements[e].getPathInfo(p).getVec(), 0, _pixelData, width, height, _boundingBox.left, _boundingBox.top, scaleX, scaleY, penWidth, _elements[e].getLineStyleColor(s));
+					drawBez(_elements[e].getPathInfo(p).getVec(), 0, pixelData, width, height, _boundingBox.left, _boundingBox.top, scaleX, scaleY, penWidth, _elements[e].getLineStyleColor(s));
 				}
 			}
 		}
 	}
+
+	return pixelData;
 }
 
 
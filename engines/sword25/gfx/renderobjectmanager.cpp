@@ -47,18 +47,24 @@ namespace Sword25 {
 
 void RenderObjectQueue::add(RenderObject *renderObject) {
 	push_back(RenderObjectQueueItem(renderObject, renderObject->getBbox(), renderObject->getVersion()));
+	_index[ItemKey(renderObject, renderObject->getVersion())] = true;
 }
 
 bool RenderObjectQueue::exists(const RenderObjectQueueItem &renderObjectQueueItem) {
-	for (RenderObjectQueue::iterator it = begin(); it != end(); ++it)
-		if ((*it)._renderObject == renderObjectQueueItem._renderObject &&
-			(*it)._version == renderObjectQueueItem._version)
-			return true;
-	return false;
+	return _index.contains(ItemKey(renderObjectQueueItem._renderObject, renderObjectQueueItem._version));
+}
+
+void RenderObjectQueue::clear() {
+	Common::List<RenderObjectQueueItem>::clear();
+	_index.clear();
 }
 
 RenderObjectManager::RenderObjectManager(int width, int height, int framebufferCount) :
 	_frameStarted(false) {
+	_lastFrameStats.objects = 0;
+	_lastFrameStats.updateRects = 0;
+	_lastFrameStats.pixels = 0;
+
 	// Wurzel des BS_RenderObject-Baumes erzeugen.
 	_rootPtr = (new RootRenderObject(this, width, height))->getHandle();
 	_uta = new MicroTileArray(width, height);
@@ -119,19 +125,30 @@ bool RenderObjectManager::render() {
 
 	updateRectsMinZ.reserve(updateRects->size());
 
+	// Only visible solid objects can hide what is below them, collect them
+	// once, topmost first, instead of filtering the whole queue for each rectangle
+	Common::Array<RenderObject *> occluders;
+	for (RenderObjectQueue::iterator it = _currQueue->reverse_begin(); it != _currQueue->end(); --it) {
+		if ((*it)._renderObject->isVisible() && (*it)._renderObject->isSolid())
+			occluders.push_back((*it)._renderObject);
+	}
+
 	// Calculate the minimum drawing Z value of each update rectangle
 	// Solid bitmaps with a Z order less than the value calculated here would be overdrawn again and
 	// so don't need to be drawn in the first place which speeds things up a bit.
+	_lastFrameStats.objects = _currQueue->size();
+	_lastFrameStats.updateRects = updateRects->size();
+	_lastFrameStats.pixels = 0;
 	for (RectangleList::iterator rectIt = updateRects->begin(); rectIt != updateRects->end(); ++rectIt) {
 		int minZ = 0;
-		for (RenderObjectQueue::iterator it = _currQueue->reverse_begin(); it != _currQueue->end(); --it) {
-			if ((*it)._renderObject->isVisible() && (*it)._renderObject->isSolid() &&
-				(*it)._renderObject->getBbox().contains(*rectIt)) {
-				minZ = (*it)._renderObject->getAbsoluteZ();
+		for (uint i = 0; i < occluders.size(); i++) {
+			if (occluders[i]->getBbox().contains(*rectIt)) {
+				minZ = occluders[i]->getAbsoluteZ();
 				break;
 			}
 		}
 		updateRectsMinZ.push_back(minZ);
+		_lastFrameStats.pixels += (*rectIt).width() * (*rectIt).height();
 	}
 
 	if (_rootPtr->render(updateRects, updateRectsMinZ)) {
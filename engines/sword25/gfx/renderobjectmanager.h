@@ -43,6 +43,7 @@
 #define SWORD25_RENDEROBJECTMANAGER_H
 
 #include "common/rect.h"
+#include "common/hashmap.h"
 #include "sword25/kernel/common.h"
 #include "sword25/gfx/renderobjectptr.h"
 #include "sword25/kernel/persistable.h"
@@ -68,6 +69,25 @@ class RenderObjectQueue : public Common::List<RenderObjectQueueItem> {
 public:
 	void add(RenderObject *renderObject);
 	bool exists(const RenderObjectQueueItem &renderObjectQueueItem);
+	void clear();
+
+private:
+	struct ItemKey {
+		RenderObject *_renderObject;
+		int _version;
+		ItemKey(RenderObject *renderObject, int version) : _renderObject(renderObject), _version(version) {}
+		bool operator==(const ItemKey &other) const {
+			return _renderObject == other._renderObject && _version == other._version;
+		}
+	};
+	struct ItemKeyHash {
+		uint operator()(const ItemKey &key) const {
+			return (uint)(size_t)key._renderObject * 31 + (uint)key._version;
+		}
+	};
+
+	// Lookup of the queued (object, version) pairs, so that comparing two frames is linear
+	Common::HashMap<ItemKey, bool, ItemKeyHash> _index;
 };
 
 /**
@@ -126,8 +146,22 @@ public:
 	virtual bool persist(OutputPersistenceBlock &writer);
 	virtual bool unpersist(InputPersistenceBlock &reader);
 
+	struct FrameStats {
+		uint32 objects;     ///< Render objects queued
+		uint32 updateRects; ///< Rectangles redrawn
+		uint32 pixels;      ///< Pixels covered by the redrawn rectangles
+	};
+
+	/**
+	    @brief Returns the statistics of the last rendered frame.
+	*/
+	const FrameStats &getLastFrameStats() const {
+		return _lastFrameStats;
+	}
+
 private:
 	bool _frameStarted;
+	FrameStats _lastFrameStats;
 	typedef Common::Array<RenderObjectPtr<TimedRenderObject> > RenderObjectList;
 	RenderObjectList _timedRenderObjects;
 
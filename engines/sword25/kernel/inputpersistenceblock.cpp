@@ -36,14 +36,15 @@
 namespace Sword25 {
 
 InputPersistenceBlock::InputPersistenceBlock(const void *data, uint dataLength, int version) :
-	_data(static_cast<const byte *>(data), dataLength),
+	_data(static_cast<const byte *>(data)),
+	_dataEnd(static_cast<const byte *>(data) + dataLength),
 	_errorState(NONE),
 	_version(version) {
-	_iter = _data.begin();
+	_iter = _data;
 }
 
 InputPersistenceBlock::~InputPersistenceBlock() {
-	if (_iter != _data.end())
+	if (_iter != _dataEnd)
 		warning("Persistence block was not read to the end.");
 }
 
@@ -118,8 +119,23 @@ void InputPersistenceBlock::readByteArray(Common::Array<byte> &value) {
 	}
 }
 
+const byte *InputPersistenceBlock::readByteArrayInPlace(uint32 &size) {
+	if (checkMarker(BLOCK_MARKER)) {
+		read(size);
+
+		if (checkBlockSize(size)) {
+			const byte *result = _iter;
+			_iter += size;
+			return result;
+		}
+	}
+
+	size = 0;
+	return 0;
+}
+
 bool InputPersistenceBlock::checkBlockSize(int size) {
-	if (_data.end() - _iter >= size) {
+	if (_dataEnd - _iter >= size) {
 		return true;
 	} else {
 		_errorState = END_OF_DATA;
@@ -46,6 +46,9 @@ public:
 		OUT_OF_SYNC
 	};
 
+	/**
+	 * The data is not copied and has to stay valid as long as the block is read.
+	 */
 	InputPersistenceBlock(const void *data, uint dataLength, int version);
 	virtual ~InputPersistenceBlock();
 
@@ -57,6 +60,12 @@ public:
 	void readString(Common::String &value);
 	void readByteArray(Common::Array<byte> &value);
 
+	/**
+	 * Reads a byte array without copying it. The returned pointer points into
+	 * the data the block was created from.
+	 */
+	const byte *readByteArrayInPlace(uint32 &size);
+
 	bool isGood() const {
 		return _errorState == NONE;
 	}
@@ -70,8 +79,9 @@ private:
 	bool checkMarker(byte marker);
 	bool checkBlockSize(int size);
 
-	Common::Array<byte> _data;
-	Common::Array<byte>::const_iterator _iter;
+	const byte *_data;
+	const byte *_dataEnd;
+	const byte *_iter;
 	ErrorState _errorState;
 
 	int _version;
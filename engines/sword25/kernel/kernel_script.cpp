@@ -309,11 +309,8 @@ static int precacheResource(lua_State *L) {
 	ResourceManager *pResource = pKernel->getResourceManager();
 	assert(pResource);
 
-#ifdef PRECACHE_RESOURCES
-	lua_pushbooleancpp(L, pResource->precacheResource(luaL_checkstring(L, 1)));
-#else
-	lua_pushbooleancpp(L, true);
-#endif
+	// The resource is loaded in the background, spread over the next frames
+	lua_pushbooleancpp(L, pResource->queuePrecache(luaL_checkstring(L, 1)));
 
 	return 1;
 }
@@ -324,11 +321,7 @@ static int forcePrecacheResource(lua_State *L) {
 	ResourceManager *pResource = pKernel->getResourceManager();
 	assert(pResource);
 
-#ifdef PRECACHE_RESOURCES
 	lua_pushbooleancpp(L, pResource->precacheResource(luaL_checkstring(L, 1), true));
-#else
-	lua_pushbooleancpp(L, true);
-#endif
 
 	return 1;
 }
@@ -339,9 +332,7 @@ static int getMaxMemoryUsage(lua_State *L) {
 	ResourceManager *pResource = pKernel->getResourceManager();
 	assert(pResource);
 
-	// This is used for debugging, so it doesn't really matter.
-	// The default value set by the scripts is 256000000 bytes
-	lua_pushnumber(L, 256000000);
+	lua_pushnumber(L, pResource->getMaxMemoryUsage());
 
 	return 1;
 }
@@ -352,8 +343,7 @@ static int setMaxMemoryUsage(lua_State *L) {
 	ResourceManager *pResource = pKernel->getResourceManager();
 	assert(pResource);
 
-	// This call is ignored, we set a limit on the number of
-	// simultaneous resources loaded instead.
+	pResource->setMaxMemoryUsage(static_cast<uint>(luaL_checknumber(L, 1)));
 
 	return 0;
 }
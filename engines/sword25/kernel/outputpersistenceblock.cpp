@@ -29,6 +29,8 @@
  *
  */
 
+#include "common/stream.h"
+
 #include "sword25/kernel/outputpersistenceblock.h"
 
 namespace {
@@ -37,10 +39,27 @@ const uint INITIAL_BUFFER_SIZE = 1024 * 64;
 
 namespace Sword25 {
 
-OutputPersistenceBlock::OutputPersistenceBlock() {
+class OutputPersistenceBlock::BlockWriteStream : public Common::WriteStream {
+public:
+	BlockWriteStream(OutputPersistenceBlock &block) : _block(block) {}
+
+	virtual uint32 write(const void *dataPtr, uint32 dataSize) {
+		_block.rawWrite(dataPtr, dataSize);
+		return dataSize;
+	}
+
+private:
+	OutputPersistenceBlock &_block;
+};
+
+OutputPersistenceBlock::OutputPersistenceBlock() : _blockStream(0), _blockStart(0) {
 	_data.reserve(INITIAL_BUFFER_SIZE);
 }
 
+OutputPersistenceBlock::~OutputPersistenceBlock() {
+	delete _blockStream;
+}
+
 void OutputPersistenceBlock::write(const void *data, uint32 size) {
 	writeMarker(BLOCK_MARKER);
 
@@ -92,6 +111,27 @@ void OutputPersistenceBlock::writeByteArray(Common::Array<byte> &value) {
 	rawWrite(&value[0], value.size());
 }
 
+Common::WriteStream *OutputPersistenceBlock::beginBlock() {
+	assert(!_blockStream);
+
+	// The size is filled in by endBlock(), once it is known
+	writeMarker(BLOCK_MARKER);
+	write((uint32)0);
+	_blockStart = _data.size();
+
+	_blockStream = new BlockWriteStream(*this);
+	return _blockStream;
+}
+
+void OutputPersistenceBlock::endBlock() {
+	assert(_blockStream);
+
+	WRITE_LE_UINT32(&_data[_blockStart - sizeof(uint32)], _data.size() - _blockStart);
+
+	delete _blockStream;
+	_blockStream = 0;
+}
+
 void OutputPersistenceBlock::writeMarker(byte marker) {
 	_data.push_back(marker);
 }
@@ -99,6 +139,14 @@ void OutputPersistenceBlock::writeMarker(byte marker) {
 void OutputPersistenceBlock::rawWrite(const void *dataPtr, size_t size) {
 	if (size > 0) {
 		uint oldSize = _data.size();
+
+		// Grow the buffer in powers of two, blocks written through a stream
+		// arrive in many small pieces
+		uint capacity = INITIAL_BUFFER_SIZE;
+		while (capacity < oldSize + size)
+			capacity <<= 1;
+		_data.reserve(capacity);
+
 		_data.resize(oldSize + size);
 		memcpy(&_data[oldSize], dataPtr, size);
 	}
@@ -35,11 +35,16 @@
 #include "sword25/kernel/common.h"
 #include "sword25/kernel/persistenceblock.h"
 
+namespace Common {
+class WriteStream;
+}
+
 namespace Sword25 {
 
 class OutputPersistenceBlock : public PersistenceBlock {
 public:
 	OutputPersistenceBlock();
+	~OutputPersistenceBlock();
 
 	void write(const void *data, uint32 size);
 	void write(int32 value);
@@ -49,6 +54,13 @@ public:
 	void writeString(const Common::String &string);
 	void writeByteArray(Common::Array<byte> &value);
 
+	/**
+	 * Starts a data block whose size is not known in advance. The block's data is
+	 * written to the returned stream, which is valid until endBlock() is called.
+	 */
+	Common::WriteStream *beginBlock();
+	void endBlock();
+
 	const void *getData() const {
 		return &_data[0];
 	}
@@ -57,10 +69,15 @@ public:
 	}
 
 private:
+	class BlockWriteStream;
+	friend class BlockWriteStream;
+
 	void writeMarker(byte marker);
 	void rawWrite(const void *dataPtr, size_t size);
 
 	Common::Array<byte> _data;
+	BlockWriteStream *_blockStream;
+	uint _blockStart;
 };
 
 } // End of namespace Sword25
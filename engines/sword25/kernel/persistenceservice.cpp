@@ -122,8 +122,10 @@ struct SavegameInformation {
 
 struct PersistenceService::Impl {
 	SavegameInformation _savegameInformations[SLOT_COUNT];
+	Stats _stats;
 
 	Impl() {
+		memset(&_stats, 0, sizeof(_stats));
 		reloadSlots();
 	}
 
@@ -193,6 +195,10 @@ PersistenceService::~PersistenceService() {
 	delete _impl;
 }
 
+const PersistenceService::Stats &PersistenceService::getStats() const {
+	return _impl->_stats;
+}
+
 void PersistenceService::reloadSlots() {
 	_impl->reloadSlots();
 }
@@ -267,6 +273,8 @@ bool PersistenceService::saveGame(uint slotID, const Common::String &screenshotF
 		return false;
 	}
 
+	uint32 startTime = g_system->getMillis();
+
 	// Dateinamen erzeugen.
 	Common::String filename = generateSavegameFilename(slotID);
 
@@ -335,6 +343,9 @@ bool PersistenceService::saveGame(uint slotID, const Common::String &screenshotF
 	file->finalize();
 	delete file;
 
+	_impl->_stats.saveTime = g_system->getMillis() - startTime;
+	_impl->_stats.saveSize = writer.getDataSize();
+
 	// Savegameinformationen fr diesen Slot aktualisieren.
 	_impl->readSlotSavegameInformation(slotID);
 
@@ -373,25 +384,28 @@ bool PersistenceService::loadGame(uint slotID) {
 	}
 #endif
 
-	byte *compressedDataBuffer = new byte[curSavegameInfo.gamedataLength];
+	uint32 startTime = g_system->getMillis();
+
 	byte *uncompressedDataBuffer = new byte[curSavegameInfo.gamedataUncompressedLength];
 	Common::String filename = generateSavegameFilename(slotID);
 	file = sfm->openForLoading(filename);
 
 	file->seek(curSavegameInfo.gamedataOffset);
-	file->read(reinterpret_cast<char *>(&compressedDataBuffer[0]), curSavegameInfo.gamedataLength);
-	if (file->err()) {
-		error("Unable to load the gamedata from the savegame file \"%s\".", filename.c_str());
-		delete[] compressedDataBuffer;
-		delete[] uncompressedDataBuffer;
-		return false;
-	}
 
 	// Uncompress game data, if needed.
 	unsigned long uncompressedBufferSize = curSavegameInfo.gamedataUncompressedLength;
 
 	if (uncompressedBufferSize > curSavegameInfo.gamedataLength) {
 		// Older saved game, where the game data was compressed again.
+		byte *compressedDataBuffer = new byte[curSavegameInfo.gamedataLength];
+		file->read(reinterpret_cast<char *>(&compressedDataBuffer[0]), curSavegameInfo.gamedataLength);
+		if (file->err()) {
+			error("Unable to load the gamedata from the savegame file \"%s\".", filename.c_str());
+			delete[] compressedDataBuffer;
+			delete[] uncompressedDataBuffer;
+			return false;
+		}
+
 		if (!Common::uncompress(reinterpret_cast<byte *>(&uncompressedDataBuffer[0]), &uncompressedBufferSize,
 					   reinterpret_cast<byte *>(&compressedDataBuffer[0]), curSavegameInfo.gamedataLength)) {
 			error("Unable to decompress the gamedata from savegame file \"%s\".", filename.c_str());
@@ -400,9 +414,16 @@ bool PersistenceService::loadGame(uint slotID) {
 			delete file;
 			return false;
 		}
+
+		delete[] compressedDataBuffer;
 	} else {
-		// Newer saved game with uncompressed game data, copy it as-is.
-		memcpy(uncompressedDataBuffer, compressedDataBuffer, uncompressedBufferSize);
+		// Newer saved game with uncompressed game data, read it as-is.
+		file->read(reinterpret_cast<char *>(&uncompressedDataBuffer[0]), uncompressedBufferSize);
+		if (file->err()) {
+			error("Unable to load the gamedata from the savegame file \"%s\".", filename.c_str());
+			delete[] uncompressedDataBuffer;
+			return false;
+		}
 	}
 
 	InputPersistenceBlock reader(&uncompressedDataBuffer[0], curSavegameInfo.gamedataUncompressedLength, curSavegameInfo.version);
@@ -416,10 +437,12 @@ bool PersistenceService::loadGame(uint slotID) {
 	success &= Kernel::getInstance()->getSfx()->unpersist(reader);
 	success &= Kernel::getInstance()->getInput()->unpersist(reader);
 
-	delete[] compressedDataBuffer;
 	delete[] uncompressedDataBuffer;
 	delete file;
 
+	_impl->_stats.loadTime = g_system->getMillis() - startTime;
+	_impl->_stats.loadSize = curSavegameInfo.gamedataUncompressedLength;
+
 	if (!success) {
 		error("Unable to unpersist the gamedata from savegame file \"%s\".", filename.c_str());
 		return false;
@@ -64,6 +64,18 @@ public:
 	bool            saveGame(uint slotID, const Common::String &screenshotFilename);
 	bool            loadGame(uint slotID);
 
+	struct Stats {
+		uint32 saveTime; ///< Milliseconds spent on the last save
+		uint32 saveSize; ///< Bytes of game data held in memory by the last save
+		uint32 loadTime; ///< Milliseconds spent on the last load
+		uint32 loadSize; ///< Bytes of game data held in memory by the last load
+	};
+
+	/**
+	 * Returns the duration and memory use of the last save and load
+	 */
+	const Stats &getStats() const;
+
 private:
 	struct Impl;
 	Impl *_impl;
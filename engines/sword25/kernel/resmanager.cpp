@@ -29,6 +29,8 @@
  *
  */
 
+#include "common/system.h"
+
 #include "sword25/sword25.h"	// for kDebugResource
 #include "sword25/kernel/resmanager.h"
 #include "sword25/kernel/resource.h"
@@ -37,15 +39,18 @@
 
 namespace Sword25 {
 
-// Sets the amount of resources that are simultaneously loaded.
-// This needs to be a relatively high number, as all the animation
-// frames in each scene are loaded as separate resources.
-// Also, George's walk states are all loaded here (150 files)
-#define SWORD25_RESOURCECACHE_MIN 400
-// The maximum number of loaded resources. If more than these resources
-// are loaded, the resource manager will start purging resources till it
-// hits the minimum limit above
-#define SWORD25_RESOURCECACHE_MAX 500
+// The default amount of memory in bytes the loaded resources may use.
+// The scripts can change it with SetMaxMemoryUsage(), they set it to
+// 256000000 bytes at startup.
+#define SWORD25_RESOURCECACHE_SIZE 256000000
+// The time in milliseconds spent per frame on loading queued resources
+#define SWORD25_PRECACHE_TIME 5
+
+ResourceManager::ResourceManager(Kernel *pKernel) :
+	_kernelPtr(pKernel),
+	_maxMemoryUsage(SWORD25_RESOURCECACHE_SIZE),
+	_usedMemory(0) {
+}
 
 ResourceManager::~ResourceManager() {
 	// Clear all unlocked resources
@@ -87,10 +92,10 @@ bool ResourceManager::registerResourceService(ResourceService *pService) {
  */
 void ResourceManager::deleteResourcesIfNecessary() {
 	// If enough memory is available, or no resources are loaded, then the function can immediately end
-	if (_resources.size() < SWORD25_RESOURCECACHE_MAX)
+	if (_usedMemory <= _maxMemoryUsage || _resources.empty())
 		return;
 
-	// Keep deleting resources until the memory usage of the process falls below the set maximum limit.
+	// Keep deleting resources until the memory usage falls below the set maximum limit.
 	// The list is processed backwards in order to first release those resources that have been
 	// not been accessed for the longest
 	Common::List<Resource *>::iterator iter = _resources.end();
@@ -100,33 +105,15 @@ void ResourceManager::deleteResourcesIfNecessary() {
 		// The resource may be released only if it isn't locked
 		if ((*iter)->getLockCount() == 0)
 			iter = deleteResource(*iter);
-	} while (iter != _resources.begin() && _resources.size() >= SWORD25_RESOURCECACHE_MIN);
-
-	// Are we still above the minimum? If yes, then start releasing locked resources
-	// FIXME: This code shouldn't be needed at all, but it seems like there is a bug
-	// in the resource lock code, and resources are not unlocked when changing rooms.
-	// Only image/animation resources are unlocked forcibly, thus this shouldn't have
-	// any impact on the game itself.
-	if (_resources.size() <= SWORD25_RESOURCECACHE_MIN)
-		return;
+	} while (iter != _resources.begin() && _usedMemory > _maxMemoryUsage);
 
-	iter = _resources.end();
-	do {
-		--iter;
-
-		// Only unlock image/animation resources
-		if ((*iter)->getFileName().hasSuffix(".swf") ||
-			(*iter)->getFileName().hasSuffix(".png")) {
-
-			warning("Forcibly unlocking %s", (*iter)->getFileName().c_str());
-
-			// Forcibly unlock the resource
-			while ((*iter)->getLockCount() > 0)
-				(*iter)->release();
+	if (_usedMemory > _maxMemoryUsage)
+		debugC(kDebugResource, "Locked resources use %d bytes, more than the limit of %d bytes", _usedMemory, _maxMemoryUsage);
+}
 
-			iter = deleteResource(*iter);
-		}
-	} while (iter != _resources.begin() && _resources.size() >= SWORD25_RESOURCECACHE_MIN);
+void ResourceManager::setMaxMemoryUsage(uint maxMemoryUsage) {
+	_maxMemoryUsage = maxMemoryUsage;
+	deleteResourcesIfNecessary();
 }
 
 /**
@@ -183,8 +170,6 @@ Resource *ResourceManager::requestResource(const Common::String &fileName) {
 	return NULL;
 }
 
-#ifdef PRECACHE_RESOURCES
-
 /**
  * Loads a resource into the cache
  * @param FileName      The filename of the resource to be cached
@@ -218,7 +203,42 @@ bool ResourceManager::precacheResource(const Common::String &fileName, bool forc
 	return true;
 }
 
-#endif
+/**
+ * Queues a resource to be loaded into the cache by processPrecacheQueue()
+ * @param FileName      The filename of the resource to be cached
+ */
+bool ResourceManager::queuePrecache(const Common::String &fileName) {
+	Common::String uniqueFileName = getUniqueFileName(fileName);
+	if (uniqueFileName.empty())
+		return false;
+
+	if (!getResource(uniqueFileName) && !_precachePending.contains(uniqueFileName)) {
+		_precacheQueue.push_back(uniqueFileName);
+		_precachePending[uniqueFileName] = true;
+	}
+
+	return true;
+}
+
+/**
+ * Loads queued resources into the cache until the time slice for the current frame is used up
+ */
+void ResourceManager::processPrecacheQueue() {
+	uint32 startTime = g_system->getMillis();
+
+	while (!_precacheQueue.empty()) {
+		Common::String fileName = _precacheQueue.front();
+		_precacheQueue.pop_front();
+		_precachePending.erase(fileName);
+
+		// The resource may have been requested since it was queued
+		if (!getResource(fileName))
+			precacheResource(fileName);
+
+		if (g_system->getMillis() - startTime >= SWORD25_PRECACHE_TIME)
+			break;
+	}
+}
 
 /**
  * Moves a resource to the top of the resource list
@@ -256,6 +276,7 @@ Resource *ResourceManager::loadResource(const Common::String &fileName) {
 			// Add the resource to the front of the list
 			_resources.push_front(pResource);
 			pResource->_iterator = _resources.begin();
+			_usedMemory += pResource->getMemorySize();
 
 			// Also store the resource in the hash table for quick lookup
 			_resourceHashMap[pResource->getFileName()] = pResource;
@@ -298,6 +319,7 @@ Common::List<Resource *>::iterator ResourceManager::deleteResource(Resource *pRe
 
 	// Delete the resource from the resource list
 	Common::List<Resource *>::iterator result = _resources.erase(pResource->_iterator);
+	_usedMemory -= pResource->getMemorySize();
 
 	// Delete the resource
 	delete pResource;
@@ -40,8 +40,6 @@
 
 namespace Sword25 {
 
-//#define PRECACHE_RESOURCES
-
 class ResourceService;
 class Resource;
 class Kernel;
@@ -56,7 +54,6 @@ public:
 	 */
 	Resource *requestResource(const Common::String &fileName);
 
-#ifdef PRECACHE_RESOURCES
 	/**
 	 * Loads a resource into the cache
 	 * @param FileName      The filename of the resource to be cached
@@ -64,7 +61,36 @@ public:
 	 * This is useful for files that may have changed in the interim
 	 */
 	bool precacheResource(const Common::String &fileName, bool forceReload = false);
-#endif
+
+	/**
+	 * Queues a resource to be loaded into the cache by processPrecacheQueue()
+	 * @param FileName      The filename of the resource to be cached
+	 */
+	bool queuePrecache(const Common::String &fileName);
+
+	/**
+	 * Loads queued resources into the cache until the time slice for the current frame is used up
+	 */
+	void processPrecacheQueue();
+
+	/**
+	 * Returns the maximum amount of memory in bytes the unlocked resources may use
+	 */
+	uint getMaxMemoryUsage() const {
+		return _maxMemoryUsage;
+	}
+
+	/**
+	 * Sets the maximum amount of memory in bytes the unlocked resources may use
+	 */
+	void setMaxMemoryUsage(uint maxMemoryUsage);
+
+	/**
+	 * Returns the amount of memory in bytes used by the loaded resources
+	 */
+	uint getUsedMemory() const {
+		return _usedMemory;
+	}
 
 	/**
 	 * Registers a RegisterResourceService. This method is the constructor of
@@ -93,9 +119,7 @@ private:
 	 * Creates a new resource manager
 	 * Only the BS_Kernel class can generate copies this class. Thus, the constructor is private
 	 */
-	ResourceManager(Kernel *pKernel) :
-		_kernelPtr(pKernel)
-	{}
+	ResourceManager(Kernel *pKernel);
 	virtual ~ResourceManager();
 
 	/**
@@ -139,6 +163,10 @@ private:
 	Common::List<Resource *> _resources;
 	typedef Common::HashMap<Common::String, Resource *> ResMap;
 	ResMap _resourceHashMap;
+	Common::List<Common::String> _precacheQueue;
+	Common::HashMap<Common::String, bool> _precachePending;
+	uint _maxMemoryUsage;
+	uint _usedMemory;
 };
 
 } // End of namespace Sword25
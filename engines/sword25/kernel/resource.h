@@ -92,6 +92,13 @@ public:
 		return _type;
 	}
 
+	/**
+	 * Returns an estimate of the memory used by the resource's data in bytes
+	 */
+	virtual uint getMemorySize() const {
+		return 0;
+	}
+
 protected:
 	virtual ~Resource() {}
 
@@ -394,12 +394,9 @@ bool LuaScriptEngine::persist(OutputPersistenceBlock &writer) {
 	pushPermanentsTable(_state, PTT_PERSIST);
 	lua_getglobal(_state, "_G");
 
-	// Lua persists and stores the data in a WriteStream
-	Common::MemoryWriteStreamDynamic writeStream;
-	Lua::persistLua(_state, &writeStream);
-
-	// Persistenzdaten in den Writer schreiben.
-	writer.write(writeStream.getData(), writeStream.size());
+	// Lua persists and stores the data directly in the writer
+	Lua::persistLua(_state, writer.beginBlock());
+	writer.endBlock();
 
 	// Die beiden Tabellen vom Stack nehmen.
 	lua_pop(_state, 2);
@@ -478,9 +475,9 @@ bool LuaScriptEngine::unpersist(InputPersistenceBlock &reader) {
 	clearGlobalTable(_state, clearExceptionsSecondPass);
 
 	// Persisted Lua data
-	Common::Array<byte> chunkData;
-	reader.readByteArray(chunkData);
-	Common::MemoryReadStream readStream(&chunkData[0], chunkData.size(), DisposeAfterUse::NO);
+	uint32 chunkSize;
+	const byte *chunkData = reader.readByteArrayInPlace(chunkSize);
+	Common::MemoryReadStream readStream(chunkData, chunkSize, DisposeAfterUse::NO);
 
 	Lua::unpersistLua(_state, &readStream);
 
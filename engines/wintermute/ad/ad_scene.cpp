@@ -90,6 +90,8 @@ void AdScene::setDefaults() {
 	_mainLayer = nullptr;
 
 	_pfPointsNum = 0;
+	_pfQueueValid = false;
+	_pfLayoutStamp = 0;
 	_persistentState = false;
 	_persistentStateSprites = true;
 
@@ -203,6 +205,8 @@ bool AdScene::getPath(const BasePoint &source, const BasePoint &target, AdPath *
 
 		// prepare working path
 		pfPointsStart();
+		_pfQueue.clear();
+		_pfQueueValid = true;
 
 		// first point
 		//_pfPath.add(new AdPathPoint(source.x, source.y, 0));
@@ -229,6 +233,7 @@ bool AdScene::getPath(const BasePoint &source, const BasePoint &target, AdPath *
 		}
 
 		pfPointsAdd(startX, startY, 0);
+		pfQueuePush(0);
 
 		//CorrectTargetPoint(&target.x, &target.y);
 
@@ -469,23 +474,168 @@ int AdScene::getPointsDist(const BasePoint &p1, const BasePoint &p2, BaseObject
 
 
 //////////////////////////////////////////////////////////////////////////
-void AdScene::pathFinderStep() {
-	int i;
-	// get lowest unmarked
-	int lowestDist = INT_MAX;
-	AdPathPoint *lowestPt = nullptr;
+int AdScene::getCachedPointsDist(const BasePoint &p1, const BasePoint &p2, BaseObject *requester) {
+	// getPointsDist() gives the same result both ways
+	PathVisibilityKey key;
+	if (p1.x < p2.x || (p1.x == p2.x && p1.y <= p2.y)) {
+		key.x1 = p1.x;
+		key.y1 = p1.y;
+		key.x2 = p2.x;
+		key.y2 = p2.y;
+	} else {
+		key.x1 = p2.x;
+		key.y1 = p2.y;
+		key.x2 = p1.x;
+		key.y2 = p1.y;
+	}
+	key.requester = requester;
+
+	Common::HashMap<PathVisibilityKey, int32, PathVisibilityKeyHash>::const_iterator it = _pfVisibility.find(key);
+	if (it != _pfVisibility.end()) {
+		return it->_value;
+	}
+
+	int dist = getPointsDist(p1, p2, requester);
+	_pfVisibility[key] = dist;
+	return dist;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+static uint32 hashRegion(uint32 stamp, BaseRegion *region) {
+	stamp = stamp * 31 + (region->_active ? 1 : 0);
+	stamp = stamp * 31 + region->_points.size();
+	for (uint32 i = 0; i < region->_points.size(); i++) {
+		stamp = stamp * 31 + region->_points[i]->x;
+		stamp = stamp * 31 + region->_points[i]->y;
+	}
+	return stamp;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+uint32 AdScene::getPathLayoutStamp() {
+	uint32 stamp = 0;
+
+	if (_mainLayer) {
+		for (uint32 i = 0; i < _mainLayer->_nodes.size(); i++) {
+			AdSceneNode *node = _mainLayer->_nodes[i];
+			if (node->_type == OBJECT_REGION) {
+				stamp = stamp * 31 + (uint32)(size_t)node->_region;
+				stamp = stamp * 31 + (node->_region->isBlocked() ? 1 : 0) + (node->_region->hasDecoration() ? 2 : 0);
+				stamp = hashRegion(stamp, node->_region);
+			}
+		}
+	}
+
+	AdGame *adGame = (AdGame *)_gameRef;
+	for (uint32 i = 0; i < _objects.size() + adGame->_objects.size(); i++) {
+		AdObject *obj = (i < _objects.size()) ? _objects[i] : adGame->_objects[i - _objects.size()];
+		if (obj->_active && obj->_currentBlockRegion) {
+			stamp = stamp * 31 + (uint32)(size_t)obj;
+			stamp = hashRegion(stamp, obj->_currentBlockRegion);
+		}
+	}
+
+	return stamp;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+void AdScene::pfQueuePush(int index) {
+	AdPathPoint *pt = _pfPath[index];
+
+	// The distance between two points is the larger of the X and Y
+	// distances (see getPointsDist()), so this never overestimates the
+	// distance left to the target, and the first path found is the shortest.
+	PathFinderNode node;
+	node.distance = pt->_distance;
+	node.estimate = pt->_distance + MAX(abs(_pfTarget->x - pt->x), abs(_pfTarget->y - pt->y));
+	node.index = index;
+
+	uint pos = _pfQueue.size();
+	_pfQueue.push_back(node);
+	while (pos > 0) {
+		uint parent = (pos - 1) / 2;
+		const PathFinderNode &p = _pfQueue[parent];
+		if (p.estimate < node.estimate || (p.estimate == node.estimate && p.index <= node.index)) {
+			break;
+		}
+		_pfQueue[pos] = p;
+		pos = parent;
+	}
+	_pfQueue[pos] = node;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+bool AdScene::pfQueuePop(int &index) {
+	while (!_pfQueue.empty()) {
+		PathFinderNode top = _pfQueue[0];
+		PathFinderNode last = _pfQueue.back();
+		_pfQueue.pop_back();
+
+		uint size = _pfQueue.size();
+		if (size > 0) {
+			uint pos = 0;
+			for (;;) {
+				uint child = pos * 2 + 1;
+				if (child >= size) {
+					break;
+				}
+				if (child + 1 < size &&
+					(_pfQueue[child + 1].estimate < _pfQueue[child].estimate ||
+					 (_pfQueue[child + 1].estimate == _pfQueue[child].estimate && _pfQueue[child + 1].index < _pfQueue[child].index))) {
+					child++;
+				}
+				const PathFinderNode &c = _pfQueue[child];
+				if (last.estimate < c.estimate || (last.estimate == c.estimate && last.index <= c.index)) {
+					break;
+				}
+				_pfQueue[pos] = c;
+				pos = child;
+			}
+			_pfQueue[pos] = last;
+		}
+
+		// Points are pushed again when their distance improves, so skip
+		// the outdated entries
+		AdPathPoint *pt = _pfPath[top.index];
+		if (!pt->_marked && pt->_distance == top.distance) {
+			index = top.index;
+			return true;
+		}
+	}
+	return false;
+}
 
-	for (i = 0; i < _pfPointsNum; i++)
-		if (!_pfPath[i]->_marked && _pfPath[i]->_distance < lowestDist) {
-			lowestDist = _pfPath[i]->_distance;
-			lowestPt = _pfPath[i];
+
+//////////////////////////////////////////////////////////////////////////
+void AdScene::pfQueueRebuild() {
+	_pfQueue.clear();
+	for (int i = 0; i < _pfPointsNum; i++) {
+		if (!_pfPath[i]->_marked && _pfPath[i]->_distance < INT_MAX) {
+			pfQueuePush(i);
 		}
+	}
+	_pfQueueValid = true;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+void AdScene::pathFinderStep() {
+	if (!_pfQueueValid) {
+		pfQueueRebuild();
+	}
 
-	if (lowestPt == nullptr) { // no path -> terminate PathFinder
+	// get the open point closest to the target
+	int lowestIndex;
+	if (!pfQueuePop(lowestIndex)) { // no path -> terminate PathFinder
 		_pfReady = true;
 		_pfTargetPath->setReady(true);
 		return;
 	}
+	AdPathPoint *lowestPt = _pfPath[lowestIndex];
 
 	lowestPt->_marked = true;
 
@@ -502,12 +652,20 @@ void AdScene::pathFinderStep() {
 	}
 
 	// otherwise keep on searching
-	for (i = 0; i < _pfPointsNum; i++)
+	for (int i = 0; i < _pfPointsNum; i++)
 		if (!_pfPath[i]->_marked) {
-			int j = getPointsDist(*lowestPt, *_pfPath[i], _pfRequester);
+			// getPointsDist() can't return less than this, so don't bother
+			// walking the line if it can't be an improvement
+			int minDist = MAX(abs(_pfPath[i]->x - lowestPt->x), abs(_pfPath[i]->y - lowestPt->y));
+			if (lowestPt->_distance + minDist >= _pfPath[i]->_distance) {
+				continue;
+			}
+
+			int j = getCachedPointsDist(*lowestPt, *_pfPath[i], _pfRequester);
 			if (j != -1 && lowestPt->_distance + j < _pfPath[i]->_distance) {
 				_pfPath[i]->_distance = lowestPt->_distance + j;
 				_pfPath[i]->_origin = lowestPt;
+				pfQueuePush(i);
 			}
 		}
 }
@@ -526,6 +684,16 @@ bool AdScene::initLoop() {
 		_gameRef->LOG(0, "STAT: PathFinder iterations in one loop: %d (%s)  _pfMaxTime=%d", nu_steps, _pfReady ? "finished" : "not yet done", _pfMaxTime);
 	}
 #else
+	if (!_pfReady) {
+		// Forget what we know about the visibility between points
+		// when any of the regions blocking them changed
+		uint32 stamp = getPathLayoutStamp();
+		if (stamp != _pfLayoutStamp || _pfVisibility.size() > 65536) {
+			_pfVisibility.clear(true);
+			_pfLayoutStamp = stamp;
+		}
+	}
+
 	uint32 start = _gameRef->_currentTime;
 	while (!_pfReady && g_system->getMillis() - start <= _pfMaxTime) {
 		pathFinderStep();
@@ -2345,6 +2513,9 @@ bool AdScene::persist(BasePersistenceManager *persistMgr) {
 	_pfPath.persist(persistMgr);
 	persistMgr->transferSint32(TMEMBER(_pfPointsNum));
 	persistMgr->transferBool(TMEMBER(_pfReady));
+	_pfQueueValid = false;
+	_pfLayoutStamp = 0;
+	_pfVisibility.clear();
 	persistMgr->transferPtr(TMEMBER_PTR(_pfRequester));
 	persistMgr->transferPtr(TMEMBER_PTR(_pfTarget));
 	persistMgr->transferPtr(TMEMBER_PTR(_pfTargetPath));
@@ -30,6 +30,7 @@
 #define WINTERMUTE_ADSCENE_H
 
 #include "engines/wintermute/base/base_fader.h"
+#include "common/hashmap.h"
 
 namespace Wintermute {
 
@@ -171,6 +172,41 @@ private:
 	BaseObject *_pfRequester;
 	BaseArray<AdPathPoint *> _pfPath;
 
+	// Open points of the path finder, as a binary heap ordered by the
+	// estimated total distance. Rebuilt from _pfPath after loading.
+	struct PathFinderNode {
+		int32 estimate;
+		int32 distance;
+		int32 index;
+	};
+	Common::Array<PathFinderNode> _pfQueue;
+	bool _pfQueueValid;
+	void pfQueuePush(int index);
+	bool pfQueuePop(int &index);
+	void pfQueueRebuild();
+
+	// Results of getPointsDist() for the current scene layout
+	struct PathVisibilityKey {
+		int32 x1, y1, x2, y2;
+		BaseObject *requester;
+		bool operator==(const PathVisibilityKey &key) const {
+			return x1 == key.x1 && y1 == key.y1 && x2 == key.x2 && y2 == key.y2 && requester == key.requester;
+		}
+	};
+	struct PathVisibilityKeyHash {
+		uint operator()(const PathVisibilityKey &key) const {
+			return ((uint)key.x1 * 73856093U) ^ ((uint)key.y1 * 19349663U) ^ ((uint)key.x2 * 83492791U) ^ ((uint)key.y2 * 50331653U) ^ (uint)(size_t)key.requester;
+		}
+	};
+	Common::HashMap<PathVisibilityKey, int32, PathVisibilityKeyHash> _pfVisibility;
+	uint32 _pfLayoutStamp;
+	/**
+	 * Get a stamp of everything isBlockedAt() depends on, to find out
+	 * whether the cached visibility between points is still valid.
+	 */
+	uint32 getPathLayoutStamp();
+	int getCachedPointsDist(const BasePoint &p1, const BasePoint &p2, BaseObject *requester);
+
 	int32 _offsetTop;
 	int32 _offsetLeft;
 
@@ -31,6 +31,7 @@
 #include "engines/wintermute/base/file/base_disk_file.h"
 #include "engines/wintermute/base/file/base_save_thumb_file.h"
 #include "engines/wintermute/base/file/base_package.h"
+#include "engines/wintermute/base/file/base_file_entry.h"
 #include "engines/wintermute/base/base_engine.h"
 #include "engines/wintermute/wintermute.h"
 #include "common/debug.h"
@@ -80,6 +81,7 @@ bool BaseFileManager::cleanup() {
 	_openFiles.clear();
 
 	// delete packages
+	_packageIndex.clear();
 	_packages.clear();
 
 	// get rid of the resources:
@@ -279,8 +281,28 @@ bool BaseFileManager::registerPackages() {
 
 bool BaseFileManager::registerPackage(Common::FSNode file, const Common::String &filename, bool searchSignature) {
 	PackageSet *pack = new PackageSet(file, filename, searchSignature);
+	if (_packages.hasArchive(file.getName())) {
+		// Let the search set warn about it and dispose of the package
+		_packages.add(file.getName(), pack, pack->getPriority(), true);
+		return STATUS_OK;
+	}
 	_packages.add(file.getName(), pack, pack->getPriority() , true);
 
+	// Merge the package into the index, a member is taken from the package
+	// with the highest priority, or the one registered first on a tie
+	const PackageSet::FileMap &files = pack->getFiles();
+	for (PackageSet::FileMap::const_iterator it = files.begin(); it != files.end(); ++it) {
+		Common::HashMap<Common::String, Common::ArchiveMemberPtr>::iterator existing = _packageIndex.find(it->_key);
+		if (existing == _packageIndex.end()) {
+			_packageIndex[it->_key] = it->_value;
+		} else {
+			const BaseFileEntry *entry = static_cast<const BaseFileEntry *>(existing->_value.get());
+			if (pack->getPriority() > entry->_package->_priority) {
+				existing->_value = it->_value;
+			}
+		}
+	}
+
 	return STATUS_OK;
 }
 
@@ -308,11 +330,11 @@ Common::SeekableReadStream *BaseFileManager::openPkgFile(const Common::String &f
 			upcName.setChar('\\', (uint32)i);
 		}
 	}
-	Common::ArchiveMemberPtr entry = _packages.getMember(upcName);
-	if (!entry) {
+	Common::HashMap<Common::String, Common::ArchiveMemberPtr>::const_iterator it = _packageIndex.find(upcName);
+	if (it == _packageIndex.end()) {
 		return nullptr;
 	}
-	file = entry->createReadStream();
+	file = it->_value->createReadStream();
 	return file;
 }
 
@@ -328,7 +350,9 @@ bool BaseFileManager::hasFile(const Common::String &filename) {
 	if (diskFileExists(filename)) {
 		return true;
 	}
-	if (_packages.hasFile(filename)) {
+	Common::String upcName = filename;
+	upcName.toUppercase();
+	if (_packageIndex.contains(upcName)) {
 		return true;    // We don't bother checking if the file can actually be opened, something bigger is wrong if that is the case.
 	}
 	if (!_detectionMode && _resources->hasFile(filename)) {
@@ -34,6 +34,7 @@
 #include "common/fs.h"
 #include "common/file.h"
 #include "common/language.h"
+#include "common/hashmap.h"
 
 namespace Wintermute {
 class BaseFileManager {
@@ -66,6 +67,8 @@ private:
 	bool registerPackage(Common::FSNode package, const Common::String &filename = "", bool searchSignature = false);
 	bool _detectionMode;
 	Common::SearchSet _packages;
+	// Members of all the packages, keyed by their uppercase name, resolved by priority
+	Common::HashMap<Common::String, Common::ArchiveMemberPtr> _packageIndex;
 	Common::Array<Common::SeekableReadStream *> _openFiles;
 	Common::Language _language;
 	Common::Archive *_resources;
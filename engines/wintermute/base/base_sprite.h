@@ -51,6 +51,7 @@ public:
 	bool display(int x, int y, BaseObject *registerOwner = nullptr, float zoomX = Graphics::kDefaultZoomX, float zoomY = Graphics::kDefaultZoomY, uint32 alpha = Graphics::kDefaultRgbaMod, float rotate = Graphics::kDefaultAngle, Graphics::TSpriteBlendMode blendMode = Graphics::BLEND_NORMAL);
 	bool getCurrentFrame(float zoomX = Graphics::kDefaultZoomX, float zoomY = Graphics::kDefaultZoomY);
 	void reset();
+	bool killAllSounds();
 	bool isChanged();
 	bool isFinished();
 	bool loadBuffer(char *buffer, bool compete = true, int lifeTime = -1, TSpriteCacheType cacheType = CACHE_ALL);
@@ -86,7 +87,6 @@ private:
 	bool _paused;
 	bool _streamed;
 	bool _streamedKeepLoaded;
-	bool killAllSounds();
 };
 
 } // End of namespace Wintermute
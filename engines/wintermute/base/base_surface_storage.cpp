@@ -34,9 +34,13 @@
 #include "engines/wintermute/base/base_file_manager.h"
 #include "engines/wintermute/platform_osystem.h"
 #include "common/str.h"
+#include "common/system.h"
 
 namespace Wintermute {
 
+// Time spent decoding queued surfaces per frame, in milliseconds
+#define SURFACE_PRELOAD_TIME 5
+
 //IMPLEMENT_PERSISTENT(BaseSurfaceStorage, true);
 
 //////////////////////////////////////////////////////////////////////
@@ -60,6 +64,8 @@ bool BaseSurfaceStorage::cleanup(bool warn) {
 		delete _surfaces[i];
 	}
 	_surfaces.clear();
+	_surfaceIndex.clear();
+	_preloadQueue.clear();
 
 	return STATUS_OK;
 }
@@ -67,6 +73,8 @@ bool BaseSurfaceStorage::cleanup(bool warn) {
 
 //////////////////////////////////////////////////////////////////////////
 bool BaseSurfaceStorage::initLoop() {
+	preloadSurfaces();
+
 	if (_gameRef->_smartCache && _gameRef->getLiveTimer()->getTime() - _lastCleanupTime >= _gameRef->_surfaceGCCycleTime) {
 		_lastCleanupTime = _gameRef->getLiveTimer()->getTime();
 		sortSurfaces();
@@ -91,6 +99,8 @@ bool BaseSurfaceStorage::removeSurface(BaseSurface *surface) {
 		if (_surfaces[i] == surface) {
 			_surfaces[i]->_referenceCount--;
 			if (_surfaces[i]->_referenceCount <= 0) {
+				_surfaceIndex.erase(_surfaces[i]->getFileNameStr());
+				_preloadQueue.remove(_surfaces[i]);
 				delete _surfaces[i];
 				_surfaces.remove_at(i);
 			}
@@ -103,11 +113,10 @@ bool BaseSurfaceStorage::removeSurface(BaseSurface *surface) {
 
 //////////////////////////////////////////////////////////////////////
 BaseSurface *BaseSurfaceStorage::addSurface(const Common::String &filename, bool defaultCK, byte ckRed, byte ckGreen, byte ckBlue, int lifeTime, bool keepLoaded) {
-	for (uint32 i = 0; i < _surfaces.size(); i++) {
-		if (scumm_stricmp(_surfaces[i]->getFileName(), filename.c_str()) == 0) {
-			_surfaces[i]->_referenceCount++;
-			return _surfaces[i];
-		}
+	SurfaceIndex::const_iterator it = _surfaceIndex.find(filename);
+	if (it != _surfaceIndex.end()) {
+		it->_value->_referenceCount++;
+		return it->_value;
 	}
 
 	if (!BaseFileManager::getEngineInstance()->hasFile(filename)) {
@@ -134,11 +143,24 @@ BaseSurface *BaseSurfaceStorage::addSurface(const Common::String &filename, bool
 	} else {
 		surface->_referenceCount = 1;
 		_surfaces.push_back(surface);
+		_surfaceIndex[filename] = surface;
+		_preloadQueue.push_back(surface);
 		return surface;
 	}
 }
 
 
+//////////////////////////////////////////////////////////////////////
+void BaseSurfaceStorage::preloadSurfaces() {
+	uint32 startTime = g_system->getMillis();
+	while (!_preloadQueue.empty() && g_system->getMillis() - startTime < SURFACE_PRELOAD_TIME) {
+		BaseSurface *surface = _preloadQueue.front();
+		_preloadQueue.pop_front();
+		surface->preload();
+	}
+}
+
+
 //////////////////////////////////////////////////////////////////////
 bool BaseSurfaceStorage::restoreAll() {
 	bool ret;
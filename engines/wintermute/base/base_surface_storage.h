@@ -31,6 +31,9 @@
 
 #include "engines/wintermute/base/base.h"
 #include "common/array.h"
+#include "common/hashmap.h"
+#include "common/hash-str.h"
+#include "common/list.h"
 
 namespace Wintermute {
 class BaseSurface;
@@ -50,6 +53,17 @@ public:
 	virtual ~BaseSurfaceStorage();
 
 	Common::Array<BaseSurface *> _surfaces;
+private:
+	/**
+	 * Decode some of the surfaces waiting in the preload queue,
+	 * within a time budget.
+	 */
+	void preloadSurfaces();
+
+	typedef Common::HashMap<Common::String, BaseSurface *, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> SurfaceIndex;
+	SurfaceIndex _surfaceIndex;
+	// Newly created surfaces, decoded during the next frames instead of on first display
+	Common::List<BaseSurface *> _preloadQueue;
 };
 
 } // End of namespace Wintermute
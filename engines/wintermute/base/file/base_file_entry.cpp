@@ -43,7 +43,7 @@ Common::SeekableReadStream *BaseFileEntry::createReadStream() const {
 	bool compressed = (_compressedLength != 0);
 
 	if (compressed) {
-		file = Common::wrapCompressedReadStream(new Common::SeekableSubReadStream(file, _offset, _offset + _length, DisposeAfterUse::YES), _length); //
+		file = Common::wrapCompressedReadStream(new Common::SeekableSubReadStream(file, _offset, _offset + _compressedLength, DisposeAfterUse::YES), _length);
 	} else {
 		file = new Common::SeekableSubReadStream(file, _offset, _offset + _length, DisposeAfterUse::YES);
 	}
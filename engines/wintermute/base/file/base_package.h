@@ -78,11 +78,17 @@ public:
 	virtual Common::SeekableReadStream *createReadStreamForMember(const Common::String &name) const;
 
 	int getPriority() const { return _priority; }
+
+	typedef Common::HashMap<Common::String, Common::ArchiveMemberPtr> FileMap;
+	/**
+	 * Get the members of the package, keyed by their uppercase name.
+	 */
+	const FileMap &getFiles() const { return _files; }
 private:
 	byte _priority;
 	Common::Array<BasePackage *> _packages;
-	Common::HashMap<Common::String, Common::ArchiveMemberPtr> _files;
-	Common::HashMap<Common::String, Common::ArchiveMemberPtr>::iterator _filesIter;
+	FileMap _files;
+	FileMap::iterator _filesIter;
 };
 
 } // End of namespace Wintermute
@@ -58,6 +58,13 @@ public:
 	virtual bool displayZoom(int x, int y, Rect32 rect, float zoomX, float zoomY, uint32 alpha = 0xFFFFFFFF, bool transparent = false, Graphics::TSpriteBlendMode blendMode = Graphics::BLEND_NORMAL, bool mirrorX = false, bool mirrorY = false) = 0;
 	virtual bool displayTiled(int x, int y, Rect32 rect, int numTimesX, int numTimesY) = 0;
 	virtual bool restore();
+	/**
+	 * Decode the image now, if its loading was deferred until first use.
+	 * @return true if the image had to be decoded
+	 */
+	virtual bool preload() {
+		return false;
+	}
 	virtual bool create(const Common::String &filename, bool defaultCK, byte ckRed, byte ckGreen, byte ckBlue, int lifeTime = -1, bool keepLoaded = false) = 0;
 	virtual bool create(int width, int height);
 	virtual bool putSurface(const Graphics::Surface &surface, bool hasAlpha = false) {
@@ -40,6 +40,7 @@
 #include "common/config-manager.h"
 
 #define DIRTY_RECT_LIMIT 800
+#define MAX_DIRTY_RECTS 32
 
 namespace Wintermute {
 
@@ -57,13 +58,18 @@ BaseRenderOSystem::BaseRenderOSystem(BaseGame *inGame) : BaseRenderer(inGame) {
 
 	_borderLeft = _borderRight = _borderTop = _borderBottom = 0;
 	_ratioX = _ratioY = 1.0f;
-	_dirtyRect = nullptr;
 	_disableDirtyRects = false;
 	if (ConfMan.hasKey("dirty_rects")) {
 		_disableDirtyRects = !ConfMan.getBool("dirty_rects");
 	}
 
 	_lastScreenChangeID = g_system->getScreenChangeID();
+
+	_spriteBatch = false;
+	_batchOwner = nullptr;
+
+	memset(&_frameStats, 0, sizeof(_frameStats));
+	memset(&_lastFrameStats, 0, sizeof(_lastFrameStats));
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -75,8 +81,6 @@ BaseRenderOSystem::~BaseRenderOSystem() {
 		delete ticket;
 	}
 
-	delete _dirtyRect;
-
 	_renderSurface->free();
 	delete _renderSurface;
 	_blankSurface->free();
@@ -152,10 +156,11 @@ bool BaseRenderOSystem::indicatorFlip() {
 }
 
 bool BaseRenderOSystem::flip() {
+	flushSpriteBatch();
+
 	if (_skipThisFrame) {
 		_skipThisFrame = false;
-		delete _dirtyRect;
-		_dirtyRect = nullptr;
+		_dirtyRects.clear();
 		g_system->updateScreen();
 		_needsFlip = false;
 
@@ -167,6 +172,9 @@ bool BaseRenderOSystem::flip() {
 		}
 
 		addDirtyRect(_renderRect);
+
+		_lastFrameStats = _frameStats;
+		memset(&_frameStats, 0, sizeof(_frameStats));
 		return true;
 	}
 	if (!_disableDirtyRects) {
@@ -194,15 +202,16 @@ bool BaseRenderOSystem::flip() {
 		if (_disableDirtyRects || screenChanged) {
 			g_system->copyRectToScreen((byte *)_renderSurface->getPixels(), _renderSurface->pitch, 0, 0, _renderSurface->w, _renderSurface->h);
 		}
-		//  g_system->copyRectToScreen((byte *)_renderSurface->getPixels(), _renderSurface->pitch, _dirtyRect->left, _dirtyRect->top, _dirtyRect->width(), _dirtyRect->height());
-		delete _dirtyRect;
-		_dirtyRect = nullptr;
+		_dirtyRects.clear();
 		_needsFlip = false;
 	}
 	_lastFrameIter = _renderQueue.end();
 
 	g_system->updateScreen();
 
+	_lastFrameStats = _frameStats;
+	memset(&_frameStats, 0, sizeof(_frameStats));
+
 	return STATUS_OK;
 }
 
@@ -272,6 +281,8 @@ void BaseRenderOSystem::drawSurface(BaseSurfaceOSystem *owner, const Graphics::S
 
 	if (_disableDirtyRects) {
 		RenderTicket *ticket = new RenderTicket(owner, surf, srcRect, dstRect, transform);
+		_frameStats.tickets++;
+		_frameStats.bytesCopied += ticket->getBytesCopied();
 		ticket->_wantsDraw = true;
 		_renderQueue.push_back(ticket);
 		drawFromSurface(ticket);
@@ -283,43 +294,100 @@ void BaseRenderOSystem::drawSurface(BaseSurfaceOSystem *owner, const Graphics::S
 		return;
 	}
 
+	if (_spriteBatch && owner) {
+		if (owner != _batchOwner) {
+			flushSpriteBatch();
+			_batchOwner = owner;
+		}
+		BatchedDraw draw;
+		draw.surf = surf;
+		draw.srcRect = *srcRect;
+		draw.dstRect = *dstRect;
+		draw.transform = transform;
+		_batchedDraws.push_back(draw);
+		return;
+	}
+
+	// Keep the draw-calls in order
+	flushSpriteBatch();
+	drawTicket(owner, surf, srcRect, dstRect, transform);
+}
+
+void BaseRenderOSystem::drawTicket(BaseSurfaceOSystem *owner, const Graphics::Surface *surf, Common::Rect *srcRect, Common::Rect *dstRect, Graphics::TransformStruct &transform) {
 	if (owner) { // Fade-tickets are owner-less
 		RenderTicket compare(owner, nullptr, srcRect, dstRect, transform);
-		RenderQueueIterator it = _lastFrameIter;
-		++it;
-		// Avoid calling end() and operator* every time, when potentially going through
-		// LOTS of tickets.
-		RenderQueueIterator endIterator = _renderQueue.end();
-		RenderTicket *compareTicket = nullptr;
-		for (; it != endIterator; ++it) {
-			compareTicket = *it;
-			if (*(compareTicket) == compare && compareTicket->_isValid) {
-				if (_disableDirtyRects) {
-					drawFromSurface(compareTicket);
-				} else {
-					drawFromQueuedTicket(it);
-				}
-				return;
-			}
+		if (drawFromLastFrame(compare)) {
+			return;
 		}
 	}
 	RenderTicket *ticket = new RenderTicket(owner, surf, srcRect, dstRect, transform);
-	if (!_disableDirtyRects) {
-		drawFromTicket(ticket);
+	_frameStats.tickets++;
+	_frameStats.bytesCopied += ticket->getBytesCopied();
+	drawFromTicket(ticket);
+}
+
+bool BaseRenderOSystem::drawFromLastFrame(const RenderTicket &compare) {
+	RenderQueueIterator it = _lastFrameIter;
+	++it;
+	// Avoid calling end() and operator* every time, when potentially going through
+	// LOTS of tickets.
+	RenderQueueIterator endIterator = _renderQueue.end();
+	RenderTicket *compareTicket = nullptr;
+	for (; it != endIterator; ++it) {
+		compareTicket = *it;
+		if (*(compareTicket) == compare && compareTicket->_isValid) {
+			drawFromQueuedTicket(it);
+			return true;
+		}
+	}
+	return false;
+}
+
+void BaseRenderOSystem::flushSpriteBatch() {
+	if (_batchedDraws.empty()) {
+		return;
+	}
+
+	if (_batchedDraws.size() == 1) {
+		BatchedDraw &draw = _batchedDraws[0];
+		drawTicket(_batchOwner, draw.surf, &draw.srcRect, &draw.dstRect, draw.transform);
 	} else {
-		ticket->_wantsDraw = true;
-		_renderQueue.push_back(ticket);
-		drawFromSurface(ticket);
+		// Compare against last frame without touching any pixels first
+		RenderTicket compare(_batchOwner);
+		for (uint i = 0; i < _batchedDraws.size(); i++) {
+			BatchedDraw &draw = _batchedDraws[i];
+			compare.addToBatch(new RenderTicket(_batchOwner, nullptr, &draw.srcRect, &draw.dstRect, draw.transform));
+		}
+		if (!drawFromLastFrame(compare)) {
+			RenderTicket *ticket = new RenderTicket(_batchOwner);
+			for (uint i = 0; i < _batchedDraws.size(); i++) {
+				BatchedDraw &draw = _batchedDraws[i];
+				ticket->addToBatch(new RenderTicket(_batchOwner, draw.surf, &draw.srcRect, &draw.dstRect, draw.transform));
+			}
+			_frameStats.tickets++;
+			_frameStats.bytesCopied += ticket->getBytesCopied();
+			drawFromTicket(ticket);
+		}
 	}
+
+	_batchedDraws.clear();
+	_batchOwner = nullptr;
 }
 
 void BaseRenderOSystem::invalidateTicket(RenderTicket *renderTicket) {
 	addDirtyRect(renderTicket->_dstRect);
 	renderTicket->_isValid = false;
+	// The owner is about to change or free the pixels the ticket refers to
+	_frameStats.bytesCopied += renderTicket->detach();
 //	renderTicket->_canDelete = true; // TODO: Maybe readd this, to avoid even more duplicates.
 }
 
 void BaseRenderOSystem::invalidateTicketsFromSurface(BaseSurfaceOSystem *surf) {
+	// Pending draw-calls still refer to the pixels of their owner
+	if (_batchOwner == surf) {
+		flushSpriteBatch();
+	}
+
 	RenderQueueIterator it;
 	for (it = _renderQueue.begin(); it != _renderQueue.end(); ++it) {
 		if ((*it)->_owner == surf) {
@@ -365,12 +433,50 @@ void BaseRenderOSystem::drawFromQueuedTicket(const RenderQueueIterator &ticket)
 }
 
 void BaseRenderOSystem::addDirtyRect(const Common::Rect &rect) {
-	if (!_dirtyRect) {
-		_dirtyRect = new Common::Rect(rect);
-	} else {
-		_dirtyRect->extend(rect);
+	Common::Rect dirty(rect);
+	dirty.clip(_renderRect);
+	if (dirty.isEmpty()) {
+		return;
 	}
-	_dirtyRect->clip(_renderRect);
+
+	// Keep the dirty rects disjoint, so no part of the screen is composed
+	// twice: merge the new rect with every rect it overlaps. The merged rect
+	// may overlap other rects in turn, so start over after each merge.
+	uint i = 0;
+	while (i < _dirtyRects.size()) {
+		if (_dirtyRects[i].contains(dirty)) {
+			return;
+		}
+		if (_dirtyRects[i].intersects(dirty)) {
+			dirty.extend(_dirtyRects[i]);
+			_dirtyRects.remove_at(i);
+			i = 0;
+		} else {
+			++i;
+		}
+	}
+
+	// Lots of small rects cost more in ticket traversal than they save,
+	// so merge with the rect which grows the least instead.
+	if (_dirtyRects.size() >= MAX_DIRTY_RECTS) {
+		uint best = 0;
+		int bestGrowth = 0;
+		for (i = 0; i < _dirtyRects.size(); i++) {
+			Common::Rect merged(_dirtyRects[i]);
+			merged.extend(dirty);
+			int growth = merged.width() * merged.height() - _dirtyRects[i].width() * _dirtyRects[i].height();
+			if (i == 0 || growth < bestGrowth) {
+				best = i;
+				bestGrowth = growth;
+			}
+		}
+		dirty.extend(_dirtyRects[best]);
+		_dirtyRects.remove_at(best);
+		addDirtyRect(dirty);
+		return;
+	}
+
+	_dirtyRects.push_back(dirty);
 }
 
 void BaseRenderOSystem::drawTickets() {
@@ -378,7 +484,8 @@ void BaseRenderOSystem::drawTickets() {
 	// Clean out the old tickets
 	// Note: We draw invalid tickets too, otherwise we wouldn't be honoring
 	// the draw request they obviously made BEFORE becoming invalid, either way
-	// we have a copy of their data, so their invalidness won't affect us.
+	// they took a copy of their data when invalidated, so their invalidness
+	// won't affect us.
 	while (it != _renderQueue.end()) {
 		if ((*it)->_wantsDraw == false) {
 			RenderTicket *ticket = *it;
@@ -389,7 +496,7 @@ void BaseRenderOSystem::drawTickets() {
 			++it;
 		}
 	}
-	if (!_dirtyRect || _dirtyRect->width() == 0 || _dirtyRect->height() == 0) {
+	if (_dirtyRects.empty()) {
 		it = _renderQueue.begin();
 		while (it != _renderQueue.end()) {
 			RenderTicket *ticket = *it;
@@ -404,38 +511,36 @@ void BaseRenderOSystem::drawTickets() {
 	// A special case: If the screen has one giant OPAQUE rect to be drawn, then we skip filling
 	// the background color. Typical use-case: Fullscreen FMVs.
 	// Caveat: The FPS-counter will invalidate this.
+	const RenderTicket *opaqueTicket = nullptr;
 	if (it != _lastFrameIter && _renderQueue.front() == _renderQueue.back() && (*it)->_transform._alphaDisable == true) {
-		// If our single opaque rect fills the dirty rect, we can skip filling.
-		if (*_dirtyRect != (*it)->_dstRect) {
-			// Apply the clear-color to the dirty rect.
-			_renderSurface->fillRect(*_dirtyRect, _clearColor);
-		}
-		// Otherwise Do NOT fill.
-	} else {
-		// Apply the clear-color to the dirty rect.
-		_renderSurface->fillRect(*_dirtyRect, _clearColor);
+		opaqueTicket = *it;
 	}
-	for (; it != _renderQueue.end(); ++it) {
-		RenderTicket *ticket = *it;
-		if (ticket->_dstRect.intersects(*_dirtyRect)) {
-			// dstClip is the area we want redrawn.
-			Common::Rect dstClip(ticket->_dstRect);
-			// reduce it to the dirty rect
-			dstClip.clip(*_dirtyRect);
-			// we need to keep track of the position to redraw the dirty rect
-			Common::Rect pos(dstClip);
-			int16 offsetX = ticket->_dstRect.left;
-			int16 offsetY = ticket->_dstRect.top;
-			// convert from screen-coords to surface-coords.
-			dstClip.translate(-offsetX, -offsetY);
 
-			drawFromSurface(ticket, &pos, &dstClip);
-			_needsFlip = true;
+	// The dirty rects are disjoint, so each of them can be composed on its own
+	Common::Rect bounds;
+	for (uint i = 0; i < _dirtyRects.size(); i++) {
+		const Common::Rect &dirtyRect = _dirtyRects[i];
+		drawDirtyRect(dirtyRect, opaqueTicket);
+
+		if (i == 0) {
+			bounds = dirtyRect;
+		} else {
+			bounds.extend(dirtyRect);
 		}
+		_frameStats.dirtyRects++;
+		_frameStats.dirtyArea += dirtyRect.width() * dirtyRect.height();
+	}
+	_frameStats.dirtyBoundingArea += bounds.width() * bounds.height();
+
+	for (it = _renderQueue.begin(); it != _renderQueue.end(); ++it) {
 		// Some tickets want redraw but don't actually clip the dirty area (typically the ones that shouldnt become clear-color)
-		ticket->_wantsDraw = false;
+		(*it)->_wantsDraw = false;
+	}
+
+	for (uint i = 0; i < _dirtyRects.size(); i++) {
+		const Common::Rect &dirtyRect = _dirtyRects[i];
+		g_system->copyRectToScreen((byte *)_renderSurface->getBasePtr(dirtyRect.left, dirtyRect.top), _renderSurface->pitch, dirtyRect.left, dirtyRect.top, dirtyRect.width(), dirtyRect.height());
 	}
-	g_system->copyRectToScreen((byte *)_renderSurface->getBasePtr(_dirtyRect->left, _dirtyRect->top), _renderSurface->pitch, _dirtyRect->left, _dirtyRect->top, _dirtyRect->width(), _dirtyRect->height());
 
 	it = _renderQueue.begin();
 	// Clean out the old tickets
@@ -452,6 +557,33 @@ void BaseRenderOSystem::drawTickets() {
 
 }
 
+void BaseRenderOSystem::drawDirtyRect(const Common::Rect &dirtyRect, const RenderTicket *opaqueTicket) {
+	// If our single opaque rect fills the dirty rect, we can skip filling.
+	if (!opaqueTicket || dirtyRect != opaqueTicket->_dstRect) {
+		// Apply the clear-color to the dirty rect.
+		_renderSurface->fillRect(dirtyRect, _clearColor);
+	}
+
+	for (RenderQueueIterator it = _renderQueue.begin(); it != _renderQueue.end(); ++it) {
+		RenderTicket *ticket = *it;
+		if (ticket->_dstRect.intersects(dirtyRect)) {
+			// dstClip is the area we want redrawn.
+			Common::Rect dstClip(ticket->_dstRect);
+			// reduce it to the dirty rect
+			dstClip.clip(dirtyRect);
+			// we need to keep track of the position to redraw the dirty rect
+			Common::Rect pos(dstClip);
+			int16 offsetX = ticket->_dstRect.left;
+			int16 offsetY = ticket->_dstRect.top;
+			// convert from screen-coords to surface-coords.
+			dstClip.translate(-offsetX, -offsetY);
+
+			drawFromSurface(ticket, &pos, &dstClip);
+			_needsFlip = true;
+		}
+	}
+}
+
 // Replacement for SDL2's SDL_RenderCopy
 void BaseRenderOSystem::drawFromSurface(RenderTicket *ticket) {
 	ticket->drawToSurface(_renderSurface);
@@ -564,6 +696,9 @@ BaseSurface *BaseRenderOSystem::createSurface() {
 void BaseRenderOSystem::endSaveLoad() {
 	BaseRenderer::endSaveLoad();
 
+	_batchedDraws.clear();
+	_batchOwner = nullptr;
+
 	// Clear the scale-buffered tickets as we just loaded.
 	RenderQueueIterator it = _renderQueue.begin();
 	while (it != _renderQueue.end()) {
@@ -582,10 +717,14 @@ void BaseRenderOSystem::endSaveLoad() {
 }
 
 bool BaseRenderOSystem::startSpriteBatch() {
+	// Without dirty rects every draw-call is drawn right away
+	_spriteBatch = !_disableDirtyRects;
 	return STATUS_OK;
 }
 
 bool BaseRenderOSystem::endSpriteBatch() {
+	flushSpriteBatch();
+	_spriteBatch = false;
 	return STATUS_OK;
 }
 
@@ -32,6 +32,7 @@
 #include "engines/wintermute/base/gfx/base_renderer.h"
 #include "common/rect.h"
 #include "graphics/surface.h"
+#include "common/array.h"
 #include "common/list.h"
 #include "graphics/transform_struct.h"
 
@@ -112,21 +113,54 @@ public:
 	void endSaveLoad();
 	void drawSurface(BaseSurfaceOSystem *owner, const Graphics::Surface *surf, Common::Rect *srcRect, Common::Rect *dstRect, Graphics::TransformStruct &transform);
 	BaseSurface *createSurface() override;
+
+	struct RenderStats {
+		uint32 tickets;           ///< Number of tickets created
+		uint32 bytesCopied;       ///< Pixel bytes copied into render tickets
+		uint32 dirtyRects;        ///< Number of dirty rects composed
+		uint32 dirtyArea;         ///< Pixels composed
+		uint32 dirtyBoundingArea; ///< Pixels in the bounding box of the dirty rects
+	};
+
+	/**
+	 * Get the render statistics of the last frame.
+	 */
+	const RenderStats &getLastFrameStats() const { return _lastFrameStats; }
 private:
 	/**
 	 * Mark a specified rect of the screen as dirty.
 	 * @param rect the region to be marked as dirty
 	 */
 	void addDirtyRect(const Common::Rect &rect);
+	/**
+	 * Queue a ticket for a draw-call, reusing the one from last frame if possible
+	 */
+	void drawTicket(BaseSurfaceOSystem *owner, const Graphics::Surface *surf, Common::Rect *srcRect, Common::Rect *dstRect, Graphics::TransformStruct &transform);
+	/**
+	 * Look for a ticket equal to compare in the remaining tickets of last
+	 * frame, and queue it if there is one
+	 * @return true if a ticket was reused
+	 */
+	bool drawFromLastFrame(const RenderTicket &compare);
+	/**
+	 * Queue the draw-calls collected since startSpriteBatch() as one ticket
+	 */
+	void flushSpriteBatch();
 	/**
 	 * Traverse the tickets that are dirty, and draw them
 	 */
 	void drawTickets();
+	/**
+	 * Compose a single dirty rect from the tickets that intersect it
+	 * @param dirtyRect the region to be redrawn
+	 * @param opaqueTicket the only ticket in the queue, if it is opaque
+	 */
+	void drawDirtyRect(const Common::Rect &dirtyRect, const RenderTicket *opaqueTicket);
 	// Non-dirty-rects:
 	void drawFromSurface(RenderTicket *ticket);
 	// Dirty-rects:
 	void drawFromSurface(RenderTicket *ticket, Common::Rect *dstRect, Common::Rect *clipRect);
-	Common::Rect *_dirtyRect;
+	Common::Array<Common::Rect> _dirtyRects;
 	Common::List<RenderTicket *> _renderQueue;
 
 	bool _needsFlip;
@@ -147,6 +181,21 @@ private:
 
 	bool _skipThisFrame;
 	int _lastScreenChangeID; // previous value of OSystem::getScreenChangeID()
+
+	RenderStats _frameStats;
+	RenderStats _lastFrameStats;
+
+	// The draw-calls made with the same owner between startSpriteBatch()
+	// and endSpriteBatch(), which are queued as a single ticket
+	struct BatchedDraw {
+		const Graphics::Surface *surf;
+		Common::Rect srcRect;
+		Common::Rect dstRect;
+		Graphics::TransformStruct transform;
+	};
+	bool _spriteBatch;
+	BaseSurfaceOSystem *_batchOwner;
+	Common::Array<BatchedDraw> _batchedDraws;
 };
 
 } // End of namespace Wintermute
@@ -50,10 +50,14 @@ BaseSurfaceOSystem::BaseSurfaceOSystem(BaseGame *inGame) : BaseSurface(inGame) {
 	_lockPitch = 0;
 	_loaded = false;
 	_rotation = 0;
+	_transformedWidth = _transformedHeight = 0;
 }
 
 //////////////////////////////////////////////////////////////////////////
 BaseSurfaceOSystem::~BaseSurfaceOSystem() {
+	// The tickets may still refer to our pixels
+	invalidateTickets();
+
 	if (_surface) {
 		_surface->free();
 		delete _surface;
@@ -64,8 +68,6 @@ BaseSurfaceOSystem::~BaseSurfaceOSystem() {
 	_alphaMask = nullptr;
 
 	_gameRef->addMem(-_width * _height * 4);
-	BaseRenderOSystem *renderer = static_cast<BaseRenderOSystem *>(_gameRef->_renderer);
-	renderer->invalidateTicketsFromSurface(this);
 }
 
 Graphics::AlphaType hasTransparencyType(const Graphics::Surface *surf) {
@@ -130,6 +132,16 @@ bool BaseSurfaceOSystem::create(const Common::String &filename, bool defaultCK,
 	return STATUS_OK;
 }
 
+//////////////////////////////////////////////////////////////////////////
+bool BaseSurfaceOSystem::preload() {
+	if (_loaded) {
+		return false;
+	}
+	finishLoad();
+	return true;
+}
+
+//////////////////////////////////////////////////////////////////////////
 bool BaseSurfaceOSystem::finishLoad() {
 	BaseImage *image = new BaseImage();
 	if (!image->loadFile(_filename)) {
@@ -315,8 +327,7 @@ bool BaseSurfaceOSystem::isTransparentAtLite(int x, int y) {
 bool BaseSurfaceOSystem::startPixelOp() {
 	//SDL_LockTexture(_texture, nullptr, &_lockPixels, &_lockPitch);
 	// Any pixel-op makes the caching useless:
-	BaseRenderOSystem *renderer = static_cast<BaseRenderOSystem *>(_gameRef->_renderer);
-	renderer->invalidateTicketsFromSurface(this);
+	invalidateTickets();
 	return STATUS_OK;
 }
 
@@ -442,6 +453,8 @@ bool BaseSurfaceOSystem::drawSprite(int x, int y, Rect32 *rect, Rect32 *newRect,
 }
 
 bool BaseSurfaceOSystem::putSurface(const Graphics::Surface &surface, bool hasAlpha) {
+	invalidateTickets();
+
 	_loaded = true;
 	if (surface.format == _surface->format && surface.pitch == _surface->pitch && surface.h == _surface->h) {
 		const byte *src = (const byte *)surface.getBasePtr(0, 0);
@@ -456,10 +469,37 @@ bool BaseSurfaceOSystem::putSurface(const Graphics::Surface &surface, bool hasAl
 	} else {
 		_alphaType = Graphics::ALPHA_OPAQUE;
 	}
+
+	return STATUS_OK;
+}
+
+void BaseSurfaceOSystem::invalidateTickets() {
+	_transformedSurface.reset();
 	BaseRenderOSystem *renderer = static_cast<BaseRenderOSystem *>(_gameRef->_renderer);
 	renderer->invalidateTicketsFromSurface(this);
+}
 
-	return STATUS_OK;
+Common::SharedPtr<Graphics::Surface> BaseSurfaceOSystem::getCachedTransform(const Common::Rect &srcRect, const Common::Rect &dstRect, const Graphics::TransformStruct &transform) const {
+	if (_transformedSurface &&
+		_transformedSrcRect == srcRect &&
+		_transformedWidth == dstRect.width() &&
+		_transformedHeight == dstRect.height() &&
+		_transformedTransform._angle == transform._angle &&
+		_transformedTransform._zoom == transform._zoom &&
+		_transformedTransform._hotspot == transform._hotspot &&
+		_transformedTransform._numTimesX == transform._numTimesX &&
+		_transformedTransform._numTimesY == transform._numTimesY) {
+		return _transformedSurface;
+	}
+	return Common::SharedPtr<Graphics::Surface>();
+}
+
+void BaseSurfaceOSystem::setCachedTransform(const Common::Rect &srcRect, const Common::Rect &dstRect, const Graphics::TransformStruct &transform, const Common::SharedPtr<Graphics::Surface> &surface) {
+	_transformedSurface = surface;
+	_transformedSrcRect = srcRect;
+	_transformedWidth = dstRect.width();
+	_transformedHeight = dstRect.height();
+	_transformedTransform = transform;
 }
 
 } // End of namespace Wintermute
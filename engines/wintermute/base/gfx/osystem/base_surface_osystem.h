@@ -33,6 +33,7 @@
 #include "graphics/transparent_surface.h"
 #include "engines/wintermute/base/gfx/base_surface.h"
 #include "common/list.h"
+#include "common/ptr.h"
 
 namespace Wintermute {
 struct TransparentSurface;
@@ -45,6 +46,8 @@ public:
 	bool create(const Common::String &filename, bool defaultCK, byte ckRed, byte ckGreen, byte ckBlue, int lifeTime = -1, bool keepLoaded = false) override;
 	bool create(int width, int height) override;
 
+	bool preload() override;
+
 	bool isTransparentAt(int x, int y) override;
 	bool isTransparentAtLite(int x, int y) override;
 
@@ -83,6 +86,14 @@ public:
 	}
 
 	Graphics::AlphaType getAlphaType() const { return _alphaType; }
+
+	/**
+	 * Get the rotated/scaled version of a part of this surface, if it was the
+	 * last one generated by a RenderTicket.
+	 * @return the transformed surface, or a null pointer if it isn't cached
+	 */
+	Common::SharedPtr<Graphics::Surface> getCachedTransform(const Common::Rect &srcRect, const Common::Rect &dstRect, const Graphics::TransformStruct &transform) const;
+	void setCachedTransform(const Common::Rect &srcRect, const Common::Rect &dstRect, const Graphics::TransformStruct &transform, const Common::SharedPtr<Graphics::Surface> &surface);
 private:
 	Graphics::Surface *_surface;
 	bool _loaded;
@@ -96,6 +107,17 @@ private:
 	void *_lockPixels;
 	int _lockPitch;
 	byte *_alphaMask;
+
+	// The last transformed part of the surface, shared with the tickets drawing it
+	Common::SharedPtr<Graphics::Surface> _transformedSurface;
+	Common::Rect _transformedSrcRect;
+	int16 _transformedWidth;
+	int16 _transformedHeight;
+	Graphics::TransformStruct _transformedTransform;
+	/**
+	 * Invalidate the tickets drawing this surface, before its pixels are changed.
+	 */
+	void invalidateTickets();
 };
 
 } // End of namespace Wintermute
@@ -40,15 +40,12 @@ RenderTicket::RenderTicket(BaseSurfaceOSystem *owner, const Graphics::Surface *s
 	_dstRect(*dstRect),
 	_isValid(true),
 	_wantsDraw(true),
-	_transform(transform) {
+	_transform(transform),
+	_bytesCopied(0) {
 	if (surf) {
-		_surface = new Graphics::Surface();
-		_surface->create((uint16)srcRect->width(), (uint16)srcRect->height(), surf->format);
-		assert(_surface->format.bytesPerPixel == 4);
-		// Get a clipped copy of the surface
-		for (int i = 0; i < _surface->h; i++) {
-			memcpy(_surface->getBasePtr(0, i), surf->getBasePtr(srcRect->left, srcRect->top + i), srcRect->width() * _surface->format.bytesPerPixel);
-		}
+		assert(surf->format.bytesPerPixel == 4);
+		// Refer to the clipped area of the surface
+		_surface = surf->getSubArea(*srcRect);
 		// Then scale it if necessary
 		//
 		// NB: The numTimesX/numTimesY properties don't yet mix well with
@@ -57,46 +54,121 @@ RenderTicket::RenderTicket(BaseSurfaceOSystem *owner, const Graphics::Surface *s
 		// NB: Mirroring and rotation are probably done in the wrong order.
 		// (Mirroring should most likely be done before rotation. See also
 		// TransformTools.)
-		if (_transform._angle != Graphics::kDefaultAngle) {
-			Graphics::TransparentSurface src(*_surface, false);
-			Graphics::Surface *temp = src.rotoscale(transform);
-			_surface->free();
-			delete _surface;
-			_surface = temp;
-		} else if ((dstRect->width() != srcRect->width() ||
-					dstRect->height() != srcRect->height()) &&
-					_transform._numTimesX * _transform._numTimesY == 1) {
-			Graphics::TransparentSurface src(*_surface, false);
-			Graphics::Surface *temp = src.scale(dstRect->width(), dstRect->height());
-			_surface->free();
-			delete _surface;
-			_surface = temp;
+		if (_transform._angle != Graphics::kDefaultAngle ||
+			((dstRect->width() != srcRect->width() ||
+			  dstRect->height() != srcRect->height()) &&
+			 _transform._numTimesX * _transform._numTimesY == 1)) {
+			// Sprites often move around without changing their transform,
+			// so the owner keeps the last transformed version around
+			if (_owner) {
+				_pixels = _owner->getCachedTransform(*srcRect, *dstRect, _transform);
+			}
+			if (!_pixels) {
+				Graphics::TransparentSurface src(_surface, false);
+				Graphics::Surface *temp;
+				if (_transform._angle != Graphics::kDefaultAngle) {
+					temp = src.rotoscale(transform);
+				} else {
+					temp = src.scale(dstRect->width(), dstRect->height());
+				}
+				_pixels = Common::SharedPtr<Graphics::Surface>(temp, Graphics::SharedPtrSurfaceDeleter());
+				_bytesCopied = temp->h * temp->pitch;
+				if (_owner) {
+					_owner->setCachedTransform(*srcRect, *dstRect, _transform, _pixels);
+				}
+			}
+			_surface = *_pixels;
+		} else if (!_owner) {
+			// Owner-less tickets are drawn from temporary surfaces, so they
+			// always need a copy.
+			detach();
 		}
-	} else {
-		_surface = nullptr;
 	}
 }
 
+RenderTicket::RenderTicket(BaseSurfaceOSystem *owner) :
+	_owner(owner),
+	_isValid(true),
+	_wantsDraw(true),
+	_transform(Graphics::TransformStruct()),
+	_bytesCopied(0) {
+}
+
 RenderTicket::~RenderTicket() {
-	if (_surface) {
-		_surface->free();
-		delete _surface;
+	for (uint i = 0; i < _batch.size(); i++) {
+		delete _batch[i];
 	}
 }
 
+void RenderTicket::addToBatch(RenderTicket *ticket) {
+	assert(ticket->_owner == _owner && !ticket->isBatch());
+	if (_batch.empty()) {
+		_dstRect = ticket->_dstRect;
+	} else {
+		_dstRect.extend(ticket->_dstRect);
+	}
+	_bytesCopied += ticket->getBytesCopied();
+	_batch.push_back(ticket);
+}
+
+uint32 RenderTicket::detach() {
+	if (isBatch()) {
+		uint32 size = 0;
+		for (uint i = 0; i < _batch.size(); i++) {
+			_batch[i]->_wantsDraw = _wantsDraw;
+			size += _batch[i]->detach();
+		}
+		_bytesCopied += size;
+		return size;
+	}
+
+	if (_pixels || !_surface.getPixels()) {
+		return 0;
+	}
+
+	if (!_wantsDraw && _owner) {
+		// This ticket will not be drawn again, so there is no need to
+		// keep the contents around
+		_surface = Graphics::Surface();
+		return 0;
+	}
+
+	Graphics::Surface *copy = new Graphics::Surface();
+	copy->copyFrom(_surface);
+	_pixels = Common::SharedPtr<Graphics::Surface>(copy, Graphics::SharedPtrSurfaceDeleter());
+	_surface = *copy;
+
+	uint32 size = copy->h * copy->pitch;
+	_bytesCopied += size;
+	return size;
+}
+
 bool RenderTicket::operator==(const RenderTicket &t) const {
 	if ((t._owner != _owner) ||
 		(t._transform != _transform)  ||
 		(t._dstRect != _dstRect) ||
-		(t._srcRect != _srcRect)
+		(t._srcRect != _srcRect) ||
+		(t._batch.size() != _batch.size())
 	) {
 		return false;
 	}
+	for (uint i = 0; i < _batch.size(); i++) {
+		if (!(*t._batch[i] == *_batch[i])) {
+			return false;
+		}
+	}
 	return true;
 }
 
 // Replacement for SDL2's SDL_RenderCopy
 void RenderTicket::drawToSurface(Graphics::Surface *_targetSurface) const {
+	if (isBatch()) {
+		for (uint i = 0; i < _batch.size(); i++) {
+			_batch[i]->drawToSurface(_targetSurface);
+		}
+		return;
+	}
+
 	Graphics::TransparentSurface src(*getSurface(), false);
 
 	Common::Rect clipRect;
@@ -126,6 +198,27 @@ void RenderTicket::drawToSurface(Graphics::Surface *_targetSurface) const {
 }
 
 void RenderTicket::drawToSurface(Graphics::Surface *_targetSurface, Common::Rect *dstRect, Common::Rect *clipRect) const {
+	if (isBatch()) {
+		// Redraw the part of each ticket in the batch that lies in the requested area
+		Common::Rect area(_dstRect);
+		if (clipRect) {
+			area = *clipRect;
+			area.translate(_dstRect.left, _dstRect.top);
+		}
+		for (uint i = 0; i < _batch.size(); i++) {
+			const RenderTicket *ticket = _batch[i];
+			Common::Rect pos(ticket->_dstRect);
+			pos.clip(area);
+			if (pos.isEmpty()) {
+				continue;
+			}
+			Common::Rect clip(pos);
+			clip.translate(-ticket->_dstRect.left, -ticket->_dstRect.top);
+			ticket->drawToSurface(_targetSurface, &pos, &clip);
+		}
+		return;
+	}
+
 	Graphics::TransparentSurface src(*getSurface(), false);
 	bool doDelete = false;
 	if (!clipRect) {
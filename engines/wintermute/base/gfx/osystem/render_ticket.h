@@ -31,6 +31,8 @@
 
 #include "graphics/transparent_surface.h"
 #include "graphics/surface.h"
+#include "common/ptr.h"
+#include "common/array.h"
 #include "common/rect.h"
 
 namespace Wintermute {
@@ -44,17 +46,46 @@ class BaseSurfaceOSystem;
  * the same call is done in the following frame. Thus allowing us to potentially
  * skip drawing the same region again, unless anything has changed. Since a surface
  * can have a potentially large amount of draw-calls made to it, at varying rotation,
- * zoom, and crop-levels we also need to hold a copy of the necessary data.
+ * zoom, and crop-levels we also need to be able to get at the necessary data.
  * (Video-surfaces may even change their data). The promise that is made when a ticket
  * is created is that what the state was of the surface at THAT point, is what will end
  * up on screen at flip() time.
+ *
+ * To keep that promise without copying every sprite every frame, untransformed
+ * tickets refer directly to the pixels of their owner. The owner invalidates its
+ * tickets before it changes or frees those pixels, at which point any ticket that
+ * is still to be drawn takes a private copy (see detach()). Rotated and scaled
+ * tickets share the transformed surface cached by their owner.
+ *
+ * A batch ticket holds a run of draw-calls made with the same owner, which
+ * are queued, compared, and drawn as one ticket.
  */
 class RenderTicket {
 public:
 	RenderTicket(BaseSurfaceOSystem *owner, const Graphics::Surface *surf, Common::Rect *srcRect, Common::Rect *dstRest, Graphics::TransformStruct transform);
-	RenderTicket() : _isValid(true), _wantsDraw(false), _transform(Graphics::TransformStruct()) {}
+	RenderTicket() : _isValid(true), _wantsDraw(false), _transform(Graphics::TransformStruct()), _bytesCopied(0) {}
+	/**
+	 * Create an empty batch ticket, see addToBatch().
+	 */
+	RenderTicket(BaseSurfaceOSystem *owner);
 	~RenderTicket();
-	const Graphics::Surface *getSurface() const { return _surface; }
+	/**
+	 * Add a ticket to this batch ticket, which takes ownership of it.
+	 * @param ticket a ticket with the same owner as this one
+	 */
+	void addToBatch(RenderTicket *ticket);
+	bool isBatch() const { return !_batch.empty(); }
+	const Graphics::Surface *getSurface() const { return &_surface; }
+	/**
+	 * Make sure the ticket no longer refers to the pixels of its owner,
+	 * by taking a copy of them if it is still going to be drawn.
+	 * @return the number of bytes copied
+	 */
+	uint32 detach();
+	/**
+	 * The number of pixel bytes copied or generated for this ticket when it was created.
+	 */
+	uint32 getBytesCopied() const { return _bytesCopied; }
 	// Non-dirty-rects:
 	void drawToSurface(Graphics::Surface *_targetSurface) const;
 	// Dirty-rects:
@@ -71,8 +102,12 @@ public:
 	bool operator==(const RenderTicket &a) const;
 	const Common::Rect *getSrcRect() const { return &_srcRect; }
 private:
-	Graphics::Surface *_surface;
+	// The pixels to draw, either owned by _pixels or by _owner
+	Graphics::Surface _surface;
+	Common::SharedPtr<Graphics::Surface> _pixels;
 	Common::Rect _srcRect;
+	uint32 _bytesCopied;
+	Common::Array<RenderTicket *> _batch;
 };
 
 } // End of namespace Wintermute
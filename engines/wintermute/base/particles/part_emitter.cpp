@@ -27,7 +27,6 @@
  */
 
 #include "engines/wintermute/base/particles/part_emitter.h"
-#include "engines/wintermute/base/particles/part_particle.h"
 #include "engines/wintermute/math/vector2.h"
 #include "engines/wintermute/math/matrix4.h"
 #include "engines/wintermute/base/scriptables/script_value.h"
@@ -35,9 +34,11 @@
 #include "engines/wintermute/base/base_engine.h"
 #include "engines/wintermute/base/timer.h"
 #include "engines/wintermute/base/base_region.h"
+#include "engines/wintermute/base/base_sprite.h"
 #include "engines/wintermute/base/base_file_manager.h"
 #include "engines/wintermute/base/gfx/base_renderer.h"
 #include "engines/wintermute/utils/utils.h"
+#include "engines/wintermute/platform_osystem.h"
 #include "common/str.h"
 #include "common/math.h"
 
@@ -45,6 +46,21 @@ namespace Wintermute {
 
 IMPLEMENT_PERSISTENT(PartEmitter, false)
 
+namespace {
+
+// Orders particle indices by the Z position of the particles
+struct ParticleZLess {
+	const float *_posZ;
+
+	ParticleZLess(const float *posZ) : _posZ(posZ) {}
+
+	bool operator()(uint32 a, uint32 b) const {
+		return _posZ[a] < _posZ[b];
+	}
+};
+
+} // End of anonymous namespace
+
 //////////////////////////////////////////////////////////////////////////
 PartEmitter::PartEmitter(BaseGame *inGame, BaseScriptHolder *owner) : BaseObject(inGame) {
 	_width = _height = 0;
@@ -95,11 +111,10 @@ PartEmitter::PartEmitter(BaseGame *inGame, BaseScriptHolder *owner) : BaseObject
 
 //////////////////////////////////////////////////////////////////////////
 PartEmitter::~PartEmitter(void) {
-	for (uint32 i = 0; i < _particles.size(); i++) {
-		delete _particles[i];
-	}
 	_particles.clear();
 
+	clearSpritePool();
+
 	for (uint32 i = 0; i < _forces.size(); i++) {
 		delete _forces[i];
 	}
@@ -150,6 +165,7 @@ bool PartEmitter::removeSprite(const char *filename) {
 		if (scumm_stricmp(filename, _sprites[i]) == 0) {
 			delete[] _sprites[i];
 			_sprites.remove_at(i);
+			clearSpritePool();
 			return STATUS_OK;
 		}
 	}
@@ -157,10 +173,7 @@ bool PartEmitter::removeSprite(const char *filename) {
 }
 
 //////////////////////////////////////////////////////////////////////////
-bool PartEmitter::initParticle(PartParticle *particle, uint32 currentTime, uint32 timerDelta) {
-	if (!particle) {
-		return STATUS_FAILED;
-	}
+bool PartEmitter::initParticle(uint32 index, uint32 currentTime, uint32 timerDelta) {
 	if (_sprites.size() == 0) {
 		return STATUS_FAILED;
 	}
@@ -203,11 +216,12 @@ bool PartEmitter::initParticle(PartParticle *particle, uint32 currentTime, uint3
 		int thicknessTop    = (int)(_borderThicknessTop    - (float)_borderThicknessTop    * posZ / 100.0f);
 		int thicknessBottom = (int)(_borderThicknessBottom - (float)_borderThicknessBottom * posZ / 100.0f);
 
-		particle->_border = _border;
-		particle->_border.left += thicknessLeft;
-		particle->_border.right -= thicknessRight;
-		particle->_border.top += thicknessTop;
-		particle->_border.bottom -= thicknessBottom;
+		Rect32 &border = _particles._border[index];
+		border = _border;
+		border.left += thicknessLeft;
+		border.right -= thicknessRight;
+		border.top += thicknessTop;
+		border.bottom -= thicknessBottom;
 	}
 
 	Vector2 vecPos((float)posX, (float)posY);
@@ -218,33 +232,68 @@ bool PartEmitter::initParticle(PartParticle *particle, uint32 currentTime, uint3
 	matRot.transformVector2(vecVel);
 
 	if (_alphaTimeBased) {
-		particle->_alpha1 = _alpha1;
-		particle->_alpha2 = _alpha2;
+		_particles._alpha1[index] = _alpha1;
+		_particles._alpha2[index] = _alpha2;
 	} else {
 		int alpha = BaseUtils::randomInt(_alpha1, _alpha2);
-		particle->_alpha1 = alpha;
-		particle->_alpha2 = alpha;
+		_particles._alpha1[index] = alpha;
+		_particles._alpha2[index] = alpha;
+	}
+
+	_particles._creationTime[index] = currentTime;
+	_particles._posX[index] = vecPos.x;
+	_particles._posY[index] = vecPos.y;
+	_particles._posZ[index] = posZ;
+	_particles._velocityX[index] = vecVel.x;
+	_particles._velocityY[index] = vecVel.y;
+	_particles._scale[index] = scale;
+	_particles._lifeTime[index] = lifeTime;
+	_particles._rotation[index] = rotation;
+	_particles._angVelocity[index] = angVelocity;
+	_particles._growthRate[index] = growthRate;
+	_particles._exponentialGrowth[index] = _exponentialGrowth;
+	_particles._isDead[index] = DID_FAIL(setParticleSprite(index, spriteIndex));
+	_particles.fadeIn(index, currentTime, _fadeInTime);
+
+
+	if (_particles._isDead[index]) {
+		return STATUS_FAILED;
+	} else {
+		return STATUS_OK;
 	}
+}
 
-	particle->_creationTime = currentTime;
-	particle->_pos = vecPos;
-	particle->_posZ = posZ;
-	particle->_velocity = vecVel;
-	particle->_scale = scale;
-	particle->_lifeTime = lifeTime;
-	particle->_rotation = rotation;
-	particle->_angVelocity = angVelocity;
-	particle->_growthRate = growthRate;
-	particle->_exponentialGrowth = _exponentialGrowth;
-	particle->_isDead = DID_FAIL(particle->setSprite(_sprites[spriteIndex]));
-	particle->fadeIn(currentTime, _fadeInTime);
+//////////////////////////////////////////////////////////////////////////
+bool PartEmitter::setParticleSprite(uint32 index, int32 spriteIndex) {
+	const char *filename = _sprites[spriteIndex];
+	BaseSprite *sprite = _particles._sprite[index];
+	if (!sprite || !sprite->getFilename() || scumm_stricmp(filename, sprite->getFilename()) != 0) {
+		// Every particle animates on its own, so sprites can't be shared between
+		// them, but an unused one can be handed over instead of parsing the file again
+		if (sprite) {
+			sprite->killAllSounds();
+			_spritePool.add(sprite);
+			_particles._sprite[index] = nullptr;
+		}
 
+		for (uint32 i = 0; i < _spritePool.size(); i++) {
+			if (scumm_stricmp(filename, _spritePool[i]->getFilename()) == 0) {
+				_particles._sprite[index] = _spritePool[i];
+				_spritePool.remove_at(i);
+				break;
+			}
+		}
+	}
 
-	if (particle->_isDead) {
-		return STATUS_FAILED;
-	} else {
-		return STATUS_OK;
+	return _particles.setSprite(_gameRef, index, filename);
+}
+
+//////////////////////////////////////////////////////////////////////////
+void PartEmitter::clearSpritePool() {
+	for (uint32 i = 0; i < _spritePool.size(); i++) {
+		delete _spritePool[i];
 	}
+	_spritePool.clear();
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -258,15 +307,10 @@ bool PartEmitter::update() {
 
 //////////////////////////////////////////////////////////////////////////
 bool PartEmitter::updateInternal(uint32 currentTime, uint32 timerDelta) {
-	int numLive = 0;
+	updateStates(currentTime);
+	integrate(currentTime, timerDelta);
 
-	for (uint32 i = 0; i < _particles.size(); i++) {
-		_particles[i]->update(this, currentTime, timerDelta);
-
-		if (!_particles[i]->_isDead) {
-			numLive++;
-		}
-	}
+	int numLive = _particles.getNumLive();
 
 
 	// we're understaffed
@@ -281,30 +325,49 @@ bool PartEmitter::updateInternal(uint32 currentTime, uint32 timerDelta) {
 			}
 
 			int toGen = MIN(_genAmount, _maxParticles - numLive);
+			uint32 numOld = _particles.size();
+			Common::Array<uint32> spawned;
+			// revived particles are alive, so the next dead one can only come after them
+			uint32 searchStart = 0;
 			while (toGen > 0) {
 				int firstDeadIndex = -1;
-				for (uint32 i = 0; i < _particles.size(); i++) {
-					if (_particles[i]->_isDead) {
+				for (uint32 i = searchStart; i < _particles.size(); i++) {
+					if (_particles._isDead[i]) {
 						firstDeadIndex = i;
 						break;
 					}
 				}
 
-				PartParticle *particle;
+				uint32 index;
 				if (firstDeadIndex >= 0) {
-					particle = _particles[firstDeadIndex];
+					index = firstDeadIndex;
 				} else {
-					particle = new PartParticle(_gameRef);
-					_particles.add(particle);
+					index = _particles.add();
 				}
-				initParticle(particle, currentTime, timerDelta);
+				initParticle(index, currentTime, timerDelta);
 				needsSort = true;
 
+				// a particle that failed to start is picked again next time
+				if (spawned.empty() || spawned.back() != index) {
+					spawned.push_back(index);
+				}
+
+				if (firstDeadIndex >= 0 && !_particles._isDead[index]) {
+					searchStart = firstDeadIndex + 1;
+				}
+
 				toGen--;
 			}
-		}
-		if (needsSort && (_scaleZBased || _velocityZBased || _lifeTimeZBased)) {
-			sortParticlesByZ();
+
+			if (isZBased()) {
+				if (_zOrder.size() == numOld) {
+					insertParticlesByZ(spawned);
+				} else {
+					sortParticlesByZ();
+				}
+			} else {
+				_zOrder.clear();
+			}
 		}
 
 		// we actually generated some particles and we're not in fast-forward mode
@@ -319,32 +382,227 @@ bool PartEmitter::updateInternal(uint32 currentTime, uint32 timerDelta) {
 }
 
 //////////////////////////////////////////////////////////////////////////
-bool PartEmitter::display(BaseRegion *region) {
-	if (_sprites.size() <= 1) {
-		BaseEngine::getRenderer()->startSpriteBatch();
-	}
+void PartEmitter::updateStates(uint32 currentTime) {
+	_activeParticles.clear();
 
 	for (uint32 i = 0; i < _particles.size(); i++) {
+		if (_particles._isDead[i]) {
+			continue;
+		}
+
+		uint32 fadeStart = _particles._fadeStart[i];
+		int32 fadeTime = _particles._fadeTime[i];
+
+		switch (_particles._state[i]) {
+		case PartParticleArray::PARTICLE_FADEIN:
+			if (currentTime - fadeStart >= (uint32)fadeTime) {
+				_particles._state[i] = PartParticleArray::PARTICLE_NORMAL;
+				_particles._currentAlpha[i] = _particles._alpha1[i];
+			} else {
+				_particles._currentAlpha[i] = (int)(((float)currentTime - (float)fadeStart) / (float)fadeTime * _particles._alpha1[i]);
+			}
+			break;
+
+		case PartParticleArray::PARTICLE_FADEOUT:
+			if (currentTime - fadeStart >= (uint32)fadeTime) {
+				_particles._isDead[i] = true;
+			} else {
+				_particles._currentAlpha[i] = _particles._fadeStartAlpha[i] - (int)(((float)currentTime - (float)fadeStart) / (float)fadeTime * _particles._fadeStartAlpha[i]);
+			}
+			break;
+
+		default:
+			// time is up
+			if (_particles._lifeTime[i] > 0) {
+				if (currentTime - _particles._creationTime[i] >= (uint32)_particles._lifeTime[i]) {
+					if (_fadeOutTime > 0) {
+						_particles.fadeOut(i, currentTime, _fadeOutTime);
+					} else {
+						_particles._isDead[i] = true;
+					}
+				}
+			}
+
+			// particle hit the border
+			if (!_particles._isDead[i] && !_particles._border[i].isRectEmpty()) {
+				Point32 p;
+				p.x = (int32)_particles._posX[i];
+				p.y = (int32)_particles._posY[i];
+				if (!BasePlatform::ptInRect(&_particles._border[i], p)) {
+					_particles.fadeOut(i, currentTime, _fadeOutTime);
+				}
+			}
+
+			if (!_particles._isDead[i] && _particles._state[i] == PartParticleArray::PARTICLE_NORMAL) {
+				_activeParticles.push_back(i);
+			}
+			break;
+		}
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////
+void PartEmitter::integrate(uint32 currentTime, uint32 timerDelta) {
+	// Fading particles keep their place, the rest is moved one property at a time
+	const uint32 *active = _activeParticles.begin();
+	const uint32 numActive = _activeParticles.size();
+
+	const uint32 *creationTime = _particles._creationTime.begin();
+	const int32 *lifeTime = _particles._lifeTime.begin();
+	const int32 *alpha1 = _particles._alpha1.begin();
+	const int32 *alpha2 = _particles._alpha2.begin();
+	int32 *currentAlpha = _particles._currentAlpha.begin();
+	float *posX = _particles._posX.begin();
+	float *posY = _particles._posY.begin();
+	float *velocityX = _particles._velocityX.begin();
+	float *velocityY = _particles._velocityY.begin();
+	float *rotation = _particles._rotation.begin();
+	const float *angVelocity = _particles._angVelocity.begin();
+	float *scale = _particles._scale.begin();
+	const float *growthRate = _particles._growthRate.begin();
+	const bool *exponentialGrowth = _particles._exponentialGrowth.begin();
+	bool *isDead = _particles._isDead.begin();
+
+	// update alpha
+	for (uint32 k = 0; k < numActive; k++) {
+		uint32 i = active[k];
+		if (lifeTime[i] > 0) {
+			int age = (int)(currentTime - creationTime[i]);
+			int alphaDelta = (int)(alpha2[i] - alpha1[i]);
+
+			currentAlpha[i] = alpha1[i] + (int)(((float)alphaDelta / (float)lifeTime[i] * (float)age));
+		}
+	}
+
+	// update velocity
+	float elapsedTime = (float)timerDelta / 1000.f;
+
+	for (uint32 f = 0; f < _forces.size(); f++) {
+		const PartForce *force = _forces[f];
+		switch (force->_type) {
+		case PartForce::FORCE_GLOBAL: {
+			Vector2 delta = force->_direction * elapsedTime;
+			for (uint32 k = 0; k < numActive; k++) {
+				uint32 i = active[k];
+				velocityX[i] += delta.x;
+				velocityY[i] += delta.y;
+			}
+		}
+		break;
+
+		case PartForce::FORCE_POINT:
+			for (uint32 k = 0; k < numActive; k++) {
+				uint32 i = active[k];
+				Vector2 vecDist = force->_pos - Vector2(posX[i], posY[i]);
+				float dist = fabs(vecDist.length());
+
+				dist = 100.0f / dist;
+
+				velocityX[i] += force->_direction.x * dist * elapsedTime;
+				velocityY[i] += force->_direction.y * dist * elapsedTime;
+			}
+			break;
+		}
+	}
+
+	// update position
+	for (uint32 k = 0; k < numActive; k++) {
+		uint32 i = active[k];
+		posX[i] += velocityX[i] * elapsedTime;
+		posY[i] += velocityY[i] * elapsedTime;
+	}
+
+	// update rotation
+	for (uint32 k = 0; k < numActive; k++) {
+		uint32 i = active[k];
+		rotation[i] = BaseUtils::normalizeAngle(rotation[i] + angVelocity[i] * elapsedTime);
+	}
+
+	// update scale
+	for (uint32 k = 0; k < numActive; k++) {
+		uint32 i = active[k];
+		if (exponentialGrowth[i]) {
+			scale[i] += scale[i] / 100.0f * growthRate[i] * elapsedTime;
+		} else {
+			scale[i] += growthRate[i] * elapsedTime;
+		}
+
+		if (scale[i] <= 0.0f) {
+			isDead[i] = true;
+		}
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////
+bool PartEmitter::display(BaseRegion *region) {
+	buildDrawOrder();
+
+	// Consecutive particles of the same sprite can be queued as a single ticket
+	BaseEngine::getRenderer()->startSpriteBatch();
+
+	for (uint32 k = 0; k < _drawOrder.size(); k++) {
+		uint32 i = _drawOrder[k];
 		if (region != nullptr && _useRegion) {
-			if (!region->pointInRegion((int)_particles[i]->_pos.x, (int)_particles[i]->_pos.y)) {
+			if (!region->pointInRegion((int)_particles._posX[i], (int)_particles._posY[i])) {
 				continue;
 			}
 		}
 
-		_particles[i]->display(this);
+		displayParticle(i);
 	}
 
-	if (_sprites.size() <= 1) {
-		BaseEngine::getRenderer()->endSpriteBatch();
-	}
+	BaseEngine::getRenderer()->endSpriteBatch();
 
 	return STATUS_OK;
 }
 
+//////////////////////////////////////////////////////////////////////////
+bool PartEmitter::displayParticle(uint32 index) {
+	BaseSprite *sprite = _particles._sprite[index];
+	if (!sprite) {
+		return STATUS_FAILED;
+	}
+
+	sprite->getCurrentFrame();
+	return sprite->display((int)_particles._posX[index], (int)_particles._posY[index],
+	                       nullptr,
+	                       _particles._scale[index], _particles._scale[index],
+	                       BYTETORGBA(255, 255, 255, _particles._currentAlpha[index]),
+	                       _particles._rotation[index],
+	                       _blendMode);
+}
+
+//////////////////////////////////////////////////////////////////////////
+void PartEmitter::buildDrawOrder() {
+	// The live particles are drawn in Z order if the emitter is Z based, and
+	// in the order they are stored otherwise. The renderer batches the runs
+	// of consecutive particles that share a sprite.
+	const uint32 *order = nullptr;
+	if (isZBased()) {
+		if (_zOrder.size() != _particles.size()) {
+			sortParticlesByZ();
+		}
+		order = _zOrder.begin();
+	}
+
+	const bool *isDead = _particles._isDead.begin();
+
+	// resize() keeps the storage from last frame, unlike clear()
+	_drawOrder.resize(_particles.size());
+	uint32 numLive = 0;
+	for (uint32 k = 0; k < _particles.size(); k++) {
+		uint32 i = order ? order[k] : k;
+		if (!isDead[i]) {
+			_drawOrder[numLive++] = i;
+		}
+	}
+	_drawOrder.resize(numLive);
+}
+
 //////////////////////////////////////////////////////////////////////////
 bool PartEmitter::start() {
 	for (uint32 i = 0; i < _particles.size(); i++) {
-		_particles[i]->_isDead = true;
+		_particles._isDead[i] = true;
 	}
 	_running = true;
 	_batchesGenerated = 0;
@@ -366,21 +624,44 @@ bool PartEmitter::start() {
 }
 
 //////////////////////////////////////////////////////////////////////////
-bool PartEmitter::sortParticlesByZ() {
-	// sort particles by _posY
-	Common::sort(_particles.begin(), _particles.end(), PartEmitter::compareZ);
-	return STATUS_OK;
+void PartEmitter::sortParticlesByZ() {
+	_zOrder.resize(_particles.size());
+	for (uint32 i = 0; i < _zOrder.size(); i++) {
+		_zOrder[i] = i;
+	}
+	Common::sort(_zOrder.begin(), _zOrder.end(), ParticleZLess(_particles._posZ.begin()));
 }
 
 //////////////////////////////////////////////////////////////////////////
-bool PartEmitter::compareZ(const PartParticle *p1, const PartParticle *p2) {
-	if (p1->_posZ < p2->_posZ) {
-		return true;
-	} else if (p1->_posZ > p2->_posZ) {
-		return false;
-	} else {
-		return false;
+void PartEmitter::insertParticlesByZ(Common::Array<uint32> &spawned) {
+	// The particles that were already there are still in order, so only the
+	// new ones need sorting before merging both lists
+	const float *posZ = _particles._posZ.begin();
+	Common::sort(spawned.begin(), spawned.end(), ParticleZLess(posZ));
+
+	Common::Array<bool> isSpawned;
+	isSpawned.resize(_particles.size());
+	for (uint32 k = 0; k < spawned.size(); k++) {
+		isSpawned[spawned[k]] = true;
+	}
+
+	_scratch.clear();
+	uint32 next = 0;
+	for (uint32 k = 0; k < _zOrder.size(); k++) {
+		uint32 i = _zOrder[k];
+		if (isSpawned[i]) {
+			continue;
+		}
+		while (next < spawned.size() && posZ[spawned[next]] < posZ[i]) {
+			_scratch.push_back(spawned[next++]);
+		}
+		_scratch.push_back(i);
 	}
+	while (next < spawned.size()) {
+		_scratch.push_back(spawned[next++]);
+	}
+
+	_zOrder = _scratch;
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -522,10 +803,8 @@ bool PartEmitter::scCallMethod(ScScript *script, ScStack *stack, ScStack *thisSt
 	else if (strcmp(name, "Stop") == 0) {
 		stack->correctParams(0);
 
-		for (uint32 i = 0; i < _particles.size(); i++) {
-			delete _particles[i];
-		}
 		_particles.clear();
+		_zOrder.clear();
 
 		_running = false;
 		stack->pushBool(true);
@@ -784,13 +1063,7 @@ ScValue *PartEmitter::scGetProperty(const Common::String &name) {
 	// NumLiveParticles (RO)
 	//////////////////////////////////////////////////////////////////////////
 	else if (name == "NumLiveParticles") {
-		int numAlive = 0;
-		for (uint32 i = 0; i < _particles.size(); i++) {
-			if (_particles[i] && !_particles[i]->_isDead) {
-				numAlive++;
-			}
-		}
-		_scValue->setInt(numAlive);
+		_scValue->setInt(_particles.getNumLive());
 		return _scValue;
 	}
 
@@ -1237,14 +1510,13 @@ bool PartEmitter::persist(BasePersistenceManager *persistMgr) {
 		numParticles = _particles.size();
 		persistMgr->transferUint32(TMEMBER(numParticles));
 		for (uint32 i = 0; i < _particles.size(); i++) {
-			_particles[i]->persist(persistMgr);
+			PartParticle(_gameRef, _particles, i).persist(persistMgr);
 		}
 	} else {
 		persistMgr->transferUint32(TMEMBER(numParticles));
 		for (uint32 i = 0; i < numParticles; i++) {
-			PartParticle *particle = new PartParticle(_gameRef);
-			particle->persist(persistMgr);
-			_particles.add(particle);
+			uint32 index = _particles.add();
+			PartParticle(_gameRef, _particles, index).persist(persistMgr);
 		}
 	}
 
@@ -32,10 +32,11 @@
 
 #include "engines/wintermute/base/base_object.h"
 #include "engines/wintermute/base/particles/part_force.h"
+#include "engines/wintermute/base/particles/part_particle.h"
 
 namespace Wintermute {
 class BaseRegion;
-class PartParticle;
+class BaseSprite;
 class PartEmitter : public BaseObject {
 public:
 	DECLARE_PERSISTENT(PartEmitter, BaseObject)
@@ -48,10 +49,15 @@ public:
 	bool start();
 
 	bool update();
+	/**
+	 * Advance the particles to currentTime, and generate new ones if needed.
+	 * @param currentTime the time to advance to
+	 * @param timerDelta the time passed since the last update
+	 */
+	bool updateInternal(uint32 currentTime, uint32 timerDelta);
 	bool display() { return display(nullptr); } // To avoid shadowing the inherited display-function.
 	bool display(BaseRegion *region);
 
-	bool sortParticlesByZ();
 	bool addSprite(const char *filename);
 	bool removeSprite(const char *filename);
 	bool setBorder(int x, int y, int width, int height);
@@ -127,12 +133,30 @@ private:
 	BaseScriptHolder *_owner;
 
 	PartForce *addForceByName(const Common::String &name);
-	bool static compareZ(const PartParticle *p1, const PartParticle *p2);
-	bool initParticle(PartParticle *particle, uint32 currentTime, uint32 timerDelta);
-	bool updateInternal(uint32 currentTime, uint32 timerDelta);
+	bool initParticle(uint32 index, uint32 currentTime, uint32 timerDelta);
+	bool setParticleSprite(uint32 index, int32 spriteIndex);
+	void clearSpritePool();
+	void updateStates(uint32 currentTime);
+	void integrate(uint32 currentTime, uint32 timerDelta);
+	bool isZBased() const { return _scaleZBased || _velocityZBased || _lifeTimeZBased; }
+	void sortParticlesByZ();
+	void insertParticlesByZ(Common::Array<uint32> &spawned);
+	void buildDrawOrder();
+	bool displayParticle(uint32 index);
 	uint32 _lastGenTime;
-	BaseArray<PartParticle *> _particles;
+	PartParticleArray _particles;
 	BaseArray<char *> _sprites;
+	// Sprites released by re-initialized particles, waiting to be reused
+	BaseArray<BaseSprite *> _spritePool;
+
+	// The live particles that are not fading in or out, set by updateStates()
+	Common::Array<uint32> _activeParticles;
+	// All the particles ordered by _posZ, if the emitter is Z based
+	Common::Array<uint32> _zOrder;
+	// The live particles in the order they are drawn
+	Common::Array<uint32> _drawOrder;
+	// Scratch space for insertParticlesByZ()
+	Common::Array<uint32> _scratch;
 };
 
 } // End of namespace Wintermute
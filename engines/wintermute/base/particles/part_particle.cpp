@@ -27,237 +27,175 @@
  */
 
 #include "engines/wintermute/base/particles/part_particle.h"
-#include "engines/wintermute/base/particles/part_emitter.h"
 #include "engines/wintermute/base/base_sprite.h"
-#include "engines/wintermute/utils/utils.h"
-#include "engines/wintermute/platform_osystem.h"
+#include "engines/wintermute/math/vector2.h"
 #include "common/str.h"
 
 namespace Wintermute {
 
 //////////////////////////////////////////////////////////////////////////
-PartParticle::PartParticle(BaseGame *inGame) : BaseClass(inGame) {
-	_pos = Vector2(0.0f, 0.0f);
-	_posZ = 0.0f;
-	_velocity = Vector2(0.0f, 0.0f);
-	_scale = 100.0f;
-	_sprite = nullptr;
-	_creationTime = 0;
-	_lifeTime = 0;
-	_isDead = true;
-	_border.setEmpty();
-
-	_state = PARTICLE_NORMAL;
-	_fadeStart = 0;
-	_fadeTime = 0;
-	_currentAlpha = 255;
-
-	_alpha1 = _alpha2 = 255;
-
-	_rotation = 0.0f;
-	_angVelocity = 0.0f;
-
-	_growthRate = 0.0f;
-	_exponentialGrowth = false;
+PartParticleArray::PartParticleArray() {
 }
 
 
 //////////////////////////////////////////////////////////////////////////
-PartParticle::~PartParticle(void) {
-	delete _sprite;
-	_sprite = nullptr;
+PartParticleArray::~PartParticleArray() {
+	clear();
 }
 
 //////////////////////////////////////////////////////////////////////////
-bool PartParticle::setSprite(const Common::String &filename) {
-	if (_sprite && _sprite->getFilename() && scumm_stricmp(filename.c_str(), _sprite->getFilename()) == 0) {
-		_sprite->reset();
-		return STATUS_OK;
-	}
-
-	delete _sprite;
-	_sprite = nullptr;
+uint32 PartParticleArray::add() {
+	Rect32 border;
+	border.setEmpty();
+
+	_growthRate.push_back(0.0f);
+	_exponentialGrowth.push_back(false);
+	_rotation.push_back(0.0f);
+	_angVelocity.push_back(0.0f);
+	_alpha1.push_back(255);
+	_alpha2.push_back(255);
+	_border.push_back(border);
+	_posX.push_back(0.0f);
+	_posY.push_back(0.0f);
+	_posZ.push_back(0.0f);
+	_velocityX.push_back(0.0f);
+	_velocityY.push_back(0.0f);
+	_scale.push_back(100.0f);
+	_sprite.push_back(nullptr);
+	_creationTime.push_back(0);
+	_lifeTime.push_back(0);
+	_isDead.push_back(true);
+	_state.push_back(PARTICLE_NORMAL);
+	_fadeStart.push_back(0);
+	_fadeTime.push_back(0);
+	_currentAlpha.push_back(255);
+	_fadeStartAlpha.push_back(0);
+
+	return _isDead.size() - 1;
+}
 
-	SystemClassRegistry::getInstance()->_disabled = true;
-	_sprite = new BaseSprite(_gameRef, (BaseObject*)_gameRef);
-	if (_sprite && DID_SUCCEED(_sprite->loadFile(filename))) {
-		SystemClassRegistry::getInstance()->_disabled = false;
-		return STATUS_OK;
-	} else {
-		delete _sprite;
-		_sprite = nullptr;
-		SystemClassRegistry::getInstance()->_disabled = false;
-		return STATUS_FAILED;
+//////////////////////////////////////////////////////////////////////////
+void PartParticleArray::clear() {
+	for (uint32 i = 0; i < _sprite.size(); i++) {
+		delete _sprite[i];
 	}
 
+	_growthRate.clear();
+	_exponentialGrowth.clear();
+	_rotation.clear();
+	_angVelocity.clear();
+	_alpha1.clear();
+	_alpha2.clear();
+	_border.clear();
+	_posX.clear();
+	_posY.clear();
+	_posZ.clear();
+	_velocityX.clear();
+	_velocityY.clear();
+	_scale.clear();
+	_sprite.clear();
+	_creationTime.clear();
+	_lifeTime.clear();
+	_isDead.clear();
+	_state.clear();
+	_fadeStart.clear();
+	_fadeTime.clear();
+	_currentAlpha.clear();
+	_fadeStartAlpha.clear();
 }
 
 //////////////////////////////////////////////////////////////////////////
-bool PartParticle::update(PartEmitter *emitter, uint32 currentTime, uint32 timerDelta) {
-	if (_state == PARTICLE_FADEIN) {
-		if (currentTime - _fadeStart >= (uint32)_fadeTime) {
-			_state = PARTICLE_NORMAL;
-			_currentAlpha = _alpha1;
-		} else {
-			_currentAlpha = (int)(((float)currentTime - (float)_fadeStart) / (float)_fadeTime * _alpha1);
+int PartParticleArray::getNumLive() const {
+	int numLive = 0;
+	for (uint32 i = 0; i < _isDead.size(); i++) {
+		if (!_isDead[i]) {
+			numLive++;
 		}
-
-		return STATUS_OK;
-	} else if (_state == PARTICLE_FADEOUT) {
-		if (currentTime - _fadeStart >= (uint32)_fadeTime) {
-			_isDead = true;
-			return STATUS_OK;
-		} else {
-			_currentAlpha = _fadeStartAlpha - (int)(((float)currentTime - (float)_fadeStart) / (float)_fadeTime * _fadeStartAlpha);
-		}
-
-		return STATUS_OK;
-	} else {
-		// time is up
-		if (_lifeTime > 0) {
-			if (currentTime - _creationTime >= (uint32)_lifeTime) {
-				if (emitter->_fadeOutTime > 0) {
-					fadeOut(currentTime, emitter->_fadeOutTime);
-				} else {
-					_isDead = true;
-				}
-			}
-		}
-
-		// particle hit the border
-		if (!_isDead && !_border.isRectEmpty()) {
-			Point32 p;
-			p.x = (int32)_pos.x;
-			p.y = (int32)_pos.y;
-			if (!BasePlatform::ptInRect(&_border, p)) {
-				fadeOut(currentTime, emitter->_fadeOutTime);
-			}
-		}
-		if (_state != PARTICLE_NORMAL) {
-			return STATUS_OK;
-		}
-
-		// update alpha
-		if (_lifeTime > 0) {
-			int age = (int)(currentTime - _creationTime);
-			int alphaDelta = (int)(_alpha2 - _alpha1);
-
-			_currentAlpha = _alpha1 + (int)(((float)alphaDelta / (float)_lifeTime * (float)age));
-		}
-
-		// update position
-		float elapsedTime = (float)timerDelta / 1000.f;
-
-		for (uint32 i = 0; i < emitter->_forces.size(); i++) {
-			PartForce *force = emitter->_forces[i];
-			switch (force->_type) {
-			case PartForce::FORCE_GLOBAL:
-				_velocity += force->_direction * elapsedTime;
-				break;
-
-			case PartForce::FORCE_POINT: {
-				Vector2 vecDist = force->_pos - _pos;
-				float dist = fabs(vecDist.length());
-
-				dist = 100.0f / dist;
-
-				_velocity += force->_direction * dist * elapsedTime;
-			}
-			break;
-			}
-		}
-		_pos += _velocity * elapsedTime;
-
-		// update rotation
-		_rotation += _angVelocity * elapsedTime;
-		_rotation = BaseUtils::normalizeAngle(_rotation);
-
-		// update scale
-		if (_exponentialGrowth) {
-			_scale += _scale / 100.0f * _growthRate * elapsedTime;
-		} else {
-			_scale += _growthRate * elapsedTime;
-		}
-
-		if (_scale <= 0.0f) {
-			_isDead = true;
-		}
-
-
-		return STATUS_OK;
 	}
+	return numLive;
 }
 
 //////////////////////////////////////////////////////////////////////////
-bool PartParticle::display(PartEmitter *emitter) {
-	if (!_sprite) {
-		return STATUS_FAILED;
+bool PartParticleArray::setSprite(BaseGame *inGame, uint32 index, const Common::String &filename) {
+	BaseSprite *&sprite = _sprite[index];
+	if (sprite && sprite->getFilename() && scumm_stricmp(filename.c_str(), sprite->getFilename()) == 0) {
+		sprite->reset();
+		return STATUS_OK;
 	}
-	if (_isDead) {
+
+	delete sprite;
+	sprite = nullptr;
+
+	SystemClassRegistry::getInstance()->_disabled = true;
+	sprite = new BaseSprite(inGame, (BaseObject*)inGame);
+	if (sprite && DID_SUCCEED(sprite->loadFile(filename))) {
+		SystemClassRegistry::getInstance()->_disabled = false;
 		return STATUS_OK;
+	} else {
+		delete sprite;
+		sprite = nullptr;
+		SystemClassRegistry::getInstance()->_disabled = false;
+		return STATUS_FAILED;
 	}
 
-	_sprite->getCurrentFrame();
-	return _sprite->display((int)_pos.x, (int)_pos.y,
-	                        nullptr,
-	                        _scale, _scale,
-	                        BYTETORGBA(255, 255, 255, _currentAlpha),
-	                        _rotation,
-	                        emitter->_blendMode);
 }
 
-
 //////////////////////////////////////////////////////////////////////////
-bool PartParticle::fadeIn(uint32 currentTime, int fadeTime) {
-	_currentAlpha = 0;
-	_fadeStart = currentTime;
-	_fadeTime = fadeTime;
-	_state = PARTICLE_FADEIN;
-
-	return STATUS_OK;
+void PartParticleArray::fadeIn(uint32 index, uint32 currentTime, int fadeTime) {
+	_currentAlpha[index] = 0;
+	_fadeStart[index] = currentTime;
+	_fadeTime[index] = fadeTime;
+	_state[index] = PARTICLE_FADEIN;
 }
 
 //////////////////////////////////////////////////////////////////////////
-bool PartParticle::fadeOut(uint32 currentTime, int fadeTime) {
-	//_currentAlpha = 255;
-	_fadeStartAlpha = _currentAlpha;
-	_fadeStart = currentTime;
-	_fadeTime = fadeTime;
-	_state = PARTICLE_FADEOUT;
-
-	return STATUS_OK;
+void PartParticleArray::fadeOut(uint32 index, uint32 currentTime, int fadeTime) {
+	_fadeStartAlpha[index] = _currentAlpha[index];
+	_fadeStart[index] = currentTime;
+	_fadeTime[index] = fadeTime;
+	_state[index] = PARTICLE_FADEOUT;
 }
 
 //////////////////////////////////////////////////////////////////////////
 bool PartParticle::persist(BasePersistenceManager *persistMgr) {
-	persistMgr->transferSint32(TMEMBER(_alpha1));
-	persistMgr->transferSint32(TMEMBER(_alpha2));
-	persistMgr->transferRect32(TMEMBER(_border));
-	persistMgr->transferVector2(TMEMBER(_pos));
-	persistMgr->transferFloat(TMEMBER(_posZ));
-	persistMgr->transferVector2(TMEMBER(_velocity));
-	persistMgr->transferFloat(TMEMBER(_scale));
-	persistMgr->transferUint32(TMEMBER(_creationTime));
-	persistMgr->transferSint32(TMEMBER(_lifeTime));
-	persistMgr->transferBool(TMEMBER(_isDead));
-	persistMgr->transferSint32(TMEMBER_INT(_state));
-	persistMgr->transferUint32(TMEMBER(_fadeStart));
-	persistMgr->transferSint32(TMEMBER(_fadeTime));
-	persistMgr->transferSint32(TMEMBER(_currentAlpha));
-	persistMgr->transferFloat(TMEMBER(_angVelocity));
-	persistMgr->transferFloat(TMEMBER(_rotation));
-	persistMgr->transferFloat(TMEMBER(_growthRate));
-	persistMgr->transferBool(TMEMBER(_exponentialGrowth));
-	persistMgr->transferSint32(TMEMBER(_fadeStartAlpha));
+	// Same layout as when every particle was an object of its own
+	Vector2 pos(_particles._posX[_index], _particles._posY[_index]);
+	Vector2 velocity(_particles._velocityX[_index], _particles._velocityY[_index]);
+
+	persistMgr->transferSint32(TMEMBER(_particles._alpha1[_index]));
+	persistMgr->transferSint32(TMEMBER(_particles._alpha2[_index]));
+	persistMgr->transferRect32(TMEMBER(_particles._border[_index]));
+	persistMgr->transferVector2(TMEMBER(pos));
+	persistMgr->transferFloat(TMEMBER(_particles._posZ[_index]));
+	persistMgr->transferVector2(TMEMBER(velocity));
+	persistMgr->transferFloat(TMEMBER(_particles._scale[_index]));
+	persistMgr->transferUint32(TMEMBER(_particles._creationTime[_index]));
+	persistMgr->transferSint32(TMEMBER(_particles._lifeTime[_index]));
+	persistMgr->transferBool(TMEMBER(_particles._isDead[_index]));
+	persistMgr->transferSint32(TMEMBER_INT(_particles._state[_index]));
+	persistMgr->transferUint32(TMEMBER(_particles._fadeStart[_index]));
+	persistMgr->transferSint32(TMEMBER(_particles._fadeTime[_index]));
+	persistMgr->transferSint32(TMEMBER(_particles._currentAlpha[_index]));
+	persistMgr->transferFloat(TMEMBER(_particles._angVelocity[_index]));
+	persistMgr->transferFloat(TMEMBER(_particles._rotation[_index]));
+	persistMgr->transferFloat(TMEMBER(_particles._growthRate[_index]));
+	persistMgr->transferBool(TMEMBER(_particles._exponentialGrowth[_index]));
+	persistMgr->transferSint32(TMEMBER(_particles._fadeStartAlpha[_index]));
 
 	if (persistMgr->getIsSaving()) {
-		const char *filename = _sprite->getFilename();
+		BaseSprite *sprite = _particles._sprite[_index];
+		const char *filename = (sprite && sprite->getFilename()) ? sprite->getFilename() : "";
 		persistMgr->transferConstChar(TMEMBER(filename));
 	} else {
+		_particles._posX[_index] = pos.x;
+		_particles._posY[_index] = pos.y;
+		_particles._velocityX[_index] = velocity.x;
+		_particles._velocityY[_index] = velocity.y;
+
 		char *filename;
 		persistMgr->transferCharPtr(TMEMBER(filename));
 		SystemClassRegistry::getInstance()->_disabled = true;
-		setSprite(filename);
+		_particles.setSprite(_gameRef, _index, filename);
 		SystemClassRegistry::getInstance()->_disabled = false;
 		delete[] filename;
 		filename = nullptr;
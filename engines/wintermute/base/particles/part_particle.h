@@ -32,57 +32,86 @@
 
 #include "engines/wintermute/base/base.h"
 #include "engines/wintermute/math/rect32.h"
-#include "engines/wintermute/math/vector2.h"
+#include "common/array.h"
 
 namespace Wintermute {
 
-class PartEmitter;
 class BaseSprite;
 class BasePersistenceManager;
 
-class PartParticle : public BaseClass {
+/**
+ * The particles of an emitter.
+ *
+ * Every property of the particles is kept in an array of its own, indexed
+ * by particle, so the emitter can update one property of all its particles
+ * in a single loop. Use PartParticle to get at a single particle.
+ */
+class PartParticleArray {
 public:
 	enum TParticleState {
 	    PARTICLE_NORMAL, PARTICLE_FADEIN, PARTICLE_FADEOUT
 	};
 
-	PartParticle(BaseGame *inGame);
-	virtual ~PartParticle(void);
+	PartParticleArray();
+	~PartParticleArray();
+
+	uint32 size() const { return _isDead.size(); }
+
+	/**
+	 * Add a dead particle.
+	 * @return the index of the new particle
+	 */
+	uint32 add();
+	void clear();
+
+	int getNumLive() const;
 
-	float _growthRate;
-	bool _exponentialGrowth;
+	bool setSprite(BaseGame *inGame, uint32 index, const Common::String &filename);
 
-	float _rotation;
-	float _angVelocity;
+	void fadeIn(uint32 index, uint32 currentTime, int fadeTime);
+	void fadeOut(uint32 index, uint32 currentTime, int fadeTime);
 
-	int32 _alpha1;
-	int32 _alpha2;
+	Common::Array<float> _growthRate;
+	Common::Array<bool> _exponentialGrowth;
 
-	Rect32 _border;
-	Vector2 _pos;
-	float _posZ;
-	Vector2 _velocity;
-	float _scale;
-	BaseSprite *_sprite;
-	uint32 _creationTime;
-	int32 _lifeTime;
-	bool _isDead;
-	TParticleState _state;
+	Common::Array<float> _rotation;
+	Common::Array<float> _angVelocity;
 
-	bool update(PartEmitter *emitter, uint32 currentTime, uint32 timerDelta);
-	bool display(PartEmitter *emitter);
+	Common::Array<int32> _alpha1;
+	Common::Array<int32> _alpha2;
 
-	bool setSprite(const Common::String &filename);
+	Common::Array<Rect32> _border;
+	Common::Array<float> _posX;
+	Common::Array<float> _posY;
+	Common::Array<float> _posZ;
+	Common::Array<float> _velocityX;
+	Common::Array<float> _velocityY;
+	Common::Array<float> _scale;
+	Common::Array<BaseSprite *> _sprite;
+	Common::Array<uint32> _creationTime;
+	Common::Array<int32> _lifeTime;
+	Common::Array<bool> _isDead;
+	Common::Array<TParticleState> _state;
 
-	bool fadeIn(uint32 currentTime, int fadeTime);
-	bool fadeOut(uint32 currentTime, int fadeTime);
+	Common::Array<uint32> _fadeStart;
+	Common::Array<int32> _fadeTime;
+	Common::Array<int32> _currentAlpha;
+	Common::Array<int32> _fadeStartAlpha;
+};
+
+/**
+ * A single particle of a PartParticleArray, used where the particles are
+ * handled one by one, like saving and loading them.
+ */
+class PartParticle {
+public:
+	PartParticle(BaseGame *inGame, PartParticleArray &particles, uint32 index) : _gameRef(inGame), _particles(particles), _index(index) {}
 
-	bool persist(BasePersistenceManager *PersistMgr);
+	bool persist(BasePersistenceManager *persistMgr);
 private:
-	uint32 _fadeStart;
-	int32 _fadeTime;
-	int32 _currentAlpha;
-	int32 _fadeStartAlpha;
+	BaseGame *_gameRef;
+	PartParticleArray &_particles;
+	uint32 _index;
 };
 
 } // End of namespace Wintermute
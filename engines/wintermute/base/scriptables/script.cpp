@@ -46,6 +46,8 @@ ScScript::ScScript(BaseGame *inGame, ScEngine *engine) : BaseClass(inGame) {
 	_currentLine = 0;
 
 	_symbols = nullptr;
+	_symbolNames = nullptr;
+	_engineGlobalSlots = nullptr;
 	_numSymbols = 0;
 
 	_engine = engine;
@@ -101,27 +103,12 @@ ScScript::~ScScript() {
 	cleanup();
 }
 
-void ScScript::readHeader() {
-	uint32 oldPos = _scriptStream->pos();
-	_scriptStream->seek(0);
-	_header.magic = _scriptStream->readUint32LE();
-	_header.version = _scriptStream->readUint32LE();
-	_header.codeStart = _scriptStream->readUint32LE();
-	_header.funcTable = _scriptStream->readUint32LE();
-	_header.symbolTable = _scriptStream->readUint32LE();
-	_header.eventTable = _scriptStream->readUint32LE();
-	_header.externalsTable = _scriptStream->readUint32LE();
-	_header.methodTable = _scriptStream->readUint32LE();
-	_scriptStream->seek(oldPos);
-}
-
-
 //////////////////////////////////////////////////////////////////////////
 bool ScScript::initScript() {
 	if (!_scriptStream) {
 		_scriptStream = new Common::MemoryReadStream(_buffer, _bufferSize);
 	}
-	readHeader();
+	_header = _image->_header;
 
 	if (_header.magic != SCRIPT_MAGIC) {
 		_gameRef->LOG(0, "File '%s' is not a valid compiled script", _filename);
@@ -161,81 +148,45 @@ bool ScScript::initScript() {
 
 //////////////////////////////////////////////////////////////////////////
 bool ScScript::initTables() {
-	uint32 origIP = _iP;
-
-	readHeader();
-	// load symbol table
-	_iP = _header.symbolTable;
-
-	_numSymbols = getDWORD();
-	_symbols = new char*[_numSymbols];
-	for (uint32 i = 0; i < _numSymbols; i++) {
-		uint32 index = getDWORD();
-		_symbols[index] = getString();
-	}
-
-	// load functions table
-	_iP = _header.funcTable;
+	// the tables are parsed once per file, see ScScriptImage
+	_header = _image->_header;
 
-	_numFunctions = getDWORD();
-	_functions = new TFunctionPos[_numFunctions];
-	for (uint32 i = 0; i < _numFunctions; i++) {
-		_functions[i].pos = getDWORD();
-		_functions[i].name = getString();
-	}
+	_symbols = _image->_symbols;
+	_symbolNames = _image->_symbolNames;
+	_numSymbols = _image->_numSymbols;
 
+	_functions = _image->_functions;
+	_numFunctions = _image->_numFunctions;
 
-	// load events table
-	_iP = _header.eventTable;
-
-	_numEvents = getDWORD();
-	_events = new TEventPos[_numEvents];
-	for (uint32 i = 0; i < _numEvents; i++) {
-		_events[i].pos = getDWORD();
-		_events[i].name = getString();
-	}
+	_events = _image->_events;
+	_numEvents = _image->_numEvents;
 
+	_externals = _image->_externals;
+	_numExternals = _image->_numExternals;
 
-	// load externals
-	if (_header.version >= 0x0101) {
-		_iP = _header.externalsTable;
+	_methods = _image->_methods;
+	_numMethods = _image->_numMethods;
 
-		_numExternals = getDWORD();
-		_externals = new TExternalFunction[_numExternals];
-		for (uint32 i = 0; i < _numExternals; i++) {
-			_externals[i].dll_name = getString();
-			_externals[i].name = getString();
-			_externals[i].call_type = (TCallType)getDWORD();
-			_externals[i].returns = (TExternalType)getDWORD();
-			_externals[i].nu_params = getDWORD();
-			if (_externals[i].nu_params > 0) {
-				_externals[i].params = new TExternalType[_externals[i].nu_params];
-				for (int j = 0; j < _externals[i].nu_params; j++) {
-					_externals[i].params[j] = (TExternalType)getDWORD();
-				}
-			}
-		}
-	}
-
-	// load method table
-	_iP = _header.methodTable;
-
-	_numMethods = getDWORD();
-	_methods = new TMethodPos[_numMethods];
-	for (uint32 i = 0; i < _numMethods; i++) {
-		_methods[i].pos = getDWORD();
-		_methods[i].name = getString();
+	// engine globals are resolved on first use, see getVar()
+	_engineGlobalSlots = new ScValue *[_numSymbols];
+	for (uint32 i = 0; i < _numSymbols; i++) {
+		_engineGlobalSlots[i] = nullptr;
 	}
 
+	return STATUS_OK;
+}
 
-	_iP = origIP;
 
-	return STATUS_OK;
+//////////////////////////////////////////////////////////////////////////
+void ScScript::attachImage(const Common::SharedPtr<ScScriptImage> &image) {
+	_image = image;
+	_buffer = image->_buffer;
+	_bufferSize = image->_size;
 }
 
 
 //////////////////////////////////////////////////////////////////////////
-bool ScScript::create(const char *filename, byte *buffer, uint32 size, BaseScriptHolder *owner) {
+bool ScScript::create(const char *filename, const Common::SharedPtr<ScScriptImage> &image, BaseScriptHolder *owner) {
 	cleanup();
 
 	_thread = false;
@@ -249,14 +200,7 @@ bool ScScript::create(const char *filename, byte *buffer, uint32 size, BaseScrip
 		strcpy(_filename, filename);
 	}
 
-	_buffer = new byte [size];
-	if (!_buffer) {
-		return STATUS_FAILED;
-	}
-
-	memcpy(_buffer, buffer, size);
-
-	_bufferSize = size;
+	attachImage(image);
 
 	bool res = initScript();
 	if (DID_FAIL(res)) {
@@ -289,14 +233,8 @@ bool ScScript::createThread(ScScript *original, uint32 initIP, const Common::Str
 		strcpy(_filename, original->_filename);
 	}
 
-	// copy buffer
-	_buffer = new byte [original->_bufferSize];
-	if (!_buffer) {
-		return STATUS_FAILED;
-	}
-
-	memcpy(_buffer, original->_buffer, original->_bufferSize);
-	_bufferSize = original->_bufferSize;
+	// share the compiled script
+	attachImage(original->_image);
 
 	// initialize
 	bool res = initScript();
@@ -346,14 +284,8 @@ bool ScScript::createMethodThread(ScScript *original, const Common::String &meth
 		strcpy(_filename, original->_filename);
 	}
 
-	// copy buffer
-	_buffer = new byte [original->_bufferSize];
-	if (!_buffer) {
-		return STATUS_FAILED;
-	}
-
-	memcpy(_buffer, original->_buffer, original->_bufferSize);
-	_bufferSize = original->_bufferSize;
+	// share the compiled script
+	attachImage(original->_image);
 
 	// initialize
 	bool res = initScript();
@@ -380,20 +312,19 @@ bool ScScript::createMethodThread(ScScript *original, const Common::String &meth
 
 //////////////////////////////////////////////////////////////////////////
 void ScScript::cleanup() {
-	if (_buffer) {
-		delete[] _buffer;
-	}
 	_buffer = nullptr;
+	_bufferSize = 0;
 
 	if (_filename) {
 		delete[] _filename;
 	}
 	_filename = nullptr;
 
-	if (_symbols) {
-		delete[] _symbols;
-	}
 	_symbols = nullptr;
+	_symbolNames = nullptr;
+
+	delete[] _engineGlobalSlots;
+	_engineGlobalSlots = nullptr;
 	_numSymbols = 0;
 
 	if (_globals && !_thread) {
@@ -413,36 +344,20 @@ void ScScript::cleanup() {
 	delete _stack;
 	_stack = nullptr;
 
-	if (_functions) {
-		delete[] _functions;
-	}
 	_functions = nullptr;
 	_numFunctions = 0;
 
-	if (_methods) {
-		delete[] _methods;
-	}
 	_methods = nullptr;
 	_numMethods = 0;
 
-	if (_events) {
-		delete[] _events;
-	}
 	_events = nullptr;
 	_numEvents = 0;
 
-
-	if (_externals) {
-		for (uint32 i = 0; i < _numExternals; i++) {
-			if (_externals[i].nu_params > 0) {
-				delete[] _externals[i].params;
-			}
-		}
-		delete[] _externals;
-	}
 	_externals = nullptr;
 	_numExternals = 0;
 
+	_image.reset();
+
 	delete _operand;
 	delete _reg1;
 	_operand = nullptr;
@@ -692,7 +607,7 @@ bool ScScript::executeInstruction() {
 		break;
 
 	case II_PUSH_VAR: {
-		ScValue *var = getVar(_symbols[getDWORD()]);
+		ScValue *var = getVar(getDWORD());
 		if (false && /*var->_type==VAL_OBJECT ||*/ var->_type == VAL_NATIVE) {
 			_operand->setReference(var);
 			_stack->push(_operand);
@@ -703,15 +618,14 @@ bool ScScript::executeInstruction() {
 	}
 
 	case II_PUSH_VAR_REF: {
-		ScValue *var = getVar(_symbols[getDWORD()]);
+		ScValue *var = getVar(getDWORD());
 		_operand->setReference(var);
 		_stack->push(_operand);
 		break;
 	}
 
 	case II_POP_VAR: {
-		char *varName = _symbols[getDWORD()];
-		ScValue *var = getVar(varName);
+		ScValue *var = getVar(getDWORD());
 		if (var) {
 			ScValue *val = _stack->pop();
 			if (!val) {
@@ -764,7 +678,7 @@ bool ScScript::executeInstruction() {
 		break;
 
 	case II_PUSH_THIS:
-		_operand->setReference(getVar(_symbols[getDWORD()]));
+		_operand->setReference(getVar(getDWORD()));
 		_thisStack->push(_operand);
 		break;
 
@@ -1121,41 +1035,42 @@ uint32 ScScript::getMethodPos(const Common::String &name) const {
 
 
 //////////////////////////////////////////////////////////////////////////
-ScValue *ScScript::getVar(char *name) {
+ScValue *ScScript::getVar(uint32 symbol) {
+	const Common::String &name = _symbolNames[symbol];
 	ScValue *ret = nullptr;
 
 	// scope locals
 	if (_scopeStack->_sP >= 0) {
-		if (_scopeStack->getTop()->propExists(name)) {
-			ret = _scopeStack->getTop()->getProp(name);
-		}
+		ret = _scopeStack->getTop()->findProp(name);
 	}
 
 	// script globals
 	if (ret == nullptr) {
-		if (_globals->propExists(name)) {
-			ret = _globals->getProp(name);
-		}
+		ret = _globals->findProp(name);
 	}
 
 	// engine globals
 	if (ret == nullptr) {
-		if (_engine->_globals->propExists(name)) {
-			ret = _engine->_globals->getProp(name);
+		// Engine globals are never removed while scripts are running,
+		// so once resolved, a symbol keeps pointing to the same value
+		ret = _engineGlobalSlots[symbol];
+		if (ret == nullptr) {
+			ret = _engine->_globals->findProp(name);
+			_engineGlobalSlots[symbol] = ret;
 		}
 	}
 
 	if (ret == nullptr) {
 		//RuntimeError("Variable '%s' is inaccessible in the current block. Consider changing the script.", name);
-		_gameRef->LOG(0, "Warning: variable '%s' is inaccessible in the current block. Consider changing the script (script:%s, line:%d)", name, _filename, _currentLine);
+		_gameRef->LOG(0, "Warning: variable '%s' is inaccessible in the current block. Consider changing the script (script:%s, line:%d)", name.c_str(), _filename, _currentLine);
 		ScValue *val = new ScValue(_gameRef);
 		ScValue *scope = _scopeStack->getTop();
 		if (scope) {
-			scope->setProp(name, val);
-			ret = _scopeStack->getTop()->getProp(name);
+			scope->setProp(name.c_str(), val);
+			ret = _scopeStack->getTop()->getProp(name.c_str());
 		} else {
-			_globals->setProp(name, val);
-			ret = _globals->getProp(name);
+			_globals->setProp(name.c_str(), val);
+			ret = _globals->getProp(name.c_str());
 		}
 		delete val;
 	}
@@ -1260,8 +1175,9 @@ bool ScScript::persist(BasePersistenceManager *persistMgr) {
 	} else {
 		persistMgr->transferUint32(TMEMBER(_bufferSize));
 		if (_bufferSize > 0) {
-			_buffer = new byte[_bufferSize];
-			persistMgr->getBytes(_buffer, _bufferSize);
+			byte *buffer = new byte[_bufferSize];
+			persistMgr->getBytes(buffer, _bufferSize);
+			attachImage(Common::SharedPtr<ScScriptImage>(new ScScriptImage(buffer, _bufferSize)));
 			_scriptStream = new Common::MemoryReadStream(_buffer, _bufferSize);
 			initTables();
 		} else {
@@ -1449,15 +1365,14 @@ const char *ScScript::dbgGetFilename() {
 //////////////////////////////////////////////////////////////////////////
 void ScScript::afterLoad() {
 	if (_buffer == nullptr) {
-		byte *buffer = _engine->getCompiledScript(_filename, &_bufferSize);
-		if (!buffer) {
+		Common::SharedPtr<ScScriptImage> image = _engine->getScriptImage(_filename);
+		if (!image) {
 			_gameRef->LOG(0, "Error reinitializing script '%s' after load. Script will be terminated.", _filename);
 			_state = SCRIPT_ERROR;
 			return;
 		}
 
-		_buffer = new byte [_bufferSize];
-		memcpy(_buffer, buffer, _bufferSize);
+		attachImage(image);
 
 		delete _scriptStream;
 		_scriptStream = new Common::MemoryReadStream(_buffer, _bufferSize);
@@ -1466,4 +1381,164 @@ void ScScript::afterLoad() {
 	}
 }
 
+
+//////////////////////////////////////////////////////////////////////////
+ScScriptImage::ScScriptImage(byte *buffer, uint32 size) {
+	_buffer = buffer;
+	_size = size;
+
+	_symbols = nullptr;
+	_symbolNames = nullptr;
+	_numSymbols = 0;
+
+	_functions = nullptr;
+	_numFunctions = 0;
+
+	_methods = nullptr;
+	_numMethods = 0;
+
+	_events = nullptr;
+	_numEvents = 0;
+
+	_externals = nullptr;
+	_numExternals = 0;
+
+	memset(&_header, 0, sizeof(_header));
+	if (_size >= sizeof(_header)) {
+		_header.magic = READ_LE_UINT32(_buffer);
+		_header.version = READ_LE_UINT32(_buffer + 4);
+		_header.codeStart = READ_LE_UINT32(_buffer + 8);
+		_header.funcTable = READ_LE_UINT32(_buffer + 12);
+		_header.symbolTable = READ_LE_UINT32(_buffer + 16);
+		_header.eventTable = READ_LE_UINT32(_buffer + 20);
+		_header.externalsTable = READ_LE_UINT32(_buffer + 24);
+		_header.methodTable = READ_LE_UINT32(_buffer + 28);
+	}
+
+	if (isValid()) {
+		readTables();
+	}
+
+	_memorySize = _size;
+	_memorySize += _numSymbols * (sizeof(char *) + sizeof(Common::String));
+	_memorySize += _numFunctions * sizeof(ScScript::TFunctionPos);
+	_memorySize += _numMethods * sizeof(ScScript::TMethodPos);
+	_memorySize += _numEvents * sizeof(ScScript::TEventPos);
+	_memorySize += _numExternals * sizeof(ScScript::TExternalFunction);
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+ScScriptImage::~ScScriptImage() {
+	delete[] _symbols;
+	delete[] _symbolNames;
+	delete[] _functions;
+	delete[] _methods;
+	delete[] _events;
+
+	if (_externals) {
+		for (uint32 i = 0; i < _numExternals; i++) {
+			if (_externals[i].nu_params > 0) {
+				delete[] _externals[i].params;
+			}
+		}
+		delete[] _externals;
+	}
+
+	delete[] _buffer;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+bool ScScriptImage::isValid() const {
+	return _header.magic == SCRIPT_MAGIC && _header.version <= SCRIPT_VERSION;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+uint32 ScScriptImage::getDWORD(uint32 &pos) const {
+	uint32 ret = READ_LE_UINT32(_buffer + pos);
+	pos += sizeof(uint32);
+	return ret;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+char *ScScriptImage::getString(uint32 &pos) const {
+	char *ret = (char *)(_buffer + pos);
+	while (_buffer[pos] != '\0') {
+		pos++;
+	}
+	pos++; // string terminator
+
+	return ret;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+void ScScriptImage::readTables() {
+	// load symbol table
+	uint32 pos = _header.symbolTable;
+
+	_numSymbols = getDWORD(pos);
+	_symbols = new char*[_numSymbols];
+	_symbolNames = new Common::String[_numSymbols];
+	for (uint32 i = 0; i < _numSymbols; i++) {
+		uint32 index = getDWORD(pos);
+		_symbols[index] = getString(pos);
+		_symbolNames[index] = _symbols[index];
+	}
+
+	// load functions table
+	pos = _header.funcTable;
+
+	_numFunctions = getDWORD(pos);
+	_functions = new ScScript::TFunctionPos[_numFunctions];
+	for (uint32 i = 0; i < _numFunctions; i++) {
+		_functions[i].pos = getDWORD(pos);
+		_functions[i].name = getString(pos);
+	}
+
+	// load events table
+	pos = _header.eventTable;
+
+	_numEvents = getDWORD(pos);
+	_events = new ScScript::TEventPos[_numEvents];
+	for (uint32 i = 0; i < _numEvents; i++) {
+		_events[i].pos = getDWORD(pos);
+		_events[i].name = getString(pos);
+	}
+
+	// load externals
+	if (_header.version >= 0x0101) {
+		pos = _header.externalsTable;
+
+		_numExternals = getDWORD(pos);
+		_externals = new ScScript::TExternalFunction[_numExternals];
+		for (uint32 i = 0; i < _numExternals; i++) {
+			_externals[i].dll_name = getString(pos);
+			_externals[i].name = getString(pos);
+			_externals[i].call_type = (TCallType)getDWORD(pos);
+			_externals[i].returns = (TExternalType)getDWORD(pos);
+			_externals[i].nu_params = getDWORD(pos);
+			if (_externals[i].nu_params > 0) {
+				_externals[i].params = new TExternalType[_externals[i].nu_params];
+				for (int j = 0; j < _externals[i].nu_params; j++) {
+					_externals[i].params[j] = (TExternalType)getDWORD(pos);
+				}
+			}
+		}
+	}
+
+	// load method table
+	pos = _header.methodTable;
+
+	_numMethods = getDWORD(pos);
+	_methods = new ScScript::TMethodPos[_numMethods];
+	for (uint32 i = 0; i < _numMethods; i++) {
+		_methods[i].pos = getDWORD(pos);
+		_methods[i].name = getString(pos);
+	}
+}
+
 } // End of namespace Wintermute
@@ -33,12 +33,14 @@
 #include "engines/wintermute/base/base.h"
 #include "engines/wintermute/base/scriptables/dcscript.h"   // Added by ClassView
 #include "engines/wintermute/coll_templ.h"
+#include "common/ptr.h"
 
 namespace Wintermute {
 class BaseScriptHolder;
 class BaseObject;
 class ScEngine;
 class ScStack;
+class ScScriptImage;
 class ScScript : public BaseClass {
 public:
 	BaseArray<int> _breakpoints;
@@ -76,7 +78,7 @@ public:
 	ScScript *_waitScript;
 	TScriptState _state;
 	TScriptState _origState;
-	ScValue *getVar(char *name);
+	ScValue *getVar(uint32 symbol);
 	uint32 getFuncPos(const Common::String &name);
 	uint32 getEventPos(const Common::String &name) const;
 	uint32 getMethodPos(const Common::String &name) const;
@@ -130,10 +132,11 @@ public:
 	uint32 getDWORD();
 	double getFloat();
 	void cleanup();
-	bool create(const char *filename, byte *buffer, uint32 size, BaseScriptHolder *owner);
+	bool create(const char *filename, const Common::SharedPtr<ScScriptImage> &image, BaseScriptHolder *owner);
 	uint32 _iP;
 private:
-	void readHeader();
+	void attachImage(const Common::SharedPtr<ScScriptImage> &image);
+	Common::SharedPtr<ScScriptImage> _image;
 	uint32 _bufferSize;
 	byte *_buffer;
 public:
@@ -149,6 +152,8 @@ public:
 	bool externalCall(ScStack *stack, ScStack *thisStack, ScScript::TExternalFunction *function);
 private:
 	char **_symbols;
+	Common::String *_symbolNames;
+	ScValue **_engineGlobalSlots;
 	uint32 _numSymbols;
 	TFunctionPos *_functions;
 	TMethodPos *_methods;
@@ -169,6 +174,55 @@ public:
 	virtual const char *dbgGetFilename();
 };
 
+/**
+ * The immutable part of a compiled script: the bytecode and the tables
+ * parsed from it. Images are shared between all the scripts and threads
+ * running the same file, each ScScript only keeps its execution state.
+ */
+class ScScriptImage {
+public:
+	/**
+	 * Parse a compiled script.
+	 * @param buffer the bytecode, allocated with new[], the image takes ownership of it
+	 * @param size size of the bytecode
+	 */
+	ScScriptImage(byte *buffer, uint32 size);
+	~ScScriptImage();
+
+	/**
+	 * Check whether the header is valid, the tables are only
+	 * available if it is.
+	 */
+	bool isValid() const;
+	/**
+	 * Get the approximate amount of memory used by the image.
+	 */
+	uint32 getMemorySize() const { return _memorySize; }
+
+	byte *_buffer;
+	uint32 _size;
+	ScScript::TScriptHeader _header;
+
+	char **_symbols;
+	Common::String *_symbolNames;
+	uint32 _numSymbols;
+	ScScript::TFunctionPos *_functions;
+	uint32 _numFunctions;
+	ScScript::TMethodPos *_methods;
+	uint32 _numMethods;
+	ScScript::TEventPos *_events;
+	uint32 _numEvents;
+	ScScript::TExternalFunction *_externals;
+	uint32 _numExternals;
+
+private:
+	void readTables();
+	uint32 getDWORD(uint32 &pos) const;
+	char *getString(uint32 &pos) const;
+
+	uint32 _memorySize;
+};
+
 } // End of namespace Wintermute
 
 #endif
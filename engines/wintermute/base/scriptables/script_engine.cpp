@@ -68,9 +68,7 @@ ScEngine::ScEngine(BaseGame *inGame) : BaseClass(inGame) {
 	}
 
 	// prepare script cache
-	for (int i = 0; i < MAX_CACHED_SCRIPTS; i++) {
-		_cachedScripts[i] = nullptr;
-	}
+	_cachedScriptsSize = 0;
 
 	_currentScript = nullptr;
 
@@ -134,18 +132,15 @@ void ScEngine::parseElement(void *data, int line, int type, void *elementData) {
 
 //////////////////////////////////////////////////////////////////////////
 ScScript *ScEngine::runScript(const char *filename, BaseScriptHolder *owner) {
-	byte *compBuffer;
-	uint32 compSize;
-
 	// get script from cache
-	compBuffer = getCompiledScript(filename, &compSize);
-	if (!compBuffer) {
+	Common::SharedPtr<ScScriptImage> image = getScriptImage(filename);
+	if (!image) {
 		return nullptr;
 	}
 
 	// add new script
 	ScScript *script = new ScScript(_gameRef, this);
-	bool ret = script->create(filename, compBuffer, compSize, owner);
+	bool ret = script->create(filename, image, owner);
 	if (DID_FAIL(ret)) {
 		_gameRef->LOG(ret, "Error running script '%s'...", filename);
 		delete script;
@@ -170,76 +165,61 @@ ScScript *ScEngine::runScript(const char *filename, BaseScriptHolder *owner) {
 
 
 //////////////////////////////////////////////////////////////////////////
-byte *ScEngine::getCompiledScript(const char *filename, uint32 *outSize, bool ignoreCache) {
+Common::SharedPtr<ScScriptImage> ScEngine::getScriptImage(const char *filename, bool ignoreCache) {
 	// is script in cache?
 	if (!ignoreCache) {
-		for (int i = 0; i < MAX_CACHED_SCRIPTS; i++) {
-			if (_cachedScripts[i] && scumm_stricmp(_cachedScripts[i]->_filename.c_str(), filename) == 0) {
+		for (uint32 i = 0; i < _cachedScripts.size(); i++) {
+			if (scumm_stricmp(_cachedScripts[i]->_filename.c_str(), filename) == 0) {
 				_cachedScripts[i]->_timestamp = g_system->getMillis();
-				*outSize = _cachedScripts[i]->_size;
-				return _cachedScripts[i]->_buffer;
+				return _cachedScripts[i]->_image;
 			}
 		}
 	}
 
 	// nope, load it
-	byte *compBuffer;
-	uint32 compSize;
-
 	uint32 size;
 
 	byte *buffer = BaseEngine::instance().getFileManager()->readWholeFile(filename, &size);
 	if (!buffer) {
 		_gameRef->LOG(0, "ScEngine::GetCompiledScript - error opening script '%s'", filename);
-		return nullptr;
+		return Common::SharedPtr<ScScriptImage>();
 	}
 
 	// needs to be compiled?
-	if (FROM_LE_32(*(uint32 *)buffer) == SCRIPT_MAGIC) {
-		compBuffer = buffer;
-		compSize = size;
-	} else {
+	if (size < sizeof(uint32) || FROM_LE_32(*(uint32 *)buffer) != SCRIPT_MAGIC) {
 		if (!_compilerAvailable) {
 			_gameRef->LOG(0, "ScEngine::GetCompiledScript - script '%s' needs to be compiled but compiler is not available", filename);
 			delete[] buffer;
-			return nullptr;
+			return Common::SharedPtr<ScScriptImage>();
 		}
 		// This code will never be called, since _compilerAvailable is const false.
 		// It's only here in the event someone would want to reinclude the compiler.
 		error("Script needs compilation, ScummVM does not contain a WME compiler");
 	}
 
-	byte *ret = nullptr;
+	// the image takes over the buffer
+	Common::SharedPtr<ScScriptImage> image(new ScScriptImage(buffer, size));
 
-	// add script to cache
-	CScCachedScript *cachedScript = new CScCachedScript(filename, compBuffer, compSize);
-	if (cachedScript) {
-		int index = 0;
-		uint32 minTime = g_system->getMillis();
-		for (int i = 0; i < MAX_CACHED_SCRIPTS; i++) {
-			if (_cachedScripts[i] == nullptr) {
-				index = i;
-				break;
-			} else if (_cachedScripts[i]->_timestamp <= minTime) {
-				minTime = _cachedScripts[i]->_timestamp;
+	// add script to cache, evicting the least recently used scripts that
+	// don't fit the budget; running scripts keep their image alive anyway
+	uint32 imageSize = image->getMemorySize();
+	while (!_cachedScripts.empty() && _cachedScriptsSize + imageSize > MAX_CACHED_SCRIPTS_SIZE) {
+		uint32 index = 0;
+		for (uint32 i = 1; i < _cachedScripts.size(); i++) {
+			if (_cachedScripts[i]->_timestamp < _cachedScripts[index]->_timestamp) {
 				index = i;
 			}
 		}
 
-		if (_cachedScripts[index] != nullptr) {
-			delete _cachedScripts[index];
-		}
-		_cachedScripts[index] = cachedScript;
-
-		ret = cachedScript->_buffer;
-		*outSize = cachedScript->_size;
+		_cachedScriptsSize -= _cachedScripts[index]->_size;
+		delete _cachedScripts[index];
+		_cachedScripts.remove_at(index);
 	}
 
+	_cachedScripts.push_back(new CScCachedScript(filename, image, imageSize));
+	_cachedScriptsSize += imageSize;
 
-	// cleanup
-	delete[] buffer;
-
-	return ret;
+	return image;
 }
 
 
@@ -446,12 +426,11 @@ int ScEngine::getNumScripts(int *running, int *waiting, int *persistent) {
 
 //////////////////////////////////////////////////////////////////////////
 bool ScEngine::emptyScriptCache() {
-	for (int i = 0; i < MAX_CACHED_SCRIPTS; i++) {
-		if (_cachedScripts[i]) {
-			delete _cachedScripts[i];
-			_cachedScripts[i] = nullptr;
-		}
+	for (uint32 i = 0; i < _cachedScripts.size(); i++) {
+		delete _cachedScripts[i];
 	}
+	_cachedScripts.clear();
+	_cachedScriptsSize = 0;
 	return STATUS_OK;
 }
 
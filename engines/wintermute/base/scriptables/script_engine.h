@@ -32,11 +32,14 @@
 #include "engines/wintermute/persistent.h"
 #include "engines/wintermute/coll_templ.h"
 #include "engines/wintermute/base/base.h"
+#include "common/ptr.h"
 
 namespace Wintermute {
 
-#define MAX_CACHED_SCRIPTS 20
+// Memory budget for compiled scripts that are not currently running
+#define MAX_CACHED_SCRIPTS_SIZE (2 * 1024 * 1024)
 class ScScript;
+class ScScriptImage;
 class ScValue;
 class BaseObject;
 class BaseScriptHolder;
@@ -44,24 +47,15 @@ class ScEngine : public BaseClass {
 public:
 	class CScCachedScript {
 	public:
-		CScCachedScript(const char *filename, byte *buffer, uint32 size) {
+		CScCachedScript(const char *filename, const Common::SharedPtr<ScScriptImage> &image, uint32 size) {
 			_timestamp = g_system->getMillis();
-			_buffer = new byte[size];
-			if (_buffer) {
-				memcpy(_buffer, buffer, size);
-			}
+			_image = image;
 			_size = size;
 			_filename = filename;
 		};
 
-		~CScCachedScript() {
-			if (_buffer) {
-				delete[] _buffer;
-			}
-		};
-
 		uint32 _timestamp;
-		byte *_buffer;
+		Common::SharedPtr<ScScriptImage> _image;
 		uint32 _size;
 		Common::String _filename;
 	};
@@ -93,7 +87,7 @@ public:
 	bool resetObject(BaseObject *Object);
 	bool resetScript(ScScript *script);
 	bool emptyScriptCache();
-	byte *getCompiledScript(const char *filename, uint32 *outSize, bool ignoreCache = false);
+	Common::SharedPtr<ScScriptImage> getScriptImage(const char *filename, bool ignoreCache = false);
 	DECLARE_PERSISTENT(ScEngine, BaseClass)
 	bool cleanup();
 	int getNumScripts(int *running = nullptr, int *waiting = nullptr, int *persistent = nullptr);
@@ -121,7 +115,8 @@ public:
 
 private:
 
-	CScCachedScript *_cachedScripts[MAX_CACHED_SCRIPTS];
+	Common::Array<CScCachedScript *> _cachedScripts;
+	uint32 _cachedScriptsSize;
 	bool _isProfiling;
 	uint32 _profilingStartTime;
 
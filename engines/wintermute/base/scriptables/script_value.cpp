@@ -191,6 +191,19 @@ ScValue *ScValue::getProp(const char *name) {
 	return ret;
 }
 
+//////////////////////////////////////////////////////////////////////////
+ScValue *ScValue::findProp(const Common::String &name) {
+	if (_type == VAL_VARIABLE_REF) {
+		return _valRef->findProp(name);
+	}
+
+	_valIter = _valObject.find(name);
+	if (_valIter != _valObject.end()) {
+		return _valIter->_value;
+	}
+	return nullptr;
+}
+
 //////////////////////////////////////////////////////////////////////////
 bool ScValue::deleteProp(const char *name) {
 	if (_type == VAL_VARIABLE_REF) {
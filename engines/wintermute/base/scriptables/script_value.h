@@ -83,6 +83,12 @@ public:
 	bool isObject();
 	bool setProp(const char *name, ScValue *val, bool copyWhole = false, bool setAsConst = false);
 	ScValue *getProp(const char *name);
+	/**
+	 * Look up a property in the property map only, without
+	 * consulting the native object or the string built-ins.
+	 * @return the property, or nullptr if it doesn't exist
+	 */
+	ScValue *findProp(const Common::String &name);
 	BaseScriptable *_valNative;
 	ScValue *_valRef;
 private:
@@ -25,12 +25,18 @@
 #include "engines/wintermute/base/base_engine.h"
 #include "engines/wintermute/base/base_file_manager.h"
 #include "engines/wintermute/base/base_game.h"
+#include "engines/wintermute/base/gfx/osystem/base_render_osystem.h"
+#include "engines/wintermute/base/particles/part_emitter.h"
+#include "engines/wintermute/base/scriptables/script_value.h"
+#include "common/system.h"
 
 namespace Wintermute {
 
 Console::Console(WintermuteEngine *vm) : GUI::Debugger(), _engineRef(vm) {
 	registerCmd("show_fps", WRAP_METHOD(Console, Cmd_ShowFps));
 	registerCmd("dump_file", WRAP_METHOD(Console, Cmd_DumpFile));
+	registerCmd("render_stats", WRAP_METHOD(Console, Cmd_RenderStats));
+	registerCmd("particle_bench", WRAP_METHOD(Console, Cmd_ParticleBench));
 }
 
 Console::~Console(void) {
@@ -81,4 +87,82 @@ bool Console::Cmd_DumpFile(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::Cmd_RenderStats(int argc, const char **argv) {
+	BaseRenderOSystem *renderer = static_cast<BaseRenderOSystem *>(_engineRef->_game->_renderer);
+	if (!renderer) {
+		debugPrintf("No renderer\n");
+		return true;
+	}
+
+	const BaseRenderOSystem::RenderStats &stats = renderer->getLastFrameStats();
+	debugPrintf("Last frame:\n");
+	debugPrintf("  Render tickets created: %u\n", stats.tickets);
+	debugPrintf("  Bytes copied into render tickets: %u\n", stats.bytesCopied);
+	debugPrintf("  Dirty rects: %u\n", stats.dirtyRects);
+	debugPrintf("  Pixels redrawn: %u (bounding box: %u)\n", stats.dirtyArea, stats.dirtyBoundingArea);
+	return true;
+}
+
+static void setEmitterProperty(BaseGame *game, PartEmitter *emitter, const char *name, int32 value) {
+	ScValue val(game, value);
+	emitter->scSetProperty(name, &val);
+}
+
+bool Console::Cmd_ParticleBench(int argc, const char **argv) {
+	if (argc < 2 || argc > 3) {
+		debugPrintf("Usage: %s <sprite file> [frames]\n", argv[0]);
+		return true;
+	}
+
+	int frames = (argc == 3) ? atoi(argv[2]) : 100;
+	if (frames <= 0) {
+		debugPrintf("Invalid number of frames '%s'\n", argv[2]);
+		return true;
+	}
+
+	BaseGame *game = _engineRef->_game;
+	static const int32 numParticles[] = { 1000, 2000, 5000, 10000 };
+	const uint32 frameTime = 20;
+
+	for (int i = 0; i < ARRAYSIZE(numParticles); i++) {
+		PartEmitter *emitter = new PartEmitter(game, nullptr);
+		if (DID_FAIL(emitter->addSprite(argv[1]))) {
+			debugPrintf("Could not load sprite '%s'\n", argv[1]);
+			delete emitter;
+			return true;
+		}
+
+		// Spawn all particles at once, and keep them alive for the whole run
+		setEmitterProperty(game, emitter, "Width", 640);
+		setEmitterProperty(game, emitter, "Height", 480);
+		setEmitterProperty(game, emitter, "MaxParticles", numParticles[i]);
+		setEmitterProperty(game, emitter, "GenerationInterval", 0);
+		setEmitterProperty(game, emitter, "GenerationAmount", numParticles[i]);
+		setEmitterProperty(game, emitter, "LifeTime1", frames * frameTime * 10);
+		setEmitterProperty(game, emitter, "LifeTime2", frames * frameTime * 10);
+		setEmitterProperty(game, emitter, "Velocity1", 10);
+		setEmitterProperty(game, emitter, "Velocity2", 50);
+		setEmitterProperty(game, emitter, "Angle1", 0);
+		setEmitterProperty(game, emitter, "Angle2", 359);
+		setEmitterProperty(game, emitter, "AngVelocity1", 10);
+		setEmitterProperty(game, emitter, "AngVelocity2", 90);
+		setEmitterProperty(game, emitter, "FadeInTime", frameTime * 10);
+		emitter->addForce("Wind", PartForce::FORCE_GLOBAL, 0, 0, 90, 5);
+		emitter->addForce("Attractor", PartForce::FORCE_POINT, 320, 240, 0, 20);
+
+		uint32 currentTime = 0;
+		emitter->updateInternal(currentTime += frameTime, frameTime);
+
+		uint32 startTime = g_system->getMillis();
+		for (int frame = 0; frame < frames; frame++) {
+			emitter->updateInternal(currentTime += frameTime, frameTime);
+		}
+		uint32 elapsed = g_system->getMillis() - startTime;
+
+		debugPrintf("%5d particles: %u ms for %d frames (%.3f ms per frame)\n", numParticles[i], elapsed, frames, (float)elapsed / frames);
+		delete emitter;
+	}
+	return true;
+}
+
 } // End of namespace Wintermute
@@ -35,6 +35,8 @@ public:
 
 	bool Cmd_ShowFps(int argc, const char **argv);
 	bool Cmd_DumpFile(int argc, const char **argv);
+	bool Cmd_RenderStats(int argc, const char **argv);
+	bool Cmd_ParticleBench(int argc, const char **argv);
 private:
 	WintermuteEngine *_engineRef;
 };
@@ -731,7 +731,7 @@ TransparentSurface *TransparentSurface::scale(uint16 newWidth, uint16 newHeight)
 
 	const tColorRGBA *sp = (const tColorRGBA *) getBasePtr(0, 0);
 	tColorRGBA *dp = (tColorRGBA *) target->getBasePtr(0, 0);
-	int spixelgap = srcW;
+	int spixelgap = pitch / 4;
 
 	if (flipx) {
 		sp += spixelw;
@@ -0,0 +1,276 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/scummsys.h"
+#include "common/list.h"
+#include "common/textconsole.h"
+#include "common/util.h"
+
+// The soccer logic is built against a minimal stand-in for the engine,
+// which only provides the SCUMM arrays and variables the logic works on.
+#define SCUMM_HE_INTERN_HE_H
+#define SCUMM_HE_LOGIC_HE_H
+
+namespace Scumm {
+
+enum {
+	GID_SOCCER = 1
+};
+
+struct GameSettings {
+	int id;
+};
+
+class ScummEngine_v90he {
+public:
+	enum {
+		kNumArrays = 5,
+		kArraySize = 8192
+	};
+
+	GameSettings _game;
+
+	int32 _arrays[kNumArrays][kArraySize];
+	int32 _scummVars[256];
+
+	ScummEngine_v90he() {
+		_game.id = GID_SOCCER;
+		memset(_arrays, 0, sizeof(_arrays));
+		memset(_scummVars, 0, sizeof(_scummVars));
+	}
+
+	int32 &arrayEntry(int array, int idx2, int idx1) {
+		return _arrays[array % kNumArrays][(idx2 * 1024 + idx1) & (kArraySize - 1)];
+	}
+};
+
+class LogicHE {
+public:
+	virtual ~LogicHE() {}
+
+	virtual void beforeBootScript() {}
+	virtual void initOnce() {}
+	virtual int startOfFrame() { return 1; }
+
+	virtual int versionID() { return 1; }
+	virtual int32 dispatch(int op, int numArgs, int32 *args) { return 1; }
+
+protected:
+	LogicHE(ScummEngine_v90he *vm) : _vm(vm) {}
+
+	ScummEngine_v90he *_vm;
+
+	void writeScummVar(int var, int32 value) {
+		_vm->_scummVars[var & 0xFF] = value;
+	}
+
+	int getFromArray(int arg0, int idx2, int idx1) {
+		return _vm->arrayEntry(arg0, idx2, idx1);
+	}
+
+	void putInArray(int arg0, int idx2, int idx1, int val) {
+		_vm->arrayEntry(arg0, idx2, idx1) = val;
+	}
+
+	int32 scummRound(double arg) { return (int32)(arg + 0.5); }
+
+	#define RAD2DEG (180 / M_PI)
+	#define DEG2RAD (M_PI / 180)
+};
+
+LogicHE *makeLogicHEsoccer(ScummEngine_v90he *vm);
+
+} // End of namespace Scumm
+
+#include "scumm/he/logic/soccer.cpp"
+
+/**
+ * Checks the collisions op_1014 reports for balls shot at boxes placed on
+ * the field. The reported positions and velocities are derived from float
+ * math, so they are only compared up to a small tolerance, while the
+ * object ids and the data of the area that was hit have to match exactly.
+ */
+class SoccerLogicTestSuite : public CxxTest::TestSuite {
+	enum {
+		kNodeArray = 0,
+		kIndexArray = 1,
+		kDataArray = 2,
+		kObjIdArray = 3,
+		kOutArray = 4,
+
+		kBounce = 50,    // Percentage of the velocity kept after a collision
+		kTolerance = 2
+	};
+
+	Scumm::ScummEngine_v90he *_vm;
+	Scumm::LogicHE *_logic;
+
+	/**
+	 * Set up the field, so every leaf of the collision tree holds the
+	 * given object ids in that order.
+	 */
+	void setupField(const int *objIds, int numObjIds) {
+		_vm = new Scumm::ScummEngine_v90he();
+		_logic = Scumm::makeLogicHEsoccer(_vm);
+		_logic->initOnce();
+
+		int32 args[10];
+		for (int i = 0; i < 10; i++)
+			args[i] = 1000 + i * 100;
+		_logic->dispatch(1007, 10, args);
+
+		// The first leaf of the tree starts one entry in front of the
+		// object ids, so its parent is left disabled
+		for (int i = 0; i < 585; i++)
+			_vm->arrayEntry(kNodeArray, 0, i) = (i != 9);
+		for (int i = 0; i < 4096; i++) {
+			int slot = (i + 1) % 8 - 1;
+			_vm->arrayEntry(kObjIdArray, 0, i) = (slot >= 0 && slot < numObjIds) ? objIds[slot] : 0;
+		}
+
+		args[0] = kNodeArray;
+		args[1] = kObjIdArray;
+		_logic->dispatch(1019, 2, args);
+	}
+
+	void tearDownField() {
+		delete _logic;
+		delete _vm;
+	}
+
+	/**
+	 * Place the collision object objId as the box spanning from (x, y, z)
+	 * to (x + w, y + h, z + d).
+	 */
+	void setBox(int objId, int x, int y, int z, int w, int h, int d) {
+		_vm->arrayEntry(kIndexArray, 0, (objId - 1) * 4 + 0) = objId * 10;
+		_vm->arrayEntry(kIndexArray, 0, (objId - 1) * 4 + 1) = kBounce;
+		_vm->arrayEntry(kIndexArray, 0, (objId - 1) * 4 + 2) = objId + 100;
+		_vm->arrayEntry(kIndexArray, 0, (objId - 1) * 4 + 3) = objId * 24;
+
+		for (int i = 0; i < 8; i++) {
+			_vm->arrayEntry(kDataArray, 0, objId * 24 + i * 3 + 0) = x + ((i & 1) ? w : 0);
+			_vm->arrayEntry(kDataArray, 0, objId * 24 + i * 3 + 1) = y + ((i & 2) ? h : 0);
+			_vm->arrayEntry(kDataArray, 0, objId * 24 + i * 3 + 2) = z + ((i & 4) ? d : 0);
+		}
+	}
+
+	int shoot(int x, int y, int z, int velX, int velY, int velZ) {
+		int32 args[14] = { x, y, z, velX, velY, velZ, kOutArray, kDataArray, kIndexArray, 1, 1, 1, 0, 0 };
+		for (int i = 0; i < 10; i++)
+			_vm->arrayEntry(kOutArray, 0, i) = -1;
+
+		int found = _logic->dispatch(1014, 14, args);
+		TS_ASSERT_EQUALS(_vm->_scummVars[108], found);
+		return found;
+	}
+
+	/**
+	 * Check the output of the last collision op_1014 found.
+	 */
+	void checkCollision(int objId, int x, int y, int z, int velX, int velY, int velZ) {
+		TS_ASSERT_EQUALS(_vm->arrayEntry(kOutArray, 0, 9), objId);
+		TS_ASSERT_EQUALS(_vm->arrayEntry(kOutArray, 0, 0), objId * 10);
+		TS_ASSERT_EQUALS(_vm->arrayEntry(kOutArray, 0, 1), kBounce);
+		TS_ASSERT_EQUALS(_vm->arrayEntry(kOutArray, 0, 2), objId + 100);
+
+		// new velocity, slowed down by the object
+		TS_ASSERT_DELTA(_vm->arrayEntry(kOutArray, 0, 3), velX * kBounce / 100, kTolerance);
+		TS_ASSERT_DELTA(_vm->arrayEntry(kOutArray, 0, 4), velY * kBounce / 100, kTolerance);
+		TS_ASSERT_DELTA(_vm->arrayEntry(kOutArray, 0, 5), velZ * kBounce / 100, kTolerance);
+
+		// position of the collision, just in front of the face that was hit
+		TS_ASSERT_DELTA(_vm->arrayEntry(kOutArray, 0, 6), x, kTolerance);
+		TS_ASSERT_DELTA(_vm->arrayEntry(kOutArray, 0, 7), y, kTolerance);
+		TS_ASSERT_DELTA(_vm->arrayEntry(kOutArray, 0, 8), z, kTolerance);
+	}
+
+public:
+	void test_front_face() {
+		static const int objIds[] = { 1 };
+		setupField(objIds, ARRAYSIZE(objIds));
+		setBox(1, -500, 0, 5000, 1000, 1000, 1000);
+
+		// The reported position is raised by 6: 1 for the ball, 5 by the logic
+		TS_ASSERT_EQUALS(shoot(0, 100, 4000, 0, 0, 1500), 1);
+		checkCollision(1, 0, 106, 4997, 0, 0, -1500);
+
+		// Falling short of the box
+		TS_ASSERT_EQUALS(shoot(0, 100, 4000, 0, 0, 900), 0);
+		// Passing beside it
+		TS_ASSERT_EQUALS(shoot(800, 100, 4000, 0, 0, 1500), 0);
+
+		tearDownField();
+	}
+
+	void test_side_face() {
+		static const int objIds[] = { 1 };
+		setupField(objIds, ARRAYSIZE(objIds));
+		setBox(1, -500, 0, 5000, 1000, 1000, 1000);
+
+		TS_ASSERT_EQUALS(shoot(-1000, 300, 5500, 800, 0, 100), 1);
+		checkCollision(1, -503, 306, 5562, -800, 0, 100);
+
+		tearDownField();
+	}
+
+	void test_moved_object() {
+		static const int objIds[] = { 1 };
+		setupField(objIds, ARRAYSIZE(objIds));
+		setBox(1, -500, 0, 5000, 1000, 1000, 1000);
+
+		TS_ASSERT_EQUALS(shoot(0, 100, 4000, 0, 0, 1500), 1);
+		checkCollision(1, 0, 106, 4997, 0, 0, -1500);
+
+		// The scripts move the objects around between calls
+		setBox(1, -500, 0, 5200, 1000, 1000, 1000);
+		TS_ASSERT_EQUALS(shoot(0, 100, 4000, 0, 0, 1500), 1);
+		checkCollision(1, 0, 106, 5197, 0, 0, -1500);
+
+		setBox(1, 500, 0, 5000, 1000, 1000, 1000);
+		TS_ASSERT_EQUALS(shoot(0, 100, 4000, 0, 0, 1500), 0);
+
+		tearDownField();
+	}
+
+	void test_closest_of_two() {
+		static const int objIds[] = { 1, 2 };
+		setupField(objIds, ARRAYSIZE(objIds));
+		setBox(1, -500, 0, 5000, 1000, 1000, 1000);
+		setBox(2, -500, 0, 3000, 1000, 1000, 500);
+
+		TS_ASSERT_EQUALS(shoot(0, 100, 2000, 0, 0, 3500), 1);
+		checkCollision(2, 0, 106, 2997, 0, 0, -3500);
+
+		tearDownField();
+	}
+
+	void test_single_sort_pass() {
+		// Collisions are found in the order 1, 2, 3, at a middle, far and
+		// near distance. The single bubble pass of sortCollisionList() only
+		// moves the furthest one to the end, so the original reports
+		// object 1 instead of the closest object 3.
+		static const int objIds[] = { 1, 2, 3 };
+		setupField(objIds, ARRAYSIZE(objIds));
+		setBox(1, -500, 0, 3000, 1000, 1000, 400);
+		setBox(2, -500, 0, 4000, 1000, 1000, 400);
+		setBox(3, -500, 0, 2000, 1000, 1000, 400);
+
+		TS_ASSERT_EQUALS(shoot(0, 100, 1000, 0, 0, 6000), 1);
+		checkCollision(1, 0, 106, 2997, 0, 0, -6000);
+
+		tearDownField();
+	}
+
+	void test_ground_intersection() {
+		static const int objIds[] = { 1 };
+		setupField(objIds, ARRAYSIZE(objIds));
+
+		// op_1021 computes where the trajectory meets the ground
+		int32 args[7] = { 100, 200, 300, 10, -20, 30, 0 };
+		_logic->dispatch(1021, 7, args);
+		TS_ASSERT_EQUALS(_vm->_scummVars[108], 200);
+		TS_ASSERT_EQUALS(_vm->_scummVars[109], 600);
+
+		tearDownField();
+	}
+};
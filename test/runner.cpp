@@ -0,0 +1,1595 @@
+/* Generated file, do not edit */
+
+#ifndef CXXTEST_RUNNING
+#define CXXTEST_RUNNING
+#endif
+
+#define _CXXTEST_HAVE_STD
+#include "./test/cxxtest_mingw.h"
+#include <cxxtest/TestListener.h>
+#include <cxxtest/TestTracker.h>
+#include <cxxtest/TestRunner.h>
+#include <cxxtest/RealDescriptions.h>
+#include <cxxtest/StdioPrinter.h>
+
+int main() {
+ return CxxTest::StdioPrinter().run();
+}
+#include "test/common/algorithm.h"
+
+static AlgorithmTestSuite suite_AlgorithmTestSuite;
+
+static CxxTest::List Tests_AlgorithmTestSuite = { 0, 0 };
+CxxTest::StaticSuiteDescription suiteDescription_AlgorithmTestSuite( "test/common/algorithm.h", 8, "AlgorithmTestSuite", suite_AlgorithmTestSuite, Tests_AlgorithmTestSuite );
+
+static class TestDescription_AlgorithmTestSuite_test_check_sort : public CxxTest::RealTestDescription {
+public:
+ TestDescription_AlgorithmTestSuite_test_check_sort() : CxxTest::RealTestDescription( Tests_AlgorithmTestSuite, suiteDescription_AlgorithmTestSuite, 37, "test_check_sort" ) {}
+ void runTest() { suite_AlgorithmTestSuite.test_check_sort(); }
+} testDescription_AlgorithmTestSuite_test_check_sort;
+
+static class TestDescription_AlgorithmTestSuite_test_pod_sort : public CxxTest::RealTestDescription {
+public:
+ TestDescription_AlgorithmTestSuite_test_pod_sort() : CxxTest::RealTestDescription( Tests_AlgorithmTestSuite, suiteDescription_AlgorithmTestSuite, 48, "test_pod_sort" ) {}
+ void runTest() { suite_AlgorithmTestSuite.test_pod_sort(); }
+} testDescription_AlgorithmTestSuite_test_pod_sort;
+
+static class TestDescription_AlgorithmTestSuite_test_container_sort : public CxxTest::RealTestDescription {
+public:
+ TestDescription_AlgorithmTestSuite_test_container_sort() : CxxTest::RealTestDescription( Tests_AlgorithmTestSuite, suiteDescription_AlgorithmTestSuite, 68, "test_container_sort" ) {}
+ void runTest() { suite_AlgorithmTestSuite.test_container_sort(); }
+} testDescription_AlgorithmTestSuite_test_container_sort;
+
+#include "test/common/array.h"
+
+static ArrayTestSuite suite_ArrayTestSuite;
+
+static CxxTest::List Tests_ArrayTestSuite = { 0, 0 };
+CxxTest::StaticSuiteDescription suiteDescription_ArrayTestSuite( "test/common/array.h", 6, "ArrayTestSuite", suite_ArrayTestSuite, Tests_ArrayTestSuite );
+
+static class TestDescription_ArrayTestSuite_test_empty_clear : public CxxTest::RealTestDescription {
+public:
+ TestDescription_ArrayTestSuite_test_empty_clear() : CxxTest::RealTestDescription( Tests_ArrayTestSuite, suiteDescription_ArrayTestSuite, 9, "test_empty_clear" ) {}
+ void runTest() { suite_ArrayTestSuite.test_empty_clear(); }
+} testDescription_ArrayTestSuite_test_empty_clear;
+
+static class TestDescription_ArrayTestSuite_test_iterator : public CxxTest::RealTestDescription {
+public:
+ TestDescription_ArrayTestSuite_test_iterator() : CxxTest::RealTestDescription( Tests_ArrayTestSuite, suiteDescription_ArrayTestSuite, 19, "test_iterator" ) {}
+ void runTest() { suite_ArrayTestSuite.test_iterator(); }
+} testDescription_ArrayTestSuite_test_iterator;
+
+static class TestDescription_ArrayTestSuite_test_direct_access : public CxxTest::RealTestDescription {
+public:
+ TestDescription_ArrayTestSuite_test_direct_access() : CxxTest::RealTestDescription( Tests_ArrayTestSuite, suiteDescription_ArrayTestSuite, 47, "test_direct_access" ) {}
+ void runTest() { suite_ArrayTestSuite.test_direct_access(); }
+} testDescription_ArrayTestSuite_test_direct_access;
+
+static class TestDescription_ArrayTestSuite_test_insert_at : public CxxTest::RealTestDescription {
+public:
+ TestDescription_ArrayTestSuite_test_insert_at() : CxxTest::RealTestDescription( Tests_ArrayTestSuite, suiteDescription_ArrayTestSuite, 60, "test_insert_at" ) {}
+ void runTest() { suite_ArrayTestSuite.test_insert_at(); }
+} testDescription_ArrayTestSuite_test_insert_at;
+
+static class TestDescription_ArrayTestSuite_test_insert_at_array : public CxxTest::RealTestDescription {
+public:
+ TestDescription_ArrayTestSuite_test_insert_at_array() : CxxTest::RealTestDescription( Tests_ArrayTestSuite, suiteDescription_ArrayTestSuite, 81, "test_insert_at_array" ) {}
+ void runTest() { suite_ArrayTestSuite.test_insert_at_array(); }
+} testDescription_ArrayTestSuite_test_insert_at_array;
+
+static class TestDescription_ArrayTestSuite_test_self_insert : public CxxTest::RealTestDescription {
+public:
+ TestDescription_ArrayTestSuite_test_self_insert() : CxxTest::RealTestDescription( Tests_ArrayTestSuite, suiteDescription_ArrayTestSuite, 110, "test_self_insert" ) {}
+ void runTest() { suite_ArrayTestSuite.test_self_insert(); }
+} testDescription_ArrayTestSuite_test_self_insert;
+
+static class TestDescription_ArrayTestSuite_test_remove_at : public CxxTest::RealTestDescription {
+public:
+ TestDescription_ArrayTestSuite_test_remove_at() : CxxTest::RealTestDescription( Tests_ArrayTestSuite, suiteDescription_ArrayTestSuite, 139, "test_remove_at" ) {}
+ void runTest() { suite_ArrayTestSuite.test_remove_at(); }
+} testDescription_ArrayTestSuite_test_remove_at;
+
+static class TestDescription_ArrayTestSuite_test_push_back : public CxxTest::RealTestDescription {
+public:
+ TestDescription_ArrayTestSuite_test_push_back() : CxxTest::RealTestDescription( Tests_ArrayTestSuite, suiteDescription_ArrayTestSuite, 160, "test_push_back" ) {}
+ void runTest() { suite_ArrayTestSuite.test_push_back(); }
+} testDescription_ArrayTestSuite_test_push_back;
+
+static class TestDescription_ArrayTestSuite_test_push_back_ex : public CxxTest::RealTestDescription {
+public:
+ TestDescription_ArrayTestSuite_test_push_back_ex() : CxxTest::RealTestDescription( Tests_ArrayTestSuite, suiteDescription_ArrayTestSuite, 195, "test_push_back_ex" ) {}
+ void runTest() { suite_ArrayTestSuite.test_push_back_ex(); }
+} testDescription_ArrayTestSuite_test_push_back_ex;
+
+static class TestDescription_ArrayTestSuite_test_copy_constructor : public CxxTest::RealTestDescription {
+public:
+ TestDescription_ArrayTestSuite_test_copy_constructor() : CxxTest::RealTestDescription( Tests_ArrayTestSuite, suiteDescription_ArrayTestSuite, 208, "test_copy_constructor" ) {}
+ void runTest() { suite_ArrayTestSuite.test_copy_constructor(); }
+} testDescription_ArrayTestSuite_test_copy_constructor;
+
+static class TestDescription_ArrayTestSuite_test_equals : public CxxTest::RealTestDescription {
+public:
+ TestDescription_ArrayTestSuite_test_equals() : CxxTest::RealTestDescription( Tests_ArrayTestSuite, suiteDescription_ArrayTestSuite, 230, "test_equals" ) {}
+ void runTest() { suite_ArrayTestSuite.test_equals(); }
+} testDescription_ArrayTestSuite_test_equals;
+
+static class TestDescription_ArrayTestSuite_test_array_constructor : public CxxTest::RealTestDescription {
+public:
+ TestDescription_ArrayTestSuite_test_array_constructor() : CxxTest::RealTestDescription( Tests_ArrayTestSuite, suiteDescription_ArrayTestSuite, 247, "test_array_constructor" ) {}
+ void runTest() { suite_ArrayTestSuite.test_array_constructor(); }
+} testDescription_ArrayTestSuite_test_array_constructor;
+
+static class TestDescription_ArrayTestSuite_test_array_constructor_str : public CxxTest::RealTestDescription {
+public:
+ TestDescription_ArrayTestSuite_test_array_constructor_str() : CxxTest::RealTestDescription( Tests_ArrayTestSuite, suiteDescription_ArrayTestSuite, 259, "test_array_constructor_str" ) {}
+ void runTest() { suite_ArrayTestSuite.test_array_constructor_str(); }
+} testDescription_ArrayTestSuite_test_array_constructor_str;
+
+static class TestDescription_ArrayTestSuite_test_front_back_push_pop : public CxxTest::RealTestDescription {
+public:
+ TestDescription_ArrayTestSuite_test_front_back_push_pop() : CxxTest::RealTestDescription( Tests_ArrayTestSuite, suiteDescription_ArrayTestSuite, 271, "test_front_back_push_pop" ) {}
+ void runTest() { suite_ArrayTestSuite.test_front_back_push_pop(); }
+} testDescription_ArrayTestSuite_test_front_back_push_pop;
+
+static class TestDescription_ArrayTestSuite_test_resize : public CxxTest::RealTestDescription {
+public:
+ TestDescription_ArrayTestSuite_test_resize() : CxxTest::RealTestDescription( Tests_ArrayTestSuite, suiteDescription_ArrayTestSuite, 290, "test_resize" ) {}
+ void runTest() { suite_ArrayTestSuite.test_resize(); }
+} testDescription_ArrayTestSuite_test_resize;
+
+#include "test/common/bitstream.h"
+
+static BitStreamTestSuite suite_BitStreamTestSuite;
+
+static CxxTest::List Tests_BitStreamTestSuite = { 0, 0 };
+CxxTest::StaticSuiteDescription suiteDescription_BitStreamTestSuite( "test/common/bitstream.h", 6, "BitStreamTestSuite", suite_BitStreamTestSuite, Tests_BitStreamTestSuite );
+
+static class TestDescription_BitStreamTestSuite_test_get_bit : public CxxTest::RealTestDescription {
+public:
+ TestDescription_BitStreamTestSuite_test_get_bit() : CxxTest::RealTestDescription( Tests_BitStreamTestSuite, suiteDescription_BitStreamTestSuite, 9, "test_get_bit" ) {}
+ void runTest() { suite_BitStreamTestSuite.test_get_bit(); }
+} testDescription_BitStreamTestSuite_test_get_bit;
+
+static class TestDescription_BitStreamTestSuite_test_get_bits : public CxxTest::RealTestDescription {
+public:
+ TestDescription_BitStreamTestSuite_test_get_bits() : CxxTest::RealTestDescription( Tests_BitStreamTestSuite, suiteDescription_BitStreamTestSuite, 23, "test_get_bits" ) {}
+ void runTest() { suite_BitStreamTestSuite.test_get_bits(); }
+} testDescription_BitStreamTestSuite_test_get_bits;
+
+static class TestDescription_BitStreamTestSuite_test_skip : public CxxTest::RealTestDescription {
+public:
+ TestDescription_BitStreamTestSuite_test_skip() : CxxTest::RealTestDescription( Tests_BitStreamTestSuite, suiteDescription_BitStreamTestSuite, 37, "test_skip" ) {}
+ void runTest() { suite_BitStreamTestSuite.test_skip(); }
+} testDescription_BitStreamTestSuite_test_skip;
+
+static class TestDescription_BitStreamTestSuite_test_rewind : public CxxTest::RealTestDescription {
+public:
+ TestDescription_BitStreamTestSuite_test_rewind() : CxxTest::RealTestDescription( Tests_BitStreamTestSuite, suiteDescription_BitStreamTestSuite, 52, "test_rewind" ) {}
+ void runTest() { suite_BitStreamTestSuite.test_rewind(); }
+} testDescription_BitStreamTestSuite_test_rewind;
+
+static class TestDescription_BitStreamTestSuite_test_peek_bit : public CxxTest::RealTestDescription {
+public:
+ TestDescription_BitStreamTestSuite_test_peek_bit() : CxxTest::RealTestDescription( Tests_BitStreamTestSuite, suiteDescription_BitStreamTestSuite, 69, "test_peek_bit" ) {}
+ void runTest() { suite_BitStreamTestSuite.test_peek_bit(); }
+} testDescription_BitStreamTestSuite_test_peek_bit;
+
+static class TestDescription_BitStreamTestSuite_test_peek_bits : public CxxTest::RealTestDescription {
+public:
+ TestDescription_BitStreamTestSuite_test_peek_bits() : CxxTest::RealTestDescription( Tests_BitStreamTestSuite, suiteDescription_BitStreamTestSuite, 85, "test_peek_bits" ) {}
+ void runTest() { suite_BitStreamTestSuite.test_peek_bits(); }
+} testDescription_BitStreamTestSuite_test_peek_bits;
+
+static class TestDescription_BitStreamTestSuite_test_eos : public CxxTest::RealTestDescription {
+public:
+ TestDescription_BitStreamTestSuite_test_eos() : CxxTest::RealTestDescription( Tests_BitStreamTestSuite, suiteDescription_BitStreamTestSuite, 104, "test_eos" ) {}
+ void runTest() { suite_BitStreamTestSuite.test_eos(); }
+} testDescription_BitStreamTestSuite_test_eos;
+
+static class TestDescription_BitStreamTestSuite_test_get_bits_lsb : public CxxTest::RealTestDescription {
+public:
+ TestDescription_BitStreamTestSuite_test_get_bits_lsb() : CxxTest::RealTestDescription( Tests_BitStreamTestSuite, suiteDescription_BitStreamTestSuite, 120, "test_get_bits_lsb" ) {}
+ void runTest() { suite_BitStreamTestSuite.test_get_bits_lsb(); }
+} testDescription_BitStreamTestSuite_test_get_bits_lsb;
+
+static class TestDescription_BitStreamTestSuite_test_peek_bits_lsb : public CxxTest::RealTestDescription {
+public:
+ TestDescription_BitStreamTestSuite_test_peek_bits_lsb() : CxxTest::RealTestDescription( Tests_BitStreamTestSuite, suiteDescription_BitStreamTestSuite, 134, "test_peek_bits_lsb" ) {}
+ void runTest() { suite_BitStreamTestSuite.test_peek_bits_lsb(); }
+} testDescription_BitStreamTestSuite_test_peek_bits_lsb;
+
+#include "test/common/bufferedreadstream.h"
+
+static BufferedReadStreamTestSuite suite_BufferedReadStreamTestSuite;
+
+static CxxTest::List Tests_BufferedReadStreamTestSuite = { 0, 0 };
+CxxTest::StaticSuiteDescription suiteDescription_BufferedReadStreamTestSuite( "test/common/bufferedreadstream.h", 6, "BufferedReadStreamTestSuite", suite_BufferedReadStreamTestSuite, Tests_BufferedReadStreamTestSuite );
+
+static class TestDescription_BufferedReadStreamTestSuite_test_traverse : public CxxTest::RealTestDescription {
+public:
+ TestDescription_BufferedReadStreamTestSuite_test_traverse() : CxxTest::RealTestDescription( Tests_BufferedReadStreamTestSuite, suiteDescription_BufferedReadStreamTestSuite, 8, "test_traverse" ) {}
+ void runTest() { suite_BufferedReadStreamTestSuite.test_traverse(); }
+} testDescription_BufferedReadStreamTestSuite_test_traverse;
+
+static class TestDescription_BufferedReadStreamTestSuite_test_traverse2 : public CxxTest::RealTestDescription {
+public:
+ TestDescription_BufferedReadStreamTestSuite_test_traverse2() : CxxTest::RealTestDescription( Tests_BufferedReadStreamTestSuite, suiteDescription_BufferedReadStreamTestSuite, 34, "test_traverse2" ) {}
+ void runTest() { suite_BufferedReadStreamTestSuite.test_traverse2(); }
+} testDescription_BufferedReadStreamTestSuite_test_traverse2;
+
+#include "test/common/bufferedseekablereadstream.h"
+
+static BufferedSeekableReadStreamTestSuite suite_BufferedSeekableReadStreamTestSuite;
+
+static CxxTest::List Tests_BufferedSeekableReadStreamTestSuite = { 0, 0 };
+CxxTest::StaticSuiteDescription suiteDescription_BufferedSeekableReadStreamTestSuite( "test/common/bufferedseekablereadstream.h", 6, "BufferedSeekableReadStreamTestSuite", suite_BufferedSeekableReadStreamTestSuite, Tests_BufferedSeekableReadStreamTestSuite );
+
+static class TestDescription_BufferedSeekableReadStreamTestSuite_test_traverse : public CxxTest::RealTestDescription {
+public:
+ TestDescription_BufferedSeekableReadStreamTestSuite_test_traverse() : CxxTest::RealTestDescription( Tests_BufferedSeekableReadStreamTestSuite, suiteDescription_BufferedSeekableReadStreamTestSuite, 8, "test_traverse" ) {}
+ void runTest() { suite_BufferedSeekableReadStreamTestSuite.test_traverse(); }
+} testDescription_BufferedSeekableReadStreamTestSuite_test_traverse;
+
+static class TestDescription_BufferedSeekableReadStreamTestSuite_test_seek : public CxxTest::RealTestDescription {
+public:
+ TestDescription_BufferedSeekableReadStreamTestSuite_test_seek() : CxxTest::RealTestDescription( Tests_BufferedSeekableReadStreamTestSuite, suiteDescription_BufferedSeekableReadStreamTestSuite, 33, "test_seek" ) {}
+ void runTest() { suite_BufferedSeekableReadStreamTestSuite.test_seek(); }
+} testDescription_BufferedSeekableReadStreamTestSuite_test_seek;
+
+#include "test/common/endian.h"
+
+static EndianTestSuite suite_EndianTestSuite;
+
+static CxxTest::List Tests_EndianTestSuite = { 0, 0 };
+CxxTest::StaticSuiteDescription suiteDescription_EndianTestSuite( "test/common/endian.h", 4, "EndianTestSuite", suite_EndianTestSuite, Tests_EndianTestSuite );
+
+static class TestDescription_EndianTestSuite_test_MKTAG : public CxxTest::RealTestDescription {
+public:
+ TestDescription_EndianTestSuite_test_MKTAG() : CxxTest::RealTestDescription( Tests_EndianTestSuite, suiteDescription_EndianTestSuite, 7, "test_MKTAG" ) {}
+ void runTest() { suite_EndianTestSuite.test_MKTAG(); }
+} testDescription_EndianTestSuite_test_MKTAG;
+
+static class TestDescription_EndianTestSuite_test_READ_BE_UINT64 : public CxxTest::RealTestDescription {
+public:
+ TestDescription_EndianTestSuite_test_READ_BE_UINT64() : CxxTest::RealTestDescription( Tests_EndianTestSuite, suiteDescription_EndianTestSuite, 13, "test_READ_BE_UINT64" ) {}
+ void runTest() { suite_EndianTestSuite.test_READ_BE_UINT64(); }
+} testDescription_EndianTestSuite_test_READ_BE_UINT64;
+
+static class TestDescription_EndianTestSuite_test_READ_LE_UINT64 : public CxxTest::RealTestDescription {
+public:
+ TestDescription_EndianTestSuite_test_READ_LE_UINT64() : CxxTest::RealTestDescription( Tests_EndianTestSuite, suiteDescription_EndianTestSuite, 19, "test_READ_LE_UINT64" ) {}
+ void runTest() { suite_EndianTestSuite.test_READ_LE_UINT64(); }
+} testDescription_EndianTestSuite_test_READ_LE_UINT64;
+
+static class TestDescription_EndianTestSuite_test_READ_BE_UINT32 : public CxxTest::RealTestDescription {
+public:
+ TestDescription_EndianTestSuite_test_READ_BE_UINT32() : CxxTest::RealTestDescription( Tests_EndianTestSuite, suiteDescription_EndianTestSuite, 25, "test_READ_BE_UINT32" ) {}
+ void runTest() { suite_EndianTestSuite.test_READ_BE_UINT32(); }
+} testDescription_EndianTestSuite_test_READ_BE_UINT32;
+
+static class TestDescription_EndianTestSuite_test_READ_LE_UINT32 : public CxxTest::RealTestDescription {
+public:
+ TestDescription_EndianTestSuite_test_READ_LE_UINT32() : CxxTest::RealTestDescription( Tests_EndianTestSuite, suiteDescription_EndianTestSuite, 31, "test_READ_LE_UINT32" ) {}
+ void runTest() { suite_EndianTestSuite.test_READ_LE_UINT32(); }
+} testDescription_EndianTestSuite_test_READ_LE_UINT32;
+
+static class TestDescription_EndianTestSuite_test_READ_BE_UINT16 : public CxxTest::RealTestDescription {
+public:
+ TestDescription_EndianTestSuite_test_READ_BE_UINT16() : CxxTest::RealTestDescription( Tests_EndianTestSuite, suiteDescription_EndianTestSuite, 37, "test_READ_BE_UINT16" ) {}
+ void runTest() { suite_EndianTestSuite.test_READ_BE_UINT16(); }
+} testDescription_EndianTestSuite_test_READ_BE_UINT16;
+
+static class TestDescription_EndianTestSuite_test_READ_LE_UINT16 : public CxxTest::RealTestDescription {
+public:
+ TestDescription_EndianTestSuite_test_READ_LE_UINT16() : CxxTest::RealTestDescription( Tests_EndianTestSuite, suiteDescription_EndianTestSuite, 43, "test_READ_LE_UINT16" ) {}
+ void runTest() { suite_EndianTestSuite.test_READ_LE_UINT16(); }
+} testDescription_EndianTestSuite_test_READ_LE_UINT16;
+
+#include "test/common/fixedstack.h"
+
+static FixedStackTestSuite suite_FixedStackTestSuite;
+
+static CxxTest::List Tests_FixedStackTestSuite = { 0, 0 };
+CxxTest::StaticSuiteDescription suiteDescription_FixedStackTestSuite( "test/common/fixedstack.h", 5, "FixedStackTestSuite", suite_FixedStackTestSuite, Tests_FixedStackTestSuite );
+
+static class TestDescription_FixedStackTestSuite_test_empty_clear : public CxxTest::RealTestDescription {
+public:
+ TestDescription_FixedStackTestSuite_test_empty_clear() : CxxTest::RealTestDescription( Tests_FixedStackTestSuite, suiteDescription_FixedStackTestSuite, 7, "test_empty_clear" ) {}
+ void runTest() { suite_FixedStackTestSuite.test_empty_clear(); }
+} testDescription_FixedStackTestSuite_test_empty_clear;
+
+static class TestDescription_FixedStackTestSuite_test_size : public CxxTest::RealTestDescription {
+public:
+ TestDescription_FixedStackTestSuite_test_size() : CxxTest::RealTestDescription( Tests_FixedStackTestSuite, suiteDescription_FixedStackTestSuite, 20, "test_size" ) {}
+ void runTest() { suite_FixedStackTestSuite.test_size(); }
+} testDescription_FixedStackTestSuite_test_size;
+
+static class TestDescription_FixedStackTestSuite_test_top_pop : public CxxTest::RealTestDescription {
+public:
+ TestDescription_FixedStackTestSuite_test_top_pop() : CxxTest::RealTestDescription( Tests_FixedStackTestSuite, suiteDescription_FixedStackTestSuite, 37, "test_top_pop" ) {}
+ void runTest() { suite_FixedStackTestSuite.test_top_pop(); }
+} testDescription_FixedStackTestSuite_test_top_pop;
+
+static class TestDescription_FixedStackTestSuite_test_assign : public CxxTest::RealTestDescription {
+public:
+ TestDescription_FixedStackTestSuite_test_assign() : CxxTest::RealTestDescription( Tests_FixedStackTestSuite, suiteDescription_FixedStackTestSuite, 55, "test_assign" ) {}
+ void runTest() { suite_FixedStackTestSuite.test_assign(); }
+} testDescription_FixedStackTestSuite_test_assign;
+
+#include "test/common/func.h"
+
+static FuncTestSuite suite_FuncTestSuite;
+
+static CxxTest::List Tests_FuncTestSuite = { 0, 0 };
+CxxTest::StaticSuiteDescription suiteDescription_FuncTestSuite( "test/common/func.h", 8, "FuncTestSuite", suite_FuncTestSuite, Tests_FuncTestSuite );
+
+static class TestDescription_FuncTestSuite_test_bind1st : public CxxTest::RealTestDescription {
+public:
+ TestDescription_FuncTestSuite_test_bind1st() : CxxTest::RealTestDescription( Tests_FuncTestSuite, suiteDescription_FuncTestSuite, 11, "test_bind1st" ) {}
+ void runTest() { suite_FuncTestSuite.test_bind1st(); }
+} testDescription_FuncTestSuite_test_bind1st;
+
+static class TestDescription_FuncTestSuite_test_bind2nd : public CxxTest::RealTestDescription {
+public:
+ TestDescription_FuncTestSuite_test_bind2nd() : CxxTest::RealTestDescription( Tests_FuncTestSuite, suiteDescription_FuncTestSuite, 17, "test_bind2nd" ) {}
+ void runTest() { suite_FuncTestSuite.test_bind2nd(); }
+} testDescription_FuncTestSuite_test_bind2nd;
+
+static class TestDescription_FuncTestSuite_test_mem_fun_ref : public CxxTest::RealTestDescription {
+public:
+ TestDescription_FuncTestSuite_test_mem_fun_ref() : CxxTest::RealTestDescription( Tests_FuncTestSuite, suiteDescription_FuncTestSuite, 33, "test_mem_fun_ref" ) {}
+ void runTest() { suite_FuncTestSuite.test_mem_fun_ref(); }
+} testDescription_FuncTestSuite_test_mem_fun_ref;
+
+static class TestDescription_FuncTestSuite_test_mem_fun : public CxxTest::RealTestDescription {
+public:
+ TestDescription_FuncTestSuite_test_mem_fun() : CxxTest::RealTestDescription( Tests_FuncTestSuite, suiteDescription_FuncTestSuite, 44, "test_mem_fun" ) {}
+ void runTest() { suite_FuncTestSuite.test_mem_fun(); }
+} testDescription_FuncTestSuite_test_mem_fun;
+
+#include "test/common/hash-str.h"
+
+static HashStrTestSuite suite_HashStrTestSuite;
+
+static CxxTest::List Tests_HashStrTestSuite = { 0, 0 };
+CxxTest::StaticSuiteDescription suiteDescription_HashStrTestSuite( "test/common/hash-str.h", 10, "HashStrTestSuite", suite_HashStrTestSuite, Tests_HashStrTestSuite );
+
+static class TestDescription_HashStrTestSuite_test_case_sensitive_string_equal_to : public CxxTest::RealTestDescription {
+public:
+ TestDescription_HashStrTestSuite_test_case_sensitive_string_equal_to() : CxxTest::RealTestDescription( Tests_HashStrTestSuite, suiteDescription_HashStrTestSuite, 13, "test_case_sensitive_string_equal_to" ) {}
+ void runTest() { suite_HashStrTestSuite.test_case_sensitive_string_equal_to(); }
+} testDescription_HashStrTestSuite_test_case_sensitive_string_equal_to;
+
+static class TestDescription_HashStrTestSuite_test_ignore_case_equal_to : public CxxTest::RealTestDescription {
+public:
+ TestDescription_HashStrTestSuite_test_ignore_case_equal_to() : CxxTest::RealTestDescription( Tests_HashStrTestSuite, suiteDescription_HashStrTestSuite, 45, "test_ignore_case_equal_to" ) {}
+ void runTest() { suite_HashStrTestSuite.test_ignore_case_equal_to(); }
+} testDescription_HashStrTestSuite_test_ignore_case_equal_to;
+
+static class TestDescription_HashStrTestSuite_test_case_sensitive_string_hash : public CxxTest::RealTestDescription {
+public:
+ TestDescription_HashStrTestSuite_test_case_sensitive_string_hash() : CxxTest::RealTestDescription( Tests_HashStrTestSuite, suiteDescription_HashStrTestSuite, 76, "test_case_sensitive_string_hash" ) {}
+ void runTest() { suite_HashStrTestSuite.test_case_sensitive_string_hash(); }
+} testDescription_HashStrTestSuite_test_case_sensitive_string_hash;
+
+static class TestDescription_HashStrTestSuite_test_ignore_case_hash : public CxxTest::RealTestDescription {
+public:
+ TestDescription_HashStrTestSuite_test_ignore_case_hash() : CxxTest::RealTestDescription( Tests_HashStrTestSuite, suiteDescription_HashStrTestSuite, 98, "test_ignore_case_hash" ) {}
+ void runTest() { suite_HashStrTestSuite.test_ignore_case_hash(); }
+} testDescription_HashStrTestSuite_test_ignore_case_hash;
+
+static class TestDescription_HashStrTestSuite_test_cpp_string_hash : public CxxTest::RealTestDescription {
+public:
+ TestDescription_HashStrTestSuite_test_cpp_string_hash() : CxxTest::RealTestDescription( Tests_HashStrTestSuite, suiteDescription_HashStrTestSuite, 116, "test_cpp_string_hash" ) {}
+ void runTest() { suite_HashStrTestSuite.test_cpp_string_hash(); }
+} testDescription_HashStrTestSuite_test_cpp_string_hash;
+
+static class TestDescription_HashStrTestSuite_test_c_style_string_hash : public CxxTest::RealTestDescription {
+public:
+ TestDescription_HashStrTestSuite_test_c_style_string_hash() : CxxTest::RealTestDescription( Tests_HashStrTestSuite, suiteDescription_HashStrTestSuite, 138, "test_c_style_string_hash" ) {}
+ void runTest() { suite_HashStrTestSuite.test_c_style_string_hash(); }
+} testDescription_HashStrTestSuite_test_c_style_string_hash;
+
+#include "test/common/hashmap.h"
+
+static HashMapTestSuite suite_HashMapTestSuite;
+
+static CxxTest::List Tests_HashMapTestSuite = { 0, 0 };
+CxxTest::StaticSuiteDescription suiteDescription_HashMapTestSuite( "test/common/hashmap.h", 6, "HashMapTestSuite", suite_HashMapTestSuite, Tests_HashMapTestSuite );
+
+static class TestDescription_HashMapTestSuite_test_empty_clear : public CxxTest::RealTestDescription {
+public:
+ TestDescription_HashMapTestSuite_test_empty_clear() : CxxTest::RealTestDescription( Tests_HashMapTestSuite, suiteDescription_HashMapTestSuite, 9, "test_empty_clear" ) {}
+ void runTest() { suite_HashMapTestSuite.test_empty_clear(); }
+} testDescription_HashMapTestSuite_test_empty_clear;
+
+static class TestDescription_HashMapTestSuite_test_contains : public CxxTest::RealTestDescription {
+public:
+ TestDescription_HashMapTestSuite_test_contains() : CxxTest::RealTestDescription( Tests_HashMapTestSuite, suiteDescription_HashMapTestSuite, 27, "test_contains" ) {}
+ void runTest() { suite_HashMapTestSuite.test_contains(); }
+} testDescription_HashMapTestSuite_test_contains;
+
+static class TestDescription_HashMapTestSuite_test_add_remove : public CxxTest::RealTestDescription {
+public:
+ TestDescription_HashMapTestSuite_test_add_remove() : CxxTest::RealTestDescription( Tests_HashMapTestSuite, suiteDescription_HashMapTestSuite, 45, "test_add_remove" ) {}
+ void runTest() { suite_HashMapTestSuite.test_add_remove(); }
+} testDescription_HashMapTestSuite_test_add_remove;
+
+static class TestDescription_HashMapTestSuite_test_add_remove_iterator : public CxxTest::RealTestDescription {
+public:
+ TestDescription_HashMapTestSuite_test_add_remove_iterator() : CxxTest::RealTestDescription( Tests_HashMapTestSuite, suiteDescription_HashMapTestSuite, 74, "test_add_remove_iterator" ) {}
+ void runTest() { suite_HashMapTestSuite.test_add_remove_iterator(); }
+} testDescription_HashMapTestSuite_test_add_remove_iterator;
+
+static class TestDescription_HashMapTestSuite_test_lookup : public CxxTest::RealTestDescription {
+public:
+ TestDescription_HashMapTestSuite_test_lookup() : CxxTest::RealTestDescription( Tests_HashMapTestSuite, suiteDescription_HashMapTestSuite, 103, "test_lookup" ) {}
+ void runTest() { suite_HashMapTestSuite.test_lookup(); }
+} testDescription_HashMapTestSuite_test_lookup;
+
+static class TestDescription_HashMapTestSuite_test_lookup_with_default : public CxxTest::RealTestDescription {
+public:
+ TestDescription_HashMapTestSuite_test_lookup_with_default() : CxxTest::RealTestDescription( Tests_HashMapTestSuite, suiteDescription_HashMapTestSuite, 118, "test_lookup_with_default" ) {}
+ void runTest() { suite_HashMapTestSuite.test_lookup_with_default(); }
+} testDescription_HashMapTestSuite_test_lookup_with_default;
+
+static class TestDescription_HashMapTestSuite_test_iterator_begin_end : public CxxTest::RealTestDescription {
+public:
+ TestDescription_HashMapTestSuite_test_iterator_begin_end() : CxxTest::RealTestDescription( Tests_HashMapTestSuite, suiteDescription_HashMapTestSuite, 136, "test_iterator_begin_end" ) {}
+ void runTest() { suite_HashMapTestSuite.test_iterator_begin_end(); }
+} testDescription_HashMapTestSuite_test_iterator_begin_end;
+
+static class TestDescription_HashMapTestSuite_test_hash_map_copy : public CxxTest::RealTestDescription {
+public:
+ TestDescription_HashMapTestSuite_test_hash_map_copy() : CxxTest::RealTestDescription( Tests_HashMapTestSuite, suiteDescription_HashMapTestSuite, 151, "test_hash_map_copy" ) {}
+ void runTest() { suite_HashMapTestSuite.test_hash_map_copy(); }
+} testDescription_HashMapTestSuite_test_hash_map_copy;
+
+static class TestDescription_HashMapTestSuite_test_collision : public CxxTest::RealTestDescription {
+public:
+ TestDescription_HashMapTestSuite_test_collision() : CxxTest::RealTestDescription( Tests_HashMapTestSuite, suiteDescription_HashMapTestSuite, 158, "test_collision" ) {}
+ void runTest() { suite_HashMapTestSuite.test_collision(); }
+} testDescription_HashMapTestSuite_test_collision;
+
+static class TestDescription_HashMapTestSuite_test_iterator : public CxxTest::RealTestDescription {
+public:
+ TestDescription_HashMapTestSuite_test_iterator() : CxxTest::RealTestDescription( Tests_HashMapTestSuite, suiteDescription_HashMapTestSuite, 200, "test_iterator" ) {}
+ void runTest() { suite_HashMapTestSuite.test_iterator(); }
+} testDescription_HashMapTestSuite_test_iterator;
+
+#include "test/common/huffman.h"
+
+static HuffmanTestSuite suite_HuffmanTestSuite;
+
+static CxxTest::List Tests_HuffmanTestSuite = { 0, 0 };
+CxxTest::StaticSuiteDescription suiteDescription_HuffmanTestSuite( "test/common/huffman.h", 12, "HuffmanTestSuite", suite_HuffmanTestSuite, Tests_HuffmanTestSuite );
+
+static class TestDescription_HuffmanTestSuite_test_get_with_full_symbols : public CxxTest::RealTestDescription {
+public:
+ TestDescription_HuffmanTestSuite_test_get_with_full_symbols() : CxxTest::RealTestDescription( Tests_HuffmanTestSuite, suiteDescription_HuffmanTestSuite, 14, "test_get_with_full_symbols" ) {}
+ void runTest() { suite_HuffmanTestSuite.test_get_with_full_symbols(); }
+} testDescription_HuffmanTestSuite_test_get_with_full_symbols;
+
+static class TestDescription_HuffmanTestSuite_test_get_without_symbols : public CxxTest::RealTestDescription {
+public:
+ TestDescription_HuffmanTestSuite_test_get_without_symbols() : CxxTest::RealTestDescription( Tests_HuffmanTestSuite, suiteDescription_HuffmanTestSuite, 60, "test_get_without_symbols" ) {}
+ void runTest() { suite_HuffmanTestSuite.test_get_without_symbols(); }
+} testDescription_HuffmanTestSuite_test_get_without_symbols;
+
+static class TestDescription_HuffmanTestSuite_test_get_after_set_symbols : public CxxTest::RealTestDescription {
+public:
+ TestDescription_HuffmanTestSuite_test_get_after_set_symbols() : CxxTest::RealTestDescription( Tests_HuffmanTestSuite, suiteDescription_HuffmanTestSuite, 98, "test_get_after_set_symbols" ) {}
+ void runTest() { suite_HuffmanTestSuite.test_get_after_set_symbols(); }
+} testDescription_HuffmanTestSuite_test_get_after_set_symbols;
+
+#include "test/common/list.h"
+
+static ListTestSuite suite_ListTestSuite;
+
+static CxxTest::List Tests_ListTestSuite = { 0, 0 };
+CxxTest::StaticSuiteDescription suiteDescription_ListTestSuite( "test/common/list.h", 5, "ListTestSuite", suite_ListTestSuite, Tests_ListTestSuite );
+
+static class TestDescription_ListTestSuite_test_empty_clear : public CxxTest::RealTestDescription {
+public:
+ TestDescription_ListTestSuite_test_empty_clear() : CxxTest::RealTestDescription( Tests_ListTestSuite, suiteDescription_ListTestSuite, 8, "test_empty_clear" ) {}
+ void runTest() { suite_ListTestSuite.test_empty_clear(); }
+} testDescription_ListTestSuite_test_empty_clear;
+
+static class TestDescription_ListTestSuite_test_size : public CxxTest::RealTestDescription {
+public:
+ TestDescription_ListTestSuite_test_size() : CxxTest::RealTestDescription( Tests_ListTestSuite, suiteDescription_ListTestSuite, 19, "test_size" ) {}
+ void runTest() { suite_ListTestSuite.test_size(); }
+} testDescription_ListTestSuite_test_size;
+
+static class TestDescription_ListTestSuite_test_iterator_begin_end : public CxxTest::RealTestDescription {
+public:
+ TestDescription_ListTestSuite_test_iterator_begin_end() : CxxTest::RealTestDescription( Tests_ListTestSuite, suiteDescription_ListTestSuite, 30, "test_iterator_begin_end" ) {}
+ void runTest() { suite_ListTestSuite.test_iterator_begin_end(); }
+} testDescription_ListTestSuite_test_iterator_begin_end;
+
+static class TestDescription_ListTestSuite_test_iterator : public CxxTest::RealTestDescription {
+public:
+ TestDescription_ListTestSuite_test_iterator() : CxxTest::RealTestDescription( Tests_ListTestSuite, suiteDescription_ListTestSuite, 45, "test_iterator" ) {}
+ void runTest() { suite_ListTestSuite.test_iterator(); }
+} testDescription_ListTestSuite_test_iterator;
+
+static class TestDescription_ListTestSuite_test_insert : public CxxTest::RealTestDescription {
+public:
+ TestDescription_ListTestSuite_test_insert() : CxxTest::RealTestDescription( Tests_ListTestSuite, suiteDescription_ListTestSuite, 89, "test_insert" ) {}
+ void runTest() { suite_ListTestSuite.test_insert(); }
+} testDescription_ListTestSuite_test_insert;
+
+static class TestDescription_ListTestSuite_test_erase : public CxxTest::RealTestDescription {
+public:
+ TestDescription_ListTestSuite_test_erase() : CxxTest::RealTestDescription( Tests_ListTestSuite, suiteDescription_ListTestSuite, 131, "test_erase" ) {}
+ void runTest() { suite_ListTestSuite.test_erase(); }
+} testDescription_ListTestSuite_test_erase;
+
+static class TestDescription_ListTestSuite_test_remove : public CxxTest::RealTestDescription {
+public:
+ TestDescription_ListTestSuite_test_remove() : CxxTest::RealTestDescription( Tests_ListTestSuite, suiteDescription_ListTestSuite, 171, "test_remove" ) {}
+ void runTest() { suite_ListTestSuite.test_remove(); }
+} testDescription_ListTestSuite_test_remove;
+
+static class TestDescription_ListTestSuite_test_reverse : public CxxTest::RealTestDescription {
+public:
+ TestDescription_ListTestSuite_test_reverse() : CxxTest::RealTestDescription( Tests_ListTestSuite, suiteDescription_ListTestSuite, 207, "test_reverse" ) {}
+ void runTest() { suite_ListTestSuite.test_reverse(); }
+} testDescription_ListTestSuite_test_reverse;
+
+static class TestDescription_ListTestSuite_test_front_back_push_pop : public CxxTest::RealTestDescription {
+public:
+ TestDescription_ListTestSuite_test_front_back_push_pop() : CxxTest::RealTestDescription( Tests_ListTestSuite, suiteDescription_ListTestSuite, 249, "test_front_back_push_pop" ) {}
+ void runTest() { suite_ListTestSuite.test_front_back_push_pop(); }
+} testDescription_ListTestSuite_test_front_back_push_pop;
+
+#include "test/common/math.h"
+
+static MathTestSuite suite_MathTestSuite;
+
+static CxxTest::List Tests_MathTestSuite = { 0, 0 };
+CxxTest::StaticSuiteDescription suiteDescription_MathTestSuite( "test/common/math.h", 5, "MathTestSuite", suite_MathTestSuite, Tests_MathTestSuite );
+
+static class TestDescription_MathTestSuite_test_intLog2 : public CxxTest::RealTestDescription {
+public:
+ TestDescription_MathTestSuite_test_intLog2() : CxxTest::RealTestDescription( Tests_MathTestSuite, suiteDescription_MathTestSuite, 8, "test_intLog2" ) {}
+ void runTest() { suite_MathTestSuite.test_intLog2(); }
+} testDescription_MathTestSuite_test_intLog2;
+
+#include "test/common/md5.h"
+
+static MD5TestSuite suite_MD5TestSuite;
+
+static CxxTest::List Tests_MD5TestSuite = { 0, 0 };
+CxxTest::StaticSuiteDescription suiteDescription_MD5TestSuite( "test/common/md5.h", 30, "MD5TestSuite", suite_MD5TestSuite, Tests_MD5TestSuite );
+
+static class TestDescription_MD5TestSuite_test_computeStreamMD5 : public CxxTest::RealTestDescription {
+public:
+ TestDescription_MD5TestSuite_test_computeStreamMD5() : CxxTest::RealTestDescription( Tests_MD5TestSuite, suiteDescription_MD5TestSuite, 32, "test_computeStreamMD5" ) {}
+ void runTest() { suite_MD5TestSuite.test_computeStreamMD5(); }
+} testDescription_MD5TestSuite_test_computeStreamMD5;
+
+#include "test/common/memoryreadstream.h"
+
+static MemoryReadStreamTestSuite suite_MemoryReadStreamTestSuite;
+
+static CxxTest::List Tests_MemoryReadStreamTestSuite = { 0, 0 };
+CxxTest::StaticSuiteDescription suiteDescription_MemoryReadStreamTestSuite( "test/common/memoryreadstream.h", 5, "MemoryReadStreamTestSuite", suite_MemoryReadStreamTestSuite, Tests_MemoryReadStreamTestSuite );
+
+static class TestDescription_MemoryReadStreamTestSuite_test_seek_set : public CxxTest::RealTestDescription {
+public:
+ TestDescription_MemoryReadStreamTestSuite_test_seek_set() : CxxTest::RealTestDescription( Tests_MemoryReadStreamTestSuite, suiteDescription_MemoryReadStreamTestSuite, 7, "test_seek_set" ) {}
+ void runTest() { suite_MemoryReadStreamTestSuite.test_seek_set(); }
+} testDescription_MemoryReadStreamTestSuite_test_seek_set;
+
+static class TestDescription_MemoryReadStreamTestSuite_test_seek_cur : public CxxTest::RealTestDescription {
+public:
+ TestDescription_MemoryReadStreamTestSuite_test_seek_cur() : CxxTest::RealTestDescription( Tests_MemoryReadStreamTestSuite, suiteDescription_MemoryReadStreamTestSuite, 24, "test_seek_cur" ) {}
+ void runTest() { suite_MemoryReadStreamTestSuite.test_seek_cur(); }
+} testDescription_MemoryReadStreamTestSuite_test_seek_cur;
+
+static class TestDescription_MemoryReadStreamTestSuite_test_seek_end : public CxxTest::RealTestDescription {
+public:
+ TestDescription_MemoryReadStreamTestSuite_test_seek_end() : CxxTest::RealTestDescription( Tests_MemoryReadStreamTestSuite, suiteDescription_MemoryReadStreamTestSuite, 45, "test_seek_end" ) {}
+ void runTest() { suite_MemoryReadStreamTestSuite.test_seek_end(); }
+} testDescription_MemoryReadStreamTestSuite_test_seek_end;
+
+static class TestDescription_MemoryReadStreamTestSuite_test_seek_read_le : public CxxTest::RealTestDescription {
+public:
+ TestDescription_MemoryReadStreamTestSuite_test_seek_read_le() : CxxTest::RealTestDescription( Tests_MemoryReadStreamTestSuite, suiteDescription_MemoryReadStreamTestSuite, 62, "test_seek_read_le" ) {}
+ void runTest() { suite_MemoryReadStreamTestSuite.test_seek_read_le(); }
+} testDescription_MemoryReadStreamTestSuite_test_seek_read_le;
+
+static class TestDescription_MemoryReadStreamTestSuite_test_seek_read_be : public CxxTest::RealTestDescription {
+public:
+ TestDescription_MemoryReadStreamTestSuite_test_seek_read_be() : CxxTest::RealTestDescription( Tests_MemoryReadStreamTestSuite, suiteDescription_MemoryReadStreamTestSuite, 77, "test_seek_read_be" ) {}
+ void runTest() { suite_MemoryReadStreamTestSuite.test_seek_read_be(); }
+} testDescription_MemoryReadStreamTestSuite_test_seek_read_be;
+
+static class TestDescription_MemoryReadStreamTestSuite_test_eos : public CxxTest::RealTestDescription {
+public:
+ TestDescription_MemoryReadStreamTestSuite_test_eos() : CxxTest::RealTestDescription( Tests_MemoryReadStreamTestSuite, suiteDescription_MemoryReadStreamTestSuite, 92, "test_eos" ) {}
+ void runTest() { suite_MemoryReadStreamTestSuite.test_eos(); }
+} testDescription_MemoryReadStreamTestSuite_test_eos;
+
+#include "test/common/memoryreadstreamendian.h"
+
+static MemoryReadStreamEndianTestSuite suite_MemoryReadStreamEndianTestSuite;
+
+static CxxTest::List Tests_MemoryReadStreamEndianTestSuite = { 0, 0 };
+CxxTest::StaticSuiteDescription suiteDescription_MemoryReadStreamEndianTestSuite( "test/common/memoryreadstreamendian.h", 5, "MemoryReadStreamEndianTestSuite", suite_MemoryReadStreamEndianTestSuite, Tests_MemoryReadStreamEndianTestSuite );
+
+static class TestDescription_MemoryReadStreamEndianTestSuite_test_seek_set : public CxxTest::RealTestDescription {
+public:
+ TestDescription_MemoryReadStreamEndianTestSuite_test_seek_set() : CxxTest::RealTestDescription( Tests_MemoryReadStreamEndianTestSuite, suiteDescription_MemoryReadStreamEndianTestSuite, 7, "test_seek_set" ) {}
+ void runTest() { suite_MemoryReadStreamEndianTestSuite.test_seek_set(); }
+} testDescription_MemoryReadStreamEndianTestSuite_test_seek_set;
+
+static class TestDescription_MemoryReadStreamEndianTestSuite_test_seek_cur : public CxxTest::RealTestDescription {
+public:
+ TestDescription_MemoryReadStreamEndianTestSuite_test_seek_cur() : CxxTest::RealTestDescription( Tests_MemoryReadStreamEndianTestSuite, suiteDescription_MemoryReadStreamEndianTestSuite, 24, "test_seek_cur" ) {}
+ void runTest() { suite_MemoryReadStreamEndianTestSuite.test_seek_cur(); }
+} testDescription_MemoryReadStreamEndianTestSuite_test_seek_cur;
+
+static class TestDescription_MemoryReadStreamEndianTestSuite_test_seek_end : public CxxTest::RealTestDescription {
+public:
+ TestDescription_MemoryReadStreamEndianTestSuite_test_seek_end() : CxxTest::RealTestDescription( Tests_MemoryReadStreamEndianTestSuite, suiteDescription_MemoryReadStreamEndianTestSuite, 45, "test_seek_end" ) {}
+ void runTest() { suite_MemoryReadStreamEndianTestSuite.test_seek_end(); }
+} testDescription_MemoryReadStreamEndianTestSuite_test_seek_end;
+
+static class TestDescription_MemoryReadStreamEndianTestSuite_test_seek_read_le : public CxxTest::RealTestDescription {
+public:
+ TestDescription_MemoryReadStreamEndianTestSuite_test_seek_read_le() : CxxTest::RealTestDescription( Tests_MemoryReadStreamEndianTestSuite, suiteDescription_MemoryReadStreamEndianTestSuite, 62, "test_seek_read_le" ) {}
+ void runTest() { suite_MemoryReadStreamEndianTestSuite.test_seek_read_le(); }
+} testDescription_MemoryReadStreamEndianTestSuite_test_seek_read_le;
+
+static class TestDescription_MemoryReadStreamEndianTestSuite_test_seek_read_be : public CxxTest::RealTestDescription {
+public:
+ TestDescription_MemoryReadStreamEndianTestSuite_test_seek_read_be() : CxxTest::RealTestDescription( Tests_MemoryReadStreamEndianTestSuite, suiteDescription_MemoryReadStreamEndianTestSuite, 77, "test_seek_read_be" ) {}
+ void runTest() { suite_MemoryReadStreamEndianTestSuite.test_seek_read_be(); }
+} testDescription_MemoryReadStreamEndianTestSuite_test_seek_read_be;
+
+static class TestDescription_MemoryReadStreamEndianTestSuite_test_seek_read_le2 : public CxxTest::RealTestDescription {
+public:
+ TestDescription_MemoryReadStreamEndianTestSuite_test_seek_read_le2() : CxxTest::RealTestDescription( Tests_MemoryReadStreamEndianTestSuite, suiteDescription_MemoryReadStreamEndianTestSuite, 92, "test_seek_read_le2" ) {}
+ void runTest() { suite_MemoryReadStreamEndianTestSuite.test_seek_read_le2(); }
+} testDescription_MemoryReadStreamEndianTestSuite_test_seek_read_le2;
+
+static class TestDescription_MemoryReadStreamEndianTestSuite_test_seek_read_be2 : public CxxTest::RealTestDescription {
+public:
+ TestDescription_MemoryReadStreamEndianTestSuite_test_seek_read_be2() : CxxTest::RealTestDescription( Tests_MemoryReadStreamEndianTestSuite, suiteDescription_MemoryReadStreamEndianTestSuite, 107, "test_seek_read_be2" ) {}
+ void runTest() { suite_MemoryReadStreamEndianTestSuite.test_seek_read_be2(); }
+} testDescription_MemoryReadStreamEndianTestSuite_test_seek_read_be2;
+
+#include "test/common/memorywritestream.h"
+
+static MemoryWriteStreamTestSuite suite_MemoryWriteStreamTestSuite;
+
+static CxxTest::List Tests_MemoryWriteStreamTestSuite = { 0, 0 };
+CxxTest::StaticSuiteDescription suiteDescription_MemoryWriteStreamTestSuite( "test/common/memorywritestream.h", 5, "MemoryWriteStreamTestSuite", suite_MemoryWriteStreamTestSuite, Tests_MemoryWriteStreamTestSuite );
+
+static class TestDescription_MemoryWriteStreamTestSuite_test_err : public CxxTest::RealTestDescription {
+public:
+ TestDescription_MemoryWriteStreamTestSuite_test_err() : CxxTest::RealTestDescription( Tests_MemoryWriteStreamTestSuite, suiteDescription_MemoryWriteStreamTestSuite, 7, "test_err" ) {}
+ void runTest() { suite_MemoryWriteStreamTestSuite.test_err(); }
+} testDescription_MemoryWriteStreamTestSuite_test_err;
+
+static class TestDescription_MemoryWriteStreamTestSuite_test_write : public CxxTest::RealTestDescription {
+public:
+ TestDescription_MemoryWriteStreamTestSuite_test_write() : CxxTest::RealTestDescription( Tests_MemoryWriteStreamTestSuite, suiteDescription_MemoryWriteStreamTestSuite, 22, "test_write" ) {}
+ void runTest() { suite_MemoryWriteStreamTestSuite.test_write(); }
+} testDescription_MemoryWriteStreamTestSuite_test_write;
+
+#include "test/common/pack.h"
+
+static PackTestSuite suite_PackTestSuite;
+
+static CxxTest::List Tests_PackTestSuite = { 0, 0 };
+CxxTest::StaticSuiteDescription suiteDescription_PackTestSuite( "test/common/pack.h", 20, "PackTestSuite", suite_PackTestSuite, Tests_PackTestSuite );
+
+static class TestDescription_PackTestSuite_test_packing : public CxxTest::RealTestDescription {
+public:
+ TestDescription_PackTestSuite_test_packing() : CxxTest::RealTestDescription( Tests_PackTestSuite, suiteDescription_PackTestSuite, 23, "test_packing" ) {}
+ void runTest() { suite_PackTestSuite.test_packing(); }
+} testDescription_PackTestSuite_test_packing;
+
+static class TestDescription_PackTestSuite_test_offsets : public CxxTest::RealTestDescription {
+public:
+ TestDescription_PackTestSuite_test_offsets() : CxxTest::RealTestDescription( Tests_PackTestSuite, suiteDescription_PackTestSuite, 27, "test_offsets" ) {}
+ void runTest() { suite_PackTestSuite.test_offsets(); }
+} testDescription_PackTestSuite_test_offsets;
+
+#include "test/common/ptr.h"
+
+static PtrTestSuite suite_PtrTestSuite;
+
+static CxxTest::List Tests_PtrTestSuite = { 0, 0 };
+CxxTest::StaticSuiteDescription suiteDescription_PtrTestSuite( "test/common/ptr.h", 5, "PtrTestSuite", suite_PtrTestSuite, Tests_PtrTestSuite );
+
+static class TestDescription_PtrTestSuite_test_deletion : public CxxTest::RealTestDescription {
+public:
+ TestDescription_PtrTestSuite_test_deletion() : CxxTest::RealTestDescription( Tests_PtrTestSuite, suiteDescription_PtrTestSuite, 17, "test_deletion" ) {}
+ void runTest() { suite_PtrTestSuite.test_deletion(); }
+} testDescription_PtrTestSuite_test_deletion;
+
+static class TestDescription_PtrTestSuite_test_assign : public CxxTest::RealTestDescription {
+public:
+ TestDescription_PtrTestSuite_test_assign() : CxxTest::RealTestDescription( Tests_PtrTestSuite, suiteDescription_PtrTestSuite, 29, "test_assign" ) {}
+ void runTest() { suite_PtrTestSuite.test_assign(); }
+} testDescription_PtrTestSuite_test_assign;
+
+static class TestDescription_PtrTestSuite_test_deleter : public CxxTest::RealTestDescription {
+public:
+ TestDescription_PtrTestSuite_test_deleter() : CxxTest::RealTestDescription( Tests_PtrTestSuite, suiteDescription_PtrTestSuite, 65, "test_deleter" ) {}
+ void runTest() { suite_PtrTestSuite.test_deleter(); }
+} testDescription_PtrTestSuite_test_deleter;
+
+static class TestDescription_PtrTestSuite_test_compare : public CxxTest::RealTestDescription {
+public:
+ TestDescription_PtrTestSuite_test_compare() : CxxTest::RealTestDescription( Tests_PtrTestSuite, suiteDescription_PtrTestSuite, 77, "test_compare" ) {}
+ void runTest() { suite_PtrTestSuite.test_compare(); }
+} testDescription_PtrTestSuite_test_compare;
+
+static class TestDescription_PtrTestSuite_test_cast : public CxxTest::RealTestDescription {
+public:
+ TestDescription_PtrTestSuite_test_cast() : CxxTest::RealTestDescription( Tests_PtrTestSuite, suiteDescription_PtrTestSuite, 99, "test_cast" ) {}
+ void runTest() { suite_PtrTestSuite.test_cast(); }
+} testDescription_PtrTestSuite_test_cast;
+
+#include "test/common/queue.h"
+
+static QueueTestSuite suite_QueueTestSuite;
+
+static CxxTest::List Tests_QueueTestSuite = { 0, 0 };
+CxxTest::StaticSuiteDescription suiteDescription_QueueTestSuite( "test/common/queue.h", 5, "QueueTestSuite", suite_QueueTestSuite, Tests_QueueTestSuite );
+
+static class TestDescription_QueueTestSuite_test_empty_clear : public CxxTest::RealTestDescription {
+public:
+ TestDescription_QueueTestSuite_test_empty_clear() : CxxTest::RealTestDescription( Tests_QueueTestSuite, suiteDescription_QueueTestSuite, 7, "test_empty_clear" ) {}
+ void runTest() { suite_QueueTestSuite.test_empty_clear(); }
+} testDescription_QueueTestSuite_test_empty_clear;
+
+static class TestDescription_QueueTestSuite_test_size : public CxxTest::RealTestDescription {
+public:
+ TestDescription_QueueTestSuite_test_size() : CxxTest::RealTestDescription( Tests_QueueTestSuite, suiteDescription_QueueTestSuite, 20, "test_size" ) {}
+ void runTest() { suite_QueueTestSuite.test_size(); }
+} testDescription_QueueTestSuite_test_size;
+
+static class TestDescription_QueueTestSuite_test_front_back_push_pop : public CxxTest::RealTestDescription {
+public:
+ TestDescription_QueueTestSuite_test_front_back_push_pop() : CxxTest::RealTestDescription( Tests_QueueTestSuite, suiteDescription_QueueTestSuite, 35, "test_front_back_push_pop" ) {}
+ void runTest() { suite_QueueTestSuite.test_front_back_push_pop(); }
+} testDescription_QueueTestSuite_test_front_back_push_pop;
+
+static class TestDescription_QueueTestSuite_test_assign : public CxxTest::RealTestDescription {
+public:
+ TestDescription_QueueTestSuite_test_assign() : CxxTest::RealTestDescription( Tests_QueueTestSuite, suiteDescription_QueueTestSuite, 54, "test_assign" ) {}
+ void runTest() { suite_QueueTestSuite.test_assign(); }
+} testDescription_QueueTestSuite_test_assign;
+
+#include "test/common/rational.h"
+
+static RationalTestSuite suite_RationalTestSuite;
+
+static CxxTest::List Tests_RationalTestSuite = { 0, 0 };
+CxxTest::StaticSuiteDescription suiteDescription_RationalTestSuite( "test/common/rational.h", 5, "RationalTestSuite", suite_RationalTestSuite, Tests_RationalTestSuite );
+
+static class TestDescription_RationalTestSuite_test_operators : public CxxTest::RealTestDescription {
+public:
+ TestDescription_RationalTestSuite_test_operators() : CxxTest::RealTestDescription( Tests_RationalTestSuite, suiteDescription_RationalTestSuite, 7, "test_operators" ) {}
+ void runTest() { suite_RationalTestSuite.test_operators(); }
+} testDescription_RationalTestSuite_test_operators;
+
+static class TestDescription_RationalTestSuite_test_assign : public CxxTest::RealTestDescription {
+public:
+ TestDescription_RationalTestSuite_test_assign() : CxxTest::RealTestDescription( Tests_RationalTestSuite, suiteDescription_RationalTestSuite, 48, "test_assign" ) {}
+ void runTest() { suite_RationalTestSuite.test_assign(); }
+} testDescription_RationalTestSuite_test_assign;
+
+static class TestDescription_RationalTestSuite_test_negative : public CxxTest::RealTestDescription {
+public:
+ TestDescription_RationalTestSuite_test_negative() : CxxTest::RealTestDescription( Tests_RationalTestSuite, suiteDescription_RationalTestSuite, 60, "test_negative" ) {}
+ void runTest() { suite_RationalTestSuite.test_negative(); }
+} testDescription_RationalTestSuite_test_negative;
+
+static class TestDescription_RationalTestSuite_test_add_sub : public CxxTest::RealTestDescription {
+public:
+ TestDescription_RationalTestSuite_test_add_sub() : CxxTest::RealTestDescription( Tests_RationalTestSuite, suiteDescription_RationalTestSuite, 74, "test_add_sub" ) {}
+ void runTest() { suite_RationalTestSuite.test_add_sub(); }
+} testDescription_RationalTestSuite_test_add_sub;
+
+static class TestDescription_RationalTestSuite_test_add_sub2 : public CxxTest::RealTestDescription {
+public:
+ TestDescription_RationalTestSuite_test_add_sub2() : CxxTest::RealTestDescription( Tests_RationalTestSuite, suiteDescription_RationalTestSuite, 89, "test_add_sub2" ) {}
+ void runTest() { suite_RationalTestSuite.test_add_sub2(); }
+} testDescription_RationalTestSuite_test_add_sub2;
+
+static class TestDescription_RationalTestSuite_test_mul : public CxxTest::RealTestDescription {
+public:
+ TestDescription_RationalTestSuite_test_mul() : CxxTest::RealTestDescription( Tests_RationalTestSuite, suiteDescription_RationalTestSuite, 105, "test_mul" ) {}
+ void runTest() { suite_RationalTestSuite.test_mul(); }
+} testDescription_RationalTestSuite_test_mul;
+
+static class TestDescription_RationalTestSuite_test_div : public CxxTest::RealTestDescription {
+public:
+ TestDescription_RationalTestSuite_test_div() : CxxTest::RealTestDescription( Tests_RationalTestSuite, suiteDescription_RationalTestSuite, 124, "test_div" ) {}
+ void runTest() { suite_RationalTestSuite.test_div(); }
+} testDescription_RationalTestSuite_test_div;
+
+#include "test/common/rect.h"
+
+static RectTestSuite suite_RectTestSuite;
+
+static CxxTest::List Tests_RectTestSuite = { 0, 0 };
+CxxTest::StaticSuiteDescription suiteDescription_RectTestSuite( "test/common/rect.h", 5, "RectTestSuite", suite_RectTestSuite, Tests_RectTestSuite );
+
+static class TestDescription_RectTestSuite_test_point_sqrDist : public CxxTest::RealTestDescription {
+public:
+ TestDescription_RectTestSuite_test_point_sqrDist() : CxxTest::RealTestDescription( Tests_RectTestSuite, suiteDescription_RectTestSuite, 8, "test_point_sqrDist" ) {}
+ void runTest() { suite_RectTestSuite.test_point_sqrDist(); }
+} testDescription_RectTestSuite_test_point_sqrDist;
+
+static class TestDescription_RectTestSuite_test_intersects : public CxxTest::RealTestDescription {
+public:
+ TestDescription_RectTestSuite_test_intersects() : CxxTest::RealTestDescription( Tests_RectTestSuite, suiteDescription_RectTestSuite, 21, "test_intersects" ) {}
+ void runTest() { suite_RectTestSuite.test_intersects(); }
+} testDescription_RectTestSuite_test_intersects;
+
+static class TestDescription_RectTestSuite_test_contains : public CxxTest::RealTestDescription {
+public:
+ TestDescription_RectTestSuite_test_contains() : CxxTest::RealTestDescription( Tests_RectTestSuite, suiteDescription_RectTestSuite, 27, "test_contains" ) {}
+ void runTest() { suite_RectTestSuite.test_contains(); }
+} testDescription_RectTestSuite_test_contains;
+
+static class TestDescription_RectTestSuite_test_extend : public CxxTest::RealTestDescription {
+public:
+ TestDescription_RectTestSuite_test_extend() : CxxTest::RealTestDescription( Tests_RectTestSuite, suiteDescription_RectTestSuite, 44, "test_extend" ) {}
+ void runTest() { suite_RectTestSuite.test_extend(); }
+} testDescription_RectTestSuite_test_extend;
+
+#include "test/common/rendermode.h"
+
+static RenderModeTestSuite suite_RenderModeTestSuite;
+
+static CxxTest::List Tests_RenderModeTestSuite = { 0, 0 };
+CxxTest::StaticSuiteDescription suiteDescription_RenderModeTestSuite( "test/common/rendermode.h", 6, "RenderModeTestSuite", suite_RenderModeTestSuite, Tests_RenderModeTestSuite );
+
+static class TestDescription_RenderModeTestSuite_test_parse_render_mode_good : public CxxTest::RealTestDescription {
+public:
+ TestDescription_RenderModeTestSuite_test_parse_render_mode_good() : CxxTest::RealTestDescription( Tests_RenderModeTestSuite, suiteDescription_RenderModeTestSuite, 8, "test_parse_render_mode_good" ) {}
+ void runTest() { suite_RenderModeTestSuite.test_parse_render_mode_good(); }
+} testDescription_RenderModeTestSuite_test_parse_render_mode_good;
+
+static class TestDescription_RenderModeTestSuite_test_parse_render_mode_bad : public CxxTest::RealTestDescription {
+public:
+ TestDescription_RenderModeTestSuite_test_parse_render_mode_bad() : CxxTest::RealTestDescription( Tests_RenderModeTestSuite, suiteDescription_RenderModeTestSuite, 28, "test_parse_render_mode_bad" ) {}
+ void runTest() { suite_RenderModeTestSuite.test_parse_render_mode_bad(); }
+} testDescription_RenderModeTestSuite_test_parse_render_mode_bad;
+
+static class TestDescription_RenderModeTestSuite_test_get_render_mode_code_back_and_forth : public CxxTest::RealTestDescription {
+public:
+ TestDescription_RenderModeTestSuite_test_get_render_mode_code_back_and_forth() : CxxTest::RealTestDescription( Tests_RenderModeTestSuite, suiteDescription_RenderModeTestSuite, 46, "test_get_render_mode_code_back_and_forth" ) {}
+ void runTest() { suite_RenderModeTestSuite.test_get_render_mode_code_back_and_forth(); }
+} testDescription_RenderModeTestSuite_test_get_render_mode_code_back_and_forth;
+
+static class TestDescription_RenderModeTestSuite_test_render_2_guio : public CxxTest::RealTestDescription {
+public:
+ TestDescription_RenderModeTestSuite_test_render_2_guio() : CxxTest::RealTestDescription( Tests_RenderModeTestSuite, suiteDescription_RenderModeTestSuite, 64, "test_render_2_guio" ) {}
+ void runTest() { suite_RenderModeTestSuite.test_render_2_guio(); }
+} testDescription_RenderModeTestSuite_test_render_2_guio;
+
+#include "test/common/seekablesubreadstream.h"
+
+static SeekableSubReadStreamTestSuite suite_SeekableSubReadStreamTestSuite;
+
+static CxxTest::List Tests_SeekableSubReadStreamTestSuite = { 0, 0 };
+CxxTest::StaticSuiteDescription suiteDescription_SeekableSubReadStreamTestSuite( "test/common/seekablesubreadstream.h", 6, "SeekableSubReadStreamTestSuite", suite_SeekableSubReadStreamTestSuite, Tests_SeekableSubReadStreamTestSuite );
+
+static class TestDescription_SeekableSubReadStreamTestSuite_test_traverse : public CxxTest::RealTestDescription {
+public:
+ TestDescription_SeekableSubReadStreamTestSuite_test_traverse() : CxxTest::RealTestDescription( Tests_SeekableSubReadStreamTestSuite, suiteDescription_SeekableSubReadStreamTestSuite, 8, "test_traverse" ) {}
+ void runTest() { suite_SeekableSubReadStreamTestSuite.test_traverse(); }
+} testDescription_SeekableSubReadStreamTestSuite_test_traverse;
+
+static class TestDescription_SeekableSubReadStreamTestSuite_test_seek : public CxxTest::RealTestDescription {
+public:
+ TestDescription_SeekableSubReadStreamTestSuite_test_seek() : CxxTest::RealTestDescription( Tests_SeekableSubReadStreamTestSuite, suiteDescription_SeekableSubReadStreamTestSuite, 32, "test_seek" ) {}
+ void runTest() { suite_SeekableSubReadStreamTestSuite.test_seek(); }
+} testDescription_SeekableSubReadStreamTestSuite_test_seek;
+
+#include "test/common/serializer.h"
+
+static SerializerTestSuite suite_SerializerTestSuite;
+
+static CxxTest::List Tests_SerializerTestSuite = { 0, 0 };
+CxxTest::StaticSuiteDescription suiteDescription_SerializerTestSuite( "test/common/serializer.h", 6, "SerializerTestSuite", suite_SerializerTestSuite, Tests_SerializerTestSuite );
+
+static class TestDescription_SerializerTestSuite_test_read_v1_as_v1 : public CxxTest::RealTestDescription {
+public:
+ TestDescription_SerializerTestSuite_test_read_v1_as_v1() : CxxTest::RealTestDescription( Tests_SerializerTestSuite, suiteDescription_SerializerTestSuite, 96, "test_read_v1_as_v1" ) {}
+ void runTest() { suite_SerializerTestSuite.test_read_v1_as_v1(); }
+} testDescription_SerializerTestSuite_test_read_v1_as_v1;
+
+static class TestDescription_SerializerTestSuite_test_read_v1_as_v2 : public CxxTest::RealTestDescription {
+public:
+ TestDescription_SerializerTestSuite_test_read_v1_as_v2() : CxxTest::RealTestDescription( Tests_SerializerTestSuite, suiteDescription_SerializerTestSuite, 104, "test_read_v1_as_v2" ) {}
+ void runTest() { suite_SerializerTestSuite.test_read_v1_as_v2(); }
+} testDescription_SerializerTestSuite_test_read_v1_as_v2;
+
+static class TestDescription_SerializerTestSuite_test_read_v2_as_v2 : public CxxTest::RealTestDescription {
+public:
+ TestDescription_SerializerTestSuite_test_read_v2_as_v2() : CxxTest::RealTestDescription( Tests_SerializerTestSuite, suiteDescription_SerializerTestSuite, 108, "test_read_v2_as_v2" ) {}
+ void runTest() { suite_SerializerTestSuite.test_read_v2_as_v2(); }
+} testDescription_SerializerTestSuite_test_read_v2_as_v2;
+
+#include "test/common/stack.h"
+
+static StackTestSuite suite_StackTestSuite;
+
+static CxxTest::List Tests_StackTestSuite = { 0, 0 };
+CxxTest::StaticSuiteDescription suiteDescription_StackTestSuite( "test/common/stack.h", 5, "StackTestSuite", suite_StackTestSuite, Tests_StackTestSuite );
+
+static class TestDescription_StackTestSuite_test_empty_clear : public CxxTest::RealTestDescription {
+public:
+ TestDescription_StackTestSuite_test_empty_clear() : CxxTest::RealTestDescription( Tests_StackTestSuite, suiteDescription_StackTestSuite, 7, "test_empty_clear" ) {}
+ void runTest() { suite_StackTestSuite.test_empty_clear(); }
+} testDescription_StackTestSuite_test_empty_clear;
+
+static class TestDescription_StackTestSuite_test_size : public CxxTest::RealTestDescription {
+public:
+ TestDescription_StackTestSuite_test_size() : CxxTest::RealTestDescription( Tests_StackTestSuite, suiteDescription_StackTestSuite, 20, "test_size" ) {}
+ void runTest() { suite_StackTestSuite.test_size(); }
+} testDescription_StackTestSuite_test_size;
+
+static class TestDescription_StackTestSuite_test_top_pop : public CxxTest::RealTestDescription {
+public:
+ TestDescription_StackTestSuite_test_top_pop() : CxxTest::RealTestDescription( Tests_StackTestSuite, suiteDescription_StackTestSuite, 37, "test_top_pop" ) {}
+ void runTest() { suite_StackTestSuite.test_top_pop(); }
+} testDescription_StackTestSuite_test_top_pop;
+
+static class TestDescription_StackTestSuite_test_assign : public CxxTest::RealTestDescription {
+public:
+ TestDescription_StackTestSuite_test_assign() : CxxTest::RealTestDescription( Tests_StackTestSuite, suiteDescription_StackTestSuite, 55, "test_assign" ) {}
+ void runTest() { suite_StackTestSuite.test_assign(); }
+} testDescription_StackTestSuite_test_assign;
+
+#include "test/common/str.h"
+
+static StringTestSuite suite_StringTestSuite;
+
+static CxxTest::List Tests_StringTestSuite = { 0, 0 };
+CxxTest::StaticSuiteDescription suiteDescription_StringTestSuite( "test/common/str.h", 5, "StringTestSuite", suite_StringTestSuite, Tests_StringTestSuite );
+
+static class TestDescription_StringTestSuite_test_constructors : public CxxTest::RealTestDescription {
+public:
+ TestDescription_StringTestSuite_test_constructors() : CxxTest::RealTestDescription( Tests_StringTestSuite, suiteDescription_StringTestSuite, 8, "test_constructors" ) {}
+ void runTest() { suite_StringTestSuite.test_constructors(); }
+} testDescription_StringTestSuite_test_constructors;
+
+static class TestDescription_StringTestSuite_test_trim : public CxxTest::RealTestDescription {
+public:
+ TestDescription_StringTestSuite_test_trim() : CxxTest::RealTestDescription( Tests_StringTestSuite, suiteDescription_StringTestSuite, 19, "test_trim" ) {}
+ void runTest() { suite_StringTestSuite.test_trim(); }
+} testDescription_StringTestSuite_test_trim;
+
+static class TestDescription_StringTestSuite_test_empty_clear : public CxxTest::RealTestDescription {
+public:
+ TestDescription_StringTestSuite_test_empty_clear() : CxxTest::RealTestDescription( Tests_StringTestSuite, suiteDescription_StringTestSuite, 27, "test_empty_clear" ) {}
+ void runTest() { suite_StringTestSuite.test_empty_clear(); }
+} testDescription_StringTestSuite_test_empty_clear;
+
+static class TestDescription_StringTestSuite_test_lastChar : public CxxTest::RealTestDescription {
+public:
+ TestDescription_StringTestSuite_test_lastChar() : CxxTest::RealTestDescription( Tests_StringTestSuite, suiteDescription_StringTestSuite, 34, "test_lastChar" ) {}
+ void runTest() { suite_StringTestSuite.test_lastChar(); }
+} testDescription_StringTestSuite_test_lastChar;
+
+static class TestDescription_StringTestSuite_test_concat1 : public CxxTest::RealTestDescription {
+public:
+ TestDescription_StringTestSuite_test_concat1() : CxxTest::RealTestDescription( Tests_StringTestSuite, suiteDescription_StringTestSuite, 43, "test_concat1" ) {}
+ void runTest() { suite_StringTestSuite.test_concat1(); }
+} testDescription_StringTestSuite_test_concat1;
+
+static class TestDescription_StringTestSuite_test_concat2 : public CxxTest::RealTestDescription {
+public:
+ TestDescription_StringTestSuite_test_concat2() : CxxTest::RealTestDescription( Tests_StringTestSuite, suiteDescription_StringTestSuite, 51, "test_concat2" ) {}
+ void runTest() { suite_StringTestSuite.test_concat2(); }
+} testDescription_StringTestSuite_test_concat2;
+
+static class TestDescription_StringTestSuite_test_concat3 : public CxxTest::RealTestDescription {
+public:
+ TestDescription_StringTestSuite_test_concat3() : CxxTest::RealTestDescription( Tests_StringTestSuite, suiteDescription_StringTestSuite, 57, "test_concat3" ) {}
+ void runTest() { suite_StringTestSuite.test_concat3(); }
+} testDescription_StringTestSuite_test_concat3;
+
+static class TestDescription_StringTestSuite_test_refCount : public CxxTest::RealTestDescription {
+public:
+ TestDescription_StringTestSuite_test_refCount() : CxxTest::RealTestDescription( Tests_StringTestSuite, suiteDescription_StringTestSuite, 63, "test_refCount" ) {}
+ void runTest() { suite_StringTestSuite.test_refCount(); }
+} testDescription_StringTestSuite_test_refCount;
+
+static class TestDescription_StringTestSuite_test_refCount2 : public CxxTest::RealTestDescription {
+public:
+ TestDescription_StringTestSuite_test_refCount2() : CxxTest::RealTestDescription( Tests_StringTestSuite, suiteDescription_StringTestSuite, 78, "test_refCount2" ) {}
+ void runTest() { suite_StringTestSuite.test_refCount2(); }
+} testDescription_StringTestSuite_test_refCount2;
+
+static class TestDescription_StringTestSuite_test_refCount3 : public CxxTest::RealTestDescription {
+public:
+ TestDescription_StringTestSuite_test_refCount3() : CxxTest::RealTestDescription( Tests_StringTestSuite, suiteDescription_StringTestSuite, 93, "test_refCount3" ) {}
+ void runTest() { suite_StringTestSuite.test_refCount3(); }
+} testDescription_StringTestSuite_test_refCount3;
+
+static class TestDescription_StringTestSuite_test_refCount4 : public CxxTest::RealTestDescription {
+public:
+ TestDescription_StringTestSuite_test_refCount4() : CxxTest::RealTestDescription( Tests_StringTestSuite, suiteDescription_StringTestSuite, 107, "test_refCount4" ) {}
+ void runTest() { suite_StringTestSuite.test_refCount4(); }
+} testDescription_StringTestSuite_test_refCount4;
+
+static class TestDescription_StringTestSuite_test_refCount5 : public CxxTest::RealTestDescription {
+public:
+ TestDescription_StringTestSuite_test_refCount5() : CxxTest::RealTestDescription( Tests_StringTestSuite, suiteDescription_StringTestSuite, 121, "test_refCount5" ) {}
+ void runTest() { suite_StringTestSuite.test_refCount5(); }
+} testDescription_StringTestSuite_test_refCount5;
+
+static class TestDescription_StringTestSuite_test_refCount6 : public CxxTest::RealTestDescription {
+public:
+ TestDescription_StringTestSuite_test_refCount6() : CxxTest::RealTestDescription( Tests_StringTestSuite, suiteDescription_StringTestSuite, 133, "test_refCount6" ) {}
+ void runTest() { suite_StringTestSuite.test_refCount6(); }
+} testDescription_StringTestSuite_test_refCount6;
+
+static class TestDescription_StringTestSuite_test_self_asignment : public CxxTest::RealTestDescription {
+public:
+ TestDescription_StringTestSuite_test_self_asignment() : CxxTest::RealTestDescription( Tests_StringTestSuite, suiteDescription_StringTestSuite, 145, "test_self_asignment" ) {}
+ void runTest() { suite_StringTestSuite.test_self_asignment(); }
+} testDescription_StringTestSuite_test_self_asignment;
+
+static class TestDescription_StringTestSuite_test_hasPrefix : public CxxTest::RealTestDescription {
+public:
+ TestDescription_StringTestSuite_test_hasPrefix() : CxxTest::RealTestDescription( Tests_StringTestSuite, suiteDescription_StringTestSuite, 195, "test_hasPrefix" ) {}
+ void runTest() { suite_StringTestSuite.test_hasPrefix(); }
+} testDescription_StringTestSuite_test_hasPrefix;
+
+static class TestDescription_StringTestSuite_test_hasSuffix : public CxxTest::RealTestDescription {
+public:
+ TestDescription_StringTestSuite_test_hasSuffix() : CxxTest::RealTestDescription( Tests_StringTestSuite, suiteDescription_StringTestSuite, 203, "test_hasSuffix" ) {}
+ void runTest() { suite_StringTestSuite.test_hasSuffix(); }
+} testDescription_StringTestSuite_test_hasSuffix;
+
+static class TestDescription_StringTestSuite_test_contains : public CxxTest::RealTestDescription {
+public:
+ TestDescription_StringTestSuite_test_contains() : CxxTest::RealTestDescription( Tests_StringTestSuite, suiteDescription_StringTestSuite, 211, "test_contains" ) {}
+ void runTest() { suite_StringTestSuite.test_contains(); }
+} testDescription_StringTestSuite_test_contains;
+
+static class TestDescription_StringTestSuite_test_toLowercase : public CxxTest::RealTestDescription {
+public:
+ TestDescription_StringTestSuite_test_toLowercase() : CxxTest::RealTestDescription( Tests_StringTestSuite, suiteDescription_StringTestSuite, 222, "test_toLowercase" ) {}
+ void runTest() { suite_StringTestSuite.test_toLowercase(); }
+} testDescription_StringTestSuite_test_toLowercase;
+
+static class TestDescription_StringTestSuite_test_toUppercase : public CxxTest::RealTestDescription {
+public:
+ TestDescription_StringTestSuite_test_toUppercase() : CxxTest::RealTestDescription( Tests_StringTestSuite, suiteDescription_StringTestSuite, 230, "test_toUppercase" ) {}
+ void runTest() { suite_StringTestSuite.test_toUppercase(); }
+} testDescription_StringTestSuite_test_toUppercase;
+
+static class TestDescription_StringTestSuite_test_deleteChar : public CxxTest::RealTestDescription {
+public:
+ TestDescription_StringTestSuite_test_deleteChar() : CxxTest::RealTestDescription( Tests_StringTestSuite, suiteDescription_StringTestSuite, 238, "test_deleteChar" ) {}
+ void runTest() { suite_StringTestSuite.test_deleteChar(); }
+} testDescription_StringTestSuite_test_deleteChar;
+
+static class TestDescription_StringTestSuite_test_erase : public CxxTest::RealTestDescription {
+public:
+ TestDescription_StringTestSuite_test_erase() : CxxTest::RealTestDescription( Tests_StringTestSuite, suiteDescription_StringTestSuite, 246, "test_erase" ) {}
+ void runTest() { suite_StringTestSuite.test_erase(); }
+} testDescription_StringTestSuite_test_erase;
+
+static class TestDescription_StringTestSuite_test_sharing : public CxxTest::RealTestDescription {
+public:
+ TestDescription_StringTestSuite_test_sharing() : CxxTest::RealTestDescription( Tests_StringTestSuite, suiteDescription_StringTestSuite, 254, "test_sharing" ) {}
+ void runTest() { suite_StringTestSuite.test_sharing(); }
+} testDescription_StringTestSuite_test_sharing;
+
+static class TestDescription_StringTestSuite_test_lastPathComponent : public CxxTest::RealTestDescription {
+public:
+ TestDescription_StringTestSuite_test_lastPathComponent() : CxxTest::RealTestDescription( Tests_StringTestSuite, suiteDescription_StringTestSuite, 263, "test_lastPathComponent" ) {}
+ void runTest() { suite_StringTestSuite.test_lastPathComponent(); }
+} testDescription_StringTestSuite_test_lastPathComponent;
+
+static class TestDescription_StringTestSuite_test_normalizePath : public CxxTest::RealTestDescription {
+public:
+ TestDescription_StringTestSuite_test_normalizePath() : CxxTest::RealTestDescription( Tests_StringTestSuite, suiteDescription_StringTestSuite, 281, "test_normalizePath" ) {}
+ void runTest() { suite_StringTestSuite.test_normalizePath(); }
+} testDescription_StringTestSuite_test_normalizePath;
+
+static class TestDescription_StringTestSuite_test_matchString : public CxxTest::RealTestDescription {
+public:
+ TestDescription_StringTestSuite_test_matchString() : CxxTest::RealTestDescription( Tests_StringTestSuite, suiteDescription_StringTestSuite, 310, "test_matchString" ) {}
+ void runTest() { suite_StringTestSuite.test_matchString(); }
+} testDescription_StringTestSuite_test_matchString;
+
+static class TestDescription_StringTestSuite_test_string_printf : public CxxTest::RealTestDescription {
+public:
+ TestDescription_StringTestSuite_test_string_printf() : CxxTest::RealTestDescription( Tests_StringTestSuite, suiteDescription_StringTestSuite, 339, "test_string_printf" ) {}
+ void runTest() { suite_StringTestSuite.test_string_printf(); }
+} testDescription_StringTestSuite_test_string_printf;
+
+static class TestDescription_StringTestSuite_test_strlcpy : public CxxTest::RealTestDescription {
+public:
+ TestDescription_StringTestSuite_test_strlcpy() : CxxTest::RealTestDescription( Tests_StringTestSuite, suiteDescription_StringTestSuite, 350, "test_strlcpy" ) {}
+ void runTest() { suite_StringTestSuite.test_strlcpy(); }
+} testDescription_StringTestSuite_test_strlcpy;
+
+static class TestDescription_StringTestSuite_test_strlcat : public CxxTest::RealTestDescription {
+public:
+ TestDescription_StringTestSuite_test_strlcat() : CxxTest::RealTestDescription( Tests_StringTestSuite, suiteDescription_StringTestSuite, 372, "test_strlcat" ) {}
+ void runTest() { suite_StringTestSuite.test_strlcat(); }
+} testDescription_StringTestSuite_test_strlcat;
+
+static class TestDescription_StringTestSuite_test_scumm_stricmp : public CxxTest::RealTestDescription {
+public:
+ TestDescription_StringTestSuite_test_scumm_stricmp() : CxxTest::RealTestDescription( Tests_StringTestSuite, suiteDescription_StringTestSuite, 403, "test_scumm_stricmp" ) {}
+ void runTest() { suite_StringTestSuite.test_scumm_stricmp(); }
+} testDescription_StringTestSuite_test_scumm_stricmp;
+
+static class TestDescription_StringTestSuite_test_scumm_strnicmp : public CxxTest::RealTestDescription {
+public:
+ TestDescription_StringTestSuite_test_scumm_strnicmp() : CxxTest::RealTestDescription( Tests_StringTestSuite, suiteDescription_StringTestSuite, 410, "test_scumm_strnicmp" ) {}
+ void runTest() { suite_StringTestSuite.test_scumm_strnicmp(); }
+} testDescription_StringTestSuite_test_scumm_strnicmp;
+
+#include "test/common/stream.h"
+
+static ReadLineStreamTestSuite suite_ReadLineStreamTestSuite;
+
+static CxxTest::List Tests_ReadLineStreamTestSuite = { 0, 0 };
+CxxTest::StaticSuiteDescription suiteDescription_ReadLineStreamTestSuite( "test/common/stream.h", 5, "ReadLineStreamTestSuite", suite_ReadLineStreamTestSuite, Tests_ReadLineStreamTestSuite );
+
+static class TestDescription_ReadLineStreamTestSuite_test_readline : public CxxTest::RealTestDescription {
+public:
+ TestDescription_ReadLineStreamTestSuite_test_readline() : CxxTest::RealTestDescription( Tests_ReadLineStreamTestSuite, suiteDescription_ReadLineStreamTestSuite, 7, "test_readline" ) {}
+ void runTest() { suite_ReadLineStreamTestSuite.test_readline(); }
+} testDescription_ReadLineStreamTestSuite_test_readline;
+
+static class TestDescription_ReadLineStreamTestSuite_test_readline2 : public CxxTest::RealTestDescription {
+public:
+ TestDescription_ReadLineStreamTestSuite_test_readline2() : CxxTest::RealTestDescription( Tests_ReadLineStreamTestSuite, suiteDescription_ReadLineStreamTestSuite, 29, "test_readline2" ) {}
+ void runTest() { suite_ReadLineStreamTestSuite.test_readline2(); }
+} testDescription_ReadLineStreamTestSuite_test_readline2;
+
+#include "test/common/subreadstream.h"
+
+static SubReadStreamTestSuite suite_SubReadStreamTestSuite;
+
+static CxxTest::List Tests_SubReadStreamTestSuite = { 0, 0 };
+CxxTest::StaticSuiteDescription suiteDescription_SubReadStreamTestSuite( "test/common/subreadstream.h", 6, "SubReadStreamTestSuite", suite_SubReadStreamTestSuite, Tests_SubReadStreamTestSuite );
+
+static class TestDescription_SubReadStreamTestSuite_test_traverse : public CxxTest::RealTestDescription {
+public:
+ TestDescription_SubReadStreamTestSuite_test_traverse() : CxxTest::RealTestDescription( Tests_SubReadStreamTestSuite, suiteDescription_SubReadStreamTestSuite, 8, "test_traverse" ) {}
+ void runTest() { suite_SubReadStreamTestSuite.test_traverse(); }
+} testDescription_SubReadStreamTestSuite_test_traverse;
+
+static class TestDescription_SubReadStreamTestSuite_test_safe_eos : public CxxTest::RealTestDescription {
+public:
+ TestDescription_SubReadStreamTestSuite_test_safe_eos() : CxxTest::RealTestDescription( Tests_SubReadStreamTestSuite, suiteDescription_SubReadStreamTestSuite, 30, "test_safe_eos" ) {}
+ void runTest() { suite_SubReadStreamTestSuite.test_safe_eos(); }
+} testDescription_SubReadStreamTestSuite_test_safe_eos;
+
+#include "test/common/tokenizer.h"
+
+static TokenizerTestSuite suite_TokenizerTestSuite;
+
+static CxxTest::List Tests_TokenizerTestSuite = { 0, 0 };
+CxxTest::StaticSuiteDescription suiteDescription_TokenizerTestSuite( "test/common/tokenizer.h", 5, "TokenizerTestSuite", suite_TokenizerTestSuite, Tests_TokenizerTestSuite );
+
+static class TestDescription_TokenizerTestSuite_test_nextToken : public CxxTest::RealTestDescription {
+public:
+ TestDescription_TokenizerTestSuite_test_nextToken() : CxxTest::RealTestDescription( Tests_TokenizerTestSuite, suiteDescription_TokenizerTestSuite, 7, "test_nextToken" ) {}
+ void runTest() { suite_TokenizerTestSuite.test_nextToken(); }
+} testDescription_TokenizerTestSuite_test_nextToken;
+
+static class TestDescription_TokenizerTestSuite_test_resetAndEmpty : public CxxTest::RealTestDescription {
+public:
+ TestDescription_TokenizerTestSuite_test_resetAndEmpty() : CxxTest::RealTestDescription( Tests_TokenizerTestSuite, suiteDescription_TokenizerTestSuite, 40, "test_resetAndEmpty" ) {}
+ void runTest() { suite_TokenizerTestSuite.test_resetAndEmpty(); }
+} testDescription_TokenizerTestSuite_test_resetAndEmpty;
+
+#include "test/common/util.h"
+
+static UtilTestSuite suite_UtilTestSuite;
+
+static CxxTest::List Tests_UtilTestSuite = { 0, 0 };
+CxxTest::StaticSuiteDescription suiteDescription_UtilTestSuite( "test/common/util.h", 7, "UtilTestSuite", suite_UtilTestSuite, Tests_UtilTestSuite );
+
+static class TestDescription_UtilTestSuite_test_parsebool_yesno : public CxxTest::RealTestDescription {
+public:
+ TestDescription_UtilTestSuite_test_parsebool_yesno() : CxxTest::RealTestDescription( Tests_UtilTestSuite, suiteDescription_UtilTestSuite, 9, "test_parsebool_yesno" ) {}
+ void runTest() { suite_UtilTestSuite.test_parsebool_yesno(); }
+} testDescription_UtilTestSuite_test_parsebool_yesno;
+
+static class TestDescription_UtilTestSuite_test_parsebool_truefalse : public CxxTest::RealTestDescription {
+public:
+ TestDescription_UtilTestSuite_test_parsebool_truefalse() : CxxTest::RealTestDescription( Tests_UtilTestSuite, suiteDescription_UtilTestSuite, 28, "test_parsebool_truefalse" ) {}
+ void runTest() { suite_UtilTestSuite.test_parsebool_truefalse(); }
+} testDescription_UtilTestSuite_test_parsebool_truefalse;
+
+static class TestDescription_UtilTestSuite_test_parsebool_onezero : public CxxTest::RealTestDescription {
+public:
+ TestDescription_UtilTestSuite_test_parsebool_onezero() : CxxTest::RealTestDescription( Tests_UtilTestSuite, suiteDescription_UtilTestSuite, 47, "test_parsebool_onezero" ) {}
+ void runTest() { suite_UtilTestSuite.test_parsebool_onezero(); }
+} testDescription_UtilTestSuite_test_parsebool_onezero;
+
+static class TestDescription_UtilTestSuite_test_parsebool_bad : public CxxTest::RealTestDescription {
+public:
+ TestDescription_UtilTestSuite_test_parsebool_bad() : CxxTest::RealTestDescription( Tests_UtilTestSuite, suiteDescription_UtilTestSuite, 70, "test_parsebool_bad" ) {}
+ void runTest() { suite_UtilTestSuite.test_parsebool_bad(); }
+} testDescription_UtilTestSuite_test_parsebool_bad;
+
+static class TestDescription_UtilTestSuite_test_is_al_num : public CxxTest::RealTestDescription {
+public:
+ TestDescription_UtilTestSuite_test_is_al_num() : CxxTest::RealTestDescription( Tests_UtilTestSuite, suiteDescription_UtilTestSuite, 107, "test_is_al_num" ) {}
+ void runTest() { suite_UtilTestSuite.test_is_al_num(); }
+} testDescription_UtilTestSuite_test_is_al_num;
+
+static class TestDescription_UtilTestSuite_test_is_alpha : public CxxTest::RealTestDescription {
+public:
+ TestDescription_UtilTestSuite_test_is_alpha() : CxxTest::RealTestDescription( Tests_UtilTestSuite, suiteDescription_UtilTestSuite, 128, "test_is_alpha" ) {}
+ void runTest() { suite_UtilTestSuite.test_is_alpha(); }
+} testDescription_UtilTestSuite_test_is_alpha;
+
+static class TestDescription_UtilTestSuite_test_is_digit : public CxxTest::RealTestDescription {
+public:
+ TestDescription_UtilTestSuite_test_is_digit() : CxxTest::RealTestDescription( Tests_UtilTestSuite, suiteDescription_UtilTestSuite, 149, "test_is_digit" ) {}
+ void runTest() { suite_UtilTestSuite.test_is_digit(); }
+} testDescription_UtilTestSuite_test_is_digit;
+
+static class TestDescription_UtilTestSuite_test_is_lower : public CxxTest::RealTestDescription {
+public:
+ TestDescription_UtilTestSuite_test_is_lower() : CxxTest::RealTestDescription( Tests_UtilTestSuite, suiteDescription_UtilTestSuite, 170, "test_is_lower" ) {}
+ void runTest() { suite_UtilTestSuite.test_is_lower(); }
+} testDescription_UtilTestSuite_test_is_lower;
+
+static class TestDescription_UtilTestSuite_test_is_upper : public CxxTest::RealTestDescription {
+public:
+ TestDescription_UtilTestSuite_test_is_upper() : CxxTest::RealTestDescription( Tests_UtilTestSuite, suiteDescription_UtilTestSuite, 192, "test_is_upper" ) {}
+ void runTest() { suite_UtilTestSuite.test_is_upper(); }
+} testDescription_UtilTestSuite_test_is_upper;
+
+static class TestDescription_UtilTestSuite_test_is_space : public CxxTest::RealTestDescription {
+public:
+ TestDescription_UtilTestSuite_test_is_space() : CxxTest::RealTestDescription( Tests_UtilTestSuite, suiteDescription_UtilTestSuite, 212, "test_is_space" ) {}
+ void runTest() { suite_UtilTestSuite.test_is_space(); }
+} testDescription_UtilTestSuite_test_is_space;
+
+static class TestDescription_UtilTestSuite_test_is_print : public CxxTest::RealTestDescription {
+public:
+ TestDescription_UtilTestSuite_test_is_print() : CxxTest::RealTestDescription( Tests_UtilTestSuite, suiteDescription_UtilTestSuite, 226, "test_is_print" ) {}
+ void runTest() { suite_UtilTestSuite.test_is_print(); }
+} testDescription_UtilTestSuite_test_is_print;
+
+#include "test/audio/audiostream.h"
+
+static AudioStreamTestSuite suite_AudioStreamTestSuite;
+
+static CxxTest::List Tests_AudioStreamTestSuite = { 0, 0 };
+CxxTest::StaticSuiteDescription suiteDescription_AudioStreamTestSuite( "test/audio/audiostream.h", 7, "AudioStreamTestSuite", suite_AudioStreamTestSuite, Tests_AudioStreamTestSuite );
+
+static class TestDescription_AudioStreamTestSuite_test_convertTimeToStreamPos : public CxxTest::RealTestDescription {
+public:
+ TestDescription_AudioStreamTestSuite_test_convertTimeToStreamPos() : CxxTest::RealTestDescription( Tests_AudioStreamTestSuite, suiteDescription_AudioStreamTestSuite, 10, "test_convertTimeToStreamPos" ) {}
+ void runTest() { suite_AudioStreamTestSuite.test_convertTimeToStreamPos(); }
+} testDescription_AudioStreamTestSuite_test_convertTimeToStreamPos;
+
+static class TestDescription_AudioStreamTestSuite_test_looping_audio_stream_mono_11025_fixed_iter : public CxxTest::RealTestDescription {
+public:
+ TestDescription_AudioStreamTestSuite_test_looping_audio_stream_mono_11025_fixed_iter() : CxxTest::RealTestDescription( Tests_AudioStreamTestSuite, suiteDescription_AudioStreamTestSuite, 104, "test_looping_audio_stream_mono_11025_fixed_iter" ) {}
+ void runTest() { suite_AudioStreamTestSuite.test_looping_audio_stream_mono_11025_fixed_iter(); }
+} testDescription_AudioStreamTestSuite_test_looping_audio_stream_mono_11025_fixed_iter;
+
+static class TestDescription_AudioStreamTestSuite_test_looping_audio_stream_mono_22050_fixed_iter : public CxxTest::RealTestDescription {
+public:
+ TestDescription_AudioStreamTestSuite_test_looping_audio_stream_mono_22050_fixed_iter() : CxxTest::RealTestDescription( Tests_AudioStreamTestSuite, suiteDescription_AudioStreamTestSuite, 108, "test_looping_audio_stream_mono_22050_fixed_iter" ) {}
+ void runTest() { suite_AudioStreamTestSuite.test_looping_audio_stream_mono_22050_fixed_iter(); }
+} testDescription_AudioStreamTestSuite_test_looping_audio_stream_mono_22050_fixed_iter;
+
+static class TestDescription_AudioStreamTestSuite_test_looping_audio_stream_stereo_11025_fixed_iter : public CxxTest::RealTestDescription {
+public:
+ TestDescription_AudioStreamTestSuite_test_looping_audio_stream_stereo_11025_fixed_iter() : CxxTest::RealTestDescription( Tests_AudioStreamTestSuite, suiteDescription_AudioStreamTestSuite, 112, "test_looping_audio_stream_stereo_11025_fixed_iter" ) {}
+ void runTest() { suite_AudioStreamTestSuite.test_looping_audio_stream_stereo_11025_fixed_iter(); }
+} testDescription_AudioStreamTestSuite_test_looping_audio_stream_stereo_11025_fixed_iter;
+
+static class TestDescription_AudioStreamTestSuite_test_looping_audio_stream_stereo_22050_fixed_iter : public CxxTest::RealTestDescription {
+public:
+ TestDescription_AudioStreamTestSuite_test_looping_audio_stream_stereo_22050_fixed_iter() : CxxTest::RealTestDescription( Tests_AudioStreamTestSuite, suiteDescription_AudioStreamTestSuite, 116, "test_looping_audio_stream_stereo_22050_fixed_iter" ) {}
+ void runTest() { suite_AudioStreamTestSuite.test_looping_audio_stream_stereo_22050_fixed_iter(); }
+} testDescription_AudioStreamTestSuite_test_looping_audio_stream_stereo_22050_fixed_iter;
+
+static class TestDescription_AudioStreamTestSuite_test_sub_looping_audio_stream_mono_11025_mid_fixed_iter : public CxxTest::RealTestDescription {
+public:
+ TestDescription_AudioStreamTestSuite_test_sub_looping_audio_stream_mono_11025_mid_fixed_iter() : CxxTest::RealTestDescription( Tests_AudioStreamTestSuite, suiteDescription_AudioStreamTestSuite, 177, "test_sub_looping_audio_stream_mono_11025_mid_fixed_iter" ) {}
+ void runTest() { suite_AudioStreamTestSuite.test_sub_looping_audio_stream_mono_11025_mid_fixed_iter(); }
+} testDescription_AudioStreamTestSuite_test_sub_looping_audio_stream_mono_11025_mid_fixed_iter;
+
+static class TestDescription_AudioStreamTestSuite_test_sub_looping_audio_stream_mono_22050_mid_fixed_iter : public CxxTest::RealTestDescription {
+public:
+ TestDescription_AudioStreamTestSuite_test_sub_looping_audio_stream_mono_22050_mid_fixed_iter() : CxxTest::RealTestDescription( Tests_AudioStreamTestSuite, suiteDescription_AudioStreamTestSuite, 181, "test_sub_looping_audio_stream_mono_22050_mid_fixed_iter" ) {}
+ void runTest() { suite_AudioStreamTestSuite.test_sub_looping_audio_stream_mono_22050_mid_fixed_iter(); }
+} testDescription_AudioStreamTestSuite_test_sub_looping_audio_stream_mono_22050_mid_fixed_iter;
+
+static class TestDescription_AudioStreamTestSuite_test_sub_looping_audio_stream_stereo_11025_mid_fixed_iter : public CxxTest::RealTestDescription {
+public:
+ TestDescription_AudioStreamTestSuite_test_sub_looping_audio_stream_stereo_11025_mid_fixed_iter() : CxxTest::RealTestDescription( Tests_AudioStreamTestSuite, suiteDescription_AudioStreamTestSuite, 185, "test_sub_looping_audio_stream_stereo_11025_mid_fixed_iter" ) {}
+ void runTest() { suite_AudioStreamTestSuite.test_sub_looping_audio_stream_stereo_11025_mid_fixed_iter(); }
+} testDescription_AudioStreamTestSuite_test_sub_looping_audio_stream_stereo_11025_mid_fixed_iter;
+
+static class TestDescription_AudioStreamTestSuite_test_sub_looping_audio_stream_stereo_22050_mid_fixed_iter : public CxxTest::RealTestDescription {
+public:
+ TestDescription_AudioStreamTestSuite_test_sub_looping_audio_stream_stereo_22050_mid_fixed_iter() : CxxTest::RealTestDescription( Tests_AudioStreamTestSuite, suiteDescription_AudioStreamTestSuite, 189, "test_sub_looping_audio_stream_stereo_22050_mid_fixed_iter" ) {}
+ void runTest() { suite_AudioStreamTestSuite.test_sub_looping_audio_stream_stereo_22050_mid_fixed_iter(); }
+} testDescription_AudioStreamTestSuite_test_sub_looping_audio_stream_stereo_22050_mid_fixed_iter;
+
+static class TestDescription_AudioStreamTestSuite_test_sub_looping_audio_stream_mono_11025_end_fixed_iter : public CxxTest::RealTestDescription {
+public:
+ TestDescription_AudioStreamTestSuite_test_sub_looping_audio_stream_mono_11025_end_fixed_iter() : CxxTest::RealTestDescription( Tests_AudioStreamTestSuite, suiteDescription_AudioStreamTestSuite, 193, "test_sub_looping_audio_stream_mono_11025_end_fixed_iter" ) {}
+ void runTest() { suite_AudioStreamTestSuite.test_sub_looping_audio_stream_mono_11025_end_fixed_iter(); }
+} testDescription_AudioStreamTestSuite_test_sub_looping_audio_stream_mono_11025_end_fixed_iter;
+
+static class TestDescription_AudioStreamTestSuite_test_sub_looping_audio_stream_mono_22050_end_fixed_iter : public CxxTest::RealTestDescription {
+public:
+ TestDescription_AudioStreamTestSuite_test_sub_looping_audio_stream_mono_22050_end_fixed_iter() : CxxTest::RealTestDescription( Tests_AudioStreamTestSuite, suiteDescription_AudioStreamTestSuite, 197, "test_sub_looping_audio_stream_mono_22050_end_fixed_iter" ) {}
+ void runTest() { suite_AudioStreamTestSuite.test_sub_looping_audio_stream_mono_22050_end_fixed_iter(); }
+} testDescription_AudioStreamTestSuite_test_sub_looping_audio_stream_mono_22050_end_fixed_iter;
+
+static class TestDescription_AudioStreamTestSuite_test_sub_looping_audio_stream_stereo_11025_end_fixed_iter : public CxxTest::RealTestDescription {
+public:
+ TestDescription_AudioStreamTestSuite_test_sub_looping_audio_stream_stereo_11025_end_fixed_iter() : CxxTest::RealTestDescription( Tests_AudioStreamTestSuite, suiteDescription_AudioStreamTestSuite, 201, "test_sub_looping_audio_stream_stereo_11025_end_fixed_iter" ) {}
+ void runTest() { suite_AudioStreamTestSuite.test_sub_looping_audio_stream_stereo_11025_end_fixed_iter(); }
+} testDescription_AudioStreamTestSuite_test_sub_looping_audio_stream_stereo_11025_end_fixed_iter;
+
+static class TestDescription_AudioStreamTestSuite_test_sub_looping_audio_stream_stereo_22050_end_fixed_iter : public CxxTest::RealTestDescription {
+public:
+ TestDescription_AudioStreamTestSuite_test_sub_looping_audio_stream_stereo_22050_end_fixed_iter() : CxxTest::RealTestDescription( Tests_AudioStreamTestSuite, suiteDescription_AudioStreamTestSuite, 205, "test_sub_looping_audio_stream_stereo_22050_end_fixed_iter" ) {}
+ void runTest() { suite_AudioStreamTestSuite.test_sub_looping_audio_stream_stereo_22050_end_fixed_iter(); }
+} testDescription_AudioStreamTestSuite_test_sub_looping_audio_stream_stereo_22050_end_fixed_iter;
+
+#include "test/audio/raw.h"
+
+static RawStreamTestSuite suite_RawStreamTestSuite;
+
+static CxxTest::List Tests_RawStreamTestSuite = { 0, 0 };
+CxxTest::StaticSuiteDescription suiteDescription_RawStreamTestSuite( "test/audio/raw.h", 8, "RawStreamTestSuite", suite_RawStreamTestSuite, Tests_RawStreamTestSuite );
+
+static class TestDescription_RawStreamTestSuite_test_read_buffer_8_bit_signed_mono : public CxxTest::RealTestDescription {
+public:
+ TestDescription_RawStreamTestSuite_test_read_buffer_8_bit_signed_mono() : CxxTest::RealTestDescription( Tests_RawStreamTestSuite, suiteDescription_RawStreamTestSuite, 28, "test_read_buffer_8_bit_signed_mono" ) {}
+ void runTest() { suite_RawStreamTestSuite.test_read_buffer_8_bit_signed_mono(); }
+} testDescription_RawStreamTestSuite_test_read_buffer_8_bit_signed_mono;
+
+static class TestDescription_RawStreamTestSuite_test_read_buffer_8_bit_signed_stereo : public CxxTest::RealTestDescription {
+public:
+ TestDescription_RawStreamTestSuite_test_read_buffer_8_bit_signed_stereo() : CxxTest::RealTestDescription( Tests_RawStreamTestSuite, suiteDescription_RawStreamTestSuite, 32, "test_read_buffer_8_bit_signed_stereo" ) {}
+ void runTest() { suite_RawStreamTestSuite.test_read_buffer_8_bit_signed_stereo(); }
+} testDescription_RawStreamTestSuite_test_read_buffer_8_bit_signed_stereo;
+
+static class TestDescription_RawStreamTestSuite_test_read_buffer_8_bit_unsigned_mono : public CxxTest::RealTestDescription {
+public:
+ TestDescription_RawStreamTestSuite_test_read_buffer_8_bit_unsigned_mono() : CxxTest::RealTestDescription( Tests_RawStreamTestSuite, suiteDescription_RawStreamTestSuite, 36, "test_read_buffer_8_bit_unsigned_mono" ) {}
+ void runTest() { suite_RawStreamTestSuite.test_read_buffer_8_bit_unsigned_mono(); }
+} testDescription_RawStreamTestSuite_test_read_buffer_8_bit_unsigned_mono;
+
+static class TestDescription_RawStreamTestSuite_test_read_buffer_16_bit_signed_be_mono : public CxxTest::RealTestDescription {
+public:
+ TestDescription_RawStreamTestSuite_test_read_buffer_16_bit_signed_be_mono() : CxxTest::RealTestDescription( Tests_RawStreamTestSuite, suiteDescription_RawStreamTestSuite, 40, "test_read_buffer_16_bit_signed_be_mono" ) {}
+ void runTest() { suite_RawStreamTestSuite.test_read_buffer_16_bit_signed_be_mono(); }
+} testDescription_RawStreamTestSuite_test_read_buffer_16_bit_signed_be_mono;
+
+static class TestDescription_RawStreamTestSuite_test_read_buffer_16_bit_signed_be_stereo : public CxxTest::RealTestDescription {
+public:
+ TestDescription_RawStreamTestSuite_test_read_buffer_16_bit_signed_be_stereo() : CxxTest::RealTestDescription( Tests_RawStreamTestSuite, suiteDescription_RawStreamTestSuite, 44, "test_read_buffer_16_bit_signed_be_stereo" ) {}
+ void runTest() { suite_RawStreamTestSuite.test_read_buffer_16_bit_signed_be_stereo(); }
+} testDescription_RawStreamTestSuite_test_read_buffer_16_bit_signed_be_stereo;
+
+static class TestDescription_RawStreamTestSuite_test_read_buffer_16_bit_unsigned_be_mono : public CxxTest::RealTestDescription {
+public:
+ TestDescription_RawStreamTestSuite_test_read_buffer_16_bit_unsigned_be_mono() : CxxTest::RealTestDescription( Tests_RawStreamTestSuite, suiteDescription_RawStreamTestSuite, 48, "test_read_buffer_16_bit_unsigned_be_mono" ) {}
+ void runTest() { suite_RawStreamTestSuite.test_read_buffer_16_bit_unsigned_be_mono(); }
+} testDescription_RawStreamTestSuite_test_read_buffer_16_bit_unsigned_be_mono;
+
+static class TestDescription_RawStreamTestSuite_test_read_buffer_16_bit_unsigned_be_stereo : public CxxTest::RealTestDescription {
+public:
+ TestDescription_RawStreamTestSuite_test_read_buffer_16_bit_unsigned_be_stereo() : CxxTest::RealTestDescription( Tests_RawStreamTestSuite, suiteDescription_RawStreamTestSuite, 52, "test_read_buffer_16_bit_unsigned_be_stereo" ) {}
+ void runTest() { suite_RawStreamTestSuite.test_read_buffer_16_bit_unsigned_be_stereo(); }
+} testDescription_RawStreamTestSuite_test_read_buffer_16_bit_unsigned_be_stereo;
+
+static class TestDescription_RawStreamTestSuite_test_read_buffer_16_bit_signed_le_mono : public CxxTest::RealTestDescription {
+public:
+ TestDescription_RawStreamTestSuite_test_read_buffer_16_bit_signed_le_mono() : CxxTest::RealTestDescription( Tests_RawStreamTestSuite, suiteDescription_RawStreamTestSuite, 56, "test_read_buffer_16_bit_signed_le_mono" ) {}
+ void runTest() { suite_RawStreamTestSuite.test_read_buffer_16_bit_signed_le_mono(); }
+} testDescription_RawStreamTestSuite_test_read_buffer_16_bit_signed_le_mono;
+
+static class TestDescription_RawStreamTestSuite_test_read_buffer_16_bit_signed_le_stereo : public CxxTest::RealTestDescription {
+public:
+ TestDescription_RawStreamTestSuite_test_read_buffer_16_bit_signed_le_stereo() : CxxTest::RealTestDescription( Tests_RawStreamTestSuite, suiteDescription_RawStreamTestSuite, 60, "test_read_buffer_16_bit_signed_le_stereo" ) {}
+ void runTest() { suite_RawStreamTestSuite.test_read_buffer_16_bit_signed_le_stereo(); }
+} testDescription_RawStreamTestSuite_test_read_buffer_16_bit_signed_le_stereo;
+
+static class TestDescription_RawStreamTestSuite_test_read_buffer_16_bit_unsigned_le_mono : public CxxTest::RealTestDescription {
+public:
+ TestDescription_RawStreamTestSuite_test_read_buffer_16_bit_unsigned_le_mono() : CxxTest::RealTestDescription( Tests_RawStreamTestSuite, suiteDescription_RawStreamTestSuite, 64, "test_read_buffer_16_bit_unsigned_le_mono" ) {}
+ void runTest() { suite_RawStreamTestSuite.test_read_buffer_16_bit_unsigned_le_mono(); }
+} testDescription_RawStreamTestSuite_test_read_buffer_16_bit_unsigned_le_mono;
+
+static class TestDescription_RawStreamTestSuite_test_read_buffer_16_bit_unsigned_le_stereo : public CxxTest::RealTestDescription {
+public:
+ TestDescription_RawStreamTestSuite_test_read_buffer_16_bit_unsigned_le_stereo() : CxxTest::RealTestDescription( Tests_RawStreamTestSuite, suiteDescription_RawStreamTestSuite, 68, "test_read_buffer_16_bit_unsigned_le_stereo" ) {}
+ void runTest() { suite_RawStreamTestSuite.test_read_buffer_16_bit_unsigned_le_stereo(); }
+} testDescription_RawStreamTestSuite_test_read_buffer_16_bit_unsigned_le_stereo;
+
+static class TestDescription_RawStreamTestSuite_test_partial_read : public CxxTest::RealTestDescription {
+public:
+ TestDescription_RawStreamTestSuite_test_partial_read() : CxxTest::RealTestDescription( Tests_RawStreamTestSuite, suiteDescription_RawStreamTestSuite, 98, "test_partial_read" ) {}
+ void runTest() { suite_RawStreamTestSuite.test_partial_read(); }
+} testDescription_RawStreamTestSuite_test_partial_read;
+
+static class TestDescription_RawStreamTestSuite_test_read_after_end : public CxxTest::RealTestDescription {
+public:
+ TestDescription_RawStreamTestSuite_test_read_after_end() : CxxTest::RealTestDescription( Tests_RawStreamTestSuite, suiteDescription_RawStreamTestSuite, 120, "test_read_after_end" ) {}
+ void runTest() { suite_RawStreamTestSuite.test_read_after_end(); }
+} testDescription_RawStreamTestSuite_test_read_after_end;
+
+static class TestDescription_RawStreamTestSuite_test_rewind : public CxxTest::RealTestDescription {
+public:
+ TestDescription_RawStreamTestSuite_test_rewind() : CxxTest::RealTestDescription( Tests_RawStreamTestSuite, suiteDescription_RawStreamTestSuite, 144, "test_rewind" ) {}
+ void runTest() { suite_RawStreamTestSuite.test_rewind(); }
+} testDescription_RawStreamTestSuite_test_rewind;
+
+static class TestDescription_RawStreamTestSuite_test_length : public CxxTest::RealTestDescription {
+public:
+ TestDescription_RawStreamTestSuite_test_length() : CxxTest::RealTestDescription( Tests_RawStreamTestSuite, suiteDescription_RawStreamTestSuite, 207, "test_length" ) {}
+ void runTest() { suite_RawStreamTestSuite.test_length(); }
+} testDescription_RawStreamTestSuite_test_length;
+
+static class TestDescription_RawStreamTestSuite_test_seek_mono : public CxxTest::RealTestDescription {
+public:
+ TestDescription_RawStreamTestSuite_test_seek_mono() : CxxTest::RealTestDescription( Tests_RawStreamTestSuite, suiteDescription_RawStreamTestSuite, 284, "test_seek_mono" ) {}
+ void runTest() { suite_RawStreamTestSuite.test_seek_mono(); }
+} testDescription_RawStreamTestSuite_test_seek_mono;
+
+static class TestDescription_RawStreamTestSuite_test_seek_stereo : public CxxTest::RealTestDescription {
+public:
+ TestDescription_RawStreamTestSuite_test_seek_stereo() : CxxTest::RealTestDescription( Tests_RawStreamTestSuite, suiteDescription_RawStreamTestSuite, 288, "test_seek_stereo" ) {}
+ void runTest() { suite_RawStreamTestSuite.test_seek_stereo(); }
+} testDescription_RawStreamTestSuite_test_seek_stereo;
+
+#include "test/audio/timestamp.h"
+
+static TimestampTestSuite suite_TimestampTestSuite;
+
+static CxxTest::List Tests_TimestampTestSuite = { 0, 0 };
+CxxTest::StaticSuiteDescription suiteDescription_TimestampTestSuite( "test/audio/timestamp.h", 7, "TimestampTestSuite", suite_TimestampTestSuite, Tests_TimestampTestSuite );
+
+static class TestDescription_TimestampTestSuite_test_diff_add_frames : public CxxTest::RealTestDescription {
+public:
+ TestDescription_TimestampTestSuite_test_diff_add_frames() : CxxTest::RealTestDescription( Tests_TimestampTestSuite, suiteDescription_TimestampTestSuite, 10, "test_diff_add_frames" ) {}
+ void runTest() { suite_TimestampTestSuite.test_diff_add_frames(); }
+} testDescription_TimestampTestSuite_test_diff_add_frames;
+
+static class TestDescription_TimestampTestSuite_test_diff_add_msecs : public CxxTest::RealTestDescription {
+public:
+ TestDescription_TimestampTestSuite_test_diff_add_msecs() : CxxTest::RealTestDescription( Tests_TimestampTestSuite, suiteDescription_TimestampTestSuite, 28, "test_diff_add_msecs" ) {}
+ void runTest() { suite_TimestampTestSuite.test_diff_add_msecs(); }
+} testDescription_TimestampTestSuite_test_diff_add_msecs;
+
+static class TestDescription_TimestampTestSuite_test_ticks : public CxxTest::RealTestDescription {
+public:
+ TestDescription_TimestampTestSuite_test_ticks() : CxxTest::RealTestDescription( Tests_TimestampTestSuite, suiteDescription_TimestampTestSuite, 60, "test_ticks" ) {}
+ void runTest() { suite_TimestampTestSuite.test_ticks(); }
+} testDescription_TimestampTestSuite_test_ticks;
+
+static class TestDescription_TimestampTestSuite_test_more_add_diff : public CxxTest::RealTestDescription {
+public:
+ TestDescription_TimestampTestSuite_test_more_add_diff() : CxxTest::RealTestDescription( Tests_TimestampTestSuite, suiteDescription_TimestampTestSuite, 87, "test_more_add_diff" ) {}
+ void runTest() { suite_TimestampTestSuite.test_more_add_diff(); }
+} testDescription_TimestampTestSuite_test_more_add_diff;
+
+static class TestDescription_TimestampTestSuite_test_negate : public CxxTest::RealTestDescription {
+public:
+ TestDescription_TimestampTestSuite_test_negate() : CxxTest::RealTestDescription( Tests_TimestampTestSuite, suiteDescription_TimestampTestSuite, 96, "test_negate" ) {}
+ void runTest() { suite_TimestampTestSuite.test_negate(); }
+} testDescription_TimestampTestSuite_test_negate;
+
+static class TestDescription_TimestampTestSuite_test_add_sub : public CxxTest::RealTestDescription {
+public:
+ TestDescription_TimestampTestSuite_test_add_sub() : CxxTest::RealTestDescription( Tests_TimestampTestSuite, suiteDescription_TimestampTestSuite, 105, "test_add_sub" ) {}
+ void runTest() { suite_TimestampTestSuite.test_add_sub(); }
+} testDescription_TimestampTestSuite_test_add_sub;
+
+static class TestDescription_TimestampTestSuite_test_diff_with_conversion : public CxxTest::RealTestDescription {
+public:
+ TestDescription_TimestampTestSuite_test_diff_with_conversion() : CxxTest::RealTestDescription( Tests_TimestampTestSuite, suiteDescription_TimestampTestSuite, 129, "test_diff_with_conversion" ) {}
+ void runTest() { suite_TimestampTestSuite.test_diff_with_conversion(); }
+} testDescription_TimestampTestSuite_test_diff_with_conversion;
+
+static class TestDescription_TimestampTestSuite_test_convert : public CxxTest::RealTestDescription {
+public:
+ TestDescription_TimestampTestSuite_test_convert() : CxxTest::RealTestDescription( Tests_TimestampTestSuite, suiteDescription_TimestampTestSuite, 148, "test_convert" ) {}
+ void runTest() { suite_TimestampTestSuite.test_convert(); }
+} testDescription_TimestampTestSuite_test_convert;
+
+static class TestDescription_TimestampTestSuite_test_equals : public CxxTest::RealTestDescription {
+public:
+ TestDescription_TimestampTestSuite_test_equals() : CxxTest::RealTestDescription( Tests_TimestampTestSuite, suiteDescription_TimestampTestSuite, 157, "test_equals" ) {}
+ void runTest() { suite_TimestampTestSuite.test_equals(); }
+} testDescription_TimestampTestSuite_test_equals;
+
+static class TestDescription_TimestampTestSuite_test_compare : public CxxTest::RealTestDescription {
+public:
+ TestDescription_TimestampTestSuite_test_compare() : CxxTest::RealTestDescription( Tests_TimestampTestSuite, suiteDescription_TimestampTestSuite, 177, "test_compare" ) {}
+ void runTest() { suite_TimestampTestSuite.test_compare(); }
+} testDescription_TimestampTestSuite_test_compare;
+
+static class TestDescription_TimestampTestSuite_test_framerate : public CxxTest::RealTestDescription {
+public:
+ TestDescription_TimestampTestSuite_test_framerate() : CxxTest::RealTestDescription( Tests_TimestampTestSuite, suiteDescription_TimestampTestSuite, 211, "test_framerate" ) {}
+ void runTest() { suite_TimestampTestSuite.test_framerate(); }
+} testDescription_TimestampTestSuite_test_framerate;
+
+static class TestDescription_TimestampTestSuite_test_direct_query : public CxxTest::RealTestDescription {
+public:
+ TestDescription_TimestampTestSuite_test_direct_query() : CxxTest::RealTestDescription( Tests_TimestampTestSuite, suiteDescription_TimestampTestSuite, 223, "test_direct_query" ) {}
+ void runTest() { suite_TimestampTestSuite.test_direct_query(); }
+} testDescription_TimestampTestSuite_test_direct_query;
+
+static class TestDescription_TimestampTestSuite_test_no_overflow : public CxxTest::RealTestDescription {
+public:
+ TestDescription_TimestampTestSuite_test_no_overflow() : CxxTest::RealTestDescription( Tests_TimestampTestSuite, suiteDescription_TimestampTestSuite, 244, "test_no_overflow" ) {}
+ void runTest() { suite_TimestampTestSuite.test_no_overflow(); }
+} testDescription_TimestampTestSuite_test_no_overflow;
+
+#include "test/engines/scumm/soccer.h"
+
+static SoccerLogicTestSuite suite_SoccerLogicTestSuite;
+
+static CxxTest::List Tests_SoccerLogicTestSuite = { 0, 0 };
+CxxTest::StaticSuiteDescription suiteDescription_SoccerLogicTestSuite( "test/engines/scumm/soccer.h", 92, "SoccerLogicTestSuite", suite_SoccerLogicTestSuite, Tests_SoccerLogicTestSuite );
+
+static class TestDescription_SoccerLogicTestSuite_test_front_face : public CxxTest::RealTestDescription {
+public:
+ TestDescription_SoccerLogicTestSuite_test_front_face() : CxxTest::RealTestDescription( Tests_SoccerLogicTestSuite, suiteDescription_SoccerLogicTestSuite, 188, "test_front_face" ) {}
+ void runTest() { suite_SoccerLogicTestSuite.test_front_face(); }
+} testDescription_SoccerLogicTestSuite_test_front_face;
+
+static class TestDescription_SoccerLogicTestSuite_test_side_face : public CxxTest::RealTestDescription {
+public:
+ TestDescription_SoccerLogicTestSuite_test_side_face() : CxxTest::RealTestDescription( Tests_SoccerLogicTestSuite, suiteDescription_SoccerLogicTestSuite, 205, "test_side_face" ) {}
+ void runTest() { suite_SoccerLogicTestSuite.test_side_face(); }
+} testDescription_SoccerLogicTestSuite_test_side_face;
+
+static class TestDescription_SoccerLogicTestSuite_test_moved_object : public CxxTest::RealTestDescription {
+public:
+ TestDescription_SoccerLogicTestSuite_test_moved_object() : CxxTest::RealTestDescription( Tests_SoccerLogicTestSuite, suiteDescription_SoccerLogicTestSuite, 216, "test_moved_object" ) {}
+ void runTest() { suite_SoccerLogicTestSuite.test_moved_object(); }
+} testDescription_SoccerLogicTestSuite_test_moved_object;
+
+static class TestDescription_SoccerLogicTestSuite_test_closest_of_two : public CxxTest::RealTestDescription {
+public:
+ TestDescription_SoccerLogicTestSuite_test_closest_of_two() : CxxTest::RealTestDescription( Tests_SoccerLogicTestSuite, suiteDescription_SoccerLogicTestSuite, 235, "test_closest_of_two" ) {}
+ void runTest() { suite_SoccerLogicTestSuite.test_closest_of_two(); }
+} testDescription_SoccerLogicTestSuite_test_closest_of_two;
+
+static class TestDescription_SoccerLogicTestSuite_test_single_sort_pass : public CxxTest::RealTestDescription {
+public:
+ TestDescription_SoccerLogicTestSuite_test_single_sort_pass() : CxxTest::RealTestDescription( Tests_SoccerLogicTestSuite, suiteDescription_SoccerLogicTestSuite, 247, "test_single_sort_pass" ) {}
+ void runTest() { suite_SoccerLogicTestSuite.test_single_sort_pass(); }
+} testDescription_SoccerLogicTestSuite_test_single_sort_pass;
+
+static class TestDescription_SoccerLogicTestSuite_test_ground_intersection : public CxxTest::RealTestDescription {
+public:
+ TestDescription_SoccerLogicTestSuite_test_ground_intersection() : CxxTest::RealTestDescription( Tests_SoccerLogicTestSuite, suiteDescription_SoccerLogicTestSuite, 264, "test_ground_intersection" ) {}
+ void runTest() { suite_SoccerLogicTestSuite.test_ground_intersection(); }
+} testDescription_SoccerLogicTestSuite_test_ground_intersection;
+
+#include <cxxtest/Root.cpp>